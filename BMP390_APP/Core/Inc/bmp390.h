@@ -20,6 +20,16 @@
 #include "stdbool.h"
 #include "stdint.h"
 #include "math.h"
+#include "bmp390_conf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#define BMP390_Restrict				__restrict	/*! The header is also included by the C++ front end (bmp390.hpp) */
+#define BMP390_StaticAssert			static_assert
+#else
+#define BMP390_Restrict				restrict
+#define BMP390_StaticAssert			_Static_assert
+#endif
 
 
 
@@ -50,6 +60,8 @@ extern float  BMP390_gForce;/**
 
 /************************SENSOR REGISTER DEFINITIONS***************************/
 
+#define BMP390_REG_CMD		 		0x7E  /*Soft reset and FIFO flush commands (BMP390_CMD_TypeDef) */
+
 #define BMP390_REG_CONFIG		 	0x1F  /*Controls the IIR filter coefficients.
  	 	 	 	 	 	 	 	 	 	    bits :  iir_filter[3:1] */
 
@@ -112,6 +124,12 @@ extern float  BMP390_gForce;/**
 /**!These macros define the address that is used at i2c communication*/
 #define BMP390_StartAdd_CalibCoeff 			    0x31
 #define BMP390_StartAdd_MSB_LSB_XLSB_PT  		0x04
+#define BMP390_StartAdd_Frame  					0x02
+#define BMP390_RawFrame_Len						16	  // ERR, STATUS, DATA_0..DATA_5, two reserved bytes, SENSORTIME_0..SENSORTIME_2,
+													  // a reserved byte, EVENT, INT_STATUS
+
+/**!The sensor accepts commands again this long after a soft reset (ms) */
+#define BMP390_StartupTime						2
 
 /**!These macros provide to calculate the altitude of BMP390 */
 // The Formula : H = (T0 / L) * (1 - (P0 / P) * (g / (R * L)))
@@ -123,6 +141,35 @@ extern float  BMP390_gForce;/**
 							  // (P) is current pressure(Unit : Pascal), (h) is current altitude(Unit : Meter)
 							  // (H) is the current altitude of the sensor or device
 
+/**!These macros provide to calculate the measurement time of BMP390 (datasheet 3.9.2, unit : microsecond)*/
+// The Formula : Tconv = 234 + press_en * (392 + 2^osr_p * 2020) + temp_en * (163 + 2^osr_t * 2020)
+#define BMP390_MeasTime_Offset		234
+#define BMP390_MeasTime_PressOffset	392
+#define BMP390_MeasTime_TempOffset	163
+#define BMP390_MeasTime_PerSample	2020
+#define BMP390_OdrPeriod_Base		5000  // Sampling period of BMP390_ODR_200, each odr_sel step doubles it
+#define BMP390_Sensortime_OdrStep	128	  // SENSORTIME counts (25.6 kHz) in the sampling period of BMP390_ODR_200
+#define BMP390_Sensortime_Mask		0x00FFFFFF
+
+/**!These macros provide the typical RMS noise of BMP390 (without oversampling and IIR filter, approximate values).
+ *  Oversampling by 2^osr scales the noise by 1/sqrt(2^osr), the IIR filter with coefficient c by 1/sqrt(2c+1) */
+#define BMP390_PressNoise_X1		1.2f  // Unit : Pascal
+#define BMP390_TempNoise_X1			0.005f// Unit : °C
+#define BMP390_OsrNoiseFactor(osr)	((osr) == 0 ? 1.0f    : (osr) == 1 ? 0.7071f : (osr) == 2 ? 0.5f   : \
+									 (osr) == 3 ? 0.3536f : (osr) == 4 ? 0.25f   : 0.1768f)
+#define BMP390_IirNoiseFactor(coef)	((coef) == 0 ? 1.0f    : (coef) == 1 ? 0.5774f : (coef) == 2 ? 0.3780f : \
+									 (coef) == 3 ? 0.2582f : (coef) == 4 ? 0.1796f : (coef) == 5 ? 0.1260f : \
+									 (coef) == 6 ? 0.0887f : 0.0626f)
+
+/**!If it is true, the raw calibration data stays in the handle (Raw_NVM) after it is processed */
+#ifndef BMP390_Keep_RawNVM
+#define BMP390_Keep_RawNVM			false
+#endif
+
+/**!If it is true, an invalid ODR is slowed down until the measurement fits, otherwise the upload is rejected */
+#ifndef BMP390_Config_AutoAdjust
+#define BMP390_Config_AutoAdjust	true
+#endif
 
 
 /******************************************************************************
@@ -143,13 +190,13 @@ typedef enum{
 
 
 /**
- * @brief Work modes
+ * @brief Work modes, PWR_CTRL mode[5:4] : 01 and 10 are both forced mode, only 11 is normal mode
  */
 typedef enum{
 
 	BMP390_Mode_Sleep  = 0,
 	BMP390_Mode_Forced = 1,
-	BMP390_Mode_Normal = 2
+	BMP390_Mode_Normal = 3
 
 }BMP390_Mode_TypeDef;
 
@@ -244,6 +291,18 @@ typedef enum{
 }BMP390_ODR_TypeDef;
 
 
+/**
+ * @brief Result of BMP390_Check_ConfigParams
+ */
+typedef enum{
+
+	BMP390_Config_OK       = 0,		/* The parameters are uploaded as they are */
+	BMP390_Config_Adjusted = 1,		/* The odr was slowed down until the measurement fits, Params.odr holds the new one */
+	BMP390_Config_Invalid  = 2		/* Out of range, or the measurement doesn't fit and AutoAdjust is false */
+
+}BMP390_Config_Status_TypeDef;
+
+
 /***********************FIFO FEATURES ENUMS**************************/
 
 /**
@@ -308,8 +367,8 @@ typedef enum{
  */
 typedef enum{
 
-	BMP390_Event_por_detected = 1,
-	BMP390_Event_itf_act_pt   = 1
+	BMP390_Event_por_detected = (1<<0),	/*The sensor was powered up or soft reset, it runs with the defaults (cleared on read)*/
+	BMP390_Event_itf_act_pt   = (1<<1)
 
 }BMP390_Event_TypeDef;
 
@@ -320,8 +379,8 @@ typedef enum{
 typedef enum{
 
 	BMP390_IntStat_Fifo_wm 	 = (1<<0),
-	BMP390_IntStat_Fifo_full = (1<<0),
-	BMP390_IntStat_drdy		 = (1<<0)
+	BMP390_IntStat_Fifo_full = (1<<1),
+	BMP390_IntStat_drdy		 = (1<<3)
 
 }BMP390_IntStat_TypeDef;
 
@@ -405,60 +464,66 @@ typedef struct{
 
 /**
  * @brief  The BMP390 registers hold the structure
- * 		   where all register features capable of receiving values are stored
+ * 		   where all register features capable of receiving values are stored.
+ * 		   Every field is a bitfield as wide as its register bits, the whole set fits in 8 bytes
  *
  */
 typedef struct {
 
 
-	BMP390_Mode_TypeDef mode;				/*! Select the sleep mode, forced mode, normal mode*/
-	BMP390_ODR_TypeDef	odr;				/*! Select the output data rate. In other words, the sampling period*/
-	BMP390_FilterCoef_TypeDef filtercoef;   /*! Select the IIR filter coefficients */
+	BMP390_Mode_TypeDef mode : 2;					/*! Select the sleep mode, forced mode, normal mode*/
+	BMP390_ODR_TypeDef	odr : 5;					/*! Select the output data rate. In other words, the sampling period*/
+	BMP390_FilterCoef_TypeDef filtercoef : 3;   	/*! Select the IIR filter coefficients */
 
 	/**
 	 * These two of them are about oversampling settings register (OSR), Variables of PWR_CTRL variable
 	 */
-	BMP390_Osrs_TypeDef press_osrs;
-	BMP390_Osrs_TypeDef temp_osrs;
+	BMP390_Osrs_TypeDef press_osrs : 3;
+	BMP390_Osrs_TypeDef temp_osrs : 3;
 
 	/**
 	 * These two of them are about eneable disable measurement , Variables of PWR_CTRL variable
 	 */
-	BMP390_REG_Stat_bits_TypeDef stat_meas_press;
-	BMP390_REG_Stat_bits_TypeDef stat_meas_temp;
+	BMP390_REG_Stat_bits_TypeDef stat_meas_press : 1;
+	BMP390_REG_Stat_bits_TypeDef stat_meas_temp : 1;
 
 	/**
 	 * These three of them are about Interface Configuration register (IF_CONF)
 	 */
-	BMP390_SPI_X_TypeDef spi_x;
-	BMP390_REG_Stat_bits_TypeDef stat_wdt;
-	BMP390_I2C_Wdt_Sel_TypeDef wdt_type;
+	BMP390_SPI_X_TypeDef spi_x : 1;
+	BMP390_REG_Stat_bits_TypeDef stat_wdt : 1;
+	BMP390_I2C_Wdt_Sel_TypeDef wdt_type : 1;
 
 	/**
 	 * These five of them are about FIFO Configuration_1 register (FIFO_CONFIG_1)
 	 */
-	BMP390_REG_Stat_bits_TypeDef stat_fifo;
-	BMP390_REG_Stat_bits_TypeDef stat_fifo_stopFull;
-	BMP390_REG_Stat_bits_TypeDef stat_fifo_press;
-	BMP390_REG_Stat_bits_TypeDef stat_fifo_temp;
-	BMP390_REG_Stat_bits_TypeDef stat_fifo_time;
+	BMP390_REG_Stat_bits_TypeDef stat_fifo : 1;
+	BMP390_REG_Stat_bits_TypeDef stat_fifo_stopFull : 1;
+	BMP390_REG_Stat_bits_TypeDef stat_fifo_press : 1;
+	BMP390_REG_Stat_bits_TypeDef stat_fifo_temp : 1;
+	BMP390_REG_Stat_bits_TypeDef stat_fifo_time : 1;
 
 	/**
 	 * These two of them are about FIFO Configuration_2 register (FIFO_CONFIG_2)
 	 */
-	BMP390_Fifo_Subsampling_TypeDef fifo_subs;
-	BMP390_Fifo_DataSelect_TypeDef fifo_sel;
+	BMP390_Fifo_Subsampling_TypeDef fifo_subs : 3;
+	BMP390_Fifo_DataSelect_TypeDef fifo_sel : 2;
 
 	/**
 	 * These seven of them are about Interrupt configuration register (INT_CTRL)
 	 */
-	BMP390_Int_Out_TypeDef int_out;
-	BMP390_Int_Level_TypeDef int_level;
-	BMP390_REG_Stat_bits_TypeDef stat_int_latch;
-	BMP390_REG_Stat_bits_TypeDef stat_int_fwtm;
-	BMP390_REG_Stat_bits_TypeDef stat_int_fful;
-	BMP390_Int_Ds_TypeDef int_ds;
-	BMP390_REG_Stat_bits_TypeDef stat_int_drdy;
+	BMP390_Int_Out_TypeDef int_out : 1;
+	BMP390_Int_Level_TypeDef int_level : 1;
+	BMP390_REG_Stat_bits_TypeDef stat_int_latch : 1;
+	BMP390_REG_Stat_bits_TypeDef stat_int_fwtm : 1;
+	BMP390_REG_Stat_bits_TypeDef stat_int_fful : 1;
+	BMP390_Int_Ds_TypeDef int_ds : 1;
+	BMP390_REG_Stat_bits_TypeDef stat_int_drdy : 1;
+
+	/**
+	 * FIFO watermark registers (FIFO_WTM_0, FIFO_WTM_1), fifo_water_mark[8:0]
+	 */
+	uint16_t fifo_wtm : 9;
 
 }BMP390_Params_t;
 
@@ -469,73 +534,132 @@ typedef struct {
  */
 typedef struct{
 
-	float alt0;
-	float alt1;
-	float holdAlt;
+	float alt0;						/*! Altitude of the previous sample */
+	float spd0;						/*! Speed of the previous sample */
+	uint32_t t0;					/*! Timestamp (ms) of the previous sample */
 
-	float acc0;
-	float acc1;
-	float holdAcc;
+}BMP390_DeltaData;
 
-	float spd0;
-	float spd1;
-	float holdSpd;
 
-}BMP390_DeltaData;
+/**
+ * @brief  Raw data of one measurement, as it is read from the sensor (24 bit values)
+ *
+ */
+typedef struct{
+
+	uint32_t rawPress;
+	uint32_t rawTemp;
+	uint32_t sensortime;
+
+}BMP390_RawFrame_TypeDef;
 
 
 /**
- * @brief   This is the general structure of the BMP390 sensor,
- * 			which contains all the variables and their respective values
+ * @brief  Status registers that are read in the same burst as the raw data
  *
  */
 typedef struct{
 
-	BMP390_Params_t Params;
+	uint8_t err;					/*! BMP390_Error_TypeDef bits */
+	uint8_t status;					/*! BMP390_DataStatus_TypeDef bits */
+	uint8_t event;					/*! BMP390_Event_TypeDef bits */
+	uint8_t intStatus;				/*! BMP390_IntStat_TypeDef bits */
 
-	uint16_t BMP390_I2C_ADDRESS;
+}BMP390_StatusRegs_TypeDef;
 
-	I2C_HandleTypeDef *i2c;
 
-	BMP390_RawCalibData_TypeDef Raw_NVM;
+/**
+ * @brief  Identity of the last processed frame. TIM1 and the output data rate aren't synchronized,
+ * 		   so the same data registers can be read more than once or a conversion can be skipped
+ *
+ */
+typedef struct{
+
+	uint32_t sensortime;			/*! Sensortime of the last new frame */
+	uint32_t duplicates;			/*! Frames without drdy, they were already processed */
+	uint32_t missed;				/*! Conversions that were never read, counted from the sensortime gaps (normal mode) */
+	uint8_t primed;					/*! Cleared by every upload, the next gap isn't counted */
+
+}BMP390_FrameTrack_TypeDef;
+
+
+/**
+ * @brief  One complete sample of the sensor, every value belongs to the same measurement
+ *
+ */
+typedef struct{
+
+	uint32_t timestamp;				/*! HAL tick (ms) of the measurement, the speed and acceleration are per its difference */
+
+	float press;					/*! (Pa) */
+	float temp;						/*! (°C) */
+	float vertAlt;					/*! (m) */
+	float vertSpd;					/*! (m/s) */
+	float vertAcc;					/*! (m/s²) */
+	float gForce;					/*! (kg*g) */
+
+}BMP390_Sample_TypeDef;
+
+
+/**
+ * @brief  Latest sample publication. The timer interrupt is the only writer,
+ * 		   any number of readers get a consistent copy without disabling interrupts.
+ * 		   seq is odd while the writer is updating the sample.
+ *
+ */
+typedef struct{
+
+	volatile uint32_t seq;
+
+	BMP390_Sample_TypeDef sample;
+
+}BMP390_SampleSeqlock_TypeDef;
+
+
+/**
+ * @brief   This is the general structure of the BMP390 sensor,
+ * 			which contains all the variables and their respective values
+ *
+ */
+typedef struct{
+
+	I2C_HandleTypeDef *i2c;
 
 	BMP390_PrcsdCalibData_TypeDef Prcsd_NVM;
 
 	BMP390_DeltaData DeltaData;
 
-	uint8_t CONFIG; 				/*! bits: iir_filter[3:1] */
-	uint8_t ODR;					/*! bits: odr_sel[4:0] */
-	uint8_t OSR;					/*! bits: osr_t[5:3], osr_p[2:0] */
-	uint8_t PWR_CTRL;				/*! bits: mode[5:4], temp_en[1:1], press_en[0:0] */
-	uint8_t IF_CONFIG;				/*! bits: i2c_wdt_sel[2:2], i2c_wdt_en[1:1], spi3[0:0] */
+	float FixedAltitude;			/*!It gets otomaticly zero or calculated sea level pressure after selecting Ref_Alt_Sel*/
+
+	BMP390_Params_t Params;			/*! Register images are built from Params while uploading, no shadow bytes are kept */
 
-	uint8_t INT_CTRL;				/**!bits:
-									 * 		drdy_en[6:6], int_ds[5:5],
-									 * 		ffull_en[4:4], fwtm_en[3:3],
-									 * 		int_latch[2:2], int_level[1:1],
-									 * 		int_od[0:0]
-									 */
+	BMP390_FrameTrack_TypeDef Track;
 
-	uint8_t FIFO_CONFIG_1;			/**!bits:
-	 	 	 	 	 	 	 	 	 * 		fifo_temp_en[4:4], fifo_press_en[3:3],
-									 * 		fifo_time_en[2:2], fifo_stop_on_full[1:1],
-									 * 		fifo_mode[0:0]
-									 */
+#if BMP390_Keep_RawNVM
+	BMP390_RawCalibData_TypeDef Raw_NVM;
+#endif
 
-	uint8_t FIFO_CONFIG_2;			/*! bits: data_select[4:3], fifo_subsampling[2:0] */
+	uint16_t BMP390_I2C_ADDRESS;
 
-	uint8_t FIFO_WTM_0;				/*! bits: fifo_water_mark_0_7[7:0] */
-	uint8_t FIFO_WTM_1;				/*! bits: fifo_water_mark_8[0:0] */
+	uint8_t ERR;					/*! bits: conf_err[2:2], cmd_err[1:1], fatal_err[0:0], read back after every upload */
 
 	char Ref_Alt_Sel;				/**
 	   	   	   	   	   	   	   	   	  * Ref_Alt_Sel is a selection;  For 'm' : it sets the reference altitude to the current location (0 meters)
 	   	   	   	   	   	   	   	   	  * 							 For 'M' : it sets the reference altitude to sea level
 	   	   	   	   	   	   	   	   	  */
 
-	float FixedAltitude;			/*!It gets otomaticly zero or calculated sea level pressure after selecting Ref_Alt_Sel*/
-
 }BMP390_HandleTypeDef;
 
+/**!RAM budget of the 10 KB part, the build fails if the structures grow.
+ *  Handle : 56 calibration + 12 delta + 4 altitude + 8 params + 16 frame track + 4 address and flags = 100 bytes,
+ *  the frame track (duplicate and missed conversion detection) raised it from 80, the delta timestamp from 96.
+ *  The sum is rounded up to the alignment of the pointer, a 64 bit host build pads the end of the handle */
+#define BMP390_HandleBudget			(sizeof(I2C_HandleTypeDef *) + 100 + (BMP390_Keep_RawNVM ? 24 : 0))
+BMP390_StaticAssert(sizeof(BMP390_Params_t) <= 8, "BMP390_Params_t grew, keep it packed");
+BMP390_StaticAssert(sizeof(BMP390_HandleTypeDef) <=
+					((BMP390_HandleBudget + sizeof(I2C_HandleTypeDef *) - 1) & ~(sizeof(I2C_HandleTypeDef *) - 1)),
+					"BMP390_HandleTypeDef grew, check the RAM budget");
+
 
 /******************************************************************************
          			#### BMP390 PROTOTYPES OF FUNCTIONS ####
@@ -550,20 +674,22 @@ _Bool BMP390_Init(BMP390_HandleTypeDef *BMP390);
 
 
 /**
-  * @brief  Retrieves raw calibration coefficient data from the BMP390 chip and stores them in Raw_NVM.
+  * @brief  Retrieves raw calibration coefficient data from the BMP390 chip.
   * @param  BMP390 general handle.
+  * @param  Raw_NVM stores the raw data, it can be the handle's Raw_NVM (BMP390_Keep_RawNVM) or a temporary one.
   * @retval booleans.
   */
-_Bool BMP390_Get_RawCalibCoeff(BMP390_HandleTypeDef *BMP390);
+_Bool BMP390_Get_RawCalibCoeff(BMP390_HandleTypeDef *BMP390, BMP390_RawCalibData_TypeDef *Raw_NVM);
 
 
 /**
   * @brief  Processes the incoming raw chip data through mathematical operations with specific numbers,
   * 		converting them into processed data and stores them in Prcsd_NVM.
   * @param  BMP390 general handle.
+  * @param  Raw_NVM is the raw data that is retrieved by BMP390_Get_RawCalibCoeff.
   * @retval booleans.
   */
-_Bool BMP390_Calc_PrcsdCalibrationCoeff(BMP390_HandleTypeDef *BMP390);
+_Bool BMP390_Calc_PrcsdCalibrationCoeff(BMP390_HandleTypeDef *BMP390, const BMP390_RawCalibData_TypeDef *Raw_NVM);
 
 
 /**
@@ -583,6 +709,49 @@ _Bool BMP390_Set_DefaultParams(BMP390_HandleTypeDef *BMP390);
 _Bool BMP390_Upload_ConfigParams(BMP390_HandleTypeDef *BMP390);
 
 
+/**
+  * @brief  Writes the FIFO and interrupt pin settings of Params (INT_CTRL, FIFO_WTM, FIFO_CONFIG_1/2).
+  * 		BMP390_Upload_ConfigParams calls it when the FIFO or an interrupt is enabled.
+  * @param  BMP390 general handle.
+  * @retval booleans.
+  */
+_Bool BMP390_Upload_FifoParams(BMP390_HandleTypeDef *BMP390);
+
+
+/**
+  * @brief  Calculates the worst case measurement time of the selected oversampling and enable settings.
+  * @param  Params is the parameter set that will be uploaded.
+  * @retval Measurement time (us).
+  */
+uint32_t BMP390_Calc_MeasTime(const BMP390_Params_t *Params);
+
+
+/**
+  * @brief  Calculates the sampling period of the selected output data rate.
+  * @param  odr is the odr_sel value.
+  * @retval Sampling period (us).
+  */
+uint32_t BMP390_Calc_OdrPeriod(BMP390_ODR_TypeDef odr);
+
+
+/**
+  * @brief  Checks the parameters before they are uploaded. In normal mode the measurement time must
+  * 		fit into the sampling period, otherwise the sensor sets conf_err and stops producing data.
+  * @param  BMP390 general handle.
+  * @param  AutoAdjust, if it is true the odr is slowed down until the measurement fits.
+  * @retval BMP390_Config_Adjusted tells that Params.odr isn't the requested one anymore.
+  */
+BMP390_Config_Status_TypeDef BMP390_Check_ConfigParams(BMP390_HandleTypeDef *BMP390, _Bool AutoAdjust);
+
+
+/**
+  * @brief  Reads the ERR register into the handle.
+  * @param  BMP390 general handle.
+  * @retval true if none of fatal_err, cmd_err and conf_err is set.
+  */
+_Bool BMP390_Get_ErrStatus(BMP390_HandleTypeDef *BMP390);
+
+
 /**
   * @brief  A single function can calculate pressure, temperature, altitude, vertical speed,
   * 		vertical acceleration, and g-force values.
@@ -600,6 +769,75 @@ _Bool BMP390_Get_SensorValues(BMP390_HandleTypeDef *BMP390, float *BMP390_Press,
 							 float *BMP390_VertAcc, float *BMP390_VertSpd,
 							 float *BMP390_gForce);
 
+/**
+  * @brief  Reads one sample and runs the whole processing chain on it. The result is returned in a single
+  * 		structure, so nothing aliases the handle or the other outputs.
+  * 		Data that was already read is not processed again, it waits up to one sampling period for a new conversion.
+  * @param  BMP390 general handle.
+  * @param  totalMass (kg) is used for the g-force.
+  * @param  Sample is filled with the timestamp and all processed values.
+  * @retval false if no new sample came, Sample is left untouched.
+  */
+_Bool BMP390_Read_Sample(BMP390_HandleTypeDef *BMP390_Restrict BMP390, float totalMass, BMP390_Sample_TypeDef *BMP390_Restrict Sample);
+
+
+/**
+  * @brief  Reads pressure, temperature, sensortime and the status registers (ERR .. INT_STATUS) in a single burst.
+  * 		The status goes through BMP390_Health_Check, a lost configuration is restored before returning,
+  * 		then BMP390_Track_Frame drops the data that was already read.
+  * @param  BMP390 general handle.
+  * @param  Frame is filled with the raw 24 bit values.
+  * @param  Regs receives the status registers, it can be NULL.
+  * @retval false if the transfer failed, the data doesn't come from the configured sensor or it isn't new.
+  */
+_Bool BMP390_Read_RawFrame(BMP390_HandleTypeDef *BMP390, BMP390_RawFrame_TypeDef *Frame, BMP390_StatusRegs_TypeDef *Regs);
+
+
+/**
+  * @brief  Tells a new conversion from data that was already read, before anything is compensated.
+  * 		drdy_press/drdy_temp are cleared when the data registers are read, STATUS comes first in the burst.
+  * @param  Track is the frame identity, duplicates and missed are counted.
+  * @param  Params give the enabled measurements, the mode and the odr.
+  * @param  Frame and Regs come from the same burst.
+  * @retval true if the frame is new.
+  */
+_Bool BMP390_Track_Frame(BMP390_FrameTrack_TypeDef *Track, const BMP390_Params_t *Params,
+						 const BMP390_RawFrame_TypeDef *Frame, const BMP390_StatusRegs_TypeDef *Regs);
+
+
+/**
+  * @brief  Writes the soft reset command and waits until the sensor starts up, all registers get their defaults.
+  * @param  BMP390 general handle.
+  * @retval booleans.
+  */
+_Bool BMP390_Soft_Reset(BMP390_HandleTypeDef *BMP390);
+
+
+/**
+  * @brief  Runs the processing chain on already read raw values (the timestamp is not touched).
+  * 		Speed and acceleration are divided by the time since the previous sample, so they stay in m/s and m/s²
+  * 		at any TIM1 period, ODR or FIFO rate. A sample with the timestamp of the previous one gets the plain differences.
+  * @param  BMP390 general handle, only the calibration, the reference altitude and the previous values are used.
+  * @param  rawPress and rawTemp are the 24 bit data register values.
+  * @param  totalMass (kg) is used for the g-force.
+  * @param  Sample is filled with all processed values.
+  * @retval booleans.
+  */
+_Bool BMP390_Process_RawData(BMP390_HandleTypeDef *BMP390_Restrict BMP390, uint32_t rawPress, uint32_t rawTemp,
+							 float totalMass, BMP390_Sample_TypeDef *BMP390_Restrict Sample);
+
+
+/**
+  * @brief  Pure stages of the processing chain, they only depend on their arguments.
+  * 		Comp_Temp (°C), Comp_Press (Pa), Comp_VertAlt (m), Comp_Delta (difference of two samples), Comp_gForce (kg*g)
+  */
+float BMP390_Comp_Temp(const BMP390_PrcsdCalibData_TypeDef *Calib, uint32_t rawTemp);
+float BMP390_Comp_Press(const BMP390_PrcsdCalibData_TypeDef *Calib, uint32_t rawPress, float temp);
+float BMP390_Comp_VertAlt(float press, float fixedAltitude);
+float BMP390_Comp_Delta(float now, float prev);
+float BMP390_Comp_gForce(float vertAcc, float totalMass);
+
+
 /**
   * @brief  Resets initial, final, and differential values to zero for vertical speed,
   * 		vertical acceleration, and g-force calculations.
@@ -662,4 +900,33 @@ float BMP390_Calc_VertAcc(BMP390_HandleTypeDef *BMP390, float *BMP390_VertSpd, f
 float BMP390_Calc_VertSpd(BMP390_HandleTypeDef *BMP390, float *BMP390_VertAlt, float *BMP390_VertSpd);
 
 
+
+/**
+  * @brief  Publishes a complete sample. Only one writer (the timer interrupt) is allowed.
+  * @param  Latest is the publication slot.
+  * @param  Sample is the new sample.
+  */
+void BMP390_Publish_Sample(BMP390_SampleSeqlock_TypeDef *Latest, const BMP390_Sample_TypeDef *Sample);
+
+
+/**
+  * @brief  Copies the latest published sample, it retries while the writer is in the middle of an update.
+  * @param  Latest is the publication slot.
+  * @param  Sample is the consistent copy.
+  * @retval Sequence number of the copied sample, it changes with every publication.
+  */
+uint32_t BMP390_Read_LatestSample(const BMP390_SampleSeqlock_TypeDef *Latest, BMP390_Sample_TypeDef *Sample);
+
+
+/**
+  * @brief  Core cycles for the benchmarks of the modules : the DWT cycle counter of the Cortex-M3, it is started on
+  * 		the first call. The host build (Tests/Host) counts with the time stamp counter of its CPU instead.
+  */
+uint32_t BMP390_Cycles(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* INC_BMP390_H_ */
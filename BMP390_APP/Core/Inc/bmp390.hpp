@@ -0,0 +1,358 @@
+/*!
+ * @file : bmp390.hpp
+
+ * Author: Yunus Emre KAYRA (github.com/YEK-Kayra)
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ **/
+
+/**
+ * NOTE ==> Header-only C++17 front end of the driver. It uses the register definitions, enums and calibration
+ * 			structures of bmp390.h, but it doesn't need bmp390.c. Everything is resolved at compile time by the
+ * 			policies: no virtual functions, no heap, no globals.
+ *
+ * 			bmp390::Bmp390<bmp390::HalI2cBus, bmp390::FloatMath, bmp390::DefaultConfig> sensor{{&hi2c1, 0x76 << 1}};
+ * 			sensor.init();
+ * 			auto m = sensor.read();
+ */
+
+#ifndef BMP390_HPP_
+#define BMP390_HPP_
+
+
+/******************************************************************************
+         			#### BMP390 INCLUDES ####
+******************************************************************************/
+#include "bmp390.h"
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+
+
+namespace bmp390 {
+
+
+/******************************************************************************
+         			#### BMP390 CONFIGURATION ####
+******************************************************************************/
+
+/**
+ * @brief  Compile-time configuration, the register images and timings are constants.
+ * 		   The measurement time is checked against the ODR period by the compiler.
+ */
+template<BMP390_Mode_TypeDef Mode, BMP390_ODR_TypeDef Odr,
+		 BMP390_Osrs_TypeDef PressOsrs, BMP390_Osrs_TypeDef TempOsrs,
+		 BMP390_FilterCoef_TypeDef FilterCoef>
+struct Config {
+
+	static constexpr uint8_t PWR_CTRL = static_cast<uint8_t>((Mode << 4) | (Enable << 1) | (Enable << 0));
+	static constexpr uint8_t SLEEP    = static_cast<uint8_t>(PWR_CTRL & 0x03);
+	static constexpr uint8_t CONFIG   = static_cast<uint8_t>(FilterCoef << 1);
+	static constexpr uint8_t ODR      = static_cast<uint8_t>(Odr);
+	static constexpr uint8_t OSR      = static_cast<uint8_t>((PressOsrs << 0) | (TempOsrs << 3));
+
+	static constexpr uint32_t MeasTime  = BMP390_MeasTime_Offset
+										+ BMP390_MeasTime_PressOffset + (BMP390_MeasTime_PerSample << PressOsrs)
+										+ BMP390_MeasTime_TempOffset  + (BMP390_MeasTime_PerSample << TempOsrs);
+	static constexpr uint32_t OdrPeriod = static_cast<uint32_t>(BMP390_OdrPeriod_Base) << Odr;
+
+	static_assert((Mode != BMP390_Mode_Normal) || (MeasTime <= OdrPeriod),
+				  "BMP390: the measurement doesn't fit into the ODR period");
+};
+
+using DefaultConfig = Config<BMP390_Mode_Normal, BMP390_ODR_25, BMP390_Oversampling_X8,
+							 BMP390_Oversampling_X2, BMP390_Filter_Coef_3>;
+
+
+/******************************************************************************
+         			#### BMP390 BUS POLICIES ####
+******************************************************************************/
+
+/**
+ * @brief  Every bus provides read(reg, data, len) and write(reg, value), both return true on success.
+ */
+struct HalI2cBus {
+
+	I2C_HandleTypeDef *i2c;
+	uint16_t address;				/*! 8 bit HAL address */
+	uint32_t timeout = 10;			/*! ms */
+
+	bool read(uint8_t reg, uint8_t *data, uint16_t len) {
+		return HAL_I2C_Mem_Read(i2c, address, reg, I2C_MEMADD_SIZE_8BIT, data, len, timeout) == HAL_OK;
+	}
+
+	bool write(uint8_t reg, uint8_t value) {
+		return HAL_I2C_Mem_Write(i2c, address, reg, I2C_MEMADD_SIZE_8BIT, &value, 1, timeout) == HAL_OK;
+	}
+};
+
+
+#ifdef HAL_SPI_MODULE_ENABLED
+/**
+ * @brief  4 wire SPI, bit 7 of the register address selects read. A read returns one dummy byte first.
+ */
+struct HalSpiBus {
+
+	SPI_HandleTypeDef *spi;
+	GPIO_TypeDef *csPort;
+	uint16_t csPin;
+	uint32_t timeout = 10;			/*! ms */
+
+	bool read(uint8_t reg, uint8_t *data, uint16_t len) {
+		uint8_t header[2] = { static_cast<uint8_t>(reg | 0x80), 0 };
+		HAL_GPIO_WritePin(csPort, csPin, GPIO_PIN_RESET);
+		bool ok = (HAL_SPI_Transmit(spi, header, 2, timeout) == HAL_OK) &&
+				  (HAL_SPI_Receive(spi, data, len, timeout) == HAL_OK);
+		HAL_GPIO_WritePin(csPort, csPin, GPIO_PIN_SET);
+		return ok;
+	}
+
+	bool write(uint8_t reg, uint8_t value) {
+		uint8_t frame[2] = { static_cast<uint8_t>(reg & 0x7F), value };
+		HAL_GPIO_WritePin(csPort, csPin, GPIO_PIN_RESET);
+		bool ok = (HAL_SPI_Transmit(spi, frame, 2, timeout) == HAL_OK);
+		HAL_GPIO_WritePin(csPort, csPin, GPIO_PIN_SET);
+		return ok;
+	}
+};
+#endif
+
+
+/**
+ * @brief  Register file in RAM, for host builds and unit tests. The calibration area and the data
+ * 		   registers can be filled by the test, writes are stored like the sensor would.
+ */
+struct MockBus {
+
+	uint8_t regs[0x80] = {};
+	uint32_t reads  = 0;
+	uint32_t writes = 0;
+
+	bool read(uint8_t reg, uint8_t *data, uint16_t len) {
+		if((reg + len) > sizeof(regs)) return false;
+		std::memcpy(data, &regs[reg], len);
+		reads++;
+		return true;
+	}
+
+	bool write(uint8_t reg, uint8_t value) {
+		if(reg >= sizeof(regs)) return false;
+		regs[reg] = value;
+		writes++;
+		return true;
+	}
+};
+
+
+/******************************************************************************
+         			#### BMP390 MATH POLICIES ####
+******************************************************************************/
+
+/**
+ * @brief  Raw calibration data in the order of the NVM (0x31..0x45)
+ */
+inline BMP390_RawCalibData_TypeDef ParseCalib(const uint8_t *nvm) {
+
+	BMP390_RawCalibData_TypeDef raw{};
+
+	raw.T1  = static_cast<uint16_t>(nvm[0]  | (nvm[1]  << 8));
+	raw.T2  = static_cast<uint16_t>(nvm[2]  | (nvm[3]  << 8));
+	raw.T3  = static_cast<int8_t>(nvm[4]);
+	raw.P1  = static_cast<int16_t>(nvm[5]  | (nvm[6]  << 8));
+	raw.P2  = static_cast<int16_t>(nvm[7]  | (nvm[8]  << 8));
+	raw.P3  = static_cast<int8_t>(nvm[9]);
+	raw.P4  = static_cast<int8_t>(nvm[10]);
+	raw.P5  = static_cast<uint16_t>(nvm[11] | (nvm[12] << 8));
+	raw.P6  = static_cast<uint16_t>(nvm[13] | (nvm[14] << 8));
+	raw.P7  = static_cast<int8_t>(nvm[15]);
+	raw.P8  = static_cast<int8_t>(nvm[16]);
+	raw.P9  = static_cast<int16_t>(nvm[17] | (nvm[18] << 8));
+	raw.P10 = static_cast<int8_t>(nvm[19]);
+	raw.P11 = static_cast<int8_t>(nvm[20]);
+
+	return raw;
+}
+
+
+/**
+ * @brief  Floating point compensation, the same equations as bmp390.c. temperature (°C), pressure (Pa)
+ */
+struct FloatMath {
+
+	using Calib = BMP390_PrcsdCalibData_TypeDef;
+
+	struct Measurement {
+		float temperature;
+		float pressure;
+	};
+
+	static Calib prepare(const BMP390_RawCalibData_TypeDef &raw) {
+
+		Calib c{};
+
+		c.T1  = raw.T1 * 256.0f;
+		c.T2  = raw.T2 / 1073741824.0f;						// 2^30
+		c.T3  = raw.T3 / 281474976710656.0f;				// 2^48
+		c.P1  = (raw.P1 - 16384.0f) / 1048576.0f;			// 2^14, 2^20
+		c.P2  = (raw.P2 - 16384.0f) / 536870912.0f;			// 2^14, 2^29
+		c.P3  = raw.P3 / 4294967296.0f;						// 2^32
+		c.P4  = raw.P4 / 137438953472.0f;					// 2^37
+		c.P5  = raw.P5 * 8.0f;								// 2^-3
+		c.P6  = raw.P6 / 64.0f;								// 2^6
+		c.P7  = raw.P7 / 256.0f;							// 2^8
+		c.P8  = raw.P8 / 32768.0f;							// 2^15
+		c.P9  = raw.P9 / 281474976710656.0f;				// 2^48
+		c.P10 = raw.P10 / 281474976710656.0f;				// 2^48
+		c.P11 = raw.P11 / 36893488147419103232.0f;			// 2^65
+
+		return c;
+	}
+
+	static Measurement compensate(const Calib &c, uint32_t rawPress, uint32_t rawTemp) {
+
+		float pd1 = static_cast<float>(rawTemp) - c.T1;
+		float t   = pd1 * c.T2 + (pd1 * pd1) * c.T3;
+
+		float t2  = t * t;
+		float t3  = t2 * t;
+		float up  = static_cast<float>(rawPress);
+
+		float out1 = c.P5 + c.P6 * t + c.P7 * t2 + c.P8 * t3;
+		float out2 = up * (c.P1 + c.P2 * t + c.P3 * t2 + c.P4 * t3);
+		float out3 = (up * up) * (c.P9 + c.P10 * t) + (up * up * up) * c.P11;
+
+		return { t, out1 + out2 + out3 };
+	}
+
+	static float pressure(const Measurement &m) { return m.pressure; }
+};
+
+
+/**
+ * @brief  Integer compensation for builds without floating point. temperature (0.01 °C), pressure (0.01 Pa)
+ * 		   The temperature is kept as t * 2^16 (Q16) and the pressure terms are scaled so that
+ * 		   every intermediate value fits into int64_t.
+ */
+struct FixedMath {
+
+	using Calib = BMP390_RawCalibData_TypeDef;
+
+	struct Measurement {
+		int32_t temperature;
+		int32_t pressure;
+	};
+
+	static Calib prepare(const BMP390_RawCalibData_TypeDef &raw) { return raw; }
+
+	static Measurement compensate(const Calib &c, uint32_t rawPress, uint32_t rawTemp) {
+
+		//Temperature : T = t * 2^16
+		int64_t pd1 = static_cast<int64_t>(rawTemp) - (static_cast<int64_t>(c.T1) << 8);
+		int64_t T   = ((pd1 * c.T2 * 262144) + (pd1 * pd1 * c.T3)) / 4294967296LL;	// 2^18, 2^32
+
+		int64_t T2  = (T * T) / 65536;												// t^2 * 2^16
+		int64_t T3  = (T2 * T) / 65536;												// t^3 * 2^16
+		int64_t u   = static_cast<int64_t>(rawPress);
+
+		//Offset (Pa * 2^16)
+		int64_t out1 = (static_cast<int64_t>(c.P5) << 19)
+					 + ((static_cast<int64_t>(c.P6) * T) / 64)
+					 + ((static_cast<int64_t>(c.P7) * T2) / 256)
+					 + ((static_cast<int64_t>(c.P8) * T3) / 32768);
+
+		//Sensitivity (2^40)
+		int64_t sens = (static_cast<int64_t>(c.P1 - 16384) << 20)
+					 + ((static_cast<int64_t>(c.P2 - 16384) * T) / 32)
+					 + ((static_cast<int64_t>(c.P3) * T2) / 256)
+					 + ((static_cast<int64_t>(c.P4) * T3) / 8192);
+		int64_t out2 = ((sens / 256) * u) / 65536;
+
+		//Second and third order terms (Pa * 2^16)
+		int64_t u2   = (u * u) / 1048576;											// u^2 / 2^20
+		int64_t quad = (static_cast<int64_t>(c.P9) << 16) + (static_cast<int64_t>(c.P10) * T);
+		int64_t u3   = ((u * u) / 16777216) * u;									// u^3 / 2^24
+		int64_t out3 = ((u2 * quad) / 268435456) + ((u3 * c.P11) / 33554432);		// 2^28, 2^25
+
+		int64_t press = out1 + out2 + out3;
+
+		return { static_cast<int32_t>((T * 100) / 65536), static_cast<int32_t>((press * 100) / 65536) };
+	}
+
+	static float pressure(const Measurement &m) { return m.pressure / 100.0f; }
+};
+
+
+/******************************************************************************
+         			#### BMP390 DRIVER ####
+******************************************************************************/
+
+template<class Bus, class Math, class Cfg = DefaultConfig>
+class Bmp390 {
+
+public:
+
+	using Measurement = typename Math::Measurement;
+
+	explicit Bmp390(const Bus &bus) : bus_(bus) {}
+
+	/**
+	 * @brief  Reads the calibration data and uploads the constant register images.
+	 */
+	bool init() {
+
+		uint8_t nvm[21];
+
+		if(!bus_.read(BMP390_StartAdd_CalibCoeff, nvm, sizeof(nvm))) return false;
+
+		calib_ = Math::prepare(ParseCalib(nvm));
+
+		//Sleep while the settings change and the mode last, as BMP390_Init : a half written set gives conf_err
+		return bus_.write(BMP390_REG_PWR_CTRL, Cfg::SLEEP)    &&
+			   bus_.write(BMP390_REG_CONFIG,   Cfg::CONFIG)   &&
+			   bus_.write(BMP390_REG_ODR,      Cfg::ODR)      &&
+			   bus_.write(BMP390_REG_OSR,      Cfg::OSR)      &&
+			   bus_.write(BMP390_REG_PWR_CTRL, Cfg::PWR_CTRL);
+	}
+
+	/**
+	 * @brief  Burst reads the data registers and compensates them.
+	 */
+	bool read(Measurement &m) {
+
+		uint8_t d[6];
+
+		if(!bus_.read(BMP390_StartAdd_MSB_LSB_XLSB_PT, d, sizeof(d))) return false;
+
+		m = compensate(static_cast<uint32_t>(d[0] | (d[1] << 8) | (d[2] << 16)),
+					   static_cast<uint32_t>(d[3] | (d[4] << 8) | (d[5] << 16)));
+		return true;
+	}
+
+	Measurement compensate(uint32_t rawPress, uint32_t rawTemp) const {
+		return Math::compensate(calib_, rawPress, rawTemp);
+	}
+
+	/**
+	 * @brief  Altitude (m) above sea level, or above fixedAltitude.
+	 */
+	static float altitude(const Measurement &m, float fixedAltitude = 0.0f) {
+		return static_cast<float>((SeaLevelTemp / GradientTemp)
+			   * (1 - std::pow(Math::pressure(m) / SeaLevelPress, (GasCoefficient * GradientTemp) / GravityAccel)))
+			   - fixedAltitude;
+	}
+
+	Bus &bus() { return bus_; }
+
+private:
+
+	Bus bus_;
+	typename Math::Calib calib_{};
+};
+
+} /* namespace bmp390 */
+
+
+#endif /* BMP390_HPP_ */
@@ -0,0 +1,124 @@
+/*!
+ * @file : bmp390_allan.h
+
+ * Author: Yunus Emre KAYRA (github.com/YEK-Kayra)
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ **/
+
+#ifndef BMP390_ALLAN_H_
+#define BMP390_ALLAN_H_
+
+
+/******************************************************************************
+         			#### BMP390 ALLAN INCLUDES ####
+******************************************************************************/
+#include "bmp390.h"
+#include "bmp390_telemetry.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/******************************************************************************
+         			#### BMP390 ALLAN DEFINITIONS ####
+******************************************************************************/
+
+/**!Octaves of tau, tau = 2^k * tau0 for k = 0 .. BMP390_Allan_Octaves - 1 */
+#ifndef BMP390_Allan_Octaves
+#define BMP390_Allan_Octaves		7
+#endif
+
+#define BMP390_Allan_MaxM			(1u << (BMP390_Allan_Octaves - 1))
+#define BMP390_Allan_RingLen		(2u * BMP390_Allan_MaxM)		/*! Running sums of the last 2 * MaxM samples */
+#define BMP390_Allan_Scale			1024.0f							/*! Fixed point of the running sums (1/1024 Pa, 1/1024 m) */
+
+
+/******************************************************************************
+         			#### BMP390 ALLAN STRUCTURES ####
+******************************************************************************/
+
+/**
+ * @brief  Accumulator of one quantity. The running sum wraps around in 32 bits,
+ * 		   only differences of it are used so the wrap doesn't matter.
+ */
+typedef struct{
+
+	uint32_t ring[BMP390_Allan_RingLen];
+	uint32_t sum;
+	uint64_t sq[BMP390_Allan_Octaves];			/*! Sum of the squared second differences */
+	uint32_t terms[BMP390_Allan_Octaves];
+
+}BMP390_AllanChannel_TypeDef;
+
+
+typedef enum{
+
+	BMP390_Allan_Press = 0,
+	BMP390_Allan_Alt   = 1
+
+}BMP390_Allan_Channel_TypeDef;
+
+
+/**
+ * @brief  Overlapping Allan deviation of pressure and altitude, the size doesn't depend on the run length.
+ */
+typedef struct{
+
+	BMP390_AllanChannel_TypeDef press;
+	BMP390_AllanChannel_TypeDef alt;
+
+	uint32_t n;									/*! Samples so far */
+	uint16_t tau0;								/*! Sampling period (ms) */
+
+}BMP390_Allan_TypeDef;
+
+
+/******************************************************************************
+         	#### BMP390 ALLAN PROTOTYPES OF FUNCTIONS ####
+******************************************************************************/
+
+/**
+  * @brief  Clears the accumulator, the sensor has to be configured and standing still.
+  * @param  Allan accumulator.
+  * @param  tau0 is the sampling period (ms), it is only reported.
+  */
+void BMP390_Allan_Init(BMP390_Allan_TypeDef *Allan, uint16_t tau0);
+
+
+/**
+  * @brief  Adds one sample, BMP390_Allan_Octaves multiply-adds per quantity.
+  * @param  Allan accumulator.
+  * @param  press (Pa) and alt (m) are the processed values.
+  */
+void BMP390_Allan_Add(BMP390_Allan_TypeDef *Allan, float press, float alt);
+
+
+/**
+  * @brief  Overlapping Allan deviation at tau = 2^octave * tau0.
+  * @param  Allan accumulator.
+  * @param  channel selects pressure (Pa) or altitude (m).
+  * @param  octave is below BMP390_Allan_Octaves.
+  * @retval the deviation, 0 until 2^(octave + 1) samples are collected.
+  */
+float BMP390_Allan_Deviation(const BMP390_Allan_TypeDef *Allan, BMP390_Allan_Channel_TypeDef channel, uint8_t octave);
+
+
+/**
+  * @brief  Sends one BMP390_Tlm_Allan packet per quantity.
+  * @param  Allan accumulator.
+  * @param  Tlm telemetry handle.
+  * @retval false if a packet is dropped.
+  */
+_Bool BMP390_Allan_Report(const BMP390_Allan_TypeDef *Allan, BMP390_Telemetry_TypeDef *Tlm);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP390_ALLAN_H_ */
@@ -0,0 +1,325 @@
+/*!
+ * @file : bmp390_async.hpp
+
+ * Author: Yunus Emre KAYRA (github.com/YEK-Kayra)
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ **/
+
+/**
+ * NOTE ==> C++20 coroutine acquisition on top of bmp390.hpp. A bus only starts a transfer and reports
+ * 			its completion later (DMA/IT callback or the mock reactor), so one thread can serve many sensors:
+ *
+ * 			bmp390::Task<bool> job(Sensor &s){ auto m = co_await s.read(); ... co_return true; }
+ *
+ * 			Coroutines are never resumed from an interrupt. The interrupt only marks the transfer as
+ * 			finished, poll() of the bus resumes the waiting coroutine from the main loop.
+ */
+
+#ifndef BMP390_ASYNC_HPP_
+#define BMP390_ASYNC_HPP_
+
+
+/******************************************************************************
+         			#### BMP390 INCLUDES ####
+******************************************************************************/
+#include "bmp390.hpp"
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+
+namespace bmp390 {
+
+
+/******************************************************************************
+         			#### BMP390 COROUTINE TASK ####
+******************************************************************************/
+
+/**
+ * @brief  Lazily started coroutine that returns T. It can be awaited by another task
+ * 		   or started from plain code with start() and checked with done().
+ */
+template<class T>
+class Task {
+
+public:
+
+	struct promise_type {
+
+		T value{};
+		std::coroutine_handle<> continuation = std::noop_coroutine();
+
+		Task get_return_object() { return Task{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+		std::suspend_always initial_suspend() noexcept { return {}; }
+
+		struct FinalAwaiter {
+			bool await_ready() noexcept { return false; }
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept { return h.promise().continuation; }
+			void await_resume() noexcept {}
+		};
+
+		FinalAwaiter final_suspend() noexcept { return {}; }
+		void return_value(T v) { value = std::move(v); }
+		void unhandled_exception() { std::terminate(); }
+	};
+
+	Task(Task &&other) noexcept : h_(std::exchange(other.h_, {})) {}
+	Task(const Task &) = delete;
+	Task &operator=(const Task &) = delete;
+	~Task() { if(h_) h_.destroy(); }
+
+	//Awaiting from another task
+	bool await_ready() const noexcept { return false; }
+	std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept {
+		h_.promise().continuation = caller;
+		return h_;
+	}
+	T await_resume() { return std::move(h_.promise().value); }
+
+	//Starting from plain code
+	void start() { h_.resume(); }
+	bool done() const { return h_.done(); }
+	const T &result() const { return h_.promise().value; }
+
+private:
+
+	explicit Task(std::coroutine_handle<promise_type> h) : h_(h) {}
+
+	std::coroutine_handle<promise_type> h_;
+};
+
+
+/******************************************************************************
+         			#### BMP390 ASYNC BUS ####
+******************************************************************************/
+
+/**
+ * @brief  One outstanding transfer. The bus fills ok and resumes the waiting coroutine.
+ */
+struct Transfer {
+
+	uint8_t reg;
+	uint8_t *data;
+	uint16_t len;
+	bool write;
+	bool ok;
+	std::coroutine_handle<> waiter;
+};
+
+
+/**
+ * @brief  Awaitable that starts a transfer on an asynchronous bus.
+ * 		   The bus provides bool start(Transfer &) : true when the transfer is queued and the bus resumes the
+ * 		   waiter later, false when it is finished at once (t.ok set), the coroutine then goes on without a resume.
+ */
+template<class AsyncBus>
+struct TransferAwaitable {
+
+	AsyncBus &bus;
+	Transfer t;
+
+	bool await_ready() const noexcept { return false; }
+	bool await_suspend(std::coroutine_handle<> h) { t.waiter = h; return bus.start(t); }
+	bool await_resume() const noexcept { return t.ok; }
+};
+
+
+/**
+ * @brief  HAL interrupt driven I2C. Only one transfer per peripheral at a time, the others wait in a queue.
+ * 		   HAL_I2C_MemRxCpltCallback / MemTxCpltCallback / ErrorCallback have to call irqComplete().
+ * 		   A transfer that doesn't fit into the queue fails at once, like MockAsyncBus does.
+ */
+template<uint8_t QueueLen = 16>
+class HalI2cAsyncBus {
+
+public:
+
+	HalI2cAsyncBus(I2C_HandleTypeDef *i2c, uint16_t address) : i2c_(i2c), address_(address) {}
+
+	bool start(Transfer &t) {
+		if(count_ == QueueLen) { t.ok = false; return false; }
+		queue_[(head_ + count_) % QueueLen] = &t;
+		count_++;
+		if(count_ == 1) kick();
+		return true;
+	}
+
+	/**
+	 * @brief  Called from the HAL callbacks (interrupt context), it doesn't resume anything.
+	 */
+	void irqComplete(bool ok) { lastOk_ = ok; finished_ = true; }
+
+	/**
+	 * @brief  Called from the main loop, resumes the coroutine whose transfer is finished.
+	 */
+	void poll() {
+
+		if(!finished_) return;
+		finished_ = false;
+
+		Transfer *t = queue_[head_];
+		head_ = (head_ + 1) % QueueLen;
+		count_--;
+		if(count_ != 0) kick();
+
+		t->ok = lastOk_;
+		t->waiter.resume();
+	}
+
+private:
+
+	void kick() {
+
+		Transfer *t = queue_[head_];
+		HAL_StatusTypeDef st = t->write
+			? HAL_I2C_Mem_Write_IT(i2c_, address_, t->reg, I2C_MEMADD_SIZE_8BIT, t->data, t->len)
+			: HAL_I2C_Mem_Read_IT(i2c_, address_, t->reg, I2C_MEMADD_SIZE_8BIT, t->data, t->len);
+
+		if(st != HAL_OK) irqComplete(false);
+	}
+
+	I2C_HandleTypeDef *i2c_;
+	uint16_t address_;
+	Transfer *queue_[QueueLen] = {};
+	uint8_t head_ = 0;
+	uint8_t count_ = 0;
+	volatile bool finished_ = false;
+	volatile bool lastOk_ = false;
+};
+
+
+/**
+ * @brief  Stand-in for the DMA/IT completions on the host. Every mock bus posts its transfers here,
+ * 		   run() completes them in order, like one interrupt per transfer would.
+ */
+template<uint16_t QueueLen = 64>
+class MockReactor {
+
+public:
+
+	bool post(Transfer &t, MockBus &regs) {
+
+		if(count_ == QueueLen) return false;
+		slots_[(head_ + count_) % QueueLen] = { &t, &regs };
+		count_++;
+		return true;
+	}
+
+	/**
+	 * @brief  Completes the transfers that are pending now, returns how many of them are completed.
+	 */
+	uint32_t run() {
+
+		uint32_t done = 0;
+		uint16_t n = count_;
+
+		while(n--) {
+
+			Slot s = slots_[head_];
+			head_ = (head_ + 1) % QueueLen;
+			count_--;
+
+			s.t->ok = s.t->write ? s.regs->write(s.t->reg, s.t->data[0])
+								 : s.regs->read(s.t->reg, s.t->data, s.t->len);
+			s.t->waiter.resume();
+			done++;
+		}
+
+		return done;
+	}
+
+	bool idle() const { return count_ == 0; }
+
+private:
+
+	struct Slot { Transfer *t; MockBus *regs; };
+
+	Slot slots_[QueueLen] = {};
+	uint16_t head_ = 0;
+	uint16_t count_ = 0;
+};
+
+
+template<class Reactor>
+struct MockAsyncBus {
+
+	Reactor &reactor;
+	MockBus regs{};
+
+	bool start(Transfer &t) {
+		if(!reactor.post(t, regs)) { t.ok = false; return false; }
+		return true;
+	}
+};
+
+
+/******************************************************************************
+         			#### BMP390 ASYNC DRIVER ####
+******************************************************************************/
+
+template<class AsyncBus, class Math, class Cfg = DefaultConfig>
+class AsyncBmp390 {
+
+public:
+
+	using Measurement = typename Math::Measurement;
+
+	struct Result {
+		bool ok;
+		Measurement m;
+	};
+
+	explicit AsyncBmp390(AsyncBus &bus) : bus_(bus) {}
+
+	Task<bool> init() {
+
+		uint8_t nvm[21];
+
+		if(!co_await transfer(BMP390_StartAdd_CalibCoeff, nvm, sizeof(nvm), false)) co_return false;
+
+		calib_ = Math::prepare(ParseCalib(nvm));
+
+		//Sleep while the settings change and the mode last, as Bmp390::init()
+		static const uint8_t regs[5][2] = {
+			{ BMP390_REG_PWR_CTRL, Cfg::SLEEP }, { BMP390_REG_CONFIG, Cfg::CONFIG },
+			{ BMP390_REG_ODR,      Cfg::ODR },   { BMP390_REG_OSR,    Cfg::OSR },
+			{ BMP390_REG_PWR_CTRL, Cfg::PWR_CTRL }
+		};
+
+		for(auto &r : regs) {
+			uint8_t value = r[1];
+			if(!co_await transfer(r[0], &value, 1, true)) co_return false;
+		}
+
+		co_return true;
+	}
+
+	Task<Result> read() {
+
+		uint8_t d[6];
+
+		if(!co_await transfer(BMP390_StartAdd_MSB_LSB_XLSB_PT, d, sizeof(d), false)) co_return Result{ false, {} };
+
+		co_return Result{ true, Math::compensate(calib_,
+												 static_cast<uint32_t>(d[0] | (d[1] << 8) | (d[2] << 16)),
+												 static_cast<uint32_t>(d[3] | (d[4] << 8) | (d[5] << 16))) };
+	}
+
+private:
+
+	TransferAwaitable<AsyncBus> transfer(uint8_t reg, uint8_t *data, uint16_t len, bool write) {
+		return { bus_, Transfer{ reg, data, len, write, false, {} } };
+	}
+
+	AsyncBus &bus_;
+	typename Math::Calib calib_{};
+};
+
+} /* namespace bmp390 */
+
+
+#endif /* BMP390_ASYNC_HPP_ */
@@ -0,0 +1,121 @@
+/*!
+ * @file : bmp390_bus.h
+
+ * Author: Yunus Emre KAYRA (github.com/YEK-Kayra)
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ **/
+
+#ifndef BMP390_BUS_H_
+#define BMP390_BUS_H_
+
+
+/******************************************************************************
+         			#### BMP390 BUS INCLUDES ####
+******************************************************************************/
+#include "bmp390.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/******************************************************************************
+         			#### BMP390 BUS DEFINITIONS ####
+******************************************************************************/
+
+/**!Pins of the I2C peripheral, they are driven as GPIO during the bus clear (I2C1 : PB6 SCL, PB7 SDA) */
+#ifndef BMP390_Bus_SclPort
+#define BMP390_Bus_SclPort			GPIOB
+#define BMP390_Bus_SclPin			GPIO_PIN_6
+#define BMP390_Bus_SdaPort			GPIOB
+#define BMP390_Bus_SdaPin			GPIO_PIN_7
+#endif
+
+/**!A transaction may take this many times its wire time before it is a timeout, plus one tick of HAL_GetTick */
+#define BMP390_Bus_TimeoutFactor	2
+
+
+/******************************************************************************
+         			#### BMP390 BUS ENUMS ####
+******************************************************************************/
+
+typedef enum{
+
+	BMP390_Bus_OK        = 0,
+	BMP390_Bus_Nack      = 1,		/* AF, the sensor doesn't answer (reset, wrong address) */
+	BMP390_Bus_BusError  = 2,		/* BERR, misplaced START/STOP (noise on the lines) */
+	BMP390_Bus_ArbLost   = 3,		/* ARLO, SDA was held low by someone else */
+	BMP390_Bus_Timeout   = 4,		/* the peripheral got stuck, usually SDA held low by the slave */
+	BMP390_Bus_Busy      = 5,		/* BUSY before START, the bus was never released */
+	BMP390_Bus_Other     = 6
+
+}BMP390_Bus_Status_TypeDef;
+
+#define BMP390_Bus_StatusCount		7
+
+
+/******************************************************************************
+         			#### BMP390 BUS STRUCTURES ####
+******************************************************************************/
+
+typedef struct{
+
+	uint32_t transfers;
+	uint32_t errors[BMP390_Bus_StatusCount];	/*! Failed transfers by class, errors[BMP390_Bus_OK] stays 0 */
+	uint32_t recoveries;
+	uint32_t failedRecoveries;					/*! The config couldn't be uploaded after the reset */
+	uint32_t maxRecoveryTime;					/*! ms */
+
+}BMP390_Bus_Stats_TypeDef;
+
+
+extern BMP390_Bus_Stats_TypeDef BMP390_Bus_Stats;
+
+
+/******************************************************************************
+         	#### BMP390 BUS PROTOTYPES OF FUNCTIONS ####
+******************************************************************************/
+
+/**
+  * @brief  Register read/write with a timeout derived from the length and the bus clock.
+  * 		A failure other than a NACK resets the bus (BMP390_Bus_Recover) before returning.
+  * @param  BMP390 general handle.
+  * @param  reg is the first register, data and len are the bytes.
+  * @retval the class of the failure, BMP390_Bus_OK on success.
+  */
+BMP390_Bus_Status_TypeDef BMP390_Bus_Read(BMP390_HandleTypeDef *BMP390, uint8_t reg, uint8_t *data, uint16_t len);
+BMP390_Bus_Status_TypeDef BMP390_Bus_Write(BMP390_HandleTypeDef *BMP390, uint8_t reg, uint8_t *data, uint16_t len);
+
+
+/**
+  * @brief  Timeout of a register transfer (ms) : address, register, repeated address and len data bytes,
+  * 		9 clocks each, BMP390_Bus_TimeoutFactor times the wire time, at least 2 ms.
+  */
+uint32_t BMP390_Bus_CalcTimeout(const I2C_HandleTypeDef *i2c, uint16_t len);
+
+
+/**
+  * @brief  Turns a HAL_I2C_GetError code into a class.
+  */
+BMP390_Bus_Status_TypeDef BMP390_Bus_Classify(HAL_StatusTypeDef status, uint32_t error);
+
+
+/**
+  * @brief  Releases a stuck bus and restores the sensor configuration, it takes about 2 ms at 100 kHz.
+  * 		The peripheral is deinitialized, 9 clocks are sent on SCL until the slave releases SDA, a STOP
+  * 		is generated, the peripheral is reset (SWRST) and initialized again and Params are uploaded.
+  * @param  BMP390 general handle.
+  * @retval booleans.
+  */
+_Bool BMP390_Bus_Recover(BMP390_HandleTypeDef *BMP390);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP390_BUS_H_ */
@@ -0,0 +1,126 @@
+/*!
+ * @file : bmp390_codec.h
+
+ * Author: Yunus Emre KAYRA (github.com/YEK-Kayra)
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ **/
+
+#ifndef BMP390_CODEC_H_
+#define BMP390_CODEC_H_
+
+
+/******************************************************************************
+         			#### BMP390 CODEC INCLUDES ####
+******************************************************************************/
+#include "bmp390.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/******************************************************************************
+         			#### BMP390 CODEC DEFINITIONS ####
+******************************************************************************/
+
+/**
+ * Stream of raw frames :
+ *
+ * 		keyframe : rawPress u24, rawTemp u24, sensortime u24   (9 bytes, little endian)
+ * 		delta    : varint(zigzag(dPress)) varint(zigzag(dTemp)) varint(zigzag(dSensortime - previous dSensortime))
+ *
+ * Deltas are taken modulo 2^24, so every 24 bit frame round-trips. A varint carries 7 bits per byte, the
+ * highest bit is set on every byte except the last one. The first frame and then every BMP390_Codec_KeyInterval
+ * frames are keyframes, the decoder counts frames the same way. The user can force a keyframe with
+ * BMP390_Codec_Init (at the start of a flash page, a telemetry packet...), a decoder started there resynchronizes.
+ */
+#ifndef BMP390_Codec_KeyInterval
+#define BMP390_Codec_KeyInterval	64
+#endif
+
+#define BMP390_Codec_KeySize		9
+#define BMP390_Codec_MaxSize		12		/*! Three varints of at most 4 bytes */
+
+
+/******************************************************************************
+         			#### BMP390 CODEC STRUCTURES ####
+******************************************************************************/
+
+/**
+ * @brief  State of one encoder or one decoder, it doesn't allocate anything else.
+ */
+typedef struct{
+
+	BMP390_RawFrame_TypeDef prev;
+	int32_t prevDt;					/*! Previous sensortime step */
+	uint16_t untilKey;				/*! Frames until the next keyframe, 0 : the next frame is a keyframe */
+
+	uint32_t frames;
+	uint32_t bytes;					/*! Encoded (or decoded) bytes */
+
+}BMP390_Codec_TypeDef;
+
+
+/**
+ * @brief  Result of BMP390_Codec_Benchmark.
+ */
+typedef struct{
+
+	uint32_t frames;
+	uint32_t rawBytes;				/*! BMP390_Codec_KeySize per frame, the size in the flash log */
+	uint32_t encodedBytes;
+	float ratio;					/*! rawBytes / encodedBytes */
+	uint32_t cyclesPerFrame;		/*! Encoder, BMP390_Cycles per frame */
+
+}BMP390_Codec_Stats_TypeDef;
+
+
+/******************************************************************************
+         	#### BMP390 CODEC PROTOTYPES OF FUNCTIONS ####
+******************************************************************************/
+
+/**
+  * @brief  Resets the state, the next frame is a keyframe.
+  * @param  Codec encoder or decoder state.
+  */
+void BMP390_Codec_Init(BMP390_Codec_TypeDef *Codec);
+
+
+/**
+  * @brief  Encodes one frame.
+  * @param  Codec encoder state.
+  * @param  Frame is the raw frame (24 bit values).
+  * @param  out has room for BMP390_Codec_MaxSize bytes.
+  * @retval number of bytes written.
+  */
+uint8_t BMP390_Codec_Encode(BMP390_Codec_TypeDef *Codec, const BMP390_RawFrame_TypeDef *Frame, uint8_t *out);
+
+
+/**
+  * @brief  Decodes one frame.
+  * @param  Codec decoder state.
+  * @param  in and len are the remaining bytes of the stream.
+  * @param  Frame is filled with the raw frame.
+  * @retval number of bytes used, -1 if the stream ends inside the frame or a varint is too long.
+  */
+int16_t BMP390_Codec_Decode(BMP390_Codec_TypeDef *Codec, const uint8_t *in, uint16_t len, BMP390_RawFrame_TypeDef *Frame);
+
+
+/**
+  * @brief  Encodes recorded frames (for example the ones of BMP390_Logger_Parse) and measures the result.
+  * 		The output is dropped, only BMP390_Codec_MaxSize bytes of stack are used.
+  * @param  Frames and n are the recorded frames.
+  * @param  Stats is filled with the compression ratio and the cycles per frame.
+  */
+void BMP390_Codec_Benchmark(const BMP390_RawFrame_TypeDef *Frames, uint32_t n, BMP390_Codec_Stats_TypeDef *Stats);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP390_CODEC_H_ */
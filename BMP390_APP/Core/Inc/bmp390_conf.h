@@ -0,0 +1,208 @@
+/*!
+ * @file : bmp390_conf.h
+
+ * Author: Yunus Emre KAYRA (github.com/YEK-Kayra)
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ **/
+
+#ifndef BMP390_CONF_H_
+#define BMP390_CONF_H_
+
+
+/******************************************************************************
+         			#### BMP390 STATIC CONFIGURATION ####
+******************************************************************************/
+
+/**
+ * If BMP390_STATIC_CONFIG is defined, the settings below are fixed at compile time.
+ * Register images, measurement time, timer reload value and noise constants become constants,
+ * BMP390_Set_DefaultParams and BMP390_Upload_ConfigParams don't calculate anything at runtime
+ * and the reference altitude selection is resolved by the preprocessor.
+ * Otherwise the driver is configured at runtime through BMP390_Params_t.
+ */
+//#define BMP390_STATIC_CONFIG
+
+#ifdef BMP390_STATIC_CONFIG
+
+/**!User settings, every one of them can be overridden from the compiler command line */
+#ifndef BMP390_CONF_MODE
+#define BMP390_CONF_MODE			BMP390_Mode_Normal
+#endif
+
+#ifndef BMP390_CONF_ODR
+#define BMP390_CONF_ODR				BMP390_ODR_25
+#endif
+
+#ifndef BMP390_CONF_PRESS_OSRS
+#define BMP390_CONF_PRESS_OSRS		BMP390_Oversampling_X8
+#endif
+
+#ifndef BMP390_CONF_TEMP_OSRS
+#define BMP390_CONF_TEMP_OSRS		BMP390_Oversampling_X2
+#endif
+
+#ifndef BMP390_CONF_FILTERCOEF
+#define BMP390_CONF_FILTERCOEF		BMP390_Filter_Coef_3
+#endif
+
+#ifndef BMP390_CONF_MEAS_PRESS
+#define BMP390_CONF_MEAS_PRESS		Enable
+#endif
+
+#ifndef BMP390_CONF_MEAS_TEMP
+#define BMP390_CONF_MEAS_TEMP		Enable
+#endif
+
+#ifndef BMP390_CONF_REF_ALT_SEL
+#define BMP390_CONF_REF_ALT_SEL		'm'		/*! 'm' : current location, 'M' : sea level */
+#endif
+
+#ifndef BMP390_CONF_SAMPLE_PERIOD
+#define BMP390_CONF_SAMPLE_PERIOD	1000	/*! TIM1 period (ms) */
+#endif
+
+
+/**!Register images */
+#define BMP390_CONF_REG_PWR_CTRL	(((BMP390_CONF_MODE)<<4) | ((BMP390_CONF_MEAS_TEMP)<<1) | ((BMP390_CONF_MEAS_PRESS)<<0))
+#define BMP390_CONF_REG_CONFIG		((BMP390_CONF_FILTERCOEF)<<1)
+#define BMP390_CONF_REG_ODR			(BMP390_CONF_ODR)
+#define BMP390_CONF_REG_OSR			(((BMP390_CONF_PRESS_OSRS)<<0) | ((BMP390_CONF_TEMP_OSRS)<<3))
+
+
+/**!Timings (us), the measurement has to fit into the sampling period (checked in bmp390.c) */
+#define BMP390_CONF_MEAS_TIME		(BMP390_MeasTime_Offset + \
+									((BMP390_CONF_MEAS_PRESS) ? (BMP390_MeasTime_PressOffset + (BMP390_MeasTime_PerSample << (BMP390_CONF_PRESS_OSRS))) : 0) + \
+									((BMP390_CONF_MEAS_TEMP)  ? (BMP390_MeasTime_TempOffset  + (BMP390_MeasTime_PerSample << (BMP390_CONF_TEMP_OSRS)))  : 0))
+
+#define BMP390_CONF_ODR_PERIOD		((uint32_t)BMP390_OdrPeriod_Base << (BMP390_CONF_ODR))
+
+
+/**!TIM1 counts milliseconds (8 MHz / (7999 + 1)) */
+#define BMP390_CONF_TIM_PERIOD		((BMP390_CONF_SAMPLE_PERIOD) - 1)
+
+
+/**!Expected RMS noise of the processed pressure (Pa) and temperature (°C) */
+#define BMP390_CONF_PRESS_NOISE		(BMP390_PressNoise_X1 * BMP390_OsrNoiseFactor(BMP390_CONF_PRESS_OSRS) * BMP390_IirNoiseFactor(BMP390_CONF_FILTERCOEF))
+#define BMP390_CONF_TEMP_NOISE		(BMP390_TempNoise_X1 * BMP390_OsrNoiseFactor(BMP390_CONF_TEMP_OSRS))
+
+#endif /* BMP390_STATIC_CONFIG */
+
+
+/******************************************************************************
+         			#### BMP390 CHARACTERIZATION MODE ####
+******************************************************************************/
+
+/**
+ * If BMP390_CHARACTERIZATION is defined, the board has to stand still. Every sample also goes into the
+ * Allan deviation accumulator (bmp390_allan.h) and the deviations of pressure and altitude are sent over
+ * the telemetry link every BMP390_CHAR_REPORT_EVERY samples. The configuration under test is the one in Params.
+ */
+//#define BMP390_CHARACTERIZATION
+
+#ifndef BMP390_CHAR_REPORT_EVERY
+#define BMP390_CHAR_REPORT_EVERY	64
+#endif
+
+#if defined(BMP390_CHARACTERIZATION) && (defined(BMP390_FIFO_MODE) || defined(BMP390_LOW_POWER) || defined(BMP390_GOVERNOR))
+#error "BMP390_CHARACTERIZATION needs the fixed TIM1 cadence, it can't be used with BMP390_FIFO_MODE, BMP390_LOW_POWER or BMP390_GOVERNOR"
+#endif
+
+
+/******************************************************************************
+         			#### BMP390 FIFO ACQUISITION MODE ####
+******************************************************************************/
+
+/**
+ * If BMP390_FIFO_MODE is defined, TIM1 doesn't poll the sensor. The FIFO collects the samples and its watermark
+ * interrupt (INT on PA0) drains it with one DMA read, the samples are processed in the main loop (bmp390_fifo.h).
+ * Every BMP390_FIFO_WATERMARK bytes (7 bytes per sample) cost two interrupts and two bus transfers.
+ */
+//#define BMP390_FIFO_MODE
+
+#ifndef BMP390_FIFO_WATERMARK
+#define BMP390_FIFO_WATERMARK		112		/*! 16 samples */
+#endif
+
+/**
+ * If BMP390_FIFO_SOFT_IIR is also defined, the FIFO holds unfiltered data and the filters of BMP390_FIFO_IIR_COEFS
+ * run on it in software (bmp390_iir.h). The first one feeds the altitude chain, the logger keeps the unfiltered frames.
+ */
+//#define BMP390_FIFO_SOFT_IIR
+
+#ifndef BMP390_FIFO_IIR_COEFS
+#define BMP390_FIFO_IIR_COEFS		{ BMP390_Filter_Coef_3, BMP390_Filter_Coef_1, BMP390_Filter_Coef_31 }	/*! Coef_3 is the default of the sensor filter */
+#endif
+
+
+
+/******************************************************************************
+         			#### BMP390 FLASH LOG ####
+******************************************************************************/
+
+/**
+ * Every raw frame goes into the LOG region of STM32F103C6TX_FLASH.ld (bmp390_logger.h), 112 records per 1 KB page.
+ * The page after the current one is always kept erased, so a dump holds (BMP390_Log_Pages - 2) to
+ * (BMP390_Log_Pages - 1) pages. Retention with the 3 pages :
+ *
+ * 		1 Hz   (TIM1 at the default 1000 ms)                   : 112 to 224 s
+ * 		25 Hz  (default ODR, BMP390_FIFO_MODE)                 : 4.5 to 9 s
+ * 		100 Hz (BMP390_GOVERNOR from the launch to the apogee) : 1.1 to 2.2 s
+ *
+ * More pages need the same number of KB moved from FLASH to LOG in the linker script. The image is about 22 KB
+ * in Release (-Os) and 25 KB in Debug (-Og) of the 29 KB, Debug at -O0 (~34 KB) doesn't fit.
+ */
+#ifndef BMP390_Log_Start
+#define BMP390_Log_Start			0x08007400	/*! ORIGIN of LOG */
+#endif
+
+#ifndef BMP390_Log_Pages
+#define BMP390_Log_Pages			3			/*! LENGTH of LOG in KB, at least 3 */
+#endif
+
+
+
+/******************************************************************************
+         			#### BMP390 LOW POWER MODE ####
+******************************************************************************/
+
+/**
+ * If BMP390_LOW_POWER is defined, the RTC alarm wakes the MCU every BMP390_LP_PERIOD ms for a forced conversion,
+ * the INT pin (PA0) wakes it when the conversion is done and the MCU waits in Stop mode in between (bmp390_lowpower.h).
+ * The samples are processed BMP390_LP_BATCH at a time. It is meant for balloons and weather stations.
+ */
+//#define BMP390_LOW_POWER
+
+#ifndef BMP390_LP_PERIOD
+#define BMP390_LP_PERIOD			10000	/*! ms */
+#endif
+
+#ifndef BMP390_LP_BATCH
+#define BMP390_LP_BATCH				6
+#endif
+
+#if defined(BMP390_LOW_POWER) && (defined(BMP390_FIFO_MODE) || defined(BMP390_GOVERNOR))
+#error "BMP390_LOW_POWER owns the INT pin and the sensor mode, it can't be used with BMP390_FIFO_MODE or BMP390_GOVERNOR"
+#endif
+
+
+/******************************************************************************
+         			#### BMP390 ODR/OSR GOVERNOR ####
+******************************************************************************/
+
+/**
+ * If BMP390_GOVERNOR is defined, the ODR, oversampling and IIR filter follow the flight (bmp390_governor.h) :
+ * slow and low power on the pad and under the parachute, fast from the launch to the apogee.
+ * Without the FIFO, TIM1 follows the ODR.
+ */
+//#define BMP390_GOVERNOR
+
+#if defined(BMP390_GOVERNOR) && defined(BMP390_STATIC_CONFIG)
+#error "BMP390_GOVERNOR changes the configuration at runtime, it can't be used with BMP390_STATIC_CONFIG"
+#endif
+
+
+#endif /* BMP390_CONF_H_ */
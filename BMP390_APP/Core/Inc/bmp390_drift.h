@@ -0,0 +1,117 @@
+/*!
+ * @file : bmp390_drift.h
+
+ * Author: Yunus Emre KAYRA (github.com/YEK-Kayra)
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ **/
+
+#ifndef BMP390_DRIFT_H_
+#define BMP390_DRIFT_H_
+
+
+/******************************************************************************
+         			#### BMP390 DRIFT INCLUDES ####
+******************************************************************************/
+#include "bmp390.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/******************************************************************************
+         			#### BMP390 DRIFT DEFINITIONS ####
+******************************************************************************/
+
+/**!Samples of the regression window, older pairs are forgotten exponentially */
+#ifndef BMP390_Drift_Window
+#define BMP390_Drift_Window			256
+#endif
+
+#define BMP390_Drift_NominalRate	39.0625f	/*! us per SENSORTIME count (25.6 kHz) */
+
+
+/******************************************************************************
+         			#### BMP390 DRIFT STRUCTURES ####
+******************************************************************************/
+
+/**
+ * @brief  Regression of MCU time (us) against sensortime. Everything is kept relative to the newest pair,
+ * 		   so the float state stays small and both counters can wrap around.
+ */
+typedef struct{
+
+	uint32_t sAnchor;				/*! Sensortime of the newest pair (24 bit) */
+	uint64_t tAnchor;				/*! MCU time of the newest pair (us) */
+
+	float mx;						/*! Weighted means relative to the anchor (counts, us) */
+	float my;
+	float cxx;						/*! Weighted covariances */
+	float cxy;
+	float rate;						/*! us per sensortime count, BMP390_Drift_NominalRate until there are two pairs */
+
+	uint32_t n;						/*! Pairs so far */
+
+	uint32_t cycles;				/*! Timebase : DWT cycle counter (HAL tick on the host) extended to 64 bit us */
+	uint32_t cycleRem;
+	uint64_t micros;
+
+}BMP390_Drift_TypeDef;
+
+
+/******************************************************************************
+         	#### BMP390 DRIFT PROTOTYPES OF FUNCTIONS ####
+******************************************************************************/
+
+/**
+  * @brief  Starts the estimator and the us timebase (DWT cycle counter).
+  * @param  Drift estimator.
+  */
+void BMP390_Drift_Init(BMP390_Drift_TypeDef *Drift);
+
+
+/**
+  * @brief  MCU time (us) since BMP390_Drift_Init, 64 bit so it doesn't wrap. It has to be called at least every
+  * 		2^32 cycles (9 minutes at 8 MHz), every sample does it.
+  * @param  Drift estimator, it keeps the state of the timebase.
+  */
+uint64_t BMP390_Drift_Micros(BMP390_Drift_TypeDef *Drift);
+
+
+/**
+  * @brief  Adds one (sensortime, MCU time) pair, O(1) and a dozen float operations.
+  * 		A gap of half the sensortime range or more (5.4 minutes) restarts the regression.
+  * @param  Drift estimator.
+  * @param  sensortime of a new frame.
+  * @param  micros is the MCU time of the same conversion. Taken right after a polled read it includes the
+  * 		read latency, the rate is still right but the mapping is late by its mean (the drdy interrupt has none).
+  */
+void BMP390_Drift_Update(BMP390_Drift_TypeDef *Drift, uint32_t sensortime, uint64_t micros);
+
+
+/**
+  * @brief  MCU time (us) of any sensortime near the newest pair, before (FIFO back-fill) or after it.
+  * @param  Drift estimator. Before the first pair sensortime is taken as counts from 0 at the nominal rate,
+  * 		that is what the FIFO dead-reckons from until its first sensortime frame.
+  * @param  sensortime is within +-5.4 minutes of the newest pair.
+  * @retval MCU time (us) on the BMP390_Drift_Micros timebase. Truncated to 32 bit after the division by 1000 it
+  * 		is a millisecond timestamp that wraps at 2^32 ms like HAL_GetTick.
+  */
+uint64_t BMP390_Drift_Map(const BMP390_Drift_TypeDef *Drift, uint32_t sensortime);
+
+
+/**
+  * @brief  Rate of the sensor clock against the MCU clock (ppm), positive if sensortime runs slow.
+  */
+float BMP390_Drift_Ppm(const BMP390_Drift_TypeDef *Drift);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP390_DRIFT_H_ */
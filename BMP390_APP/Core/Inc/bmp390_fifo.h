@@ -0,0 +1,304 @@
+/*!
+ * @file : bmp390_fifo.h
+
+ * Author: Yunus Emre KAYRA (github.com/YEK-Kayra)
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ **/
+
+#ifndef BMP390_FIFO_H_
+#define BMP390_FIFO_H_
+
+
+/******************************************************************************
+         			#### BMP390 FIFO INCLUDES ####
+******************************************************************************/
+#include "bmp390.h"
+#include "bmp390_drift.h"
+#include "bmp390_iir.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/******************************************************************************
+         			#### BMP390 FIFO DEFINITIONS ####
+******************************************************************************/
+
+/**
+ * Frames in the sensor FIFO :
+ *
+ * 		0x94 : header, temperature u24, pressure u24 (7 bytes)
+ * 		0x90 : header, temperature u24 (4 bytes)			0x84 : header, pressure u24 (4 bytes)
+ * 		0xA0 : header, sensortime u24 (4 bytes), it follows the last data frame when the FIFO is read empty
+ * 		0x44 : header, one byte (configuration error)		0x48 : header, one byte (configuration change)
+ * 		0x80 : header, one byte (empty FIFO)
+ *
+ * All values are little endian. The data frames have no time of their own, they are one FIFO period apart.
+ */
+#define BMP390_Fifo_Hdr_PressTemp	0x94
+#define BMP390_Fifo_Hdr_Temp		0x90
+#define BMP390_Fifo_Hdr_Press		0x84
+#define BMP390_Fifo_Hdr_Time		0xA0
+#define BMP390_Fifo_Hdr_ConfigErr	0x44
+#define BMP390_Fifo_Hdr_ConfigChg	0x48
+#define BMP390_Fifo_Hdr_Empty		0x80
+
+#define BMP390_Fifo_PressTempLen	7
+#define BMP390_Fifo_Capacity		512		/*! Bytes of the sensor FIFO, fifo_water_mark is 9 bits */
+#define BMP390_Fifo_StatusLen		4		/*! EVENT, INT_STATUS, FIFO_LENGTH_0, FIFO_LENGTH_1 */
+#define BMP390_Fifo_TimeLen			4		/*! Sensortime frame, FIFO_LENGTH doesn't count it, it comes past the fill level */
+
+/**!Size of each of the two drain buffers, a drain never reads more than this */
+#ifndef BMP390_Fifo_BufSize
+#define BMP390_Fifo_BufSize			BMP390_Fifo_Capacity
+#endif
+
+/**!INT pin of the sensor (PA0, EXTI0_IRQHandler in stm32f1xx_it.c), I2C1 RX is DMA1 channel 7 */
+#ifndef BMP390_Fifo_IntPort
+#define BMP390_Fifo_IntPort			GPIOA
+#define BMP390_Fifo_IntPin			GPIO_PIN_0
+#define BMP390_Fifo_IntIRQn			EXTI0_IRQn
+#define BMP390_Fifo_IntClkEnable()	__HAL_RCC_GPIOA_CLK_ENABLE()
+#endif
+
+/**!I2C bit times of a register read of len bytes : address, register, repeated address and the data */
+#define BMP390_Fifo_Bits(len)		(((uint32_t)(len) + 3) * 9)
+
+#define BMP390_Fifo_PauseTimeout	60		/*! ms, a full 512 byte drain takes 47 ms at 100 kHz */
+
+
+/******************************************************************************
+         			#### BMP390 FIFO STRUCTURES ####
+******************************************************************************/
+
+/**
+ * @brief  Partial frame at the end of a drain, the start of the next drain completes it.
+ */
+typedef struct{
+
+	uint8_t buf[BMP390_Fifo_PressTempLen];
+	uint8_t len;
+
+}BMP390_Fifo_Carry_TypeDef;
+
+
+/**
+ * @brief  Position in a drained buffer. frame points into the buffer, only a frame that was split between two
+ * 		   drains is put together in the carry (at most 7 bytes), nothing else is copied.
+ */
+typedef struct{
+
+	const uint8_t *data;
+	uint16_t len;
+	uint16_t pos;					/*! Offset of the next frame in data */
+	BMP390_Fifo_Carry_TypeDef *Carry;
+	uint8_t stitched;				/*! The first frame is in Carry */
+
+	const uint8_t *frame;			/*! Current frame, header first */
+	uint8_t header;					/*! BMP390_Fifo_Hdr_x */
+	uint32_t sensortime;			/*! Time of the current data frame */
+
+	uint16_t dataFrames;			/*! Data frames of the buffer */
+	uint16_t index;					/*! Data frames handed out so far */
+	uint32_t step;
+	uint32_t prevStep;				/*! Step of the data frames before the change */
+	uint16_t change;				/*! Index of the first data frame with step */
+	uint8_t changed;				/*! The buffer has a configuration change frame */
+	uint32_t last;					/*! Time of the last data frame, from the sensortime frame if there is one */
+	uint8_t timed;					/*! The buffer has a sensortime frame */
+
+}BMP390_Fifo_Iter_TypeDef;
+
+
+/**
+ * @brief  Result of BMP390_Fifo_Benchmark, BMP390_Cycles.
+ */
+typedef struct{
+
+	uint16_t frames;
+	uint32_t iterCycles;			/*! Per data frame, BMP390_Fifo_Next in place */
+	uint32_t copyCycles;			/*! Per data frame, parse into BMP390_RawFrame_TypeDef structs and read them back */
+	uint16_t iterRam;				/*! Bytes besides the DMA buffer */
+	uint16_t copyRam;
+
+}BMP390_Fifo_Bench_TypeDef;
+
+
+typedef struct{
+
+	uint32_t wakeups;				/*! INT interrupts, BMP390_Fifo_Task re-triggers included */
+	uint32_t drains;				/*! Completed DMA reads of the FIFO, one more interrupt each */
+	uint32_t bytes;
+	uint32_t frames;				/*! Pressure and temperature frames handed to the main loop */
+	uint32_t overruns;				/*! Both buffers waited for the main loop, the data stayed in the FIFO */
+	uint32_t errors;				/*! Failed status reads and DMA transfers */
+	uint64_t busBits;				/*! I2C bit times of every transfer, utilization = busBits / (clock * seconds) */
+
+}BMP390_Fifo_Stats_TypeDef;
+
+
+/**
+ * @brief  Watermark driven acquisition. The INT edge reads the FIFO length, the DMA drains that many bytes
+ * 		   and the sensortime frame behind them into a free buffer and the main loop parses the full buffers.
+ */
+typedef struct{
+
+	BMP390_HandleTypeDef *BMP390;
+	BMP390_Drift_TypeDef *Drift;	/*! Fed with the sensortime frames, it can be NULL */
+	BMP390_Iir_TypeDef *Iir;		/*! Software filters of the unfiltered FIFO data, NULL : the sensor filters */
+
+	DMA_HandleTypeDef hdma;
+
+	uint8_t buf[2][BMP390_Fifo_BufSize + BMP390_Fifo_TimeLen];
+	volatile uint16_t len[2];		/*! Bytes of a buffer that waits for the main loop, 0 : free */
+	uint64_t readTime[2];			/*! MCU time (us) at the end of the drain */
+	volatile uint16_t reading;		/*! Length of the drain in progress */
+	volatile uint8_t dmaBuf;		/*! Buffer that the next drain fills */
+	volatile uint8_t busy;
+	uint8_t taskBuf;				/*! Buffer that the main loop parses next */
+
+	uint32_t step;					/*! Sensortime counts between two data frames */
+	uint32_t prevStep;				/*! Step before a new ODR, until its configuration change frame is parsed */
+	uint32_t sensortime;			/*! Sensortime of the last parsed data frame */
+	BMP390_Fifo_Carry_TypeDef Carry;
+
+	BMP390_Fifo_Stats_TypeDef Stats;
+
+}BMP390_Fifo_TypeDef;
+
+
+/**
+ * @brief  Receives every pressure and temperature frame, sensortime is filled in from the FIFO period.
+ * 		   With an Iir bank the frame is unfiltered and the bank has already been updated with it.
+ */
+typedef void (*BMP390_Fifo_Callback_t)(void *ctx, const BMP390_RawFrame_TypeDef *Frame);
+
+
+/******************************************************************************
+         	#### BMP390 FIFO PROTOTYPES OF FUNCTIONS ####
+******************************************************************************/
+
+/**
+  * @brief  Enables the FIFO (pressure, temperature, sensortime) with a watermark interrupt and a full interrupt
+  * 		on a latched, active high INT pin, then uploads Params and sets up the EXTI line and the DMA.
+  * 		The sensor has to be initialized and TIM1 polling has to be stopped, they would share the bus.
+  * @param  Fifo acquisition handle.
+  * @param  BMP390 general handle, its Params get the FIFO settings.
+  * @param  Drift estimator, it can be NULL.
+  * @param  Iir filter bank, it can be NULL. With a bank the FIFO holds unfiltered data and every frame runs through
+  * 		the bank before the callback, otherwise the FIFO holds the data filtered by the sensor.
+  * @param  watermark (bytes) is below BMP390_Fifo_Capacity, 16 frames are 112 bytes.
+  * @retval booleans.
+  */
+_Bool BMP390_Fifo_Init(BMP390_Fifo_TypeDef *Fifo, BMP390_HandleTypeDef *BMP390, BMP390_Drift_TypeDef *Drift,
+					   BMP390_Iir_TypeDef *Iir, uint16_t watermark);
+
+
+/**
+  * @brief  INT edge (EXTI), reads EVENT .. FIFO_LENGTH (it releases the latched pin) and starts the drain.
+  */
+void BMP390_Fifo_IRQHandler(BMP390_Fifo_TypeDef *Fifo);
+
+
+/**
+  * @brief  End of the drain and failed drains, they are called from HAL_I2C_MemRxCpltCallback and HAL_I2C_ErrorCallback.
+  */
+void BMP390_Fifo_RxCplt(BMP390_Fifo_TypeDef *Fifo);
+void BMP390_Fifo_Error(BMP390_Fifo_TypeDef *Fifo);
+
+
+/**
+  * @brief  Parses the drained buffers, it is called from the main loop. It also re-triggers a drain that was
+  * 		skipped while both buffers were full or that failed, the latched pin is still high then.
+  * @param  Fifo acquisition handle.
+  * @param  cb receives every pressure and temperature frame, ctx is passed to it.
+  * @retval Number of frames.
+  */
+uint16_t BMP390_Fifo_Task(BMP390_Fifo_TypeDef *Fifo, BMP390_Fifo_Callback_t cb, void *ctx);
+
+
+/**
+  * @brief  Keeps the INT interrupt from starting a drain while the main loop writes registers, it waits up to
+  * 		BMP390_Fifo_PauseTimeout for the drain in progress. An edge that comes meanwhile stays pending.
+  * 		Resume takes the step of a new ODR from Params and enables the interrupt again.
+  * @retval false if the drain didn't end, Resume is needed anyway.
+  */
+_Bool BMP390_Fifo_Pause(BMP390_Fifo_TypeDef *Fifo);
+void BMP390_Fifo_Resume(BMP390_Fifo_TypeDef *Fifo);
+
+
+/**
+  * @brief  Starts walking a drained buffer. Only the headers are scanned, to count the data frames and to find
+  * 		the sensortime frame that dates them.
+  * @param  It iterator.
+  * @param  data and len are the drained bytes, they must stay untouched until the walk ends.
+  * @param  Carry is the partial frame of the previous drain (len 0 if none), it receives the partial frame of this one.
+  * @param  step is the number of sensortime counts between two data frames.
+  * @param  prevStep is the step before an ODR change that is still in the FIFO, the data frames before its
+  * 		configuration change frame (all of them if there is none) use it. It is step without a change.
+  * @param  sensortime of the last data frame of the previous drain, it dates the frames when there is no sensortime frame.
+  */
+void BMP390_Fifo_IterInit(BMP390_Fifo_Iter_TypeDef *It, const uint8_t *data, uint16_t len,
+						  BMP390_Fifo_Carry_TypeDef *Carry, uint32_t step, uint32_t prevStep, uint32_t sensortime);
+
+
+/**
+  * @brief  Moves to the next frame, frame, header and sensortime (data frames) are set.
+  * 		A partial frame at the end goes into the carry, an unknown header ends the walk.
+  * @param  It iterator.
+  * @retval false at the end of the buffer.
+  */
+_Bool BMP390_Fifo_Next(BMP390_Fifo_Iter_TypeDef *It);
+
+
+/**
+  * @brief  Raw values of the current frame, read in place. Temperature comes first in a 0x94 frame.
+  */
+static inline uint32_t BMP390_Fifo_U24(const uint8_t *p){
+
+	return p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16);
+}
+
+static inline uint32_t BMP390_Fifo_RawTemp(const BMP390_Fifo_Iter_TypeDef *It){
+
+	return BMP390_Fifo_U24(&It->frame[1]);
+}
+
+static inline uint32_t BMP390_Fifo_RawPress(const BMP390_Fifo_Iter_TypeDef *It){
+
+	return BMP390_Fifo_U24(&It->frame[(It->header == BMP390_Fifo_Hdr_PressTemp) ? 4 : 1]);
+}
+
+
+/**
+  * @brief  Iterator against a parser that copies every frame into a BMP390_RawFrame_TypeDef array first.
+  * @param  data and len are a drained buffer, step dates the frames.
+  * @param  scratch has room for the frames of the copying parser, len / BMP390_Fifo_PressTempLen of them.
+  * @param  Bench receives the results.
+  */
+void BMP390_Fifo_Benchmark(const uint8_t *data, uint16_t len, uint32_t step, BMP390_RawFrame_TypeDef *scratch,
+						   BMP390_Fifo_Bench_TypeDef *Bench);
+
+
+/**
+  * @brief  Wake-ups per second and bus utilization (0 .. 1) of a watermark, two interrupts and two transfers per drain.
+  * @param  watermark (bytes).
+  * @param  frameLen is the size of one data frame (BMP390_Fifo_PressTempLen).
+  * @param  framePeriod is the FIFO period (us).
+  * @param  clock is the I2C clock (Hz).
+  * @param  wakeups and busLoad receive the results.
+  */
+void BMP390_Fifo_CalcLoad(uint16_t watermark, uint8_t frameLen, uint32_t framePeriod, uint32_t clock,
+						  float *wakeups, float *busLoad);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP390_FIFO_H_ */
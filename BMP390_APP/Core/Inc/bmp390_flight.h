@@ -0,0 +1,140 @@
+/*!
+ * @file : bmp390_flight.h
+
+ * Author: Yunus Emre KAYRA (github.com/YEK-Kayra)
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ **/
+
+#ifndef BMP390_FLIGHT_H_
+#define BMP390_FLIGHT_H_
+
+
+/******************************************************************************
+         			#### BMP390 FLIGHT INCLUDES ####
+******************************************************************************/
+#include "bmp390.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/******************************************************************************
+         			#### BMP390 FLIGHT ENUMS ####
+******************************************************************************/
+
+typedef enum{
+
+	BMP390_Flight_Pad     = 0,
+	BMP390_Flight_Boost   = 1,		/* climbing and accelerating */
+	BMP390_Flight_Coast   = 2,		/* climbing and decelerating */
+	BMP390_Flight_Apogee  = 3,		/* lasts one sample, the moment to deploy the recovery */
+	BMP390_Flight_Descent = 4,
+	BMP390_Flight_Landed  = 5
+
+}BMP390_Flight_State_TypeDef;
+
+#define BMP390_Flight_States		6
+
+/**!alpha and beta are the gains of the tracker at this sampling period (ms), they are rescaled to the real one */
+#define BMP390_Flight_GainPeriod	40
+
+
+/******************************************************************************
+         			#### BMP390 FLIGHT STRUCTURES ####
+******************************************************************************/
+
+/**
+ * @brief  Thresholds, hysteresis (m, m/s) and debounce (ms) of the transitions. A debounce is the time the condition
+ * 		   has to hold, so the latency doesn't change with the sampling rate.
+ */
+typedef struct{
+
+	float alpha;					/*! Altitude gain of the alpha-beta tracker at BMP390_Flight_GainPeriod, 0 .. 1 */
+	float beta;						/*! Speed gain of the alpha-beta tracker at BMP390_Flight_GainPeriod */
+
+	float launchAlt;				/*! Pad -> Boost : above launchAlt and faster than launchSpd */
+	float launchSpd;
+	float burnoutHyst;				/*! Boost -> Coast : speed fell burnoutHyst below its peak */
+	float apogeeHyst;				/*! Coast -> Apogee : speed below -apogeeHyst */
+	float landedSpd;				/*! Descent -> Landed : |speed| below landedSpd */
+
+	uint16_t launchDebounce;
+	uint16_t burnoutDebounce;
+	uint16_t apogeeDebounce;
+	uint16_t landedDebounce;
+
+}BMP390_Flight_Config_TypeDef;
+
+
+typedef struct{
+
+	BMP390_Flight_Config_TypeDef Config;
+
+	BMP390_Flight_State_TypeDef state;
+	uint8_t debouncing;				/*! The condition of the next transition holds since debounceStart (ms) */
+	uint32_t debounceStart;
+
+	float alt;						/*! Tracked altitude (m) and speed (m/s) */
+	float spd;
+	float padAlt;
+	float peakSpd;
+	float peakAlt;
+	uint32_t peakTime;				/*! Timestamp of peakAlt (ms) */
+
+	uint32_t lastTime;
+	uint8_t primed;
+
+	uint32_t gainDt;				/*! ms, alphaDt and betaDt are the gains rescaled to this period */
+	float alphaDt;
+	float betaDt;
+
+	uint32_t eventTime[BMP390_Flight_States];	/*! Timestamp at which every state was entered (ms) */
+
+}BMP390_Flight_TypeDef;
+
+
+/******************************************************************************
+         	#### BMP390 FLIGHT PROTOTYPES OF FUNCTIONS ####
+******************************************************************************/
+
+/**
+  * @brief  Starts on the pad.
+  * @param  Flight state machine.
+  * @param  Config is copied, NULL selects the defaults (BMP390_Flight_DefaultConfig).
+  */
+void BMP390_Flight_Init(BMP390_Flight_TypeDef *Flight, const BMP390_Flight_Config_TypeDef *Config);
+
+
+/**
+  * @brief  Defaults for a small rocket sampled at 25 Hz to 200 Hz.
+  * @param  Config is filled with the defaults.
+  */
+void BMP390_Flight_DefaultConfig(BMP390_Flight_Config_TypeDef *Config);
+
+
+/**
+  * @brief  Tracks altitude and speed with an alpha-beta filter and runs one step of the state machine, O(1).
+  * 		The vertSpd of the sample is a raw first difference, the tracker replaces it.
+  * @param  Flight state machine.
+  * @param  Sample gives timestamp (ms) and vertAlt (m).
+  * @retval the new state if it changed, otherwise -1.
+  */
+int8_t BMP390_Flight_Update(BMP390_Flight_TypeDef *Flight, const BMP390_Sample_TypeDef *Sample);
+
+
+/**
+  * @brief  Apogee detection time minus the time of the highest tracked altitude (ms), 0 before the apogee.
+  */
+uint32_t BMP390_Flight_ApogeeLatency(const BMP390_Flight_TypeDef *Flight);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP390_FLIGHT_H_ */
@@ -0,0 +1,147 @@
+/*!
+ * @file : bmp390_governor.h
+
+ * Author: Yunus Emre KAYRA (github.com/YEK-Kayra)
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ **/
+
+#ifndef BMP390_GOVERNOR_H_
+#define BMP390_GOVERNOR_H_
+
+
+/******************************************************************************
+         			#### BMP390 GOVERNOR INCLUDES ####
+******************************************************************************/
+#include "bmp390.h"
+#include "bmp390_flight.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/******************************************************************************
+         			#### BMP390 GOVERNOR DEFINITIONS ####
+******************************************************************************/
+
+/**!Profiles from the slowest to the fastest : idle (pad, landed), cruise (parachute), fast (boost to apogee) */
+#define BMP390_Gov_Profiles			3
+
+/**!Supply current of the sensor (uA, datasheet typical), during a conversion and in standby between them */
+#define BMP390_Gov_ActiveCurrent	700.0f
+#define BMP390_Gov_StandbyCurrent	2.0f
+
+
+/******************************************************************************
+         			#### BMP390 GOVERNOR STRUCTURES ####
+******************************************************************************/
+
+typedef struct{
+
+	uint8_t odr;					/*! BMP390_ODR_TypeDef */
+	uint8_t pressOsrs;				/*! BMP390_Oversampling_TypeDef */
+	uint8_t tempOsrs;
+	uint8_t filterCoef;				/*! BMP390_FilterCoef_TypeDef */
+
+}BMP390_Gov_Profile_TypeDef;
+
+
+/**
+ * @brief  A profile is entered as soon as |speed| or |acceleration| crosses its threshold and left one step at a
+ * 		   time, after both stayed below (1 - hyst) of its thresholds for dwell.
+ */
+typedef struct{
+
+	BMP390_Gov_Profile_TypeDef Profile[BMP390_Gov_Profiles];
+
+	float upSpd[BMP390_Gov_Profiles];		/*! m/s, [0] is not used */
+	float upAcc[BMP390_Gov_Profiles];		/*! m/s^2, [0] is not used */
+	float hyst;
+	uint32_t dwell;							/*! ms */
+	float accTau;							/*! s, smoothing of the acceleration (derivative of the tracked speed) */
+
+}BMP390_Gov_Config_TypeDef;
+
+
+typedef struct{
+
+	uint32_t switches;
+	uint32_t writes;						/*! Register writes, up to 3 per switch */
+	uint32_t failures;						/*! Switches with a failed write, the restore uploads the new profile */
+	uint32_t time[BMP390_Gov_Profiles];		/*! ms spent in every profile */
+
+}BMP390_Gov_Stats_TypeDef;
+
+
+typedef struct{
+
+	BMP390_Gov_Config_TypeDef Config;
+
+	uint8_t level;							/*! Selected profile */
+	uint8_t primed;
+	float acc;								/*! m/s^2 */
+	float lastSpd;
+	uint32_t lastTime;						/*! ms */
+	uint32_t calmSince;						/*! ms, start of the time below the thresholds of level */
+
+	BMP390_Gov_Stats_TypeDef Stats;
+
+}BMP390_Governor_TypeDef;
+
+
+/******************************************************************************
+         	#### BMP390 GOVERNOR PROTOTYPES OF FUNCTIONS ####
+******************************************************************************/
+
+/**
+  * @brief  Starts on the slowest profile, BMP390_Governor_Apply uploads it.
+  * @param  Gov governor.
+  * @param  Config is copied, NULL selects the defaults (BMP390_Governor_DefaultConfig).
+  */
+void BMP390_Governor_Init(BMP390_Governor_TypeDef *Gov, const BMP390_Gov_Config_TypeDef *Config);
+
+
+/**
+  * @brief  Profiles and thresholds for a small rocket.
+  * @param  Config is filled with the defaults.
+  */
+void BMP390_Governor_DefaultConfig(BMP390_Gov_Config_TypeDef *Config);
+
+
+/**
+  * @brief  Picks the profile from the tracked speed of the flight and its derivative, O(1). It doesn't touch the bus.
+  * @param  Gov governor.
+  * @param  Flight is updated with the same sample before.
+  * @param  timestamp of the sample (ms).
+  * @retval the new level if it changed (BMP390_Governor_Apply has to follow), otherwise -1.
+  */
+int8_t BMP390_Governor_Update(BMP390_Governor_TypeDef *Gov, const BMP390_Flight_TypeDef *Flight, uint32_t timestamp);
+
+
+/**
+  * @brief  Uploads the selected profile with the registers that differ from Params only, in an order that never
+  * 		leaves a measurement longer than the period : OSR first when the ODR gets faster, ODR first otherwise.
+  * 		Params take the profile before the writes, a restore after a failure uploads it as well.
+  * 		The sensor can't be used by anything else meanwhile (BMP390_Fifo_Pause, or call it where the sensor is read).
+  * @param  Gov governor.
+  * @param  BMP390 general handle.
+  * @retval booleans.
+  */
+_Bool BMP390_Governor_Apply(BMP390_Governor_TypeDef *Gov, BMP390_HandleTypeDef *BMP390);
+
+
+/**
+  * @brief  Average supply current of a profile (uA) : active during the measurement time, standby otherwise.
+  */
+float BMP390_Governor_Current(const BMP390_Gov_Profile_TypeDef *Profile);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP390_GOVERNOR_H_ */
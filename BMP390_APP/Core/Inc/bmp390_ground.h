@@ -0,0 +1,120 @@
+/*!
+ * @file : bmp390_ground.h
+
+ * Author: Yunus Emre KAYRA (github.com/YEK-Kayra)
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ **/
+
+#ifndef BMP390_GROUND_H_
+#define BMP390_GROUND_H_
+
+
+/******************************************************************************
+         			#### BMP390 GROUND INCLUDES ####
+******************************************************************************/
+#include "bmp390.h"
+#include "bmp390_flight.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/******************************************************************************
+         			#### BMP390 GROUND STRUCTURES ####
+******************************************************************************/
+
+/**
+ * @brief  The vehicle is at rest while the spread of the altitude stays below maxStd and its trend below maxRate.
+ * 		   The reference only follows the ground after hold ms at rest, any motion freezes it at once.
+ */
+typedef struct{
+
+	float fastTau;					/*! s, smoothing of the altitude and of its spread */
+	float rateTau;					/*! s, smoothing of the trend (derivative of the smoothed altitude) */
+	float refTau;					/*! s, time constant of the reference while it follows the ground */
+	float maxStd;					/*! m */
+	float maxRate;					/*! m/s, the weather moves the ground a few mm/s at most */
+	uint32_t hold;					/*! ms */
+
+}BMP390_Ground_Config_TypeDef;
+
+
+typedef struct{
+
+	uint32_t motions;				/*! Rest -> motion transitions */
+	uint32_t restTime;				/*! ms during which the reference followed the ground */
+	float minRef;					/*! Range of the reference (m), its drift since the boot */
+	float maxRef;
+
+}BMP390_Ground_Stats_TypeDef;
+
+
+typedef struct{
+
+	BMP390_Ground_Config_TypeDef Config;
+
+	float ref;						/*! Ground altitude over the standard sea level (m), mirrored into FixedAltitude */
+	float startRef;					/*! FixedAltitude of the boot (m) */
+	float mean;						/*! Smoothed altitude over the standard sea level (m) */
+	float var;						/*! m^2 */
+	float rate;						/*! m/s */
+	uint32_t lastTime;				/*! ms */
+	uint32_t quietSince;			/*! ms, start of the time below the thresholds */
+	uint8_t atRest;
+	uint8_t primed;
+
+	BMP390_Ground_Stats_TypeDef Stats;
+
+}BMP390_Ground_TypeDef;
+
+
+/******************************************************************************
+         	#### BMP390 GROUND PROTOTYPES OF FUNCTIONS ####
+******************************************************************************/
+
+/**
+  * @brief  Starts in motion, the reference is taken from FixedAltitude with the first sample.
+  * @param  Ground tracker.
+  * @param  Config is copied, NULL selects the defaults (BMP390_Ground_DefaultConfig).
+  */
+void BMP390_Ground_Init(BMP390_Ground_TypeDef *Ground, const BMP390_Ground_Config_TypeDef *Config);
+
+
+/**
+  * @brief  Defaults for the 1 s TIM1 period up to a few hundred Hz.
+  * @param  Config is filled with the defaults.
+  */
+void BMP390_Ground_DefaultConfig(BMP390_Ground_Config_TypeDef *Config);
+
+
+/**
+  * @brief  Runs the rest detector and, at rest, moves FixedAltitude toward the ground, O(1) and no pow.
+  * 		The previous altitude of the handle is moved as well, so the vertSpd of the next sample doesn't jump.
+  * 		Nothing is done with the sea level reference (Ref_Alt_Sel 'M').
+  * @param  Ground tracker.
+  * @param  BMP390 general handle, Sample was processed with it.
+  * @param  Flight is updated with the same sample before, the reference is frozen outside of the pad.
+  * 		NULL leaves the decision to the rest detector alone.
+  * @param  Sample gives timestamp (ms) and vertAlt (m).
+  * @retval true if the reference followed the ground with this sample.
+  */
+_Bool BMP390_Ground_Update(BMP390_Ground_TypeDef *Ground, BMP390_HandleTypeDef *BMP390,
+						   const BMP390_Flight_TypeDef *Flight, const BMP390_Sample_TypeDef *Sample);
+
+
+/**
+  * @brief  Drift of the reference since the boot (m), a positive value is a falling ground pressure.
+  */
+float BMP390_Ground_Drift(const BMP390_Ground_TypeDef *Ground);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP390_GROUND_H_ */
@@ -0,0 +1,87 @@
+/*!
+ * @file : bmp390_health.h
+
+ * Author: Yunus Emre KAYRA (github.com/YEK-Kayra)
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ **/
+
+#ifndef BMP390_HEALTH_H_
+#define BMP390_HEALTH_H_
+
+
+/******************************************************************************
+         			#### BMP390 HEALTH INCLUDES ####
+******************************************************************************/
+#include "bmp390.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/******************************************************************************
+         			#### BMP390 HEALTH ENUMS ####
+******************************************************************************/
+
+typedef enum{
+
+	BMP390_Health_Por   = 0,		/* por_detected, a brown-out put the sensor back to sleep mode defaults */
+	BMP390_Health_Fatal = 1,		/* fatal_err, it stays set until a soft reset */
+	BMP390_Health_Cmd   = 2,		/* cmd_err, a command was rejected, the data is still valid */
+	BMP390_Health_Conf  = 3			/* conf_err, the measurement doesn't fit into the ODR period */
+
+}BMP390_Health_Fault_TypeDef;
+
+#define BMP390_Health_FaultCount	4
+
+
+/******************************************************************************
+         			#### BMP390 HEALTH STRUCTURES ####
+******************************************************************************/
+
+typedef struct{
+
+	uint32_t frames;								/*! Checked frames */
+	uint32_t faults[BMP390_Health_FaultCount];		/*! Detected faults by class */
+	uint32_t droppedFrames;							/*! Frames whose data wasn't valid */
+	uint32_t restores;
+	uint32_t failedRestores;						/*! The reset or the upload failed, the next frame tries again */
+
+}BMP390_Health_Stats_TypeDef;
+
+
+extern BMP390_Health_Stats_TypeDef BMP390_Health_Stats;
+
+
+/******************************************************************************
+         	#### BMP390 HEALTH PROTOTYPES OF FUNCTIONS ####
+******************************************************************************/
+
+/**
+  * @brief  Checks the status registers of a frame, a few compares when nothing is wrong.
+  * 		POR and conf_err upload Params again, fatal_err soft resets the sensor first.
+  * @param  BMP390 general handle, ERR is updated.
+  * @param  Regs are the status registers read with the frame.
+  * @retval false if the data of the frame isn't valid.
+  */
+_Bool BMP390_Health_Check(BMP390_HandleTypeDef *BMP390, const BMP390_StatusRegs_TypeDef *Regs);
+
+
+/**
+  * @brief  Puts the sensor back into the configuration of Params.
+  * @param  BMP390 general handle.
+  * @param  reset, if it is true the sensor is soft reset first (about 3 ms).
+  * @retval booleans.
+  */
+_Bool BMP390_Health_Restore(BMP390_HandleTypeDef *BMP390, _Bool reset);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP390_HEALTH_H_ */
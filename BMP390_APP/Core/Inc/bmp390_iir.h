@@ -0,0 +1,134 @@
+/*!
+ * @file : bmp390_iir.h
+
+ * Author: Yunus Emre KAYRA (github.com/YEK-Kayra)
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ **/
+
+#ifndef BMP390_IIR_H_
+#define BMP390_IIR_H_
+
+
+/******************************************************************************
+         			#### BMP390 IIR INCLUDES ####
+******************************************************************************/
+#include "bmp390.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/******************************************************************************
+         			#### BMP390 IIR DEFINITIONS ####
+******************************************************************************/
+
+/**!Filters that run in parallel on the same stream */
+#ifndef BMP390_Iir_MaxFilters
+#define BMP390_Iir_MaxFilters		4
+#endif
+
+#define BMP390_Iir_Frac				7		/*! The state keeps 7 fractional bits, 1/128 of a raw count */
+
+
+/******************************************************************************
+         			#### BMP390 IIR STRUCTURES ####
+******************************************************************************/
+
+/**
+ * @brief  One filter, y += (x - y) / (coef + 1) on raw counts in Q7. coef + 1 is a power of two so the division is a shift,
+ * 		   the bits it drops are kept and added to the next difference, so the state is Q(7 + shift) in effect.
+ */
+typedef struct{
+
+	uint32_t press;					/*! Q7 raw counts, 24 bit raw values leave one bit of headroom */
+	uint32_t temp;
+	uint8_t shift;					/*! BMP390_FilterCoef_TypeDef, log2(coef + 1) */
+	uint8_t pressRem;				/*! Bits below Q7 that the last shift dropped, 0 .. coef */
+	uint8_t tempRem;
+
+}BMP390_IirFilter_TypeDef;
+
+
+/**
+ * @brief  Bank of filters fed by one unfiltered stream.
+ */
+typedef struct{
+
+	BMP390_IirFilter_TypeDef Filter[BMP390_Iir_MaxFilters];
+	uint8_t n;
+	uint8_t primed;					/*! The first sample loads the states, like the sensor after a reset */
+
+	uint32_t samples;
+
+}BMP390_Iir_TypeDef;
+
+
+/******************************************************************************
+         	#### BMP390 IIR PROTOTYPES OF FUNCTIONS ####
+******************************************************************************/
+
+/**
+  * @brief  Sets up the filters, the next sample primes them.
+  * @param  Iir filter bank.
+  * @param  coefs are the strengths, the same register values as the iir_filter field of CONFIG.
+  * @param  n filters, up to BMP390_Iir_MaxFilters.
+  * @retval booleans.
+  */
+_Bool BMP390_Iir_Init(BMP390_Iir_TypeDef *Iir, const BMP390_FilterCoef_TypeDef *coefs, uint8_t n);
+
+
+/**
+  * @brief  The next sample primes the filters again (after a restore or a FIFO flush).
+  */
+void BMP390_Iir_Reset(BMP390_Iir_TypeDef *Iir);
+
+
+/**
+  * @brief  Runs one unfiltered sample through every filter, two additions, one shift and one mask per value.
+  * 		The outputs stay within 0.51 counts of the exact recurrence (half a count of rounding plus the state's
+  * 		1/128). That is not bit-exact with the sensor : its filter's internal precision isn't published.
+  * @param  Iir filter bank.
+  * @param  Frame gives rawPress and rawTemp.
+  */
+void BMP390_Iir_Update(BMP390_Iir_TypeDef *Iir, const BMP390_RawFrame_TypeDef *Frame);
+
+
+/**
+  * @brief  BMP390_Iir_Update over a batch of frames, Out (n * Iir->n frames, filter after filter) can be NULL.
+  * 		Out[i * Iir->n + k] is frame i through filter k, with the sensortime of frame i.
+  */
+void BMP390_Iir_Batch(BMP390_Iir_TypeDef *Iir, const BMP390_RawFrame_TypeDef *Frames, uint16_t n, BMP390_RawFrame_TypeDef *Out);
+
+
+/**
+  * @brief  Output of filter k, rounded to raw counts. It can go to BMP390_Process_RawData like a sensor value.
+  */
+static inline uint32_t BMP390_Iir_Press(const BMP390_Iir_TypeDef *Iir, uint8_t k){
+
+	return (Iir->Filter[k].press + (1u << (BMP390_Iir_Frac - 1))) >> BMP390_Iir_Frac;
+}
+
+static inline uint32_t BMP390_Iir_Temp(const BMP390_Iir_TypeDef *Iir, uint8_t k){
+
+	return (Iir->Filter[k].temp + (1u << (BMP390_Iir_Frac - 1))) >> BMP390_Iir_Frac;
+}
+
+
+/**
+  * @brief  BMP390_Cycles per sample per filter of BMP390_Iir_Batch.
+  * @param  Iir filter bank, it is reset and then fed the frames.
+  * @param  Frames and n are the stream.
+  */
+uint32_t BMP390_Iir_Benchmark(BMP390_Iir_TypeDef *Iir, const BMP390_RawFrame_TypeDef *Frames, uint16_t n);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP390_IIR_H_ */
@@ -0,0 +1,144 @@
+/*!
+ * @file : bmp390_logger.h
+
+ * Author: Yunus Emre KAYRA (github.com/YEK-Kayra)
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ **/
+
+#ifndef BMP390_LOGGER_H_
+#define BMP390_LOGGER_H_
+
+
+/******************************************************************************
+         			#### BMP390 LOGGER INCLUDES ####
+******************************************************************************/
+#include "bmp390.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/******************************************************************************
+         			#### BMP390 LOGGER DEFINITIONS ####
+******************************************************************************/
+
+/**
+ * Flash layout (LOG region of STM32F103C6TX_FLASH.ld) :
+ *
+ * 		page   : header[8] | pair[0] | pair[1] | ... | pair[BMP390_Log_PairsPerPage - 1] | unused
+ * 		header : magic u16 (0xB390), seq u32 (page sequence number), reserved u16 (0xFFFF)
+ * 		pair   : record[9] | record[9]   (18 bytes, 9 half-words)
+ * 		record : rawPress u24, rawTemp u24, sensortime u24
+ *
+ * All fields are little endian. The pages are used in a circle, the page with the highest seq is the newest one.
+ * A pair that is all 0xFF is the end of the page, a record that is all 0xFF is padding (see BMP390_Logger_Flush).
+ *
+ * Capacity : 56 pairs = 112 records per page. The page after the current one is always kept erased, so a dump holds
+ * (BMP390_Log_Pages - 2) full pages plus the current one : 112 to 224 records with 3 pages, that is 112 to 224 s at
+ * 1 Hz but only 4.5 to 9 s at 25 Hz. BMP390_Log_Start and BMP390_Log_Pages are in bmp390_conf.h.
+ */
+#define BMP390_Log_PageSize			FLASH_PAGE_SIZE
+#define BMP390_Log_Magic			0xB390
+#define BMP390_Log_HeaderSize		8
+#define BMP390_Log_RecordSize		9
+#define BMP390_Log_PairSize			(2 * BMP390_Log_RecordSize)
+#define BMP390_Log_PairsPerPage		((BMP390_Log_PageSize - BMP390_Log_HeaderSize) / BMP390_Log_PairSize)
+
+/**!Records waiting in RAM for BMP390_Logger_Task, must be a power of two */
+#ifndef BMP390_Log_QueueLen
+#define BMP390_Log_QueueLen			16
+#endif
+
+
+/******************************************************************************
+         			#### BMP390 LOGGER STRUCTURES ####
+******************************************************************************/
+
+/**
+ * @brief  Circular flash log. The timer interrupt pushes, the main loop programs the flash.
+ */
+typedef struct{
+
+	BMP390_RawFrame_TypeDef queue[BMP390_Log_QueueLen];
+	volatile uint8_t head;			/*! Written by BMP390_Logger_Push only */
+	volatile uint8_t tail;			/*! Written by BMP390_Logger_Task only */
+
+	uint8_t page;					/*! The page that is being filled */
+	uint8_t nextErased;				/*! The page after it is already erased */
+	uint16_t pair;					/*! First free pair of the page */
+	uint32_t seq;					/*! Sequence number of the page */
+
+	uint32_t records;				/*! Records programmed since BMP390_Logger_Init */
+	uint32_t droppedRecords;		/*! The queue was full, the main loop fell behind */
+	uint32_t flashErrors;
+
+}BMP390_Logger_TypeDef;
+
+
+/**
+ * @brief  Called for every record found by BMP390_Logger_Parse, index counts from the oldest record.
+ */
+typedef void (*BMP390_Logger_Callback_t)(void *ctx, uint32_t index, const BMP390_RawFrame_TypeDef *Frame);
+
+
+/******************************************************************************
+         	#### BMP390 LOGGER PROTOTYPES OF FUNCTIONS ####
+******************************************************************************/
+
+/**
+  * @brief  Finds the newest page and the first free pair in it, the log continues from there.
+  * 		If there isn't any valid page, the first page is erased and the log starts from scratch.
+  * @param  Log logger handle.
+  * @retval booleans.
+  */
+_Bool BMP390_Logger_Init(BMP390_Logger_TypeDef *Log);
+
+
+/**
+  * @brief  Queues a raw frame, it only copies 12 bytes so it can be called from the timer interrupt.
+  * @param  Log logger handle.
+  * @param  Frame is the raw frame.
+  * @retval false if the queue is full and the frame is dropped.
+  */
+_Bool BMP390_Logger_Push(BMP390_Logger_TypeDef *Log, const BMP390_RawFrame_TypeDef *Frame);
+
+
+/**
+  * @brief  Programs the queued records pair by pair and erases the next page ahead of time.
+  * 		A page erase stalls the core for 20 to 40 ms (single flash bank, no fetch while it runs) and the TIM1
+  * 		interrupt waits for it too, so this must be called from the main loop only, never from an interrupt.
+  * @param  Log logger handle.
+  * @retval false if a flash operation failed.
+  */
+_Bool BMP390_Logger_Task(BMP390_Logger_TypeDef *Log);
+
+
+/**
+  * @brief  Programs everything in the queue, an odd last record is padded with 0xFF (before a power down).
+  * @param  Log logger handle.
+  * @retval false if a flash operation failed.
+  */
+_Bool BMP390_Logger_Flush(BMP390_Logger_TypeDef *Log);
+
+
+/**
+  * @brief  Reconstructs the log from a dump of the LOG region (st-flash read log.bin 0x08007400 3072).
+  * 		It doesn't use any peripheral, so the same code is the decoder on the host.
+  * @param  dump is the content of the region, size is a multiple of BMP390_Log_PageSize.
+  * @param  cb is called for each record from the oldest one to the newest one.
+  * @param  ctx is passed to cb.
+  * @retval number of records.
+  */
+uint32_t BMP390_Logger_Parse(const uint8_t *dump, uint32_t size, BMP390_Logger_Callback_t cb, void *ctx);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP390_LOGGER_H_ */
@@ -0,0 +1,173 @@
+/*!
+ * @file : bmp390_lowpower.h
+
+ * Author: Yunus Emre KAYRA (github.com/YEK-Kayra)
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ **/
+
+#ifndef BMP390_LOWPOWER_H_
+#define BMP390_LOWPOWER_H_
+
+
+/******************************************************************************
+         			#### BMP390 LOW POWER INCLUDES ####
+******************************************************************************/
+#include "bmp390.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/******************************************************************************
+         			#### BMP390 LOW POWER DEFINITIONS ####
+******************************************************************************/
+
+/**!INT pin of the sensor, the same one as the FIFO mode (PA0, EXTI0_IRQHandler in stm32f1xx_it.c) */
+#ifndef BMP390_Lp_IntPort
+#define BMP390_Lp_IntPort			GPIOA
+#define BMP390_Lp_IntPin			GPIO_PIN_0
+#define BMP390_Lp_IntIRQn			EXTI0_IRQn
+#define BMP390_Lp_IntClkEnable()	__HAL_RCC_GPIOA_CLK_ENABLE()
+#endif
+
+/**!The RTC counts ms of the LSI. LSI is 40 kHz nominal but 30 .. 60 kHz between parts, trim it for long periods */
+#ifndef BMP390_Lp_LsiHz
+#define BMP390_Lp_LsiHz				40000
+#endif
+
+#define BMP390_Lp_RtcLine			EXTI_IMR_MR17	/*! The RTC alarm reaches the EXTI as line 17, it wakes up Stop mode */
+#define BMP390_Lp_MaxBatch			16
+
+
+/******************************************************************************
+         			#### BMP390 LOW POWER STRUCTURES ####
+******************************************************************************/
+
+/**
+ * @brief  Current proxies since BMP390_LowPower_Init.
+ */
+typedef struct{
+
+	uint32_t wakes;
+	uint32_t stops;					/*! Sleeps in Stop mode */
+	uint32_t sleeps;				/*! Sleeps in Sleep mode, a DMA was running */
+	uint64_t activeCycles;			/*! Core cycles while awake (BMP390_Cycles) */
+	uint64_t busCycles;				/*! Core cycles of the sensor transfers */
+	uint32_t samples;
+	uint32_t batches;
+	uint32_t missed;				/*! Conversions without an INT edge before the next alarm */
+
+}BMP390_Lp_Stats_TypeDef;
+
+
+/**
+ * @brief  BMP390_Lp_Stats_TypeDef scaled to one hour.
+ */
+typedef struct{
+
+	float wakes;
+	float activeCycles;
+	float busMs;
+	float duty;						/*! Awake fraction of the time (0 .. 1) */
+
+}BMP390_Lp_Report_TypeDef;
+
+
+/**
+ * @brief  Receives the samples of a batch, timestamp is the RTC time of the conversion (ms).
+ */
+typedef void (*BMP390_Lp_Callback_t)(void *ctx, const BMP390_RawFrame_TypeDef *Frame, uint32_t timestamp);
+
+
+/**
+ * @brief  RTC alarm -> forced conversion -> INT edge -> read, the MCU is stopped in between.
+ * 		   The interrupts only set flags, the sensor is only used from the main loop.
+ */
+typedef struct{
+
+	BMP390_HandleTypeDef *BMP390;
+
+	uint32_t period;				/*! ms between two conversions */
+	uint8_t batch;					/*! Samples per processing */
+
+	volatile uint8_t alarm;			/*! Set by the RTC alarm */
+	volatile uint8_t drdy;			/*! Set by the INT edge */
+	uint8_t converting;
+	uint32_t nextAlarm;				/*! RTC ms */
+
+	BMP390_RawFrame_TypeDef frame[BMP390_Lp_MaxBatch];
+	uint32_t time[BMP390_Lp_MaxBatch];
+	uint8_t n;
+
+	uint32_t startTime;				/*! RTC ms */
+	uint32_t wakeCycles;			/*! BMP390_Cycles at the last wake-up */
+
+	BMP390_Lp_Stats_TypeDef Stats;
+
+}BMP390_LowPower_TypeDef;
+
+
+/******************************************************************************
+         	#### BMP390 LOW POWER PROTOTYPES OF FUNCTIONS ####
+******************************************************************************/
+
+/**
+  * @brief  Puts the sensor in forced mode with a latched data ready interrupt, uploads Params, starts the RTC
+  * 		from the LSI and sets up the INT and RTC alarm EXTI lines. TIM1 polling has to be stopped.
+  * @param  Lp low power handle.
+  * @param  BMP390 general handle, its Params get the mode and interrupt settings.
+  * @param  period between two conversions (ms), longer than the measurement time.
+  * @param  batch is the number of samples per processing, up to BMP390_Lp_MaxBatch.
+  * @retval booleans.
+  */
+_Bool BMP390_LowPower_Init(BMP390_LowPower_TypeDef *Lp, BMP390_HandleTypeDef *BMP390, uint32_t period, uint8_t batch);
+
+
+/**
+  * @brief  RTC alarm (RTC_Alarm_IRQHandler) and INT edge (EXTI0_IRQHandler), they only set flags.
+  */
+void BMP390_LowPower_AlarmIRQHandler(BMP390_LowPower_TypeDef *Lp);
+void BMP390_LowPower_IntIRQHandler(BMP390_LowPower_TypeDef *Lp);
+
+
+/**
+  * @brief  Starts the conversion of an alarm, reads the result of an INT edge and hands a full batch to cb.
+  * 		It is called from the main loop after every wake-up.
+  * @param  Lp low power handle.
+  * @param  cb receives every sample of a full batch, ctx is passed to it.
+  * @retval Number of processed samples.
+  */
+uint8_t BMP390_LowPower_Task(BMP390_LowPower_TypeDef *Lp, BMP390_Lp_Callback_t cb, void *ctx);
+
+
+/**
+  * @brief  Waits for the next interrupt in Stop mode, or in Sleep mode if a DMA is still running (telemetry).
+  * 		It returns at once if an event came after BMP390_LowPower_Task. SysTick is suspended meanwhile.
+  * @param  Lp low power handle.
+  * @param  deep selects Stop mode.
+  */
+void BMP390_LowPower_Sleep(BMP390_LowPower_TypeDef *Lp, _Bool deep);
+
+
+/**
+  * @brief  RTC time (ms), it keeps counting in Stop mode.
+  */
+uint32_t BMP390_LowPower_Millis(void);
+
+
+/**
+  * @brief  Wakes, active cycles and bus time per hour of the run so far.
+  */
+void BMP390_LowPower_Report(const BMP390_LowPower_TypeDef *Lp, BMP390_Lp_Report_TypeDef *Report);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP390_LOWPOWER_H_ */
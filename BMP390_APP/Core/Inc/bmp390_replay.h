@@ -0,0 +1,138 @@
+/*!
+ * @file : bmp390_replay.h
+
+ * Author: Yunus Emre KAYRA (github.com/YEK-Kayra)
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ **/
+
+#ifndef BMP390_REPLAY_H_
+#define BMP390_REPLAY_H_
+
+
+/******************************************************************************
+         			#### BMP390 REPLAY INCLUDES ####
+******************************************************************************/
+#include "bmp390.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/******************************************************************************
+         			#### BMP390 REPLAY STRUCTURES ####
+******************************************************************************/
+
+/**
+ * @brief  Optional stage that runs on every processed sample (filters under test), it may change the sample.
+ */
+typedef void (*BMP390_Replay_Stage_t)(void *ctx, BMP390_Sample_TypeDef *Sample);
+
+
+/**
+ * @brief  Returns a free running microsecond counter, it is only used for the throughput.
+ */
+typedef uint32_t (*BMP390_Replay_Clock_t)(void);
+
+
+/**
+ * @brief  Largest absolute difference of every output from the recorded one.
+ */
+typedef struct{
+
+	float press;
+	float temp;
+	float vertAlt;
+	float vertSpd;
+	float vertAcc;
+
+}BMP390_Replay_Err_TypeDef;
+
+
+typedef struct{
+
+	BMP390_HandleTypeDef BMP390;	/*! Calibration, reference altitude and the kinematic history, no bus */
+	float totalMass;
+
+	BMP390_Replay_Stage_t stage;
+	void *stageCtx;
+
+	BMP390_Replay_Clock_t clock;	/*! NULL : framesPerSecond stays 0 */
+
+	float tolerance;				/*! A sample is a mismatch if any of its outputs differs more than this */
+
+	const BMP390_Sample_TypeDef *expected;	/*! Recorded samples for BMP390_Replay_LogCallback, by record index */
+	uint32_t expectedCount;
+
+	uint32_t timestamp;				/*! Of the previous frame (ms), frames without a recorded sample go on from it */
+	uint32_t sensortime;			/*! Of the previous frame */
+
+	uint32_t frames;
+	uint32_t compared;
+	uint32_t mismatches;
+	uint32_t firstMismatch;			/*! Index of the first mismatching frame */
+	BMP390_Replay_Err_TypeDef maxErr;
+
+	uint32_t elapsedUs;
+	uint32_t framesPerSecond;
+
+}BMP390_Replay_TypeDef;
+
+
+/******************************************************************************
+         	#### BMP390 REPLAY PROTOTYPES OF FUNCTIONS ####
+******************************************************************************/
+
+/**
+  * @brief  Prepares a replay with the calibration of the recorded sensor.
+  * 		The stage, clock, tolerance and expected fields can be set after this call.
+  * @param  Replay replay handle.
+  * @param  Calib is the processed calibration (BMP390_Calc_PrcsdCalibrationCoeff of the recorded NVM).
+  * @param  fixedAltitude and totalMass are the values used during the recording.
+  */
+void BMP390_Replay_Init(BMP390_Replay_TypeDef *Replay, const BMP390_PrcsdCalibData_TypeDef *Calib, float fixedAltitude, float totalMass);
+
+
+/**
+  * @brief  Runs one raw frame through BMP390_Process_RawData and the stage.
+  * @param  Replay replay handle.
+  * @param  Frame is the raw frame.
+  * @param  Expected is the recorded sample of the frame, NULL if there isn't one.
+  * @param  Sample is filled with the new output. Its timestamp is the recorded one, or the previous one advanced by
+  * 		the sensortime of the frame at the nominal rate : speed and acceleration are divided by it.
+  * @retval false if the output doesn't match Expected.
+  */
+_Bool BMP390_Replay_Frame(BMP390_Replay_TypeDef *Replay, const BMP390_RawFrame_TypeDef *Frame,
+						  const BMP390_Sample_TypeDef *Expected, BMP390_Sample_TypeDef *Sample);
+
+
+/**
+  * @brief  Replays n frames (a mapped log file, a decoded flash dump...) and measures the throughput.
+  * @param  Replay replay handle.
+  * @param  Frames are the raw frames.
+  * @param  Expected are the recorded samples, NULL if there aren't any.
+  * @param  Out receives the outputs, NULL if they aren't needed.
+  * @param  n is the number of frames.
+  * @retval true if every output matches.
+  */
+_Bool BMP390_Replay_Run(BMP390_Replay_TypeDef *Replay, const BMP390_RawFrame_TypeDef *Frames,
+						const BMP390_Sample_TypeDef *Expected, BMP390_Sample_TypeDef *Out, uint32_t n);
+
+
+/**
+  * @brief  BMP390_Logger_Callback_t adapter, ctx is the replay handle. Replays a flash dump without copying it:
+  * 		BMP390_Logger_Parse(dump, size, BMP390_Replay_LogCallback, &Replay).
+  * 		Record index is compared with expected[index], records past expectedCount only go through the stage.
+  */
+void BMP390_Replay_LogCallback(void *ctx, uint32_t index, const BMP390_RawFrame_TypeDef *Frame);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP390_REPLAY_H_ */
@@ -0,0 +1,109 @@
+/*!
+ * @file : bmp390_sim.h
+
+ * Author: Yunus Emre KAYRA (github.com/YEK-Kayra)
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ **/
+
+#ifndef BMP390_SIM_H_
+#define BMP390_SIM_H_
+
+
+/******************************************************************************
+         			#### BMP390 SIM INCLUDES ####
+******************************************************************************/
+#include "bmp390.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/******************************************************************************
+         			#### BMP390 SIM DEFINITIONS ####
+******************************************************************************/
+
+#define BMP390_Sim_SensortimeHz		25600	/*! SENSORTIME counts at 25.6 kHz */
+
+
+/******************************************************************************
+         			#### BMP390 SIM STRUCTURES ####
+******************************************************************************/
+
+/**
+ * @brief  Synthetic sensor. True pressure and temperature go in, raw frames like the real sensor's come out.
+ */
+typedef struct{
+
+	BMP390_PrcsdCalibData_TypeDef Calib;
+
+	float pressNoise;				/*! Pa RMS per conversion, BMP390_PressNoise_X1 scaled by the oversampling */
+	float tempNoise;				/*! °C RMS per conversion */
+	float coef;						/*! IIR filter coefficient (0, 1, 3 .. 127) */
+
+	double pressFilt;				/*! IIR state in raw counts, a float is half a count coarse there */
+	double tempFilt;
+	uint8_t primed;
+
+	uint32_t sensortime;
+	uint32_t sensortimeStep;		/*! ODR period in sensortime counts */
+	uint32_t rng;
+
+}BMP390_Sim_TypeDef;
+
+
+/******************************************************************************
+         	#### BMP390 SIM PROTOTYPES OF FUNCTIONS ####
+******************************************************************************/
+
+/**
+  * @brief  Prepares a synthetic sensor.
+  * @param  Sim simulator handle.
+  * @param  Calib is the processed calibration of the sensor that is imitated.
+  * @param  Params gives odr, press_osrs, temp_osrs and filtercoef.
+  * @param  seed of the noise, the same seed gives the same sequence.
+  */
+void BMP390_Sim_Init(BMP390_Sim_TypeDef *Sim, const BMP390_PrcsdCalibData_TypeDef *Calib, const BMP390_Params_t *Params, uint32_t seed);
+
+
+/**
+  * @brief  Produces the raw frame of one conversion.
+  * @param  Sim simulator handle.
+  * @param  press (Pa) and temp (°C) are the true values.
+  * @param  Frame is filled with noisy, filtered raw values and the sensortime.
+  */
+void BMP390_Sim_Step(BMP390_Sim_TypeDef *Sim, float press, float temp, BMP390_RawFrame_TypeDef *Frame);
+
+
+/**
+  * @brief  BMP390_Sim_Step over a whole trajectory.
+  * @param  temp can be NULL, then the temperature is tempConst.
+  */
+void BMP390_Sim_Generate(BMP390_Sim_TypeDef *Sim, const float *press, const float *temp, float tempConst,
+						 uint32_t n, BMP390_RawFrame_TypeDef *Frames);
+
+
+/**
+  * @brief  Inverse of BMP390_Comp_Temp and BMP390_Comp_Press, the raw value that gives the true value.
+  * 		slope receives the change of the compensated value per raw count, it can be NULL.
+  * 		Double, the raw values are up to 2^24 where a float has a whole count of rounding.
+  */
+double BMP390_Sim_RawTemp(const BMP390_PrcsdCalibData_TypeDef *Calib, float temp, float *slope);
+double BMP390_Sim_RawPress(const BMP390_PrcsdCalibData_TypeDef *Calib, float press, float temp, float *slope);
+
+
+/**
+  * @brief  Approximately normal noise with unit RMS (four xorshift32 uniforms), state must not be 0.
+  */
+float BMP390_Sim_Noise(uint32_t *state);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP390_SIM_H_ */
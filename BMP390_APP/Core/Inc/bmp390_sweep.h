@@ -0,0 +1,139 @@
+/*!
+ * @file : bmp390_sweep.h
+
+ * Author: Yunus Emre KAYRA (github.com/YEK-Kayra)
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ **/
+
+#ifndef BMP390_SWEEP_H_
+#define BMP390_SWEEP_H_
+
+
+/******************************************************************************
+         			#### BMP390 SWEEP INCLUDES ####
+******************************************************************************/
+#include "bmp390.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/******************************************************************************
+         			#### BMP390 SWEEP DEFINITIONS ####
+******************************************************************************/
+
+/**!Size of the configuration grid of BMP390_Sweep_GridConfig, spdSteps values of spdAlpha are used */
+#define BMP390_Sweep_FilterSteps		8		/*! BMP390_Filter_Coef_0 .. BMP390_Filter_Coef_127 */
+#define BMP390_Sweep_OsrSteps			6		/*! BMP390_Oversampling_X1 .. BMP390_Oversampling_X32 */
+#define BMP390_Sweep_GridSize(spdSteps)	((uint32_t)BMP390_Sweep_FilterSteps * BMP390_Sweep_OsrSteps * (spdSteps))
+
+
+/******************************************************************************
+         			#### BMP390 SWEEP STRUCTURES ####
+******************************************************************************/
+
+/**
+ * @brief  One recorded or simulated flight. It is only read, any number of evaluations can share it.
+ */
+typedef struct{
+
+	const float *press;				/*! Pressure of every sample (Pa) */
+	const float *truthAlt;			/*! Reference altitude (m), NULL : the altitude of press is the reference */
+	uint32_t n;
+	float period;					/*! Sampling period (s) */
+	float noise;					/*! Pressure noise (Pa RMS at X1) added before the filter, 0 for recorded flights */
+
+	uint32_t apogeeIndex;			/*! Filled by BMP390_Sweep_PrepareFlight */
+	float peakAlt;
+
+}BMP390_Sweep_Flight_TypeDef;
+
+
+/**
+ * @brief  One point of the grid.
+ */
+typedef struct{
+
+	uint8_t filterCoef;				/*! BMP390_Filter_Coef_x, the sensor IIR is emulated */
+	uint8_t pressOsrs;				/*! BMP390_Oversampling_Xx, scales the added noise */
+	float spdAlpha;					/*! Vertical speed smoothing, 1 : no smoothing */
+	uint32_t seed;					/*! Noise seed, the same seed gives the same result */
+
+}BMP390_Sweep_Config_TypeDef;
+
+
+typedef struct{
+
+	uint32_t index;					/*! Grid index of the configuration */
+	float altRms;					/*! Altitude error (m RMS) */
+	float lag;						/*! Peak of the filtered altitude minus the real apogee (s) */
+	float detectDelay;				/*! Apogee detection (speed < 0 near the top) minus the real apogee (s), negative : early */
+	_Bool detected;					/*! false : the apogee was never detected, detectDelay is 0 */
+	float score;					/*! Filled by BMP390_Sweep_Rank */
+
+}BMP390_Sweep_Result_TypeDef;
+
+
+/**
+ * @brief  Weights of the ranking, score = altRms + lag * |lag| + detectDelay * |detectDelay|.
+ */
+typedef struct{
+
+	float lag;
+	float detectDelay;
+
+}BMP390_Sweep_Weights_TypeDef;
+
+
+/******************************************************************************
+         	#### BMP390 SWEEP PROTOTYPES OF FUNCTIONS ####
+******************************************************************************/
+
+/**
+  * @brief  Finds the real apogee of a flight, once per flight before the evaluations.
+  * @param  Flight is the flight.
+  */
+void BMP390_Sweep_PrepareFlight(BMP390_Sweep_Flight_TypeDef *Flight);
+
+
+/**
+  * @brief  Maps a grid index to a configuration, so every worker can take any index in any order.
+  * @param  index is below BMP390_Sweep_GridSize(spdSteps).
+  * @param  spdSteps is the number of spdAlpha values between 1/spdSteps and 1.
+  * @param  Config is filled with the configuration.
+  */
+void BMP390_Sweep_GridConfig(uint32_t index, uint16_t spdSteps, BMP390_Sweep_Config_TypeDef *Config);
+
+
+/**
+  * @brief  Runs the filter, BMP390_Comp_VertAlt and the speed estimator over a flight.
+  * 		It is reentrant, it only reads Flight and Config and uses a few bytes of stack, so the
+  * 		configurations can be split between threads without any locking.
+  * @param  Flight is a prepared flight.
+  * @param  Config is the configuration.
+  * @param  Result is filled with the metrics (index is left untouched).
+  */
+void BMP390_Sweep_Evaluate(const BMP390_Sweep_Flight_TypeDef *Flight, const BMP390_Sweep_Config_TypeDef *Config,
+						   BMP390_Sweep_Result_TypeDef *Result);
+
+
+/**
+  * @brief  Scores the results and sorts the best k of them to the front of Results.
+  * 		An early detection costs as much as a late one, an undetected apogee ranks after every detected one.
+  * @param  Results and n are the results of the sweep.
+  * @param  Weights are the ranking weights.
+  * @param  k is the number of the best results that are needed.
+  */
+void BMP390_Sweep_Rank(BMP390_Sweep_Result_TypeDef *Results, uint32_t n, const BMP390_Sweep_Weights_TypeDef *Weights, uint32_t k);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP390_SWEEP_H_ */
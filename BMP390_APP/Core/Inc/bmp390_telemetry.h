@@ -0,0 +1,146 @@
+/*!
+ * @file : bmp390_telemetry.h
+
+ * Author: Yunus Emre KAYRA (github.com/YEK-Kayra)
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ **/
+
+#ifndef BMP390_TELEMETRY_H_
+#define BMP390_TELEMETRY_H_
+
+
+/******************************************************************************
+         			#### BMP390 TELEMETRY INCLUDES ####
+******************************************************************************/
+#include "bmp390.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/******************************************************************************
+         			#### BMP390 TELEMETRY DEFINITIONS ####
+******************************************************************************/
+
+/**
+ * Frame on the wire (USART1 TX, PA9) :
+ *
+ * 		COBS( type[1] | seq[1] | payload[0..BMP390_Tlm_MaxPayload] | crc16[2] ) | 0x00
+ *
+ * crc16 is CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) of type, seq and payload, little endian.
+ * All payload fields are little endian. The 0x00 delimiter never appears inside a frame.
+ */
+#define BMP390_Tlm_MaxPayload		40
+#define BMP390_Tlm_MaxRawFrame		(2 + BMP390_Tlm_MaxPayload + 2)
+#define BMP390_Tlm_MaxFrame			(BMP390_Tlm_MaxRawFrame + (BMP390_Tlm_MaxRawFrame / 254) + 2)
+
+/**!Size of each of the two DMA buffers, one is being sent while the other one is being filled */
+#ifndef BMP390_Tlm_BufSize
+#define BMP390_Tlm_BufSize			128
+#endif
+
+#ifndef BMP390_Tlm_Baudrate
+#define BMP390_Tlm_Baudrate			115200
+#endif
+
+
+/******************************************************************************
+         			#### BMP390 TELEMETRY ENUMS ####
+******************************************************************************/
+
+/**
+ * @brief Packet types, the payload layout of every type is fixed
+ */
+typedef enum{
+
+	BMP390_Tlm_Sample = 0x01,		/* timestamp u32, press f32, temp f32, vertAlt f32, vertSpd f32, vertAcc f32, gForce f32 (28 bytes) */
+	BMP390_Tlm_RawFrame = 0x02,		/* timestamp u32, rawPress u24, rawTemp u24, sensortime u24 (13 bytes) */
+	BMP390_Tlm_Allan = 0x03			/* channel u8 (0 press, 1 alt), octaves u8, tau0 ms u16, samples u32, adev f32 per octave */
+
+}BMP390_Tlm_Type_TypeDef;
+
+
+/******************************************************************************
+         			#### BMP390 TELEMETRY STRUCTURES ####
+******************************************************************************/
+
+/**
+ * @brief  Double buffered USART1 TX DMA queue
+ */
+typedef struct{
+
+	DMA_HandleTypeDef hdma;			/*! DMA1 Channel4, USART1_TX */
+
+	uint8_t buf[2][BMP390_Tlm_BufSize];
+
+	uint16_t fill;					/*! Bytes waiting in buf[active] */
+	uint8_t active;					/*! The buffer that is being filled */
+	volatile uint8_t busy;			/*! The other buffer is being sent */
+	uint8_t seq;
+
+	uint32_t sentFrames;
+	uint32_t droppedFrames;			/*! The fill buffer had no room, the link is slower than the data */
+	uint32_t txErrors;				/*! DMA transfer errors, the frames of that buffer are lost, the receiver resyncs on 0x00 */
+
+}BMP390_Telemetry_TypeDef;
+
+
+/******************************************************************************
+         	#### BMP390 TELEMETRY PROTOTYPES OF FUNCTIONS ####
+******************************************************************************/
+
+/**
+  * @brief  Configures PA9, USART1 (8N1, BMP390_Tlm_Baudrate) and its TX DMA channel.
+  * @param  Tlm telemetry handle.
+  * @retval booleans.
+  */
+_Bool BMP390_Telemetry_Init(BMP390_Telemetry_TypeDef *Tlm);
+
+
+/**
+  * @brief  Frames a payload and queues it. It only copies bytes, the DMA sends them.
+  * 		It can be called from the timer interrupt and from the main loop.
+  * @param  Tlm telemetry handle.
+  * @param  type is the packet type.
+  * @param  payload and len (up to BMP390_Tlm_MaxPayload) are the packet content.
+  * @retval false if the frame is dropped.
+  */
+_Bool BMP390_Telemetry_Send(BMP390_Telemetry_TypeDef *Tlm, uint8_t type, const uint8_t *payload, uint8_t len);
+
+
+/**
+  * @brief  Serializes a processed sample into a BMP390_Tlm_Sample packet and queues it.
+  * @param  Tlm telemetry handle.
+  * @param  Sample is the processed sample.
+  * @retval false if the frame is dropped.
+  */
+_Bool BMP390_Telemetry_SendSample(BMP390_Telemetry_TypeDef *Tlm, const BMP390_Sample_TypeDef *Sample);
+
+
+/**
+  * @brief  Must be called from DMA1_Channel4_IRQHandler.
+  * @param  Tlm telemetry handle.
+  */
+void BMP390_Telemetry_IRQHandler(BMP390_Telemetry_TypeDef *Tlm);
+
+
+/**
+  * @brief  Frame encoding and decoding, they don't use any peripheral so they also run on the host (decoder, loopback tests).
+  * 		Encode returns the frame length including the 0x00 delimiter.
+  * 		Decode takes one frame without the delimiter, checks the CRC and returns the payload length or -1.
+  */
+uint16_t BMP390_Telemetry_Encode(uint8_t seq, uint8_t type, const uint8_t *payload, uint8_t len, uint8_t *frame);
+int16_t  BMP390_Telemetry_Decode(const uint8_t *frame, uint16_t len, uint8_t *type, uint8_t *seq, uint8_t *payload);
+uint16_t BMP390_Telemetry_Crc16(const uint8_t *data, uint16_t len);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP390_TELEMETRY_H_ */
@@ -57,6 +57,7 @@ void PendSV_Handler(void);
 void SysTick_Handler(void);
 void TIM1_UP_IRQHandler(void);
 /* USER CODE BEGIN EFP */
+void DMA1_Channel4_IRQHandler(void);
 
 /* USER CODE END EFP */
 
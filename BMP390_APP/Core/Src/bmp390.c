@@ -36,24 +36,51 @@
  */
 
 #include "bmp390.h"
+#include "bmp390_bus.h"
+#include "bmp390_health.h"
+
+#ifdef BMP390_STATIC_CONFIG
+_Static_assert((BMP390_CONF_MODE != BMP390_Mode_Normal) || (BMP390_CONF_MEAS_TIME <= BMP390_CONF_ODR_PERIOD),
+			   "BMP390 static configuration: the measurement doesn't fit into the ODR period");
+_Static_assert((BMP390_CONF_SAMPLE_PERIOD * 1000UL) >= BMP390_CONF_ODR_PERIOD,
+			   "BMP390 static configuration: TIM1 would read the same data more than once");
+#endif
 
 _Bool BMP390_Init(BMP390_HandleTypeDef *BMP390){
 
-	 if(HAL_I2C_IsDeviceReady(BMP390->i2c, BMP390->BMP390_I2C_ADDRESS, 10, 1000) != HAL_OK){
+	 if(HAL_I2C_IsDeviceReady(BMP390->i2c, BMP390->BMP390_I2C_ADDRESS, 10, BMP390_Bus_CalcTimeout(BMP390->i2c, 0)) != HAL_OK){
 
 		 HAL_GPIO_WritePin(GPIOC, GPIO_PIN_13, GPIO_PIN_SET);
 
 	 }
 
-	 BMP390_Get_RawCalibCoeff(BMP390);
+#if BMP390_Keep_RawNVM
+	 BMP390_RawCalibData_TypeDef *Raw_NVM = &BMP390->Raw_NVM;
+#else
+	 BMP390_RawCalibData_TypeDef RawCalib;	//Only needed until it is processed
+	 BMP390_RawCalibData_TypeDef *Raw_NVM = &RawCalib;
+#endif
+
+	 BMP390_Get_RawCalibCoeff(BMP390, Raw_NVM);
 
-	 BMP390_Calc_PrcsdCalibrationCoeff(BMP390);
+	 BMP390_Calc_PrcsdCalibrationCoeff(BMP390, Raw_NVM);
 
 	 BMP390_Set_DefaultParams(BMP390);
 
 	 BMP390_Upload_ConfigParams(BMP390);
 
 
+#ifdef BMP390_STATIC_CONFIG
+
+	 BMP390->Ref_Alt_Sel   = BMP390_CONF_REF_ALT_SEL;
+	 BMP390->FixedAltitude = 0.0;
+
+#if BMP390_CONF_REF_ALT_SEL == 'm'
+	 BMP390->FixedAltitude = BMP390_Calc_TemporaryAltitude(BMP390, &BMP390_VertAlt);
+#endif
+
+#else
+
 	 if(BMP390->Ref_Alt_Sel == 'm'){
 
 		 BMP390->FixedAltitude = 0.0; //We set zero at the first time because gets the real place altitude value
@@ -66,6 +93,8 @@ _Bool BMP390_Init(BMP390_HandleTypeDef *BMP390){
 
 	 }
 
+#endif
+
 	 BMP390_ResetRef_DeltaVal(BMP390);
 
 	 HAL_TIM_Base_Start_IT(&htim1);
@@ -77,93 +106,262 @@ _Bool BMP390_Init(BMP390_HandleTypeDef *BMP390){
 
 _Bool BMP390_ResetRef_DeltaVal(BMP390_HandleTypeDef *BMP390){
 
-	//At the beginning, reset the altitude values for the first and second conditions.
+	//At the beginning, reset the previous altitude and speed values.
 	BMP390->DeltaData.alt0 = 0.0;
-	BMP390->DeltaData.alt1 = 0.0;
-	BMP390->DeltaData.holdAlt = 0.0;
-
-	//At the beginning, reset the speed values for the first and second conditions.
 	BMP390->DeltaData.spd0 = 0.0;
-	BMP390->DeltaData.spd1 = 0.0;
-	BMP390->DeltaData.holdSpd = 0.0;
-
-	//At the beginning, reset the acceleration values for the first and second conditions.
-	BMP390->DeltaData.acc0 = 0.0;
-	BMP390->DeltaData.acc1 = 0.0;
-	BMP390->DeltaData.holdAcc = 0.0;
+	BMP390->DeltaData.t0 = 0;
 
 	return true;
 }
 
 _Bool BMP390_Upload_ConfigParams(BMP390_HandleTypeDef *BMP390){
 
-	 BMP390->PWR_CTRL = ((BMP390->Params.mode)<<4) |
-			 	 	 	((BMP390->Params.stat_meas_temp)<<1)|
-			 	 	 	((BMP390->Params.stat_meas_press)<<0);
+	 uint8_t PWR_CTRL;	/*! bits: mode[5:4], temp_en[1:1], press_en[0:0] */
+	 uint8_t CONFIG;	/*! bits: iir_filter[3:1] */
+	 uint8_t ODR;		/*! bits: odr_sel[4:0] */
+	 uint8_t OSR;		/*! bits: osr_t[5:3], osr_p[2:0] */
+	 uint8_t SLEEP;		/*! PWR_CTRL with mode[5:4] = sleep */
+
+#ifdef BMP390_STATIC_CONFIG
+
+	 //Checked at compile time
+	 PWR_CTRL = BMP390_CONF_REG_PWR_CTRL;
+	 CONFIG   = BMP390_CONF_REG_CONFIG;
+	 ODR      = BMP390_CONF_REG_ODR;
+	 OSR      = BMP390_CONF_REG_OSR;
+
+#else
+
+	 //An adjusted odr is uploaded, the caller sees it in Params.odr
+	 if(BMP390_Check_ConfigParams(BMP390, BMP390_Config_AutoAdjust) == BMP390_Config_Invalid){
 
-	 BMP390->CONFIG   = ((BMP390->Params.filtercoef)<<1);
+		 return false;
 
-	 BMP390->ODR 	  = (BMP390->Params.odr);
+	 }
+
+	 PWR_CTRL = ((BMP390->Params.mode)<<4) |
+			 	((BMP390->Params.stat_meas_temp)<<1)|
+			 	((BMP390->Params.stat_meas_press)<<0);
+
+	 CONFIG   = ((BMP390->Params.filtercoef)<<1);
+
+	 ODR 	  = (BMP390->Params.odr);
+
+     OSR 	  = ((BMP390->Params.press_osrs)<<0) |
+			    ((BMP390->Params.temp_osrs)<<3);
+
+#endif
+
+	 SLEEP = PWR_CTRL & 0x03;
+
+	 //FIFO and interrupt pin are only written when they are used, they keep their reset values otherwise
+	 if((BMP390->Params.stat_fifo == Enable) || (BMP390->Params.stat_int_drdy == Enable) ||
+		(BMP390->Params.stat_int_fwtm == Enable) || (BMP390->Params.stat_int_fful == Enable)){
+
+		 if(!BMP390_Upload_FifoParams(BMP390)){
+
+			 return false;
+
+		 }
+
+	 }
 
-     BMP390->OSR 	  = ((BMP390->Params.press_osrs)<<0) |
-					    ((BMP390->Params.temp_osrs)<<3);
+	 //Like the Bosch API the sensor sleeps while the settings change and the mode goes last : normal mode checks
+	 //the measurement time against the ODR period whenever a register changes, a half written set gives conf_err
+	 if(BMP390_Bus_Write(BMP390, BMP390_REG_PWR_CTRL, &SLEEP, 1) != BMP390_Bus_OK ||
+		BMP390_Bus_Write(BMP390, BMP390_REG_CONFIG, &CONFIG, 1) != BMP390_Bus_OK ||
+		BMP390_Bus_Write(BMP390, BMP390_REG_ODR, &ODR, 1) != BMP390_Bus_OK ||
+		BMP390_Bus_Write(BMP390, BMP390_REG_OSR, &OSR, 1) != BMP390_Bus_OK ||
+		BMP390_Bus_Write(BMP390, BMP390_REG_PWR_CTRL, &PWR_CTRL, 1) != BMP390_Bus_OK){
 
-	 HAL_I2C_Mem_Write(BMP390->i2c, BMP390->BMP390_I2C_ADDRESS, BMP390_REG_PWR_CTRL , 1, &BMP390->PWR_CTRL, 1, 1000);
-	 HAL_I2C_Mem_Write(BMP390->i2c, BMP390->BMP390_I2C_ADDRESS, BMP390_REG_CONFIG , 1, &BMP390->CONFIG, 1, 1000);
-	 HAL_I2C_Mem_Write(BMP390->i2c, BMP390->BMP390_I2C_ADDRESS, BMP390_REG_ODR , 1, &BMP390->ODR, 1, 1000);
-	 HAL_I2C_Mem_Write(BMP390->i2c, BMP390->BMP390_I2C_ADDRESS, BMP390_REG_OSR , 1, &BMP390->OSR, 1, 1000);
+		 return false;
+
+	 }
+
+	 //Sensortime restarts or changes its step, the next gap says nothing about missed samples
+	 BMP390->Track.primed = false;
+
+	 return BMP390_Get_ErrStatus(BMP390);
+}
+
+_Bool BMP390_Upload_FifoParams(BMP390_HandleTypeDef *BMP390){
+
+	 uint8_t INT_CTRL;		/*! bits: drdy_en[6:6], int_ds[5:5], ffull_en[4:4], fwtm_en[3:3], int_latch[2:2], int_level[1:1], int_od[0:0] */
+	 uint8_t FIFO_WTM_0;	/*! fifo_water_mark[7:0] */
+	 uint8_t FIFO_WTM_1;	/*! fifo_water_mark[8:8] */
+	 uint8_t FIFO_CONFIG_1;	/*! bits: fifo_temp_en[4:4], fifo_press_en[3:3], fifo_time_en[2:2], fifo_stop_on_full[1:1], fifo_mode[0:0] */
+	 uint8_t FIFO_CONFIG_2;	/*! bits: data_select[4:3], fifo_subsampling[2:0] */
+
+	 INT_CTRL      = ((BMP390->Params.stat_int_drdy)<<6) |
+			 	 	 ((BMP390->Params.int_ds)<<5) |
+					 ((BMP390->Params.stat_int_fful)<<4) |
+					 ((BMP390->Params.stat_int_fwtm)<<3) |
+					 ((BMP390->Params.stat_int_latch)<<2) |
+					 ((BMP390->Params.int_level)<<1) |
+					 ((BMP390->Params.int_out)<<0);
+
+	 FIFO_WTM_0    = (uint8_t)(BMP390->Params.fifo_wtm & 0xFF);
+	 FIFO_WTM_1    = (uint8_t)((BMP390->Params.fifo_wtm >> 8) & 0x01);
+
+	 FIFO_CONFIG_1 = ((BMP390->Params.stat_fifo_temp)<<4) |
+			 	 	 ((BMP390->Params.stat_fifo_press)<<3) |
+					 ((BMP390->Params.stat_fifo_time)<<2) |
+					 ((BMP390->Params.stat_fifo_stopFull)<<1) |
+					 ((BMP390->Params.stat_fifo)<<0);
+
+	 FIFO_CONFIG_2 = ((BMP390->Params.fifo_sel)<<3) |
+			 	 	 ((BMP390->Params.fifo_subs)<<0);
+
+	 //The sensor doesn't auto-increment on writes, every register is a transfer of its own
+	 if(BMP390_Bus_Write(BMP390, BMP390_REG_INT_CTRL, &INT_CTRL, 1) != BMP390_Bus_OK ||
+		BMP390_Bus_Write(BMP390, BMP390_REG_FIFO_WTM_0_1, &FIFO_WTM_0, 1) != BMP390_Bus_OK ||
+		BMP390_Bus_Write(BMP390, BMP390_REG_FIFO_WTM_0_1 + 1, &FIFO_WTM_1, 1) != BMP390_Bus_OK ||
+		BMP390_Bus_Write(BMP390, BMP390_REG_FIFO_CONFIG_2, &FIFO_CONFIG_2, 1) != BMP390_Bus_OK ||
+		BMP390_Bus_Write(BMP390, BMP390_REG_FIFO_CONFIG_1, &FIFO_CONFIG_1, 1) != BMP390_Bus_OK){
+
+		 return false;
+
+	 }
 
 	 return true;
 }
 
-_Bool BMP390_Get_RawCalibCoeff(BMP390_HandleTypeDef *BMP390){
+uint32_t BMP390_Calc_MeasTime(const BMP390_Params_t *Params){
+
+	uint32_t measTime = BMP390_MeasTime_Offset;
+
+	if(Params->stat_meas_press == Enable){
+
+		measTime += BMP390_MeasTime_PressOffset + ((uint32_t)BMP390_MeasTime_PerSample << Params->press_osrs);
+
+	}
+
+	if(Params->stat_meas_temp == Enable){
+
+		measTime += BMP390_MeasTime_TempOffset + ((uint32_t)BMP390_MeasTime_PerSample << Params->temp_osrs);
+
+	}
+
+	return measTime;
+}
+
+uint32_t BMP390_Calc_OdrPeriod(BMP390_ODR_TypeDef odr){
+
+	return ((uint32_t)BMP390_OdrPeriod_Base << odr);
+
+}
+
+BMP390_Config_Status_TypeDef BMP390_Check_ConfigParams(BMP390_HandleTypeDef *BMP390, _Bool AutoAdjust){
+
+	BMP390_Config_Status_TypeDef status = BMP390_Config_OK;
+	uint32_t measTime;
+
+	if((BMP390->Params.press_osrs > BMP390_Oversampling_X32) || (BMP390->Params.temp_osrs > BMP390_Oversampling_X32) ||
+	   (BMP390->Params.odr > BMP390_ODR_0p0015) || (BMP390->Params.filtercoef > BMP390_Filter_Coef_127) ||
+	   (BMP390->Params.mode > BMP390_Mode_Normal)){
+
+		return BMP390_Config_Invalid;
+
+	}
+
+	//Sleep and forced mode have no sampling period, the measurement starts on demand
+	if(BMP390->Params.mode != BMP390_Mode_Normal){
+
+		return BMP390_Config_OK;
+
+	}
+
+	measTime = BMP390_Calc_MeasTime(&BMP390->Params);
+
+	while(measTime > BMP390_Calc_OdrPeriod(BMP390->Params.odr)){
+
+		if(!AutoAdjust || (BMP390->Params.odr == BMP390_ODR_0p0015)){
+
+			return BMP390_Config_Invalid;
+
+		}
+
+		BMP390->Params.odr++;
+		status = BMP390_Config_Adjusted;
+
+	}
+
+	return status;
+}
+
+_Bool BMP390_Get_ErrStatus(BMP390_HandleTypeDef *BMP390){
+
+	if(BMP390_Bus_Read(BMP390, BMP390_REG_ERR, &BMP390->ERR, 1) != BMP390_Bus_OK){
+
+		return false;
+
+	}
+
+	return ((BMP390->ERR & (BMP390_Error_Fatal | BMP390_Error_Command | BMP390_Error_Configuration)) == 0);
+
+}
+
+_Bool BMP390_Get_RawCalibCoeff(BMP390_HandleTypeDef *BMP390, BMP390_RawCalibData_TypeDef *Raw_NVM){
 
 	uint8_t BMP390_CalibCoeff[21];
 	uint8_t cnt = 0;
 
-	HAL_I2C_Mem_Read(BMP390->i2c, BMP390->BMP390_I2C_ADDRESS, BMP390_StartAdd_CalibCoeff, 1, &BMP390_CalibCoeff[0], 21, 1000);
-
-	BMP390->Raw_NVM.T1  = (uint16_t)((BMP390_CalibCoeff[cnt]) | (BMP390_CalibCoeff[cnt+1]<<8));  cnt+=2;
-	BMP390->Raw_NVM.T2  = (uint16_t)((BMP390_CalibCoeff[cnt]) | (BMP390_CalibCoeff[cnt+1]<<8));  cnt+=2;
-	BMP390->Raw_NVM.T3  = (int8_t)((BMP390_CalibCoeff[cnt])); 								     cnt+=1;
-	BMP390->Raw_NVM.P1  = (int16_t)((BMP390_CalibCoeff[cnt])  | (BMP390_CalibCoeff[cnt+1]<<8));  cnt+=2;
-	BMP390->Raw_NVM.P2  = (int16_t)((BMP390_CalibCoeff[cnt])  | (BMP390_CalibCoeff[cnt+1]<<8));  cnt+=2;
-	BMP390->Raw_NVM.P3  = (int8_t)((BMP390_CalibCoeff[cnt])); 								     cnt+=1;
-	BMP390->Raw_NVM.P4  = (int8_t)((BMP390_CalibCoeff[cnt])); 								     cnt+=1;
-	BMP390->Raw_NVM.P5  = (uint16_t)((BMP390_CalibCoeff[cnt]) | (BMP390_CalibCoeff[cnt+1]<<8));  cnt+=2;
-	BMP390->Raw_NVM.P6  = (uint16_t)((BMP390_CalibCoeff[cnt]) | (BMP390_CalibCoeff[cnt+1]<<8));  cnt+=2;
-	BMP390->Raw_NVM.P7  = (int8_t)((BMP390_CalibCoeff[cnt])); 									 cnt+=1;
-	BMP390->Raw_NVM.P8  = (int8_t)((BMP390_CalibCoeff[cnt]));  									 cnt+=1;
-	BMP390->Raw_NVM.P9  = (int16_t)((BMP390_CalibCoeff[cnt])  | (BMP390_CalibCoeff[cnt+1]<<8));  cnt+=2;
-	BMP390->Raw_NVM.P10 = (int8_t)((BMP390_CalibCoeff[cnt])); 									 cnt+=1;
-	BMP390->Raw_NVM.P11 = (int8_t)((BMP390_CalibCoeff[cnt]));
+	if(BMP390_Bus_Read(BMP390, BMP390_StartAdd_CalibCoeff, &BMP390_CalibCoeff[0], 21) != BMP390_Bus_OK){
+
+		return false;
+
+	}
+
+	Raw_NVM->T1  = (uint16_t)((BMP390_CalibCoeff[cnt]) | (BMP390_CalibCoeff[cnt+1]<<8));  cnt+=2;
+	Raw_NVM->T2  = (uint16_t)((BMP390_CalibCoeff[cnt]) | (BMP390_CalibCoeff[cnt+1]<<8));  cnt+=2;
+	Raw_NVM->T3  = (int8_t)((BMP390_CalibCoeff[cnt])); 								     cnt+=1;
+	Raw_NVM->P1  = (int16_t)((BMP390_CalibCoeff[cnt])  | (BMP390_CalibCoeff[cnt+1]<<8));  cnt+=2;
+	Raw_NVM->P2  = (int16_t)((BMP390_CalibCoeff[cnt])  | (BMP390_CalibCoeff[cnt+1]<<8));  cnt+=2;
+	Raw_NVM->P3  = (int8_t)((BMP390_CalibCoeff[cnt])); 								     cnt+=1;
+	Raw_NVM->P4  = (int8_t)((BMP390_CalibCoeff[cnt])); 								     cnt+=1;
+	Raw_NVM->P5  = (uint16_t)((BMP390_CalibCoeff[cnt]) | (BMP390_CalibCoeff[cnt+1]<<8));  cnt+=2;
+	Raw_NVM->P6  = (uint16_t)((BMP390_CalibCoeff[cnt]) | (BMP390_CalibCoeff[cnt+1]<<8));  cnt+=2;
+	Raw_NVM->P7  = (int8_t)((BMP390_CalibCoeff[cnt])); 									 cnt+=1;
+	Raw_NVM->P8  = (int8_t)((BMP390_CalibCoeff[cnt]));  									 cnt+=1;
+	Raw_NVM->P9  = (int16_t)((BMP390_CalibCoeff[cnt])  | (BMP390_CalibCoeff[cnt+1]<<8));  cnt+=2;
+	Raw_NVM->P10 = (int8_t)((BMP390_CalibCoeff[cnt])); 									 cnt+=1;
+	Raw_NVM->P11 = (int8_t)((BMP390_CalibCoeff[cnt]));
 
 	return true;
 
 }
 
-_Bool BMP390_Calc_PrcsdCalibrationCoeff(BMP390_HandleTypeDef *BMP390){
-
-	BMP390->Prcsd_NVM.T1 = (BMP390->Raw_NVM.T1 / pow(2,-8));
-	BMP390->Prcsd_NVM.T2 = (BMP390->Raw_NVM.T2 / pow(2,30));
-	BMP390->Prcsd_NVM.T3 = (BMP390->Raw_NVM.T3 / pow(2,48));
-	BMP390->Prcsd_NVM.P1 = ((BMP390->Raw_NVM.P1 - pow(2,14)) / pow(2,20));
-	BMP390->Prcsd_NVM.P2 = ((BMP390->Raw_NVM.P2 - pow(2,14)) / pow(2,29));
-	BMP390->Prcsd_NVM.P3 = (BMP390->Raw_NVM.P3 / pow(2,32));
-	BMP390->Prcsd_NVM.P4 = (BMP390->Raw_NVM.P4 / pow(2,37));
-	BMP390->Prcsd_NVM.P5 = (BMP390->Raw_NVM.P5 / pow(2,-3));
-	BMP390->Prcsd_NVM.P6 = (BMP390->Raw_NVM.P6 / pow(2,6));
-	BMP390->Prcsd_NVM.P7 = (BMP390->Raw_NVM.P7 / pow(2,8));
-	BMP390->Prcsd_NVM.P8 = (BMP390->Raw_NVM.P8 / pow(2,15));
-	BMP390->Prcsd_NVM.P9 = (BMP390->Raw_NVM.P9 / pow(2,48));
-	BMP390->Prcsd_NVM.P10 = (BMP390->Raw_NVM.P10 / pow(2,48));
-	BMP390->Prcsd_NVM.P11 = (BMP390->Raw_NVM.P11 / pow(2,65));
+_Bool BMP390_Calc_PrcsdCalibrationCoeff(BMP390_HandleTypeDef *BMP390, const BMP390_RawCalibData_TypeDef *Raw_NVM){
+
+	BMP390->Prcsd_NVM.T1 = (Raw_NVM->T1 / pow(2,-8));
+	BMP390->Prcsd_NVM.T2 = (Raw_NVM->T2 / pow(2,30));
+	BMP390->Prcsd_NVM.T3 = (Raw_NVM->T3 / pow(2,48));
+	BMP390->Prcsd_NVM.P1 = ((Raw_NVM->P1 - pow(2,14)) / pow(2,20));
+	BMP390->Prcsd_NVM.P2 = ((Raw_NVM->P2 - pow(2,14)) / pow(2,29));
+	BMP390->Prcsd_NVM.P3 = (Raw_NVM->P3 / pow(2,32));
+	BMP390->Prcsd_NVM.P4 = (Raw_NVM->P4 / pow(2,37));
+	BMP390->Prcsd_NVM.P5 = (Raw_NVM->P5 / pow(2,-3));
+	BMP390->Prcsd_NVM.P6 = (Raw_NVM->P6 / pow(2,6));
+	BMP390->Prcsd_NVM.P7 = (Raw_NVM->P7 / pow(2,8));
+	BMP390->Prcsd_NVM.P8 = (Raw_NVM->P8 / pow(2,15));
+	BMP390->Prcsd_NVM.P9 = (Raw_NVM->P9 / pow(2,48));
+	BMP390->Prcsd_NVM.P10 = (Raw_NVM->P10 / pow(2,48));
+	BMP390->Prcsd_NVM.P11 = (Raw_NVM->P11 / pow(2,65));
 
 	return true;
 }
 
 _Bool BMP390_Set_DefaultParams(BMP390_HandleTypeDef *BMP390){
 
+#ifdef BMP390_STATIC_CONFIG
+	BMP390->Params.mode = BMP390_CONF_MODE;
+	BMP390->Params.stat_meas_press = BMP390_CONF_MEAS_PRESS;
+	BMP390->Params.stat_meas_temp = BMP390_CONF_MEAS_TEMP;
+	BMP390->Params.press_osrs = BMP390_CONF_PRESS_OSRS;
+	BMP390->Params.temp_osrs = BMP390_CONF_TEMP_OSRS;
+	BMP390->Params.filtercoef = BMP390_CONF_FILTERCOEF;
+	BMP390->Params.odr = BMP390_CONF_ODR;
+#else
 	BMP390->Params.mode = BMP390_Mode_Normal;
 	BMP390->Params.stat_meas_press = Enable;
 	BMP390->Params.stat_meas_temp = Enable;
@@ -171,6 +369,7 @@ _Bool BMP390_Set_DefaultParams(BMP390_HandleTypeDef *BMP390){
 	BMP390->Params.temp_osrs= BMP390_Oversampling_X2 ;
 	BMP390->Params.filtercoef = BMP390_Filter_Coef_3;
 	BMP390->Params.odr = BMP390_ODR_50;
+#endif
 
 	return true;
 }
@@ -181,43 +380,179 @@ _Bool BMP390_Get_SensorValues(BMP390_HandleTypeDef *BMP390, float *BMP390_Press,
 							 float *BMP390_VertAcc, float *BMP390_VertSpd,
 							 float *BMP390_gForce){
 
-	uint32_t rawPress;
-	uint32_t rawTemp;
-	uint8_t MSB_LSB_XLSB_PT[6] = {0};
+	BMP390_Sample_TypeDef sample;
+
+	if(!BMP390_Read_Sample(BMP390, TotalMass, &sample)){
+
+		return false;
+
+	}
+
+	*BMP390_Temp  	= sample.temp;
+	*BMP390_Press 	= sample.press;
+	*BMP390_VertAlt = sample.vertAlt;
+	*BMP390_VertSpd = sample.vertSpd;
+	*BMP390_VertAcc = sample.vertAcc;
+	*BMP390_gForce  = sample.gForce;
+
+	return true;
+}
+
+
+_Bool BMP390_Read_Sample(BMP390_HandleTypeDef *BMP390_Restrict BMP390, float totalMass, BMP390_Sample_TypeDef *BMP390_Restrict Sample){
+
+	BMP390_RawFrame_TypeDef frame;
+	uint32_t start = HAL_GetTick();
+	uint32_t wait = (BMP390_Calc_OdrPeriod(BMP390->Params.odr) / 1000) + 2;
+
+	//The data registers are polled until a new conversion comes, a repeated read costs one burst but no compensation
+	while(!BMP390_Read_RawFrame(BMP390, &frame, NULL)){
+
+		if((HAL_GetTick() - start) > wait){
+
+			return false;
+
+		}
+
+	}
+
+	Sample->timestamp = HAL_GetTick();
+
+	return BMP390_Process_RawData(BMP390, frame.rawPress, frame.rawTemp, totalMass, Sample);
+}
 
-	HAL_I2C_Mem_Read(BMP390->i2c, BMP390->BMP390_I2C_ADDRESS, BMP390_StartAdd_MSB_LSB_XLSB_PT, 1, &MSB_LSB_XLSB_PT[6], 6, 10000);
 
-	rawPress = ((MSB_LSB_XLSB_PT[2])<<16)  | ((MSB_LSB_XLSB_PT[1])<<8) | ((MSB_LSB_XLSB_PT[0])<<0);
-	rawTemp  = ((MSB_LSB_XLSB_PT[5])<<16)  | ((MSB_LSB_XLSB_PT[4])<<8) | ((MSB_LSB_XLSB_PT[3])<<0);
+_Bool BMP390_Read_RawFrame(BMP390_HandleTypeDef *BMP390, BMP390_RawFrame_TypeDef *Frame, BMP390_StatusRegs_TypeDef *Regs){
 
+	uint8_t ERR_TO_INT_STATUS[BMP390_RawFrame_Len] = {0};
+	BMP390_StatusRegs_TypeDef regs;
 
-	*BMP390_Temp  	= BMP390_Calc_PrcsdTemp(BMP390,rawTemp);
-	*BMP390_Press 	= BMP390_Calc_PrcsdPress(BMP390,rawPress,BMP390_Temp);
-	*BMP390_VertAlt = BMP390_Calc_VertAlt(BMP390, BMP390_Press);
+	//5 more bytes than DATA..SENSORTIME alone, cheaper than a separate transfer for ERR and EVENT
+	if(BMP390_Bus_Read(BMP390, BMP390_StartAdd_Frame, &ERR_TO_INT_STATUS[0], BMP390_RawFrame_Len) != BMP390_Bus_OK){
 
-	BMP390_Calc_VertSpd(BMP390, BMP390_VertAlt,BMP390_VertSpd);
-	BMP390_Calc_VertAcc(BMP390, BMP390_VertSpd, BMP390_VertAcc);
-	BMP390_Calc_gForce(BMP390, BMP390_gForce, &TotalMass, BMP390_VertAcc);
+		return false;
 
+	}
+
+	regs.err       = ERR_TO_INT_STATUS[0];
+	regs.status    = ERR_TO_INT_STATUS[1];
+	regs.event     = ERR_TO_INT_STATUS[14];
+	regs.intStatus = ERR_TO_INT_STATUS[15];
+
+	Frame->rawPress   = ((ERR_TO_INT_STATUS[4])<<16)  | ((ERR_TO_INT_STATUS[3])<<8)  | ((ERR_TO_INT_STATUS[2])<<0);
+	Frame->rawTemp    = ((ERR_TO_INT_STATUS[7])<<16)  | ((ERR_TO_INT_STATUS[6])<<8)  | ((ERR_TO_INT_STATUS[5])<<0);
+	Frame->sensortime = ((ERR_TO_INT_STATUS[12])<<16) | ((ERR_TO_INT_STATUS[11])<<8) | ((ERR_TO_INT_STATUS[10])<<0);
+
+	if(Regs != NULL){
+
+		*Regs = regs;
+
+	}
+
+	if(!BMP390_Health_Check(BMP390, &regs)){
+
+		return false;
+
+	}
+
+	return BMP390_Track_Frame(&BMP390->Track, &BMP390->Params, Frame, &regs);
+}
+
+
+_Bool BMP390_Track_Frame(BMP390_FrameTrack_TypeDef *Track, const BMP390_Params_t *Params,
+						 const BMP390_RawFrame_TypeDef *Frame, const BMP390_StatusRegs_TypeDef *Regs){
+
+	uint8_t drdy = ((Params->stat_meas_press == Enable) ? BMP390_drdy_Press : 0) |
+				   ((Params->stat_meas_temp == Enable) ? BMP390_drdy_Temp : 0);
+	uint32_t step, gap, periods;
+
+	if((Regs->status & drdy) == 0){
+
+		Track->duplicates++;
+		return false;
+
+	}
+
+	//In normal mode a conversion comes every period, a gap of n periods means n - 1 were overwritten unread
+	if(Track->primed && (Params->mode == BMP390_Mode_Normal)){
+
+		step = (uint32_t)BMP390_Sensortime_OdrStep << Params->odr;
+		gap = (Frame->sensortime - Track->sensortime) & BMP390_Sensortime_Mask;
+		periods = (gap + (step / 2)) / step;
+
+		if(periods > 1){
+
+			Track->missed += periods - 1;
+
+		}
+
+	}
+
+	Track->sensortime = Frame->sensortime;
+	Track->primed = true;
 
 	return true;
 }
 
 
-float BMP390_Calc_PrcsdTemp(BMP390_HandleTypeDef *BMP390, uint32_t rawTemp){
+_Bool BMP390_Soft_Reset(BMP390_HandleTypeDef *BMP390){
+
+	uint8_t CMD = BMP390_CMD_Softreset;
+
+	if(BMP390_Bus_Write(BMP390, BMP390_REG_CMD, &CMD, 1) != BMP390_Bus_OK){
+
+		return false;
+
+	}
+
+	HAL_Delay(BMP390_StartupTime);
+
+	return true;
+}
+
+
+_Bool BMP390_Process_RawData(BMP390_HandleTypeDef *BMP390_Restrict BMP390, uint32_t rawPress, uint32_t rawTemp,
+							 float totalMass, BMP390_Sample_TypeDef *BMP390_Restrict Sample){
+
+	//Every stage works on values, the handle is only touched to keep the previous altitude, speed and timestamp
+	uint32_t elapsed = Sample->timestamp - BMP390->DeltaData.t0;
+	float perSec  = (elapsed != 0) ? (1000.0f / (float)elapsed) : 1.0f;
+	float temp    = BMP390_Comp_Temp(&BMP390->Prcsd_NVM, rawTemp);
+	float press   = BMP390_Comp_Press(&BMP390->Prcsd_NVM, rawPress, temp);
+	float vertAlt = BMP390_Comp_VertAlt(press, BMP390->FixedAltitude);
+	float vertSpd = BMP390_Comp_Delta(vertAlt, BMP390->DeltaData.alt0) * perSec;
+	float vertAcc = BMP390_Comp_Delta(vertSpd, BMP390->DeltaData.spd0) * perSec;
+
+	BMP390->DeltaData.alt0 = vertAlt;
+	BMP390->DeltaData.spd0 = vertSpd;
+	BMP390->DeltaData.t0 = Sample->timestamp;
+
+	Sample->temp    = temp;
+	Sample->press   = press;
+	Sample->vertAlt = vertAlt;
+	Sample->vertSpd = vertSpd;
+	Sample->vertAcc = vertAcc;
+	Sample->gForce  = BMP390_Comp_gForce(vertAcc, totalMass);
+
+	return true;
+}
+
+
+float BMP390_Comp_Temp(const BMP390_PrcsdCalibData_TypeDef *Calib, uint32_t rawTemp){
 
 	float partial_data1;
 	float partial_data2;
 
 
-	partial_data1 = (float)(rawTemp - BMP390->Prcsd_NVM.T1);
-	partial_data2 = (float)(partial_data1 * BMP390->Prcsd_NVM.T2);
+	partial_data1 = (float)(rawTemp - Calib->T1);
+	partial_data2 = (float)(partial_data1 * Calib->T2);
 
-	return (partial_data2 + (partial_data1 * partial_data1) * BMP390->Prcsd_NVM.T3);
+	return (partial_data2 + (partial_data1 * partial_data1) * Calib->T3);
 
 }
 
-float BMP390_Calc_PrcsdPress(BMP390_HandleTypeDef *BMP390, uint32_t rawPress, float *BMP390_Temp){
+
+float BMP390_Comp_Press(const BMP390_PrcsdCalibData_TypeDef *Calib, uint32_t rawPress, float temp){
 
 	float partial_data1;
 	float partial_data2;
@@ -227,29 +562,63 @@ float BMP390_Calc_PrcsdPress(BMP390_HandleTypeDef *BMP390, uint32_t rawPress, fl
 	float partial_out2;
 
 
-	partial_data1 = BMP390->Prcsd_NVM.P6 * (*(BMP390_Temp));
-	partial_data2 = BMP390->Prcsd_NVM.P7 * ((*(BMP390_Temp)) * (*(BMP390_Temp)));
-	partial_data3 = BMP390->Prcsd_NVM.P8 * ((*(BMP390_Temp)) * (*(BMP390_Temp)) * (*(BMP390_Temp)));
-	partial_out1 =  BMP390->Prcsd_NVM.P5 + partial_data1 + partial_data2 + partial_data3;
-	partial_data1 = BMP390->Prcsd_NVM.P2 * (*(BMP390_Temp));
-	partial_data2 = BMP390->Prcsd_NVM.P3 * ((*(BMP390_Temp)) * (*(BMP390_Temp)));
-	partial_data3 = BMP390->Prcsd_NVM.P4 * ((*(BMP390_Temp)) * (*(BMP390_Temp)) * (*(BMP390_Temp)));
-	partial_out2 = (float)rawPress * (BMP390->Prcsd_NVM.P1 + partial_data1 + partial_data2 + partial_data3);
+	partial_data1 = Calib->P6 * temp;
+	partial_data2 = Calib->P7 * (temp * temp);
+	partial_data3 = Calib->P8 * (temp * temp * temp);
+	partial_out1 =  Calib->P5 + partial_data1 + partial_data2 + partial_data3;
+	partial_data1 = Calib->P2 * temp;
+	partial_data2 = Calib->P3 * (temp * temp);
+	partial_data3 = Calib->P4 * (temp * temp * temp);
+	partial_out2 = (float)rawPress * (Calib->P1 + partial_data1 + partial_data2 + partial_data3);
 	partial_data1 = (float)rawPress * (float)rawPress;
-	partial_data2 = BMP390->Prcsd_NVM.P9 + BMP390->Prcsd_NVM.P10 * (*(BMP390_Temp));
+	partial_data2 = Calib->P9 + Calib->P10 * temp;
 	partial_data3 = partial_data1 * partial_data2;
-	partial_data4 = partial_data3 + ((float)rawPress * (float)rawPress * (float)rawPress) * BMP390->Prcsd_NVM.P11;
+	partial_data4 = partial_data3 + ((float)rawPress * (float)rawPress * (float)rawPress) * Calib->P11;
 
 	return partial_out1 + partial_out2 + partial_data4;
 
 }
 
 
-float BMP390_Calc_VertAlt(BMP390_HandleTypeDef *BMP390, float *BMP390_Press){
+float BMP390_Comp_VertAlt(float press, float fixedAltitude){
 
 	return (((SeaLevelTemp / GradientTemp)
-			* (1 - pow((*BMP390_Press / SeaLevelPress),((GasCoefficient * GradientTemp)/GravityAccel))))
-			- (BMP390->FixedAltitude));
+			* (1 - pow((press / SeaLevelPress),((GasCoefficient * GradientTemp)/GravityAccel))))
+			- (fixedAltitude));
+
+}
+
+
+float BMP390_Comp_Delta(float now, float prev){
+
+	return (now - prev);
+
+}
+
+
+float BMP390_Comp_gForce(float vertAcc, float totalMass){
+
+	return ((vertAcc/GravityAccel)*totalMass);
+
+}
+
+
+float BMP390_Calc_PrcsdTemp(BMP390_HandleTypeDef *BMP390, uint32_t rawTemp){
+
+	return BMP390_Comp_Temp(&BMP390->Prcsd_NVM, rawTemp);
+
+}
+
+float BMP390_Calc_PrcsdPress(BMP390_HandleTypeDef *BMP390, uint32_t rawPress, float *BMP390_Temp){
+
+	return BMP390_Comp_Press(&BMP390->Prcsd_NVM, rawPress, *BMP390_Temp);
+
+}
+
+
+float BMP390_Calc_VertAlt(BMP390_HandleTypeDef *BMP390, float *BMP390_Press){
+
+	return BMP390_Comp_VertAlt(*BMP390_Press, BMP390->FixedAltitude);
 
 }
 
@@ -257,18 +626,23 @@ float BMP390_Calc_VertAlt(BMP390_HandleTypeDef *BMP390, float *BMP390_Press){
 float BMP390_Calc_TemporaryAltitude(BMP390_HandleTypeDef *BMP390, float *BMP390_VertAlt){
 
 	 float tempAltitude = 0;
+	 uint8_t samples = 0;
+
 	 for(int cnt = 0 ; cnt < 20 ; cnt++){
 
-		 BMP390_Get_SensorValues(BMP390, &BMP390_Press,
-			  		  	  	  	 &BMP390_Temp, BMP390_VertAlt,
-			  					 &BMP390_VertAcc, &BMP390_VertSpd,
-			  					 &BMP390_gForce);
+		 if(BMP390_Get_SensorValues(BMP390, &BMP390_Press,
+			  		  	  	  	    &BMP390_Temp, BMP390_VertAlt,
+			  					    &BMP390_VertAcc, &BMP390_VertSpd,
+			  					    &BMP390_gForce)){
+
+			 tempAltitude = (float)(tempAltitude + (*BMP390_VertAlt));
+			 samples++;
 
-		 tempAltitude = (float)(tempAltitude + (float)((*BMP390_VertAlt) * (0.05)));
+		 }
 
 	  }
 
-	 return tempAltitude;
+	 return (samples != 0) ? (tempAltitude / samples) : 0.0f;
 
 }
 
@@ -276,25 +650,79 @@ float BMP390_Calc_TemporaryAltitude(BMP390_HandleTypeDef *BMP390, float *BMP390_
 //Yükseklik değişimi ile hız hesabı,// V = (X1 - X0)/gerçek 1 saniye hızı verecek
 float BMP390_Calc_VertSpd(BMP390_HandleTypeDef *BMP390, float *BMP390_VertAlt, float *BMP390_VertSpd){
 
-	BMP390->DeltaData.alt1 = (*BMP390_VertAlt);//gelen irtifa  verisini x1 e at
-	(*BMP390_VertSpd) 	   = (BMP390->DeltaData.alt1 - BMP390->DeltaData.alt0); // Verilerin farkını al ve hız değeri elde et
-	BMP390->DeltaData.alt0 = BMP390->DeltaData.alt1; // artık yeni konum x0 x1'İn değerini alarak bir basamak daha çıktı
+	(*BMP390_VertSpd) 	   = BMP390_Comp_Delta((*BMP390_VertAlt), BMP390->DeltaData.alt0); // Verilerin farkını al ve hız değeri elde et
+	BMP390->DeltaData.alt0 = (*BMP390_VertAlt); // artık yeni konum x0 x1'İn değerini alarak bir basamak daha çıktı
+
+	return (*BMP390_VertSpd);
 
 }
 
 
 float BMP390_Calc_VertAcc(BMP390_HandleTypeDef *BMP390, float *BMP390_VertSpd, float *BMP390_VertAcc){
 
-	BMP390->DeltaData.spd1 = (*BMP390_VertSpd);
-	*BMP390_VertAcc		   = (BMP390->DeltaData.spd1 - BMP390->DeltaData.spd0);
-	BMP390->DeltaData.spd0 = BMP390->DeltaData.spd1;
+	*BMP390_VertAcc		   = BMP390_Comp_Delta((*BMP390_VertSpd), BMP390->DeltaData.spd0);
+	BMP390->DeltaData.spd0 = (*BMP390_VertSpd);
+
+	return (*BMP390_VertAcc);
 
 }
 
 
 float BMP390_Calc_gForce(BMP390_HandleTypeDef *BMP390,  float *BMP390_gForce, float *TotalMass, float *BMP390_VertAcc){
 
-	(*BMP390_gForce ) = (((*BMP390_VertAcc)/GravityAccel)*(*TotalMass));
+	(void)BMP390;	//The g force needs no state, the handle keeps the signature of the other BMP390_Calc_ functions
+	(*BMP390_gForce ) = BMP390_Comp_gForce((*BMP390_VertAcc), (*TotalMass));
+
+	return (*BMP390_gForce);
+
+}
+
+
+void BMP390_Publish_Sample(BMP390_SampleSeqlock_TypeDef *Latest, const BMP390_Sample_TypeDef *Sample){
+
+	Latest->seq++;		//Odd, readers will retry
+	__DMB();
+
+	Latest->sample = *Sample;
+
+	__DMB();
+	Latest->seq++;		//Even, the sample is consistent again
+
+}
+
+
+uint32_t BMP390_Read_LatestSample(const BMP390_SampleSeqlock_TypeDef *Latest, BMP390_Sample_TypeDef *Sample){
+
+	uint32_t seq;
+
+	do{
+
+		do{
+			seq = Latest->seq;
+		}while(seq & 1);
+
+		__DMB();
+		*Sample = Latest->sample;
+		__DMB();
+
+	}while(seq != Latest->seq);
+
+	return seq;
+}
+
+
+#if defined(__arm__)
+
+uint32_t BMP390_Cycles(void){
+
+	if((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0){
+
+		CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+		DWT->CYCCNT = 0;
+		DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	}
 
+	return DWT->CYCCNT;
 }
 
+#endif
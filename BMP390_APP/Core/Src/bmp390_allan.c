@@ -0,0 +1,136 @@
+/*!
+ *  @file : bmp390_allan.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * NOTE ==> With the running sum S of the samples, the overlapping Allan variance at tau = m * tau0 is
+ *
+ * 			AVAR(m) = sum over i of (S[i] - 2 S[i-m] + S[i-2m])^2 / (2 m^2 (N - 2m))
+ *
+ * 			so every new sample adds one term per octave and only the last 2 * MaxM sums have to be kept.
+ * 			tau0 cancels out, the result is in the unit of the samples.
+ */
+
+#include "bmp390_allan.h"
+#include "string.h"
+
+
+static void BMP390_Allan_AddChannel(BMP390_AllanChannel_TypeDef *Ch, uint32_t n, float value);
+
+
+void BMP390_Allan_Init(BMP390_Allan_TypeDef *Allan, uint16_t tau0){
+
+	//S[0] = 0 is the first ring entry
+	memset(Allan, 0, sizeof(*Allan));
+
+	Allan->tau0 = tau0;
+}
+
+
+void BMP390_Allan_Add(BMP390_Allan_TypeDef *Allan, float press, float alt){
+
+	uint32_t n = Allan->n + 1;
+
+	BMP390_Allan_AddChannel(&Allan->press, n, press);
+	BMP390_Allan_AddChannel(&Allan->alt, n, alt);
+
+	Allan->n = n;
+}
+
+
+float BMP390_Allan_Deviation(const BMP390_Allan_TypeDef *Allan, BMP390_Allan_Channel_TypeDef channel, uint8_t octave){
+
+	const BMP390_AllanChannel_TypeDef *Ch = (channel == BMP390_Allan_Press) ? &Allan->press : &Allan->alt;
+	float m = (float)(1u << octave);
+
+	if(octave >= BMP390_Allan_Octaves || Ch->terms[octave] == 0){
+
+		return 0.0f;
+	}
+
+	return sqrtf((float)Ch->sq[octave] / (2.0f * m * m * (float)Ch->terms[octave])) / BMP390_Allan_Scale;
+}
+
+
+_Bool BMP390_Allan_Report(const BMP390_Allan_TypeDef *Allan, BMP390_Telemetry_TypeDef *Tlm){
+
+	uint8_t payload[8 + (4 * BMP390_Allan_Octaves)];
+	_Bool ok = true;
+
+	BMP390_StaticAssert(sizeof(payload) <= BMP390_Tlm_MaxPayload, "Allan packet doesn't fit into a telemetry frame");
+
+	for(uint8_t channel = BMP390_Allan_Press; channel <= BMP390_Allan_Alt; channel++){
+
+		payload[0] = channel;
+		payload[1] = BMP390_Allan_Octaves;
+		memcpy(&payload[2], &Allan->tau0, 2);
+		memcpy(&payload[4], &Allan->n, 4);
+
+		for(uint8_t k = 0; k < BMP390_Allan_Octaves; k++){
+
+			float adev = BMP390_Allan_Deviation(Allan, channel, k);
+			memcpy(&payload[8 + (4 * k)], &adev, 4);
+		}
+
+		ok &= BMP390_Telemetry_Send(Tlm, BMP390_Tlm_Allan, payload, sizeof(payload));
+	}
+
+	return ok;
+}
+
+
+static void BMP390_Allan_AddChannel(BMP390_AllanChannel_TypeDef *Ch, uint32_t n, float value){
+
+	float fixed = value * BMP390_Allan_Scale;
+
+	//Rounded, a cast would truncate toward 0 and shrink every difference across 0 (the altitude on the pad)
+	Ch->sum += (uint32_t)(int32_t)((fixed >= 0.0f) ? (fixed + 0.5f) : (fixed - 0.5f));
+
+	for(uint8_t k = 0; k < BMP390_Allan_Octaves; k++){
+
+		uint32_t m = 1u << k;
+		int32_t d;
+
+		if((2 * m) > n){
+
+			break;
+		}
+
+		//For 2m = RingLen, S[n - 2m] is still in the slot that S[n] is going to overwrite
+		d = (int32_t)(Ch->sum - (2u * Ch->ring[(n - m) % BMP390_Allan_RingLen]) + Ch->ring[(n - (2 * m)) % BMP390_Allan_RingLen]);
+
+		Ch->sq[k] += (uint64_t)((int64_t)d * d);
+		Ch->terms[k]++;
+	}
+
+	Ch->ring[n % BMP390_Allan_RingLen] = Ch->sum;
+}
@@ -0,0 +1,227 @@
+/*!
+ *  @file : bmp390_bus.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * NOTE ==> Every register transfer of the driver goes through here. The timeouts are a few ms instead of
+ * 			seconds, so a glitch costs the timer interrupt one sample. A stuck bus is cleared and the sensor
+ * 			configuration is uploaded again right away, the next sample is read normally.
+ */
+
+#include "bmp390_bus.h"
+
+
+#define BMP390_Bus_HalfClock		5		/*! us, bus clear clock of 100 kHz */
+
+BMP390_Bus_Stats_TypeDef BMP390_Bus_Stats;
+
+static volatile uint8_t BMP390_Bus_Recovering;
+
+static BMP390_Bus_Status_TypeDef BMP390_Bus_Transfer(BMP390_HandleTypeDef *BMP390, uint8_t reg, uint8_t *data, uint16_t len, _Bool write);
+static void BMP390_Bus_Clear(void);
+static void BMP390_Bus_DelayUs(uint32_t us);
+
+
+BMP390_Bus_Status_TypeDef BMP390_Bus_Read(BMP390_HandleTypeDef *BMP390, uint8_t reg, uint8_t *data, uint16_t len){
+
+	return BMP390_Bus_Transfer(BMP390, reg, data, len, false);
+}
+
+
+BMP390_Bus_Status_TypeDef BMP390_Bus_Write(BMP390_HandleTypeDef *BMP390, uint8_t reg, uint8_t *data, uint16_t len){
+
+	return BMP390_Bus_Transfer(BMP390, reg, data, len, true);
+}
+
+
+uint32_t BMP390_Bus_CalcTimeout(const I2C_HandleTypeDef *i2c, uint16_t len){
+
+	uint32_t clock = (i2c->Init.ClockSpeed != 0) ? i2c->Init.ClockSpeed : 100000;
+	uint32_t bits = ((uint32_t)len + 3) * 9;
+	uint32_t us = (bits * 1000000u) / clock;
+	uint32_t ms = ((us * BMP390_Bus_TimeoutFactor) + 999) / 1000;
+
+	//HAL_GetTick counts whole ms, one more tick covers a transfer that starts just before a tick
+	return (ms < 1) ? 2 : (ms + 1);
+}
+
+
+BMP390_Bus_Status_TypeDef BMP390_Bus_Classify(HAL_StatusTypeDef status, uint32_t error){
+
+	if(status == HAL_OK){
+
+		return BMP390_Bus_OK;
+	}
+
+	if(error & HAL_I2C_ERROR_BERR)    return BMP390_Bus_BusError;
+	if(error & HAL_I2C_ERROR_ARLO)    return BMP390_Bus_ArbLost;
+	if(error & HAL_I2C_ERROR_AF)      return BMP390_Bus_Nack;
+	if(error & HAL_I2C_ERROR_TIMEOUT) return BMP390_Bus_Timeout;
+
+	return (status == HAL_BUSY) ? BMP390_Bus_Busy : (status == HAL_TIMEOUT) ? BMP390_Bus_Timeout : BMP390_Bus_Other;
+}
+
+
+_Bool BMP390_Bus_Recover(BMP390_HandleTypeDef *BMP390){
+
+	uint32_t start = HAL_GetTick();
+	uint32_t elapsed;
+	_Bool ok;
+
+	BMP390_Bus_Recovering = true;
+	BMP390_Bus_Stats.recoveries++;
+
+	HAL_I2C_DeInit(BMP390->i2c);
+
+	BMP390_Bus_Clear();
+
+	//HAL_I2C_Init pulses SWRST, that also releases a BUSY the STM32F1 errata leaves latched
+	ok = (HAL_I2C_Init(BMP390->i2c) == HAL_OK);
+
+	//A glitch can also have reset the sensor, its configuration is written again from Params
+	ok = ok && BMP390_Upload_ConfigParams(BMP390);
+
+	if(!ok){
+
+		BMP390_Bus_Stats.failedRecoveries++;
+	}
+
+	elapsed = HAL_GetTick() - start;
+
+	if(elapsed > BMP390_Bus_Stats.maxRecoveryTime){
+
+		BMP390_Bus_Stats.maxRecoveryTime = elapsed;
+	}
+
+	BMP390_Bus_Recovering = false;
+
+	return ok;
+}
+
+
+static BMP390_Bus_Status_TypeDef BMP390_Bus_Transfer(BMP390_HandleTypeDef *BMP390, uint8_t reg, uint8_t *data, uint16_t len, _Bool write){
+
+	uint32_t timeout = BMP390_Bus_CalcTimeout(BMP390->i2c, len);
+	BMP390_Bus_Status_TypeDef bus;
+	HAL_StatusTypeDef status;
+
+	BMP390_Bus_Stats.transfers++;
+
+	//HAL waits 25 ms for BUSY to clear before the START, a bus that is already stuck is reset at once
+	if(BMP390->i2c->Instance->SR2 & I2C_SR2_BUSY){
+
+		bus = BMP390_Bus_Busy;
+	}
+	else{
+
+		status = write ? HAL_I2C_Mem_Write(BMP390->i2c, BMP390->BMP390_I2C_ADDRESS, reg, I2C_MEMADD_SIZE_8BIT, data, len, timeout)
+					   : HAL_I2C_Mem_Read(BMP390->i2c, BMP390->BMP390_I2C_ADDRESS, reg, I2C_MEMADD_SIZE_8BIT, data, len, timeout);
+
+		bus = BMP390_Bus_Classify(status, HAL_I2C_GetError(BMP390->i2c));
+	}
+
+	if(bus == BMP390_Bus_OK){
+
+		return BMP390_Bus_OK;
+	}
+
+	BMP390_Bus_Stats.errors[bus]++;
+
+	//A NACK leaves the bus idle, there is nothing to clear. Recovery itself uses the bus, so it isn't nested
+	if(bus != BMP390_Bus_Nack && !BMP390_Bus_Recovering){
+
+		BMP390_Bus_Recover(BMP390);
+	}
+
+	return bus;
+}
+
+
+/**
+ * @brief  Up to 9 clocks on SCL until the slave releases SDA, then a STOP condition. The lines are open drain,
+ * 		   the pull-ups bring them high.
+ */
+static void BMP390_Bus_Clear(void){
+
+	GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+	HAL_GPIO_WritePin(BMP390_Bus_SclPort, BMP390_Bus_SclPin, GPIO_PIN_SET);
+	HAL_GPIO_WritePin(BMP390_Bus_SdaPort, BMP390_Bus_SdaPin, GPIO_PIN_SET);
+
+	GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_OD;
+	GPIO_InitStruct.Pull = GPIO_NOPULL;
+	GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+
+	GPIO_InitStruct.Pin = BMP390_Bus_SclPin;
+	HAL_GPIO_Init(BMP390_Bus_SclPort, &GPIO_InitStruct);
+	GPIO_InitStruct.Pin = BMP390_Bus_SdaPin;
+	HAL_GPIO_Init(BMP390_Bus_SdaPort, &GPIO_InitStruct);
+
+	BMP390_Bus_DelayUs(BMP390_Bus_HalfClock);
+
+	for(uint8_t i = 0; i < 9; i++){
+
+		if(HAL_GPIO_ReadPin(BMP390_Bus_SdaPort, BMP390_Bus_SdaPin) == GPIO_PIN_SET){
+
+			break;
+		}
+
+		HAL_GPIO_WritePin(BMP390_Bus_SclPort, BMP390_Bus_SclPin, GPIO_PIN_RESET);
+		BMP390_Bus_DelayUs(BMP390_Bus_HalfClock);
+		HAL_GPIO_WritePin(BMP390_Bus_SclPort, BMP390_Bus_SclPin, GPIO_PIN_SET);
+		BMP390_Bus_DelayUs(BMP390_Bus_HalfClock);
+	}
+
+	//STOP : SDA rises while SCL is high
+	HAL_GPIO_WritePin(BMP390_Bus_SclPort, BMP390_Bus_SclPin, GPIO_PIN_RESET);
+	BMP390_Bus_DelayUs(BMP390_Bus_HalfClock);
+	HAL_GPIO_WritePin(BMP390_Bus_SdaPort, BMP390_Bus_SdaPin, GPIO_PIN_RESET);
+	BMP390_Bus_DelayUs(BMP390_Bus_HalfClock);
+	HAL_GPIO_WritePin(BMP390_Bus_SclPort, BMP390_Bus_SclPin, GPIO_PIN_SET);
+	BMP390_Bus_DelayUs(BMP390_Bus_HalfClock);
+	HAL_GPIO_WritePin(BMP390_Bus_SdaPort, BMP390_Bus_SdaPin, GPIO_PIN_SET);
+	BMP390_Bus_DelayUs(BMP390_Bus_HalfClock);
+}
+
+
+/**
+ * @brief  Busy wait, it is called with interrupts running from the timer interrupt so SysTick can't be used.
+ * 		   About 4 cycles per loop, it only has to be long enough.
+ */
+static void BMP390_Bus_DelayUs(uint32_t us){
+
+	volatile uint32_t loops = ((SystemCoreClock / 1000000u) * us) / 4u + 1u;
+
+	while(loops--){
+
+	}
+}
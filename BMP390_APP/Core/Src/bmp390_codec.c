@@ -0,0 +1,200 @@
+/*!
+ *  @file : bmp390_codec.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * NOTE ==> Consecutive raw values differ by a few counts, the sensortime step is constant while the ODR
+ * 			doesn't change. A delta frame is usually 3 to 5 bytes instead of 9, only integer adds and shifts are used.
+ */
+
+#include "bmp390_codec.h"
+
+
+#define BMP390_Codec_Mask24				0x00FFFFFF
+#define BMP390_Codec_Delta24(a, b)		(((int32_t)(((a) - (b)) << 8)) >> 8)	/*! Signed difference modulo 2^24 */
+
+static uint8_t BMP390_Codec_PutVarint(uint8_t *out, int32_t value);
+static int8_t  BMP390_Codec_GetVarint(const uint8_t *in, uint16_t len, int32_t *value);
+
+
+void BMP390_Codec_Init(BMP390_Codec_TypeDef *Codec){
+
+	Codec->prev.rawPress = 0;
+	Codec->prev.rawTemp = 0;
+	Codec->prev.sensortime = 0;
+	Codec->prevDt = 0;
+	Codec->untilKey = 0;
+	Codec->frames = 0;
+	Codec->bytes = 0;
+}
+
+
+uint8_t BMP390_Codec_Encode(BMP390_Codec_TypeDef *Codec, const BMP390_RawFrame_TypeDef *Frame, uint8_t *out){
+
+	uint8_t n = 0;
+	int32_t dt = BMP390_Codec_Delta24(Frame->sensortime, Codec->prev.sensortime);
+
+	if(Codec->untilKey == 0){
+
+		out[0] = Frame->rawPress;   out[1] = Frame->rawPress >> 8;   out[2] = Frame->rawPress >> 16;
+		out[3] = Frame->rawTemp;    out[4] = Frame->rawTemp >> 8;    out[5] = Frame->rawTemp >> 16;
+		out[6] = Frame->sensortime; out[7] = Frame->sensortime >> 8; out[8] = Frame->sensortime >> 16;
+
+		n = BMP390_Codec_KeySize;
+		dt = 0;
+		Codec->untilKey = BMP390_Codec_KeyInterval;
+	}
+	else{
+
+		n += BMP390_Codec_PutVarint(&out[n], BMP390_Codec_Delta24(Frame->rawPress, Codec->prev.rawPress));
+		n += BMP390_Codec_PutVarint(&out[n], BMP390_Codec_Delta24(Frame->rawTemp, Codec->prev.rawTemp));
+		n += BMP390_Codec_PutVarint(&out[n], dt - Codec->prevDt);
+	}
+
+	Codec->untilKey--;
+	Codec->prev.rawPress = Frame->rawPress & BMP390_Codec_Mask24;
+	Codec->prev.rawTemp = Frame->rawTemp & BMP390_Codec_Mask24;
+	Codec->prev.sensortime = Frame->sensortime & BMP390_Codec_Mask24;
+	Codec->prevDt = dt;
+	Codec->frames++;
+	Codec->bytes += n;
+
+	return n;
+}
+
+
+int16_t BMP390_Codec_Decode(BMP390_Codec_TypeDef *Codec, const uint8_t *in, uint16_t len, BMP390_RawFrame_TypeDef *Frame){
+
+	int16_t n = 0;
+	int8_t used;
+	int32_t dPress, dTemp, ddt;
+
+	if(Codec->untilKey == 0){
+
+		if(len < BMP390_Codec_KeySize){
+
+			return -1;
+		}
+
+		Frame->rawPress   = in[0] | (in[1] << 8) | ((uint32_t)in[2] << 16);
+		Frame->rawTemp    = in[3] | (in[4] << 8) | ((uint32_t)in[5] << 16);
+		Frame->sensortime = in[6] | (in[7] << 8) | ((uint32_t)in[8] << 16);
+
+		n = BMP390_Codec_KeySize;
+		Codec->prevDt = 0;
+		Codec->untilKey = BMP390_Codec_KeyInterval;
+	}
+	else{
+
+		if((used = BMP390_Codec_GetVarint(&in[n], len - n, &dPress)) < 0) return -1;
+		n += used;
+		if((used = BMP390_Codec_GetVarint(&in[n], len - n, &dTemp)) < 0) return -1;
+		n += used;
+		if((used = BMP390_Codec_GetVarint(&in[n], len - n, &ddt)) < 0) return -1;
+		n += used;
+
+		Codec->prevDt += ddt;
+
+		Frame->rawPress   = (Codec->prev.rawPress + dPress) & BMP390_Codec_Mask24;
+		Frame->rawTemp    = (Codec->prev.rawTemp + dTemp) & BMP390_Codec_Mask24;
+		Frame->sensortime = (Codec->prev.sensortime + Codec->prevDt) & BMP390_Codec_Mask24;
+	}
+
+	Codec->untilKey--;
+	Codec->prev = *Frame;
+	Codec->frames++;
+	Codec->bytes += n;
+
+	return n;
+}
+
+
+void BMP390_Codec_Benchmark(const BMP390_RawFrame_TypeDef *Frames, uint32_t n, BMP390_Codec_Stats_TypeDef *Stats){
+
+	BMP390_Codec_TypeDef enc;
+	uint8_t out[BMP390_Codec_MaxSize];
+	uint32_t start;
+
+	BMP390_Codec_Init(&enc);
+
+	start = BMP390_Cycles();
+
+	for(uint32_t i = 0; i < n; i++){
+
+		BMP390_Codec_Encode(&enc, &Frames[i], out);
+	}
+
+	Stats->cyclesPerFrame = (n != 0) ? ((BMP390_Cycles() - start) / n) : 0;
+	Stats->frames = n;
+	Stats->rawBytes = n * BMP390_Codec_KeySize;
+	Stats->encodedBytes = enc.bytes;
+	Stats->ratio = (enc.bytes != 0) ? ((float)Stats->rawBytes / (float)enc.bytes) : 0.0f;
+}
+
+
+/**
+ * @brief  ZigZag maps small negative and positive values to small unsigned values (0, -1, 1, -2 -> 0, 1, 2, 3).
+ */
+static uint8_t BMP390_Codec_PutVarint(uint8_t *out, int32_t value){
+
+	uint32_t zz = ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+	uint8_t n = 0;
+
+	while(zz >= 0x80){
+
+		out[n++] = (uint8_t)(zz | 0x80);
+		zz >>= 7;
+	}
+
+	out[n++] = (uint8_t)zz;
+
+	return n;
+}
+
+
+static int8_t BMP390_Codec_GetVarint(const uint8_t *in, uint16_t len, int32_t *value){
+
+	uint32_t zz = 0;
+
+	for(uint8_t i = 0; i < 4 && i < len; i++){
+
+		zz |= (uint32_t)(in[i] & 0x7F) << (7 * i);
+
+		if((in[i] & 0x80) == 0){
+
+			*value = (int32_t)(zz >> 1) ^ -(int32_t)(zz & 1);
+			return i + 1;
+		}
+	}
+
+	return -1;
+}
@@ -0,0 +1,186 @@
+/*!
+ *  @file : bmp390_drift.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * NOTE ==> The sensor counts sensortime with its own oscillator and the MCU runs from HSI, they disagree by up to a
+ * 			few percent. MCU time is regressed on sensortime with an exponentially weighted least squares fit :
+ *
+ * 				dx = x - mx, dy = y - my, mx += w * dx, my += w * dy,
+ * 				cxx = (1 - w) * (cxx + w * dx * dx), cxy = (1 - w) * (cxy + w * dx * dy), rate = cxy / cxx
+ *
+ * 			x and y are measured from the newest pair. When a pair comes the means are shifted by its distance
+ * 			from the previous one (the covariances don't change under a shift) and the new pair sits at (0, 0).
+ * 			The means stay within one window of the anchor, so floats are enough and nothing has to grow.
+ */
+
+#include "bmp390_drift.h"
+
+
+#define BMP390_Drift_HalfRange		0x00800000	/*! Half of the 24 bit sensortime range */
+
+static int32_t BMP390_Drift_SensortimeDiff(uint32_t a, uint32_t b);
+
+
+void BMP390_Drift_Init(BMP390_Drift_TypeDef *Drift){
+
+	Drift->sAnchor = 0;
+	Drift->tAnchor = 0;
+	Drift->mx = 0.0f;
+	Drift->my = 0.0f;
+	Drift->cxx = 0.0f;
+	Drift->cxy = 0.0f;
+	Drift->rate = BMP390_Drift_NominalRate;
+	Drift->n = 0;
+
+#if defined(__arm__)
+
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	Drift->cycles = DWT->CYCCNT;
+
+#else
+
+	Drift->cycles = 0;
+
+#endif
+
+	Drift->cycleRem = 0;
+	Drift->micros = 0;
+}
+
+
+uint64_t BMP390_Drift_Micros(BMP390_Drift_TypeDef *Drift){
+
+#if defined(__arm__)
+
+	uint32_t perUs = SystemCoreClock / 1000000u;
+	uint32_t now = DWT->CYCCNT;
+
+	//The difference of two cycle counts is right across a wrap, the remainder carries the part of a us
+	Drift->cycleRem += now - Drift->cycles;
+	Drift->cycles = now;
+
+	Drift->micros += Drift->cycleRem / perUs;
+	Drift->cycleRem %= perUs;
+
+#else
+
+	//No cycle counter, the ms tick is extended the same way
+	uint32_t now = HAL_GetTick();
+
+	Drift->micros += (uint64_t)(now - Drift->cycles) * 1000u;
+	Drift->cycles = now;
+
+#endif
+
+	return Drift->micros;
+}
+
+
+void BMP390_Drift_Update(BMP390_Drift_TypeDef *Drift, uint32_t sensortime, uint64_t micros){
+
+	int32_t ds = BMP390_Drift_SensortimeDiff(sensortime, Drift->sAnchor);
+	float w, dx, dy;
+
+	if((Drift->n != 0) && ((ds <= 0) || (ds >= (BMP390_Drift_HalfRange - 1)))){
+
+		//Sensortime restarted (reset of the sensor) or the gap is too long to tell the wraps apart
+		Drift->n = 0;
+	}
+
+	if(Drift->n == 0){
+
+		Drift->mx = 0.0f;
+		Drift->my = 0.0f;
+		Drift->cxx = 0.0f;
+		Drift->cxy = 0.0f;
+	}
+	else{
+
+		Drift->mx -= (float)ds;
+		Drift->my -= (float)(int64_t)(micros - Drift->tAnchor);
+	}
+
+	Drift->sAnchor = sensortime & BMP390_Sensortime_Mask;
+	Drift->tAnchor = micros;
+	Drift->n++;
+
+	//Plain average until the window is full, so the first pairs aren't pulled towards zero
+	w = (Drift->n < BMP390_Drift_Window) ? (1.0f / (float)Drift->n) : (1.0f / (float)BMP390_Drift_Window);
+
+	dx = -Drift->mx;
+	dy = -Drift->my;
+
+	Drift->mx += w * dx;
+	Drift->my += w * dy;
+	Drift->cxx = (1.0f - w) * (Drift->cxx + (w * dx * dx));
+	Drift->cxy = (1.0f - w) * (Drift->cxy + (w * dx * dy));
+
+	if(Drift->cxx > 0.0f){
+
+		Drift->rate = Drift->cxy / Drift->cxx;
+	}
+}
+
+
+uint64_t BMP390_Drift_Map(const BMP390_Drift_TypeDef *Drift, uint32_t sensortime){
+
+	float x;
+	float y;
+
+	//No anchor yet, the dead-reckoned sensortime counts from 0 and only the nominal rate is known
+	if(Drift->n == 0){
+
+		return ((uint64_t)(sensortime & BMP390_Sensortime_Mask) * 390625u) / 10000u;
+	}
+
+	x = (float)BMP390_Drift_SensortimeDiff(sensortime, Drift->sAnchor);
+	y = Drift->my + (Drift->rate * (x - Drift->mx));
+
+	return Drift->tAnchor + (uint64_t)(int64_t)((y >= 0.0f) ? (y + 0.5f) : (y - 0.5f));
+}
+
+
+float BMP390_Drift_Ppm(const BMP390_Drift_TypeDef *Drift){
+
+	return ((Drift->rate / BMP390_Drift_NominalRate) - 1.0f) * 1e6f;
+}
+
+
+/**
+ * @brief  a - b of two 24 bit sensortimes, between -2^23 and 2^23 - 1.
+ */
+static int32_t BMP390_Drift_SensortimeDiff(uint32_t a, uint32_t b){
+
+	return ((int32_t)((a - b) << 8)) >> 8;
+}
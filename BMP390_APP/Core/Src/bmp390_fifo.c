@@ -0,0 +1,629 @@
+/*!
+ *  @file : bmp390_fifo.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * NOTE ==> The bus is touched twice per drain instead of once per sample : a 4 byte status read on the INT edge and
+ * 			one DMA read of the whole FIFO. The MCU only wakes up for the INT edge and the end of the DMA, the main loop
+ * 			parses the buffer while the next one is being filled. Nothing here waits for the sensor.
+ * 			Frames are read where the DMA put them, only a frame split between two drains is copied (into Carry).
+ */
+
+#include "bmp390_fifo.h"
+#include "bmp390_bus.h"
+#include "bmp390_health.h"
+#include "string.h"
+
+
+static void BMP390_Fifo_Start(BMP390_Fifo_TypeDef *Fifo);
+static uint16_t BMP390_Fifo_Parse(BMP390_Fifo_TypeDef *Fifo, uint8_t b, BMP390_Fifo_Callback_t cb, void *ctx);
+static void BMP390_Fifo_Scan(BMP390_Fifo_Iter_TypeDef *It, const uint8_t *frame);
+static uint8_t BMP390_Fifo_FrameLen(uint8_t header);
+static _Bool BMP390_Fifo_IsData(uint8_t header);
+static uint32_t BMP390_Fifo_Back(const BMP390_Fifo_Iter_TypeDef *It, uint16_t index);
+static uint16_t BMP390_Fifo_CopyParse(const uint8_t *data, uint16_t len, uint32_t step, BMP390_RawFrame_TypeDef *Frames);
+
+
+_Bool BMP390_Fifo_Init(BMP390_Fifo_TypeDef *Fifo, BMP390_HandleTypeDef *BMP390, BMP390_Drift_TypeDef *Drift,
+					   BMP390_Iir_TypeDef *Iir, uint16_t watermark){
+
+	GPIO_InitTypeDef GPIO_InitStruct = {0};
+	uint8_t CMD = BMP390_CMD_Fifoflush;
+
+	Fifo->BMP390 = BMP390;
+	Fifo->Drift = Drift;
+	Fifo->Iir = Iir;
+	Fifo->len[0] = 0;
+	Fifo->len[1] = 0;
+	Fifo->reading = 0;
+	Fifo->dmaBuf = 0;
+	Fifo->taskBuf = 0;
+	Fifo->busy = false;
+	Fifo->sensortime = 0;
+	Fifo->Carry.len = 0;
+	Fifo->Stats = (BMP390_Fifo_Stats_TypeDef){0};
+
+	if((watermark == 0) || (watermark >= BMP390_Fifo_Capacity) || (watermark > BMP390_Fifo_BufSize)){
+
+		return false;
+
+	}
+
+	BMP390->Params.stat_fifo = Enable;
+	BMP390->Params.stat_fifo_stopFull = Disable;
+	BMP390->Params.stat_fifo_press = Enable;
+	BMP390->Params.stat_fifo_temp = Enable;
+	BMP390->Params.stat_fifo_time = Enable;
+	BMP390->Params.fifo_subs = BMP390_FifoSub_0;
+	BMP390->Params.fifo_sel = (Iir != NULL) ? BMP390_Fifo_UnfilteredData : BMP390_Fifo_FilteredData;
+	BMP390->Params.int_out = BMP390_Int_Out_PP;
+	BMP390->Params.int_level = BMP390_Int_Level_A_H;
+	BMP390->Params.stat_int_latch = Enable;			//The pin stays high until INT_STATUS is read, no edge is lost
+	BMP390->Params.stat_int_fwtm = Enable;
+	BMP390->Params.stat_int_fful = Enable;
+	BMP390->Params.stat_int_drdy = Disable;
+	BMP390->Params.fifo_wtm = watermark;
+
+	Fifo->step = ((uint32_t)BMP390_Sensortime_OdrStep << BMP390->Params.odr) << BMP390->Params.fifo_subs;
+	Fifo->prevStep = Fifo->step;
+
+	__HAL_RCC_DMA1_CLK_ENABLE();
+
+	Fifo->hdma.Instance = DMA1_Channel7;
+	Fifo->hdma.Init.Direction = DMA_PERIPH_TO_MEMORY;
+	Fifo->hdma.Init.PeriphInc = DMA_PINC_DISABLE;
+	Fifo->hdma.Init.MemInc = DMA_MINC_ENABLE;
+	Fifo->hdma.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+	Fifo->hdma.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+	Fifo->hdma.Init.Mode = DMA_NORMAL;
+	Fifo->hdma.Init.Priority = DMA_PRIORITY_HIGH;
+
+	if(HAL_DMA_Init(&Fifo->hdma) != HAL_OK){
+
+		return false;
+
+	}
+
+	__HAL_LINKDMA(BMP390->i2c, hdmarx, Fifo->hdma);
+
+	//Below SysTick like TIM1, the status read uses HAL timeouts
+	HAL_NVIC_SetPriority(DMA1_Channel7_IRQn, 1, 0);
+	HAL_NVIC_EnableIRQ(DMA1_Channel7_IRQn);
+	HAL_NVIC_SetPriority(I2C1_ER_IRQn, 1, 0);
+	HAL_NVIC_EnableIRQ(I2C1_ER_IRQn);
+
+	if(!BMP390_Upload_ConfigParams(BMP390) ||
+	   BMP390_Bus_Write(BMP390, BMP390_REG_CMD, &CMD, 1) != BMP390_Bus_OK){
+
+		return false;
+
+	}
+
+	//The flush empties the FIFO, the filters start again with it
+	if(Iir != NULL){
+
+		BMP390_Iir_Reset(Iir);
+	}
+
+	BMP390_Fifo_IntClkEnable();
+
+	GPIO_InitStruct.Pin = BMP390_Fifo_IntPin;
+	GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING;
+	GPIO_InitStruct.Pull = GPIO_PULLDOWN;
+	HAL_GPIO_Init(BMP390_Fifo_IntPort, &GPIO_InitStruct);
+
+	HAL_NVIC_SetPriority(BMP390_Fifo_IntIRQn, 1, 0);
+	HAL_NVIC_EnableIRQ(BMP390_Fifo_IntIRQn);
+
+	return true;
+}
+
+
+void BMP390_Fifo_IRQHandler(BMP390_Fifo_TypeDef *Fifo){
+
+	__HAL_GPIO_EXTI_CLEAR_IT(BMP390_Fifo_IntPin);
+
+	Fifo->Stats.wakeups++;
+
+	BMP390_Fifo_Start(Fifo);
+}
+
+
+void BMP390_Fifo_RxCplt(BMP390_Fifo_TypeDef *Fifo){
+
+	uint8_t b = Fifo->dmaBuf;
+
+	Fifo->readTime[b] = (Fifo->Drift != NULL) ? BMP390_Drift_Micros(Fifo->Drift) : 0;
+	Fifo->len[b] = Fifo->reading;
+	Fifo->dmaBuf = b ^ 1;
+
+	Fifo->Stats.drains++;
+	Fifo->Stats.bytes += Fifo->reading;
+
+	Fifo->busy = false;
+}
+
+
+void BMP390_Fifo_Error(BMP390_Fifo_TypeDef *Fifo){
+
+	Fifo->Stats.errors++;
+	Fifo->busy = false;
+
+	//The bytes that were read are lost, the rest stays in the FIFO and the latched pin brings it back
+	BMP390_Bus_Recover(Fifo->BMP390);
+}
+
+
+uint16_t BMP390_Fifo_Task(BMP390_Fifo_TypeDef *Fifo, BMP390_Fifo_Callback_t cb, void *ctx){
+
+	uint16_t frames = 0;
+
+	while(Fifo->len[Fifo->taskBuf] != 0){
+
+		frames += BMP390_Fifo_Parse(Fifo, Fifo->taskBuf, cb, ctx);
+
+		Fifo->len[Fifo->taskBuf] = 0;
+		Fifo->taskBuf ^= 1;
+	}
+
+	if(!Fifo->busy && (HAL_GPIO_ReadPin(BMP390_Fifo_IntPort, BMP390_Fifo_IntPin) == GPIO_PIN_SET)){
+
+		HAL_NVIC_SetPendingIRQ(BMP390_Fifo_IntIRQn);
+	}
+
+	return frames;
+}
+
+
+_Bool BMP390_Fifo_Pause(BMP390_Fifo_TypeDef *Fifo){
+
+	uint32_t start = HAL_GetTick();
+
+	HAL_NVIC_DisableIRQ(BMP390_Fifo_IntIRQn);
+
+	while(Fifo->busy){
+
+		if((HAL_GetTick() - start) > BMP390_Fifo_PauseTimeout){
+
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+void BMP390_Fifo_Resume(BMP390_Fifo_TypeDef *Fifo){
+
+	BMP390_HandleTypeDef *BMP390 = Fifo->BMP390;
+	uint32_t step = ((uint32_t)BMP390_Sensortime_OdrStep << BMP390->Params.odr) << BMP390->Params.fifo_subs;
+
+	//The frames that are already in the FIFO keep the old step until the configuration change frame
+	if(step != Fifo->step){
+
+		Fifo->prevStep = Fifo->step;
+		Fifo->step = step;
+	}
+
+	HAL_NVIC_EnableIRQ(BMP390_Fifo_IntIRQn);
+}
+
+
+void BMP390_Fifo_IterInit(BMP390_Fifo_Iter_TypeDef *It, const uint8_t *data, uint16_t len,
+						  BMP390_Fifo_Carry_TypeDef *Carry, uint32_t step, uint32_t prevStep, uint32_t sensortime){
+
+	uint16_t i;
+	uint8_t size, need;
+
+	It->data = data;
+	It->len = len;
+	It->pos = 0;
+	It->Carry = Carry;
+	It->stitched = false;
+	It->frame = NULL;
+	It->header = 0;
+	It->sensortime = 0;
+	It->dataFrames = 0;
+	It->index = 0;
+	It->step = step;
+	It->prevStep = prevStep;
+	It->change = 0;
+	It->changed = false;
+	It->timed = false;
+
+	//The frame that the previous drain split is completed first, its header is already in the carry
+	if(Carry->len != 0){
+
+		need = BMP390_Fifo_FrameLen(Carry->buf[0]) - Carry->len;
+
+		if(need > len){
+
+			memcpy(&Carry->buf[Carry->len], data, len);
+			Carry->len += len;
+			It->pos = len;
+		}
+		else{
+
+			memcpy(&Carry->buf[Carry->len], data, need);
+			It->pos = need;
+			It->stitched = true;
+			BMP390_Fifo_Scan(It, Carry->buf);
+		}
+	}
+
+	for(i = It->pos; i < len; i += size){
+
+		size = BMP390_Fifo_FrameLen(data[i]);
+
+		if((size == 0) || ((i + size) > len)){
+
+			break;
+		}
+
+		BMP390_Fifo_Scan(It, &data[i]);
+	}
+
+	//Without a change frame the whole buffer is either before the change or after it
+	if(!It->changed){
+
+		It->change = (prevStep != step) ? It->dataFrames : 0;
+	}
+
+	if(!It->timed){
+
+		It->last = (sensortime + ((uint32_t)(It->dataFrames - It->change) * step) +
+					((uint32_t)It->change * prevStep)) & BMP390_Sensortime_Mask;
+	}
+}
+
+
+_Bool BMP390_Fifo_Next(BMP390_Fifo_Iter_TypeDef *It){
+
+	uint8_t size;
+
+	if(It->stitched){
+
+		It->stitched = false;
+		It->frame = It->Carry->buf;
+		It->Carry->len = 0;
+	}
+	else{
+
+		if(It->pos >= It->len){
+
+			return false;
+		}
+
+		size = BMP390_Fifo_FrameLen(It->data[It->pos]);
+
+		//Nothing after an unknown header can be framed, the next drain starts on a frame again
+		if(size == 0){
+
+			It->pos = It->len;
+			return false;
+		}
+
+		if((It->pos + size) > It->len){
+
+			It->Carry->len = (uint8_t)(It->len - It->pos);
+			memcpy(It->Carry->buf, &It->data[It->pos], It->Carry->len);
+			It->pos = It->len;
+			return false;
+		}
+
+		It->frame = &It->data[It->pos];
+		It->pos += size;
+	}
+
+	It->header = It->frame[0];
+
+	if(BMP390_Fifo_IsData(It->header)){
+
+		It->sensortime = (It->last - BMP390_Fifo_Back(It, It->index)) & BMP390_Sensortime_Mask;
+		It->index++;
+	}
+
+	return true;
+}
+
+
+void BMP390_Fifo_Benchmark(const uint8_t *data, uint16_t len, uint32_t step, BMP390_RawFrame_TypeDef *scratch,
+						   BMP390_Fifo_Bench_TypeDef *Bench){
+
+	BMP390_Fifo_Iter_TypeDef It;
+	BMP390_Fifo_Carry_TypeDef Carry = {0};
+	volatile uint32_t sink;
+	uint32_t sum = 0;
+	uint32_t start, iter, copy;
+	uint16_t n;
+
+	//Both of them read every value once, the sum keeps the compiler from dropping the work
+	start = BMP390_Cycles();
+
+	BMP390_Fifo_IterInit(&It, data, len, &Carry, step, step, 0);
+
+	while(BMP390_Fifo_Next(&It)){
+
+		if(It.header == BMP390_Fifo_Hdr_PressTemp){
+
+			sum += BMP390_Fifo_RawPress(&It) + BMP390_Fifo_RawTemp(&It) + It.sensortime;
+		}
+	}
+
+	iter = BMP390_Cycles() - start;
+
+	start = BMP390_Cycles();
+
+	n = BMP390_Fifo_CopyParse(data, len, step, scratch);
+
+	for(uint16_t k = 0; k < n; k++){
+
+		sum += scratch[k].rawPress + scratch[k].rawTemp + scratch[k].sensortime;
+	}
+
+	copy = BMP390_Cycles() - start;
+
+	sink = sum;
+	(void)sink;
+
+	Bench->frames = n;
+	Bench->iterCycles = (n != 0) ? (iter / n) : 0;
+	Bench->copyCycles = (n != 0) ? (copy / n) : 0;
+	Bench->iterRam = sizeof(BMP390_Fifo_Iter_TypeDef) + sizeof(BMP390_Fifo_Carry_TypeDef);
+	Bench->copyRam = n * sizeof(BMP390_RawFrame_TypeDef);
+}
+
+
+void BMP390_Fifo_CalcLoad(uint16_t watermark, uint8_t frameLen, uint32_t framePeriod, uint32_t clock,
+						  float *wakeups, float *busLoad){
+
+	float drains = ((float)frameLen * 1e6f) / ((float)framePeriod * (float)watermark);
+
+	*wakeups = 2.0f * drains;
+	*busLoad = (drains * (float)(BMP390_Fifo_Bits(BMP390_Fifo_StatusLen) + BMP390_Fifo_Bits(watermark + 4))) / (float)clock;
+}
+
+
+/**
+ * @brief  Status read and start of the drain, from the INT edge only. A drain in progress or two full buffers skip it.
+ */
+static void BMP390_Fifo_Start(BMP390_Fifo_TypeDef *Fifo){
+
+	uint8_t EVENT_TO_FIFO_LENGTH[BMP390_Fifo_StatusLen];
+	BMP390_StatusRegs_TypeDef regs = {0};
+	uint16_t len;
+
+	if(Fifo->busy){
+
+		return;
+	}
+
+	if(Fifo->len[Fifo->dmaBuf] != 0){
+
+		Fifo->Stats.overruns++;
+		return;
+	}
+
+	Fifo->Stats.busBits += BMP390_Fifo_Bits(BMP390_Fifo_StatusLen);
+
+	if(BMP390_Bus_Read(Fifo->BMP390, BMP390_REG_EVENT, EVENT_TO_FIFO_LENGTH, BMP390_Fifo_StatusLen) != BMP390_Bus_OK){
+
+		Fifo->Stats.errors++;
+		return;
+	}
+
+	//A power-on reset is caught here too, the restore uploads the FIFO settings again and the FIFO starts empty
+	regs.event = EVENT_TO_FIFO_LENGTH[0];
+	regs.intStatus = EVENT_TO_FIFO_LENGTH[1];
+
+	if(!BMP390_Health_Check(Fifo->BMP390, &regs)){
+
+		return;
+	}
+
+	len = (EVENT_TO_FIFO_LENGTH[2] | (EVENT_TO_FIFO_LENGTH[3] << 8)) & 0x01FF;
+
+	if(len > BMP390_Fifo_BufSize){
+
+		len = BMP390_Fifo_BufSize;
+	}
+
+	//The DMA needs two bytes at least, the smallest frame is two bytes
+	if(len < 2){
+
+		return;
+	}
+
+	//Reading past the fill level brings the sensortime frame, it dates the buffer and feeds the drift estimator
+	len += BMP390_Fifo_TimeLen;
+
+	Fifo->busy = true;
+	Fifo->reading = len;
+	Fifo->Stats.busBits += BMP390_Fifo_Bits(len);
+
+	if(HAL_I2C_Mem_Read_DMA(Fifo->BMP390->i2c, Fifo->BMP390->BMP390_I2C_ADDRESS, BMP390_REG_FIFO_DATA,
+							I2C_MEMADD_SIZE_8BIT, Fifo->buf[Fifo->dmaBuf], len) != HAL_OK){
+
+		Fifo->Stats.errors++;
+		Fifo->busy = false;
+	}
+}
+
+
+/**
+ * @brief  Hands the pressure and temperature frames of a drained buffer to the callback, in place.
+ */
+static uint16_t BMP390_Fifo_Parse(BMP390_Fifo_TypeDef *Fifo, uint8_t b, BMP390_Fifo_Callback_t cb, void *ctx){
+
+	BMP390_Fifo_Iter_TypeDef It;
+	BMP390_RawFrame_TypeDef frame;
+	uint16_t n = 0;
+
+	BMP390_Fifo_IterInit(&It, Fifo->buf[b], Fifo->len[b], &Fifo->Carry, Fifo->step, Fifo->prevStep, Fifo->sensortime);
+
+	if(It.timed && (Fifo->Drift != NULL)){
+
+		BMP390_Drift_Update(Fifo->Drift, It.last, Fifo->readTime[b]);
+	}
+
+	while(BMP390_Fifo_Next(&It)){
+
+		if(It.header != BMP390_Fifo_Hdr_PressTemp){
+
+			continue;
+		}
+
+		frame.rawTemp    = BMP390_Fifo_RawTemp(&It);
+		frame.rawPress   = BMP390_Fifo_RawPress(&It);
+		frame.sensortime = It.sensortime;
+		n++;
+
+		if(Fifo->Iir != NULL){
+
+			BMP390_Iir_Update(Fifo->Iir, &frame);
+		}
+
+		if(cb != NULL){
+
+			cb(ctx, &frame);
+		}
+	}
+
+	Fifo->sensortime = It.last;
+	Fifo->Stats.frames += n;
+
+	//The change reached this buffer, the next ones only hold frames of the new ODR
+	if(It.changed){
+
+		Fifo->prevStep = It.step;
+	}
+
+	return n;
+}
+
+
+/**
+ * @brief  Header scan of BMP390_Fifo_IterInit, data frames are counted and the sensortime frame is kept.
+ */
+static void BMP390_Fifo_Scan(BMP390_Fifo_Iter_TypeDef *It, const uint8_t *frame){
+
+	if(BMP390_Fifo_IsData(frame[0])){
+
+		It->dataFrames++;
+	}
+	else if(frame[0] == BMP390_Fifo_Hdr_Time){
+
+		It->last = BMP390_Fifo_U24(&frame[1]);
+		It->timed = true;
+	}
+	else if((frame[0] == BMP390_Fifo_Hdr_ConfigChg) && (It->prevStep != It->step)){
+
+		It->change = It->dataFrames;
+		It->changed = true;
+	}
+}
+
+
+/**
+ * @brief  Sensortime from data frame index to the last data frame, the frames from change on are step apart.
+ */
+static uint32_t BMP390_Fifo_Back(const BMP390_Fifo_Iter_TypeDef *It, uint16_t index){
+
+	uint16_t first = ((index + 1) > It->change) ? (index + 1) : It->change;
+	uint16_t after = It->dataFrames - first;
+
+	return ((uint32_t)after * It->step) + ((uint32_t)(It->dataFrames - 1 - index - after) * It->prevStep);
+}
+
+
+/**
+ * @brief  Size of a frame from its header, 0 for an unknown header.
+ */
+static uint8_t BMP390_Fifo_FrameLen(uint8_t header){
+
+	switch(header){
+
+		case BMP390_Fifo_Hdr_PressTemp:	return BMP390_Fifo_PressTempLen;
+		case BMP390_Fifo_Hdr_Temp:
+		case BMP390_Fifo_Hdr_Press:
+		case BMP390_Fifo_Hdr_Time:		return 4;
+		case BMP390_Fifo_Hdr_ConfigErr:
+		case BMP390_Fifo_Hdr_ConfigChg:
+		case BMP390_Fifo_Hdr_Empty:		return 2;
+		default:						return 0;
+	}
+}
+
+
+static _Bool BMP390_Fifo_IsData(uint8_t header){
+
+	return (header == BMP390_Fifo_Hdr_PressTemp) || (header == BMP390_Fifo_Hdr_Temp) || (header == BMP390_Fifo_Hdr_Press);
+}
+
+
+/**
+ * @brief  Reference for BMP390_Fifo_Benchmark : every data frame is copied into a struct, then they are dated.
+ */
+static uint16_t BMP390_Fifo_CopyParse(const uint8_t *data, uint16_t len, uint32_t step, BMP390_RawFrame_TypeDef *Frames){
+
+	uint16_t n = 0, i;
+	uint8_t size;
+	uint32_t last = 0;
+
+	for(i = 0; i < len; i += size){
+
+		size = BMP390_Fifo_FrameLen(data[i]);
+
+		if((size == 0) || ((i + size) > len)){
+
+			break;
+		}
+
+		if(data[i] == BMP390_Fifo_Hdr_PressTemp){
+
+			Frames[n].rawTemp  = BMP390_Fifo_U24(&data[i + 1]);
+			Frames[n].rawPress = BMP390_Fifo_U24(&data[i + 4]);
+			n++;
+		}
+		else if(data[i] == BMP390_Fifo_Hdr_Time){
+
+			last = BMP390_Fifo_U24(&data[i + 1]);
+		}
+	}
+
+	for(i = 0; i < n; i++){
+
+		Frames[i].sensortime = (last - ((uint32_t)(n - 1 - i) * step)) & BMP390_Sensortime_Mask;
+	}
+
+	return n;
+}
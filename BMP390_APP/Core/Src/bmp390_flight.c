@@ -0,0 +1,282 @@
+/*!
+ *  @file : bmp390_flight.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * NOTE ==> Every transition needs its condition to hold for its debounce time, a single noisy sample never
+ * 			changes the state. The time comes from the timestamps, at 1 Hz a debounce shorter than the period is
+ * 			confirmed by the next sample and at 200 Hz by the sample that reaches it. The tracker gains are
+ * 			rescaled to the sampling period too, see BMP390_Flight_Gains : a faster rate averages more samples
+ * 			in the same time, so the tracker gets faster and its speed is as noisy as at the configured period.
+ * 			The states only move forward, pad -> boost -> coast -> apogee -> descent -> landed.
+ */
+
+#include "bmp390_flight.h"
+
+
+static void BMP390_Flight_Gains(BMP390_Flight_TypeDef *Flight, uint32_t dt);
+static _Bool BMP390_Flight_Debounce(BMP390_Flight_TypeDef *Flight, _Bool condition, uint16_t time, uint32_t now);
+
+
+void BMP390_Flight_Init(BMP390_Flight_TypeDef *Flight, const BMP390_Flight_Config_TypeDef *Config){
+
+	if(Config != NULL){
+
+		Flight->Config = *Config;
+	}
+	else{
+
+		BMP390_Flight_DefaultConfig(&Flight->Config);
+	}
+
+	Flight->state = BMP390_Flight_Pad;
+	Flight->debouncing = false;
+	Flight->debounceStart = 0;
+	Flight->alt = 0.0f;
+	Flight->spd = 0.0f;
+	Flight->padAlt = 0.0f;
+	Flight->peakSpd = 0.0f;
+	Flight->peakAlt = 0.0f;
+	Flight->peakTime = 0;
+	Flight->lastTime = 0;
+	Flight->primed = false;
+	Flight->gainDt = 0;
+
+	for(uint8_t i = 0; i < BMP390_Flight_States; i++){
+
+		Flight->eventTime[i] = 0;
+	}
+}
+
+
+void BMP390_Flight_DefaultConfig(BMP390_Flight_Config_TypeDef *Config){
+
+	Config->alpha = 0.2f;
+	Config->beta = 0.02f;
+
+	Config->launchAlt = 10.0f;
+	Config->launchSpd = 5.0f;
+	Config->burnoutHyst = 2.0f;
+	Config->apogeeHyst = 1.0f;
+	Config->landedSpd = 1.0f;
+
+	Config->launchDebounce = 100;
+	Config->burnoutDebounce = 100;
+	Config->apogeeDebounce = 100;
+	Config->landedDebounce = 4000;
+}
+
+
+int8_t BMP390_Flight_Update(BMP390_Flight_TypeDef *Flight, const BMP390_Sample_TypeDef *Sample){
+
+	const BMP390_Flight_Config_TypeDef *Cfg = &Flight->Config;
+	BMP390_Flight_State_TypeDef next = Flight->state;
+	float dt, predicted, residual, alt;
+
+	if(!Flight->primed){
+
+		Flight->alt = Sample->vertAlt;
+		Flight->padAlt = Sample->vertAlt;
+		Flight->peakAlt = Sample->vertAlt;
+		Flight->peakTime = Sample->timestamp;
+		Flight->lastTime = Sample->timestamp;
+		Flight->eventTime[BMP390_Flight_Pad] = Sample->timestamp;
+		Flight->primed = true;
+
+		return -1;
+	}
+
+	dt = (float)(Sample->timestamp - Flight->lastTime) * 0.001f;
+
+	if(dt <= 0.0f){
+
+		return -1;
+	}
+
+	//The gains are only recalculated when the period changes
+	if((Sample->timestamp - Flight->lastTime) != Flight->gainDt){
+
+		BMP390_Flight_Gains(Flight, Sample->timestamp - Flight->lastTime);
+	}
+
+	Flight->lastTime = Sample->timestamp;
+
+	//Alpha-beta tracker
+	predicted = Flight->alt + (Flight->spd * dt);
+	residual = Sample->vertAlt - predicted;
+	Flight->alt = predicted + (Flight->alphaDt * residual);
+	Flight->spd += (Flight->betaDt / dt) * residual;
+
+	alt = Flight->alt - Flight->padAlt;
+
+	if(Flight->alt > Flight->peakAlt){
+
+		Flight->peakAlt = Flight->alt;
+		Flight->peakTime = Sample->timestamp;
+	}
+
+	switch(Flight->state){
+
+		case BMP390_Flight_Pad:
+
+			//The pad drifts with the weather, it follows the altitude while the rocket stands still
+			if(BMP390_Flight_Debounce(Flight, (alt > Cfg->launchAlt) && (Flight->spd > Cfg->launchSpd),
+									  Cfg->launchDebounce, Sample->timestamp)){
+
+				next = BMP390_Flight_Boost;
+			}
+			else if(Flight->spd < Cfg->launchSpd && Flight->spd > -Cfg->launchSpd){
+
+				Flight->padAlt = Flight->alt;
+				Flight->peakAlt = Flight->alt;
+				Flight->peakTime = Sample->timestamp;
+			}
+			break;
+
+		case BMP390_Flight_Boost:
+
+			if(Flight->spd > Flight->peakSpd){
+
+				Flight->peakSpd = Flight->spd;
+			}
+
+			if(Flight->spd < -Cfg->apogeeHyst){
+
+				//Very short burn, the coast was shorter than the debounce
+				if(BMP390_Flight_Debounce(Flight, true, Cfg->apogeeDebounce, Sample->timestamp)){
+
+					next = BMP390_Flight_Apogee;
+				}
+			}
+			else if(BMP390_Flight_Debounce(Flight, Flight->spd < (Flight->peakSpd - Cfg->burnoutHyst),
+										   Cfg->burnoutDebounce, Sample->timestamp)){
+
+				next = BMP390_Flight_Coast;
+			}
+			break;
+
+		case BMP390_Flight_Coast:
+
+			if(BMP390_Flight_Debounce(Flight, Flight->spd < -Cfg->apogeeHyst, Cfg->apogeeDebounce, Sample->timestamp)){
+
+				next = BMP390_Flight_Apogee;
+			}
+			break;
+
+		case BMP390_Flight_Apogee:
+
+			next = BMP390_Flight_Descent;
+			break;
+
+		case BMP390_Flight_Descent:
+
+			if(BMP390_Flight_Debounce(Flight, (Flight->spd < Cfg->landedSpd) && (Flight->spd > -Cfg->landedSpd),
+									  Cfg->landedDebounce, Sample->timestamp)){
+
+				next = BMP390_Flight_Landed;
+			}
+			break;
+
+		case BMP390_Flight_Landed:
+		default:
+			break;
+	}
+
+	if(next == Flight->state){
+
+		return -1;
+	}
+
+	Flight->state = next;
+	Flight->debouncing = false;
+	Flight->eventTime[next] = Sample->timestamp;
+
+	return (int8_t)next;
+}
+
+
+uint32_t BMP390_Flight_ApogeeLatency(const BMP390_Flight_TypeDef *Flight){
+
+	if(Flight->state < BMP390_Flight_Apogee){
+
+		return 0;
+	}
+
+	return Flight->eventTime[BMP390_Flight_Apogee] - Flight->peakTime;
+}
+
+
+/**
+ * @brief  Rescales the gains to a period of dt (ms). For a critically damped tracker alpha = 1 - r² and
+ * 		   beta = (1 - r)², r0 comes from the configured alpha and the time constant is -dt / ln(r).
+ * 		   The noise of the speed goes with dt / tau³, so faster than BMP390_Flight_GainPeriod the time constant
+ * 		   goes with the cube root of the period, r = r0^((dt / GainPeriod)^(2/3)) : 8 times the rate halves the lag
+ * 		   at the same speed noise. Slower, the time constant stays, a longer one would add whole periods of lag.
+ * 		   beta keeps its ratio to the critically damped one and stays in the stable range.
+ */
+static void BMP390_Flight_Gains(BMP390_Flight_TypeDef *Flight, uint32_t dt){
+
+	float ratio = (float)dt / (float)BMP390_Flight_GainPeriod;
+	float r0 = sqrtf(1.0f - Flight->Config.alpha);
+	float r = powf(r0, (ratio < 1.0f) ? cbrtf(ratio * ratio) : ratio);
+	float b0 = (1.0f - r0) * (1.0f - r0);
+
+	Flight->gainDt = dt;
+	Flight->alphaDt = 1.0f - (r * r);
+	Flight->betaDt = (r0 < 1.0f) ? (Flight->Config.beta * ((1.0f - r) * (1.0f - r)) / b0) : Flight->Config.beta;
+
+	if(Flight->betaDt > (2.0f - Flight->alphaDt)){
+
+		Flight->betaDt = 2.0f - Flight->alphaDt;
+	}
+}
+
+
+/**
+ * @brief  True once condition has held in every sample for time (ms) since the first sample that satisfied it.
+ */
+static _Bool BMP390_Flight_Debounce(BMP390_Flight_TypeDef *Flight, _Bool condition, uint16_t time, uint32_t now){
+
+	if(!condition){
+
+		Flight->debouncing = false;
+		return false;
+	}
+
+	if(!Flight->debouncing){
+
+		Flight->debouncing = true;
+		Flight->debounceStart = now;
+	}
+
+	return (now - Flight->debounceStart) >= time;
+}
@@ -0,0 +1,243 @@
+/*!
+ *  @file : bmp390_governor.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * NOTE ==> The fixed X8 at 50 Hz doesn't fit (21 ms of measurement in 20 ms) and is slowed down to 25 Hz, which
+ * 			burns about 370 uA on the pad for hours and is still slow during the boost. The governor runs 12.5 Hz at
+ * 			X2 on the pad, 25 Hz at X4 under the parachute and 100 Hz at X2 from the launch to the apogee.
+ * 			The flight tracker works with timestamps, so it stays continuous across a change of ODR.
+ * 			Near the apogee the speed is small but the deceleration isn't, the acceleration keeps the fast profile.
+ */
+
+#include "bmp390_governor.h"
+#include "bmp390_bus.h"
+
+
+static _Bool BMP390_Governor_Write(BMP390_Governor_TypeDef *Gov, BMP390_HandleTypeDef *BMP390, uint8_t reg, uint8_t value);
+
+
+void BMP390_Governor_Init(BMP390_Governor_TypeDef *Gov, const BMP390_Gov_Config_TypeDef *Config){
+
+	if(Config != NULL){
+
+		Gov->Config = *Config;
+	}
+	else{
+
+		BMP390_Governor_DefaultConfig(&Gov->Config);
+	}
+
+	Gov->level = 0;
+	Gov->primed = false;
+	Gov->acc = 0.0f;
+	Gov->lastSpd = 0.0f;
+	Gov->lastTime = 0;
+	Gov->calmSince = 0;
+	Gov->Stats = (BMP390_Gov_Stats_TypeDef){0};
+}
+
+
+void BMP390_Governor_DefaultConfig(BMP390_Gov_Config_TypeDef *Config){
+
+	Config->Profile[0] = (BMP390_Gov_Profile_TypeDef){BMP390_ODR_12p5, BMP390_Oversampling_X2, BMP390_Oversampling_X1, BMP390_Filter_Coef_3};
+	Config->Profile[1] = (BMP390_Gov_Profile_TypeDef){BMP390_ODR_25,   BMP390_Oversampling_X4, BMP390_Oversampling_X1, BMP390_Filter_Coef_3};
+	Config->Profile[2] = (BMP390_Gov_Profile_TypeDef){BMP390_ODR_100,  BMP390_Oversampling_X2, BMP390_Oversampling_X1, BMP390_Filter_Coef_1};
+
+	Config->upSpd[0] = 0.0f;
+	Config->upAcc[0] = 0.0f;
+	Config->upSpd[1] = 3.0f;
+	Config->upAcc[1] = 4.0f;
+	Config->upSpd[2] = 25.0f;
+	Config->upAcc[2] = 6.0f;
+
+	Config->hyst = 0.5f;
+	Config->dwell = 3000;
+	Config->accTau = 0.3f;
+}
+
+
+int8_t BMP390_Governor_Update(BMP390_Governor_TypeDef *Gov, const BMP390_Flight_TypeDef *Flight, uint32_t timestamp){
+
+	const BMP390_Gov_Config_TypeDef *Cfg = &Gov->Config;
+	float dt, spd, acc;
+	uint8_t k;
+
+	if(!Flight->primed){
+
+		return -1;
+	}
+
+	if(!Gov->primed){
+
+		Gov->lastSpd = Flight->spd;
+		Gov->lastTime = timestamp;
+		Gov->calmSince = timestamp;
+		Gov->primed = true;
+
+		return -1;
+	}
+
+	if(timestamp == Gov->lastTime){
+
+		return -1;
+	}
+
+	dt = (float)(timestamp - Gov->lastTime) * 0.001f;
+	Gov->Stats.time[Gov->level] += timestamp - Gov->lastTime;
+
+	Gov->acc += (dt / (Cfg->accTau + dt)) * (((Flight->spd - Gov->lastSpd) / dt) - Gov->acc);
+	Gov->lastSpd = Flight->spd;
+	Gov->lastTime = timestamp;
+
+	spd = fabsf(Flight->spd);
+	acc = fabsf(Gov->acc);
+
+	//Up at once, straight to the fastest profile whose thresholds are crossed
+	for(k = BMP390_Gov_Profiles - 1; k > Gov->level; k--){
+
+		if((spd > Cfg->upSpd[k]) || (acc > Cfg->upAcc[k])){
+
+			Gov->level = k;
+			Gov->calmSince = timestamp;
+			return (int8_t)k;
+		}
+	}
+
+	//Down one step after dwell
+	if((Gov->level > 0) &&
+	   (spd < (Cfg->upSpd[Gov->level] * (1.0f - Cfg->hyst))) && (acc < (Cfg->upAcc[Gov->level] * (1.0f - Cfg->hyst)))){
+
+		if((timestamp - Gov->calmSince) >= Cfg->dwell){
+
+			Gov->level--;
+			Gov->calmSince = timestamp;
+			return (int8_t)Gov->level;
+		}
+	}
+	else{
+
+		Gov->calmSince = timestamp;
+	}
+
+	return -1;
+}
+
+
+_Bool BMP390_Governor_Apply(BMP390_Governor_TypeDef *Gov, BMP390_HandleTypeDef *BMP390){
+
+	const BMP390_Gov_Profile_TypeDef *Profile = &Gov->Config.Profile[Gov->level];
+	BMP390_Params_t prev = BMP390->Params;
+	uint8_t OSR, ODR, CONFIG;
+	_Bool osrChange, odrChange, ok = true;
+
+	BMP390->Params.odr = Profile->odr;
+	BMP390->Params.press_osrs = Profile->pressOsrs;
+	BMP390->Params.temp_osrs = Profile->tempOsrs;
+	BMP390->Params.filtercoef = Profile->filterCoef;
+
+	//A profile that doesn't fit is a configuration mistake, nothing is written
+	if(BMP390_Calc_MeasTime(&BMP390->Params) > BMP390_Calc_OdrPeriod(BMP390->Params.odr)){
+
+		BMP390->Params = prev;
+		Gov->Stats.failures++;
+		return false;
+	}
+
+	OSR    = ((BMP390->Params.press_osrs)<<0) | ((BMP390->Params.temp_osrs)<<3);
+	ODR    = BMP390->Params.odr;
+	CONFIG = ((BMP390->Params.filtercoef)<<1);
+
+	osrChange = (BMP390->Params.press_osrs != prev.press_osrs) || (BMP390->Params.temp_osrs != prev.temp_osrs);
+	odrChange = (BMP390->Params.odr != prev.odr);
+
+	//Every intermediate state fits : the new OSR in the old longer period, or the old OSR in the new longer period
+	if(BMP390->Params.odr < prev.odr){
+
+		if(osrChange) ok &= BMP390_Governor_Write(Gov, BMP390, BMP390_REG_OSR, OSR);
+		ok &= BMP390_Governor_Write(Gov, BMP390, BMP390_REG_ODR, ODR);
+	}
+	else{
+
+		if(odrChange) ok &= BMP390_Governor_Write(Gov, BMP390, BMP390_REG_ODR, ODR);
+		if(osrChange) ok &= BMP390_Governor_Write(Gov, BMP390, BMP390_REG_OSR, OSR);
+	}
+
+	if(BMP390->Params.filtercoef != prev.filtercoef){
+
+		ok &= BMP390_Governor_Write(Gov, BMP390, BMP390_REG_CONFIG, CONFIG);
+	}
+
+	//The next sensortime gap spans two periods, it isn't a count of missed samples
+	if(odrChange){
+
+		BMP390->Track.primed = false;
+	}
+
+	Gov->Stats.switches++;
+
+	if(!ok){
+
+		Gov->Stats.failures++;
+	}
+
+	return ok;
+}
+
+
+float BMP390_Governor_Current(const BMP390_Gov_Profile_TypeDef *Profile){
+
+	BMP390_Params_t Params = {0};
+	float duty;
+
+	Params.stat_meas_press = Enable;
+	Params.stat_meas_temp = Enable;
+	Params.press_osrs = Profile->pressOsrs;
+	Params.temp_osrs = Profile->tempOsrs;
+
+	duty = (float)BMP390_Calc_MeasTime(&Params) / (float)BMP390_Calc_OdrPeriod((BMP390_ODR_TypeDef)Profile->odr);
+
+	if(duty > 1.0f){
+
+		duty = 1.0f;
+	}
+
+	return (duty * BMP390_Gov_ActiveCurrent) + ((1.0f - duty) * BMP390_Gov_StandbyCurrent);
+}
+
+
+static _Bool BMP390_Governor_Write(BMP390_Governor_TypeDef *Gov, BMP390_HandleTypeDef *BMP390, uint8_t reg, uint8_t value){
+
+	Gov->Stats.writes++;
+
+	return (BMP390_Bus_Write(BMP390, reg, &value, 1) == BMP390_Bus_OK);
+}
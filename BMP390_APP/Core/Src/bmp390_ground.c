@@ -0,0 +1,179 @@
+/*!
+ *  @file : bmp390_ground.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * NOTE ==> FixedAltitude is taken once at the boot, the weather moves the ground pressure by a few hundred Pa in
+ * 			a day, tens of metres of fake altitude. The tracker moves FixedAltitude toward the ground while the
+ * 			vehicle provably stands still : the spread of the altitude is the noise of the sensor and its trend is
+ * 			no faster than the weather. Any motion freezes the reference at once and it follows again only after
+ * 			hold at rest, so a slow lift or a walk to the pad is never zeroed out. Only the pad is tracked, the
+ * 			altitude after the landing keeps the reference of the launch.
+ */
+
+#include "bmp390_ground.h"
+
+
+void BMP390_Ground_Init(BMP390_Ground_TypeDef *Ground, const BMP390_Ground_Config_TypeDef *Config){
+
+	if(Config != NULL){
+
+		Ground->Config = *Config;
+	}
+	else{
+
+		BMP390_Ground_DefaultConfig(&Ground->Config);
+	}
+
+	Ground->ref = 0.0f;
+	Ground->startRef = 0.0f;
+	Ground->mean = 0.0f;
+	Ground->var = 0.0f;
+	Ground->rate = 0.0f;
+	Ground->lastTime = 0;
+	Ground->quietSince = 0;
+	Ground->atRest = false;
+	Ground->primed = false;
+
+	Ground->Stats.motions = 0;
+	Ground->Stats.restTime = 0;
+	Ground->Stats.minRef = 0.0f;
+	Ground->Stats.maxRef = 0.0f;
+}
+
+
+void BMP390_Ground_DefaultConfig(BMP390_Ground_Config_TypeDef *Config){
+
+	Config->fastTau = 5.0f;
+	Config->rateTau = 20.0f;
+	Config->refTau = 60.0f;
+	Config->maxStd = 0.5f;
+	Config->maxRate = 0.02f;
+	Config->hold = 30000;
+}
+
+
+_Bool BMP390_Ground_Update(BMP390_Ground_TypeDef *Ground, BMP390_HandleTypeDef *BMP390,
+						   const BMP390_Flight_TypeDef *Flight, const BMP390_Sample_TypeDef *Sample){
+
+	const BMP390_Ground_Config_TypeDef *Cfg = &Ground->Config;
+	float dt, alt, prevMean, residual, k, shift;
+	_Bool quiet;
+
+	if(BMP390->Ref_Alt_Sel != 'm'){
+
+		return false;
+	}
+
+	//Back over the standard sea level, the sample was processed with the current reference
+	alt = Sample->vertAlt + BMP390->FixedAltitude;
+
+	if(!Ground->primed){
+
+		Ground->ref = BMP390->FixedAltitude;
+		Ground->startRef = BMP390->FixedAltitude;
+		Ground->Stats.minRef = BMP390->FixedAltitude;
+		Ground->Stats.maxRef = BMP390->FixedAltitude;
+		Ground->mean = alt;
+		Ground->lastTime = Sample->timestamp;
+		Ground->quietSince = Sample->timestamp;
+		Ground->primed = true;
+
+		return false;
+	}
+
+	if(Sample->timestamp == Ground->lastTime){
+
+		return false;
+	}
+
+	dt = (float)(Sample->timestamp - Ground->lastTime) * 0.001f;
+
+	//Exponentially weighted mean and variance of the altitude, trend of the mean
+	k = dt / (Cfg->fastTau + dt);
+	prevMean = Ground->mean;
+	residual = alt - Ground->mean;
+	Ground->mean += k * residual;
+	Ground->var = (1.0f - k) * (Ground->var + (k * residual * residual));
+	Ground->rate += (dt / (Cfg->rateTau + dt)) * (((Ground->mean - prevMean) / dt) - Ground->rate);
+
+	quiet = (Ground->var < (Cfg->maxStd * Cfg->maxStd)) && (Ground->rate < Cfg->maxRate) && (Ground->rate > -Cfg->maxRate);
+
+	if((Flight != NULL) && (Flight->state != BMP390_Flight_Pad)){
+
+		quiet = false;
+	}
+
+	if(!quiet){
+
+		if(Ground->atRest){
+
+			Ground->Stats.motions++;
+		}
+
+		Ground->atRest = false;
+		Ground->quietSince = Sample->timestamp;
+	}
+	else if((Sample->timestamp - Ground->quietSince) >= Cfg->hold){
+
+		if(Ground->atRest){
+
+			Ground->Stats.restTime += Sample->timestamp - Ground->lastTime;
+		}
+
+		Ground->atRest = true;
+	}
+
+	Ground->lastTime = Sample->timestamp;
+
+	if(!Ground->atRest){
+
+		return false;
+	}
+
+	//The reference follows the smoothed ground, the previous altitude moves with it
+	shift = (dt / (Cfg->refTau + dt)) * (Ground->mean - Ground->ref);
+	Ground->ref += shift;
+	BMP390->FixedAltitude = Ground->ref;
+	BMP390->DeltaData.alt0 -= shift;
+
+	if(Ground->ref < Ground->Stats.minRef) Ground->Stats.minRef = Ground->ref;
+	if(Ground->ref > Ground->Stats.maxRef) Ground->Stats.maxRef = Ground->ref;
+
+	return true;
+}
+
+
+float BMP390_Ground_Drift(const BMP390_Ground_TypeDef *Ground){
+
+	return Ground->ref - Ground->startRef;
+}
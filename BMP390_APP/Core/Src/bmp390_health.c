@@ -0,0 +1,105 @@
+/*!
+ *  @file : bmp390_health.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * NOTE ==> ERR, STATUS, EVENT and INT_STATUS come with every frame (BMP390_Read_RawFrame reads 0x02 .. 0x11),
+ * 			so watching them costs 5 bytes of the burst instead of extra transfers. At 100 kHz the burst grows
+ * 			from 126 to 171 bit times, 1.26 ms to 1.71 ms per sample. Reading ERR and EVENT on their own would
+ * 			take two more transfers of 36 bit times each plus their HAL overhead.
+ * 			EVENT, cmd_err and conf_err are cleared by the read, every fault is seen exactly once.
+ */
+
+#include "bmp390_health.h"
+#include "bmp390_bus.h"
+
+
+BMP390_Health_Stats_TypeDef BMP390_Health_Stats;
+
+
+_Bool BMP390_Health_Check(BMP390_HandleTypeDef *BMP390, const BMP390_StatusRegs_TypeDef *Regs){
+
+	_Bool fatal = (Regs->err & BMP390_Error_Fatal) != 0;
+	_Bool lost;
+
+	BMP390_Health_Stats.frames++;
+	BMP390->ERR = Regs->err;
+
+	if((Regs->err == 0) && ((Regs->event & BMP390_Event_por_detected) == 0)){
+
+		return true;
+	}
+
+	if(Regs->event & BMP390_Event_por_detected) BMP390_Health_Stats.faults[BMP390_Health_Por]++;
+	if(Regs->err & BMP390_Error_Fatal)          BMP390_Health_Stats.faults[BMP390_Health_Fatal]++;
+	if(Regs->err & BMP390_Error_Command)        BMP390_Health_Stats.faults[BMP390_Health_Cmd]++;
+	if(Regs->err & BMP390_Error_Configuration)  BMP390_Health_Stats.faults[BMP390_Health_Conf]++;
+
+	//A rejected command doesn't touch the measurement, everything else means the registers can't be trusted
+	lost = fatal || (Regs->event & BMP390_Event_por_detected) || (Regs->err & BMP390_Error_Configuration);
+
+	if(!lost){
+
+		return true;
+	}
+
+	BMP390_Health_Stats.droppedFrames++;
+	BMP390_Health_Restore(BMP390, fatal);
+
+	return false;
+}
+
+
+_Bool BMP390_Health_Restore(BMP390_HandleTypeDef *BMP390, _Bool reset){
+
+	_Bool ok = true;
+	uint8_t EVENT;
+
+	BMP390_Health_Stats.restores++;
+
+	if(reset){
+
+		//The soft reset sets por_detected as well, it is read away so the next frame doesn't restore again
+		ok = BMP390_Soft_Reset(BMP390) &&
+			 (BMP390_Bus_Read(BMP390, BMP390_REG_EVENT, &EVENT, 1) == BMP390_Bus_OK);
+	}
+
+	//The upload also reads ERR back, a conf_err that comes again fails here
+	ok = ok && BMP390_Upload_ConfigParams(BMP390);
+
+	if(!ok){
+
+		BMP390_Health_Stats.failedRestores++;
+	}
+
+	return ok;
+}
@@ -0,0 +1,158 @@
+/*!
+ *  @file : bmp390_iir.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * NOTE ==> The sensor filters with data_filt = (data_filt_prev * coef + data_in) / (coef + 1), coef = 2^n - 1.
+ * 			It is the same as data_filt += (data_in - data_filt) >> n, which is what runs here on raw counts in Q7.
+ * 			The shift alone would floor every step : a state within 2^n Q7 units (one count at coef 127) below
+ * 			the input would never move while one above it always would. The dropped bits are carried into the
+ * 			next difference instead, the rounding error doesn't build up and the dead band is 1/128 of a count.
+ * 			With the FIFO on unfiltered data the raw stream stays available for fast detection and any number of
+ * 			strengths come out of it, the filter of the data registers only gives one.
+ */
+
+#include "bmp390_iir.h"
+
+
+
+
+_Bool BMP390_Iir_Init(BMP390_Iir_TypeDef *Iir, const BMP390_FilterCoef_TypeDef *coefs, uint8_t n){
+
+	if((n == 0) || (n > BMP390_Iir_MaxFilters)){
+
+		return false;
+	}
+
+	for(uint8_t k = 0; k < n; k++){
+
+		if(coefs[k] > BMP390_Filter_Coef_127){
+
+			return false;
+		}
+
+		Iir->Filter[k].shift = (uint8_t)coefs[k];
+		Iir->Filter[k].press = 0;
+		Iir->Filter[k].temp = 0;
+		Iir->Filter[k].pressRem = 0;
+		Iir->Filter[k].tempRem = 0;
+	}
+
+	Iir->n = n;
+	BMP390_Iir_Reset(Iir);
+
+	return true;
+}
+
+
+void BMP390_Iir_Reset(BMP390_Iir_TypeDef *Iir){
+
+	Iir->primed = false;
+	Iir->samples = 0;
+}
+
+
+void BMP390_Iir_Update(BMP390_Iir_TypeDef *Iir, const BMP390_RawFrame_TypeDef *Frame){
+
+	uint32_t press = Frame->rawPress << BMP390_Iir_Frac;
+	uint32_t temp = Frame->rawTemp << BMP390_Iir_Frac;
+	BMP390_IirFilter_TypeDef *Filter = Iir->Filter;
+
+	if(!Iir->primed){
+
+		for(uint8_t k = 0; k < Iir->n; k++){
+
+			Filter[k].press = press;
+			Filter[k].temp = temp;
+			Filter[k].pressRem = 0;
+			Filter[k].tempRem = 0;
+		}
+
+		Iir->primed = true;
+	}
+	else{
+
+		//Both are below 2^31, the difference and the carried bits fit in an int32_t and the shift keeps the sign
+		for(uint8_t k = 0; k < Iir->n; k++){
+
+			uint32_t mask = (1u << Filter[k].shift) - 1u;
+			int32_t dp = (int32_t)(press - Filter[k].press) + Filter[k].pressRem;
+			int32_t dt = (int32_t)(temp - Filter[k].temp) + Filter[k].tempRem;
+
+			Filter[k].press += (uint32_t)(dp >> Filter[k].shift);
+			Filter[k].temp += (uint32_t)(dt >> Filter[k].shift);
+			Filter[k].pressRem = (uint8_t)((uint32_t)dp & mask);
+			Filter[k].tempRem = (uint8_t)((uint32_t)dt & mask);
+		}
+	}
+
+	Iir->samples++;
+}
+
+
+void BMP390_Iir_Batch(BMP390_Iir_TypeDef *Iir, const BMP390_RawFrame_TypeDef *Frames, uint16_t n, BMP390_RawFrame_TypeDef *Out){
+
+	for(uint16_t i = 0; i < n; i++){
+
+		BMP390_Iir_Update(Iir, &Frames[i]);
+
+		if(Out != NULL){
+
+			for(uint8_t k = 0; k < Iir->n; k++){
+
+				Out->rawPress = BMP390_Iir_Press(Iir, k);
+				Out->rawTemp = BMP390_Iir_Temp(Iir, k);
+				Out->sensortime = Frames[i].sensortime;
+				Out++;
+			}
+		}
+	}
+}
+
+
+uint32_t BMP390_Iir_Benchmark(BMP390_Iir_TypeDef *Iir, const BMP390_RawFrame_TypeDef *Frames, uint16_t n){
+
+	uint32_t start;
+
+	if((n == 0) || (Iir->n == 0)){
+
+		return 0;
+	}
+
+	BMP390_Iir_Reset(Iir);
+
+	start = BMP390_Cycles();
+
+	BMP390_Iir_Batch(Iir, Frames, n, NULL);
+
+	return (BMP390_Cycles() - start) / ((uint32_t)n * Iir->n);
+}
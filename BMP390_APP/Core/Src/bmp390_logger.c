@@ -0,0 +1,357 @@
+/*!
+ *  @file : bmp390_logger.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * NOTE ==> The timer interrupt only copies the raw frame into the RAM queue. The main loop programs the flash
+ * 			half-word by half-word and erases the page after the current one while it is still filling it,
+ * 			so a page switch never waits for an erase. The erase itself still delays samples : the F103 has a
+ * 			single flash bank, the core can't fetch for the 20 to 40 ms it runs and the TIM1 interrupt is held
+ * 			pending until it ends. At the 1 s period that is a late sample once every 112 records, above about
+ * 			25 Hz updates are lost (only one stays pending). Pages are reused in order, every page wears the same.
+ */
+
+#include "bmp390_logger.h"
+#include "string.h"
+
+
+#define BMP390_Log_Page(p)		((const uint8_t *)(uintptr_t)(BMP390_Log_Start + ((uint32_t)(p) * BMP390_Log_PageSize)))
+
+static _Bool BMP390_Logger_PageSeq(const uint8_t *page, uint32_t *seq);
+static _Bool BMP390_Logger_IsBlank(const uint8_t *data, uint16_t len);
+static _Bool BMP390_Logger_Erase(uint8_t page);
+static _Bool BMP390_Logger_Program(uint32_t address, const uint8_t *data, uint16_t len);
+static _Bool BMP390_Logger_OpenNext(BMP390_Logger_TypeDef *Log);
+static _Bool BMP390_Logger_WritePair(BMP390_Logger_TypeDef *Log, uint8_t n);
+
+
+_Bool BMP390_Logger_Init(BMP390_Logger_TypeDef *Log){
+
+	uint32_t seq;
+	_Bool found = false;
+
+	Log->head = 0;
+	Log->tail = 0;
+	Log->records = 0;
+	Log->droppedRecords = 0;
+	Log->flashErrors = 0;
+
+	for(uint8_t i = 0; i < BMP390_Log_Pages; i++){
+
+		if(BMP390_Logger_PageSeq(BMP390_Log_Page(i), &seq) && (!found || seq > Log->seq)){
+
+			found = true;
+			Log->page = i;
+			Log->seq = seq;
+		}
+	}
+
+	if(!found){
+
+		//Empty or foreign content, start with the last page so that OpenNext begins the log at page 0
+		Log->page = BMP390_Log_Pages - 1;
+		Log->seq = 0;
+		Log->pair = BMP390_Log_PairsPerPage;
+		Log->nextErased = false;
+
+		return BMP390_Logger_OpenNext(Log);
+	}
+
+	Log->pair = 0;
+	while(Log->pair < BMP390_Log_PairsPerPage &&
+		  !BMP390_Logger_IsBlank(BMP390_Log_Page(Log->page) + BMP390_Log_HeaderSize + (Log->pair * BMP390_Log_PairSize), BMP390_Log_PairSize)){
+
+		Log->pair++;
+	}
+
+	Log->nextErased = BMP390_Logger_IsBlank(BMP390_Log_Page((Log->page + 1) % BMP390_Log_Pages), BMP390_Log_PageSize);
+
+	return true;
+}
+
+
+_Bool BMP390_Logger_Push(BMP390_Logger_TypeDef *Log, const BMP390_RawFrame_TypeDef *Frame){
+
+	uint8_t head = Log->head;
+
+	if((uint8_t)(head - Log->tail) >= BMP390_Log_QueueLen){
+
+		Log->droppedRecords++;
+		return false;
+	}
+
+	Log->queue[head & (BMP390_Log_QueueLen - 1)] = *Frame;
+	Log->head = head + 1;
+
+	return true;
+}
+
+
+_Bool BMP390_Logger_Task(BMP390_Logger_TypeDef *Log){
+
+	_Bool ok = true;
+
+	while(ok && (uint8_t)(Log->head - Log->tail) >= 2){
+
+		ok = BMP390_Logger_WritePair(Log, 2);
+	}
+
+	if(ok && !Log->nextErased){
+
+		ok = BMP390_Logger_Erase((Log->page + 1) % BMP390_Log_Pages);
+		Log->nextErased = ok;
+	}
+
+	return ok;
+}
+
+
+_Bool BMP390_Logger_Flush(BMP390_Logger_TypeDef *Log){
+
+	_Bool ok = BMP390_Logger_Task(Log);
+
+	if(ok && (uint8_t)(Log->head - Log->tail) == 1){
+
+		ok = BMP390_Logger_WritePair(Log, 1);
+	}
+
+	return ok;
+}
+
+
+uint32_t BMP390_Logger_Parse(const uint8_t *dump, uint32_t size, BMP390_Logger_Callback_t cb, void *ctx){
+
+	uint32_t pages = size / BMP390_Log_PageSize;
+	uint32_t index = 0;
+	uint32_t lastSeq = 0;
+	_Bool first = true;
+
+	for(;;){
+
+		//Next page in sequence order, the one with the smallest seq after lastSeq
+		const uint8_t *page = NULL;
+		uint32_t pageSeq = 0;
+		uint32_t seq;
+
+		for(uint32_t i = 0; i < pages; i++){
+
+			if(BMP390_Logger_PageSeq(dump + (i * BMP390_Log_PageSize), &seq) &&
+			   (first || seq > lastSeq) && (page == NULL || seq < pageSeq)){
+
+				page = dump + (i * BMP390_Log_PageSize);
+				pageSeq = seq;
+			}
+		}
+
+		if(page == NULL){
+
+			return index;
+		}
+
+		first = false;
+		lastSeq = pageSeq;
+
+		for(uint16_t p = 0; p < BMP390_Log_PairsPerPage; p++){
+
+			const uint8_t *pair = page + BMP390_Log_HeaderSize + (p * BMP390_Log_PairSize);
+
+			if(BMP390_Logger_IsBlank(pair, BMP390_Log_PairSize)){
+
+				break;
+			}
+
+			for(uint8_t r = 0; r < 2; r++){
+
+				const uint8_t *rec = pair + (r * BMP390_Log_RecordSize);
+				BMP390_RawFrame_TypeDef frame;
+
+				if(BMP390_Logger_IsBlank(rec, BMP390_Log_RecordSize)){
+
+					continue;
+				}
+
+				frame.rawPress   = rec[0] | (rec[1] << 8) | ((uint32_t)rec[2] << 16);
+				frame.rawTemp    = rec[3] | (rec[4] << 8) | ((uint32_t)rec[5] << 16);
+				frame.sensortime = rec[6] | (rec[7] << 8) | ((uint32_t)rec[8] << 16);
+
+				if(cb != NULL){
+
+					cb(ctx, index, &frame);
+				}
+
+				index++;
+			}
+		}
+	}
+}
+
+
+/**
+ * @brief  A page is valid once its magic is programmed, the magic is programmed after the seq.
+ */
+static _Bool BMP390_Logger_PageSeq(const uint8_t *page, uint32_t *seq){
+
+	if((page[0] | (page[1] << 8)) != BMP390_Log_Magic){
+
+		return false;
+	}
+
+	*seq = page[2] | (page[3] << 8) | ((uint32_t)page[4] << 16) | ((uint32_t)page[5] << 24);
+
+	return true;
+}
+
+
+static _Bool BMP390_Logger_IsBlank(const uint8_t *data, uint16_t len){
+
+	while(len--){
+
+		if(*data++ != 0xFF){
+
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+static _Bool BMP390_Logger_Erase(uint8_t page){
+
+	FLASH_EraseInitTypeDef erase = {0};
+	uint32_t pageError = 0;
+	HAL_StatusTypeDef status;
+
+	erase.TypeErase = FLASH_TYPEERASE_PAGES;
+	erase.Banks = FLASH_BANK_1;
+	erase.PageAddress = BMP390_Log_Start + ((uint32_t)page * BMP390_Log_PageSize);
+	erase.NbPages = 1;
+
+	HAL_FLASH_Unlock();
+	status = HAL_FLASHEx_Erase(&erase, &pageError);
+	HAL_FLASH_Lock();
+
+	return status == HAL_OK;
+}
+
+
+/**
+ * @brief  len must be even, the flash is programmed by half-words.
+ */
+static _Bool BMP390_Logger_Program(uint32_t address, const uint8_t *data, uint16_t len){
+
+	HAL_StatusTypeDef status = HAL_OK;
+
+	HAL_FLASH_Unlock();
+
+	for(uint16_t i = 0; i < len && status == HAL_OK; i += 2){
+
+		status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_HALFWORD, address + i, data[i] | (data[i + 1] << 8));
+	}
+
+	HAL_FLASH_Lock();
+
+	return status == HAL_OK;
+}
+
+
+static _Bool BMP390_Logger_OpenNext(BMP390_Logger_TypeDef *Log){
+
+	uint8_t next = (Log->page + 1) % BMP390_Log_Pages;
+	uint32_t address = BMP390_Log_Start + ((uint32_t)next * BMP390_Log_PageSize);
+	uint32_t seq = Log->seq + 1;
+	uint8_t seqBytes[4] = { seq, seq >> 8, seq >> 16, seq >> 24 };
+	uint8_t magic[2] = { (uint8_t)BMP390_Log_Magic, BMP390_Log_Magic >> 8 };
+
+	if(!Log->nextErased && !BMP390_Logger_Erase(next)){
+
+		Log->flashErrors++;
+		return false;
+	}
+
+	if(!BMP390_Logger_Program(address + 2, seqBytes, sizeof(seqBytes)) ||
+	   !BMP390_Logger_Program(address, magic, sizeof(magic))){
+
+		Log->flashErrors++;
+		return false;
+	}
+
+	Log->page = next;
+	Log->seq = seq;
+	Log->pair = 0;
+	Log->nextErased = false;
+
+	return true;
+}
+
+
+/**
+ * @brief  Takes n (1 or 2) records from the queue and programs them as one pair, a missing record stays 0xFF.
+ */
+static _Bool BMP390_Logger_WritePair(BMP390_Logger_TypeDef *Log, uint8_t n){
+
+	uint8_t pair[BMP390_Log_PairSize];
+	uint32_t address;
+
+	if(Log->pair >= BMP390_Log_PairsPerPage && !BMP390_Logger_OpenNext(Log)){
+
+		return false;
+	}
+
+	memset(pair, 0xFF, sizeof(pair));
+
+	for(uint8_t r = 0; r < n; r++){
+
+		const BMP390_RawFrame_TypeDef *frame = &Log->queue[(uint8_t)(Log->tail + r) & (BMP390_Log_QueueLen - 1)];
+		uint8_t *rec = &pair[r * BMP390_Log_RecordSize];
+
+		rec[0] = frame->rawPress;   rec[1] = frame->rawPress >> 8;   rec[2] = frame->rawPress >> 16;
+		rec[3] = frame->rawTemp;    rec[4] = frame->rawTemp >> 8;    rec[5] = frame->rawTemp >> 16;
+		rec[6] = frame->sensortime; rec[7] = frame->sensortime >> 8; rec[8] = frame->sensortime >> 16;
+	}
+
+	//The records leave the queue even if programming fails, a bad pair must not block the log
+	Log->tail = Log->tail + n;
+
+	address = BMP390_Log_Start + ((uint32_t)Log->page * BMP390_Log_PageSize) + BMP390_Log_HeaderSize + ((uint32_t)Log->pair * BMP390_Log_PairSize);
+	Log->pair++;
+
+	if(!BMP390_Logger_Program(address, pair, sizeof(pair))){
+
+		Log->flashErrors++;
+		return false;
+	}
+
+	Log->records += n;
+
+	return true;
+}
@@ -0,0 +1,367 @@
+/*!
+ *  @file : bmp390_lowpower.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * NOTE ==> In normal mode the sensor converts all the time and the MCU spins in the main loop. Here the sensor sleeps
+ * 			between forced conversions and the MCU is in Stop mode, only the RTC (LSI) and the EXTI lines run :
+ *
+ * 				RTC alarm -> wake, PWR_CTRL forced (1 byte) -> Stop -> INT edge -> wake, burst read -> Stop
+ *
+ * 			Every batch of samples is processed in one go. The system clock is HSI, which is also the clock after
+ * 			Stop mode, so nothing has to be restored after a wake-up.
+ */
+
+#include "bmp390_lowpower.h"
+#include "bmp390_bus.h"
+
+
+static _Bool BMP390_LowPower_RtcInit(void);
+static void BMP390_LowPower_SetAlarm(uint32_t alarm);
+static void BMP390_LowPower_RtcWait(void);
+static _Bool BMP390_LowPower_Read(BMP390_LowPower_TypeDef *Lp);
+
+
+_Bool BMP390_LowPower_Init(BMP390_LowPower_TypeDef *Lp, BMP390_HandleTypeDef *BMP390, uint32_t period, uint8_t batch){
+
+	GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+	Lp->BMP390 = BMP390;
+	Lp->period = period;
+	Lp->batch = batch;
+	Lp->alarm = false;
+	Lp->drdy = false;
+	Lp->converting = false;
+	Lp->n = 0;
+	Lp->Stats = (BMP390_Lp_Stats_TypeDef){0};
+
+	if((batch == 0) || (batch > BMP390_Lp_MaxBatch) || (period == 0)){
+
+		return false;
+
+	}
+
+	BMP390->Params.mode = BMP390_Mode_Forced;
+	BMP390->Params.int_out = BMP390_Int_Out_PP;
+	BMP390->Params.int_level = BMP390_Int_Level_A_H;
+	BMP390->Params.stat_int_latch = Enable;			//Released by the INT_STATUS byte of the frame read
+	BMP390->Params.stat_int_drdy = Enable;
+
+	if((BMP390_Calc_MeasTime(&BMP390->Params) / 1000u) >= period){
+
+		return false;
+
+	}
+
+	BMP390_Lp_IntClkEnable();
+
+	GPIO_InitStruct.Pin = BMP390_Lp_IntPin;
+	GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING;
+	GPIO_InitStruct.Pull = GPIO_PULLDOWN;
+	HAL_GPIO_Init(BMP390_Lp_IntPort, &GPIO_InitStruct);
+
+	HAL_NVIC_SetPriority(BMP390_Lp_IntIRQn, 1, 0);
+	HAL_NVIC_EnableIRQ(BMP390_Lp_IntIRQn);
+
+	//The upload starts a first conversion, its INT edge is the first sample
+	Lp->converting = true;
+
+	if(!BMP390_Upload_ConfigParams(BMP390)){
+
+		return false;
+
+	}
+
+	if(!BMP390_LowPower_RtcInit()){
+
+		return false;
+
+	}
+
+	Lp->startTime = BMP390_LowPower_Millis();
+	Lp->nextAlarm = Lp->startTime + period;
+	BMP390_LowPower_SetAlarm(Lp->nextAlarm);
+
+	HAL_NVIC_SetPriority(RTC_Alarm_IRQn, 1, 0);
+	HAL_NVIC_EnableIRQ(RTC_Alarm_IRQn);
+
+	Lp->wakeCycles = BMP390_Cycles();
+
+	return true;
+}
+
+
+void BMP390_LowPower_AlarmIRQHandler(BMP390_LowPower_TypeDef *Lp){
+
+	RTC->CRL &= ~RTC_CRL_ALRF;
+	EXTI->PR = BMP390_Lp_RtcLine;
+
+	Lp->alarm = true;
+}
+
+
+void BMP390_LowPower_IntIRQHandler(BMP390_LowPower_TypeDef *Lp){
+
+	__HAL_GPIO_EXTI_CLEAR_IT(BMP390_Lp_IntPin);
+
+	Lp->drdy = true;
+}
+
+
+uint8_t BMP390_LowPower_Task(BMP390_LowPower_TypeDef *Lp, BMP390_Lp_Callback_t cb, void *ctx){
+
+	BMP390_HandleTypeDef *BMP390 = Lp->BMP390;
+	uint8_t PWR_CTRL;
+	uint32_t start, now;
+	uint8_t n = 0;
+
+	if(Lp->drdy){
+
+		Lp->drdy = false;
+		Lp->converting = false;
+		BMP390_LowPower_Read(Lp);
+	}
+
+	if(Lp->alarm){
+
+		Lp->alarm = false;
+
+		//No edge since the last trigger, the read releases a pin that was latched without an edge
+		if(Lp->converting){
+
+			Lp->Stats.missed++;
+			BMP390_LowPower_Read(Lp);
+		}
+
+		PWR_CTRL = ((BMP390_Mode_Forced)<<4) |
+				   ((BMP390->Params.stat_meas_temp)<<1) |
+				   ((BMP390->Params.stat_meas_press)<<0);
+
+		start = BMP390_Cycles();
+
+		if(BMP390_Bus_Write(BMP390, BMP390_REG_PWR_CTRL, &PWR_CTRL, 1) == BMP390_Bus_OK){
+
+			Lp->converting = true;
+		}
+
+		Lp->Stats.busCycles += BMP390_Cycles() - start;
+
+		//The alarms stay on the period grid, unless the processing took longer than a period
+		now = BMP390_LowPower_Millis();
+		Lp->nextAlarm += Lp->period;
+
+		if((int32_t)(Lp->nextAlarm - now) <= 0){
+
+			Lp->nextAlarm = now + Lp->period;
+		}
+
+		BMP390_LowPower_SetAlarm(Lp->nextAlarm);
+	}
+
+	if(Lp->n >= Lp->batch){
+
+		for(uint8_t i = 0; i < Lp->n; i++){
+
+			if(cb != NULL){
+
+				cb(ctx, &Lp->frame[i], Lp->time[i]);
+			}
+		}
+
+		n = Lp->n;
+		Lp->n = 0;
+		Lp->Stats.batches++;
+	}
+
+	return n;
+}
+
+
+void BMP390_LowPower_Sleep(BMP390_LowPower_TypeDef *Lp, _Bool deep){
+
+	__disable_irq();
+
+	//WFI would wait for the next event, an event that is already here goes through BMP390_LowPower_Task first
+	if(Lp->alarm || Lp->drdy || (Lp->n >= Lp->batch)){
+
+		__enable_irq();
+		return;
+
+	}
+
+	Lp->Stats.activeCycles += BMP390_Cycles() - Lp->wakeCycles;
+
+	HAL_SuspendTick();
+
+	if(deep){
+
+		Lp->Stats.stops++;
+		HAL_PWR_EnterSTOPMode(PWR_LOWPOWERREGULATOR_ON, PWR_STOPENTRY_WFI);
+
+		//The RTC registers are read through the APB1 again after Stop mode, they have to resynchronize
+		RTC->CRL &= ~RTC_CRL_RSF;
+		while((RTC->CRL & RTC_CRL_RSF) == 0);
+	}
+	else{
+
+		Lp->Stats.sleeps++;
+		HAL_PWR_EnterSLEEPMode(PWR_MAINREGULATOR_ON, PWR_SLEEPENTRY_WFI);
+	}
+
+	HAL_ResumeTick();
+
+	Lp->wakeCycles = BMP390_Cycles();
+	Lp->Stats.wakes++;
+
+	__enable_irq();
+}
+
+
+uint32_t BMP390_LowPower_Millis(void){
+
+	uint16_t high = RTC->CNTH;
+	uint16_t low = RTC->CNTL;
+
+	//CNTL wrapped between the two reads
+	if(RTC->CNTH != high){
+
+		high = RTC->CNTH;
+		low = RTC->CNTL;
+	}
+
+	return ((uint32_t)high << 16) | low;
+}
+
+
+void BMP390_LowPower_Report(const BMP390_LowPower_TypeDef *Lp, BMP390_Lp_Report_TypeDef *Report){
+
+	float elapsed = (float)(BMP390_LowPower_Millis() - Lp->startTime);		//ms
+	float cyclesPerMs = (float)SystemCoreClock / 1000.0f;
+	float hour = (elapsed > 0.0f) ? (3600000.0f / elapsed) : 0.0f;
+
+	Report->wakes = (float)Lp->Stats.wakes * hour;
+	Report->activeCycles = (float)Lp->Stats.activeCycles * hour;
+	Report->busMs = ((float)Lp->Stats.busCycles / cyclesPerMs) * hour;
+	Report->duty = (elapsed > 0.0f) ? ((float)Lp->Stats.activeCycles / (elapsed * cyclesPerMs)) : 0.0f;
+}
+
+
+/**
+ * @brief  Burst read of the finished conversion into the batch, a duplicate or a failed read is skipped.
+ */
+static _Bool BMP390_LowPower_Read(BMP390_LowPower_TypeDef *Lp){
+
+	BMP390_RawFrame_TypeDef frame;
+	uint32_t start = BMP390_Cycles();
+	_Bool ok;
+
+	ok = BMP390_Read_RawFrame(Lp->BMP390, &frame, NULL);
+
+	Lp->Stats.busCycles += BMP390_Cycles() - start;
+
+	if(!ok || (Lp->n >= BMP390_Lp_MaxBatch)){
+
+		return false;
+	}
+
+	Lp->frame[Lp->n] = frame;
+	Lp->time[Lp->n] = BMP390_LowPower_Millis();
+	Lp->n++;
+	Lp->Stats.samples++;
+
+	return true;
+}
+
+
+/**
+ * @brief  RTC from the LSI with a 1 ms tick and its alarm on EXTI line 17 (rising edge).
+ */
+static _Bool BMP390_LowPower_RtcInit(void){
+
+	uint32_t start = HAL_GetTick();
+
+	__HAL_RCC_PWR_CLK_ENABLE();
+	__HAL_RCC_BKP_CLK_ENABLE();
+	HAL_PWR_EnableBkUpAccess();
+
+	__HAL_RCC_LSI_ENABLE();
+
+	while(__HAL_RCC_GET_FLAG(RCC_FLAG_LSIRDY) == RESET){
+
+		if((HAL_GetTick() - start) > 2){
+
+			return false;
+		}
+	}
+
+	__HAL_RCC_RTC_CONFIG(RCC_RTCCLKSOURCE_LSI);
+	__HAL_RCC_RTC_ENABLE();
+
+	RTC->CRL &= ~RTC_CRL_RSF;
+	while((RTC->CRL & RTC_CRL_RSF) == 0);
+
+	BMP390_LowPower_RtcWait();
+	RTC->CRL |= RTC_CRL_CNF;
+	RTC->PRLH = 0;
+	RTC->PRLL = (BMP390_Lp_LsiHz / 1000u) - 1u;
+	RTC->CNTH = 0;
+	RTC->CNTL = 0;
+	RTC->CRL &= ~RTC_CRL_CNF;
+	BMP390_LowPower_RtcWait();
+
+	RTC->CRH |= RTC_CRH_ALRIE;
+
+	EXTI->IMR |= BMP390_Lp_RtcLine;
+	EXTI->RTSR |= BMP390_Lp_RtcLine;
+
+	return true;
+}
+
+
+static void BMP390_LowPower_SetAlarm(uint32_t alarm){
+
+	BMP390_LowPower_RtcWait();
+	RTC->CRL |= RTC_CRL_CNF;
+	RTC->ALRH = (uint16_t)(alarm >> 16);
+	RTC->ALRL = (uint16_t)(alarm & 0xFFFF);
+	RTC->CRL &= ~RTC_CRL_CNF;
+	BMP390_LowPower_RtcWait();
+}
+
+
+/**
+ * @brief  The previous write to the RTC registers has to be finished before the next one (RTOFF).
+ */
+static void BMP390_LowPower_RtcWait(void){
+
+	while((RTC->CRL & RTC_CRL_RTOFF) == 0);
+}
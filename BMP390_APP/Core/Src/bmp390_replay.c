@@ -0,0 +1,165 @@
+/*!
+ *  @file : bmp390_replay.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * NOTE ==> Recorded raw frames go through the same BMP390_Process_RawData as the flight code, nothing is
+ * 			reimplemented here. The module doesn't touch any peripheral, so it is built into host tools as is
+ * 			and the host tool only has to map the log file and pass a pointer to it.
+ */
+
+#include "bmp390_replay.h"
+#include "string.h"
+
+
+static float BMP390_Replay_Diff(float a, float b, float *maxErr);
+
+
+void BMP390_Replay_Init(BMP390_Replay_TypeDef *Replay, const BMP390_PrcsdCalibData_TypeDef *Calib, float fixedAltitude, float totalMass){
+
+	memset(Replay, 0, sizeof(*Replay));
+
+	Replay->BMP390.Prcsd_NVM = *Calib;
+	Replay->BMP390.FixedAltitude = fixedAltitude;
+	Replay->totalMass = totalMass;
+	Replay->tolerance = 0.0f;
+}
+
+
+_Bool BMP390_Replay_Frame(BMP390_Replay_TypeDef *Replay, const BMP390_RawFrame_TypeDef *Frame,
+						  const BMP390_Sample_TypeDef *Expected, BMP390_Sample_TypeDef *Sample){
+
+	_Bool ok = true;
+	BMP390_Replay_Err_TypeDef *maxErr = &Replay->maxErr;
+
+	//The sensortime steps of every ODR are whole milliseconds at the nominal 25.6 kHz
+	if(Expected != NULL){
+
+		Sample->timestamp = Expected->timestamp;
+	}
+	else if(Replay->frames != 0){
+
+		Sample->timestamp = Replay->timestamp +
+							(uint32_t)(((uint64_t)((Frame->sensortime - Replay->sensortime) & BMP390_Sensortime_Mask) * 390625u) / 10000000u);
+	}
+	else{
+
+		Sample->timestamp = 0;
+	}
+
+	Replay->timestamp = Sample->timestamp;
+	Replay->sensortime = Frame->sensortime;
+
+	BMP390_Process_RawData(&Replay->BMP390, Frame->rawPress, Frame->rawTemp, Replay->totalMass, Sample);
+
+	if(Replay->stage != NULL){
+
+		Replay->stage(Replay->stageCtx, Sample);
+	}
+
+	Replay->frames++;
+
+	if(Expected == NULL){
+
+		return true;
+	}
+
+	Replay->compared++;
+
+	//A NaN difference never compares less or equal, a NaN output is a mismatch too
+	ok &= BMP390_Replay_Diff(Sample->press,   Expected->press,   &maxErr->press)   <= Replay->tolerance;
+	ok &= BMP390_Replay_Diff(Sample->temp,    Expected->temp,    &maxErr->temp)    <= Replay->tolerance;
+	ok &= BMP390_Replay_Diff(Sample->vertAlt, Expected->vertAlt, &maxErr->vertAlt) <= Replay->tolerance;
+	ok &= BMP390_Replay_Diff(Sample->vertSpd, Expected->vertSpd, &maxErr->vertSpd) <= Replay->tolerance;
+	ok &= BMP390_Replay_Diff(Sample->vertAcc, Expected->vertAcc, &maxErr->vertAcc) <= Replay->tolerance;
+
+	if(!ok){
+
+		if(Replay->mismatches == 0){
+
+			Replay->firstMismatch = Replay->frames - 1;
+		}
+
+		Replay->mismatches++;
+		return false;
+	}
+
+	return true;
+}
+
+
+_Bool BMP390_Replay_Run(BMP390_Replay_TypeDef *Replay, const BMP390_RawFrame_TypeDef *Frames,
+						const BMP390_Sample_TypeDef *Expected, BMP390_Sample_TypeDef *Out, uint32_t n){
+
+	BMP390_Sample_TypeDef sample;
+	uint32_t mismatches = Replay->mismatches;
+	uint32_t start = (Replay->clock != NULL) ? Replay->clock() : 0;
+
+	for(uint32_t i = 0; i < n; i++){
+
+		BMP390_Replay_Frame(Replay, &Frames[i], (Expected != NULL) ? &Expected[i] : NULL, (Out != NULL) ? &Out[i] : &sample);
+	}
+
+	if(Replay->clock != NULL){
+
+		Replay->elapsedUs += Replay->clock() - start;
+
+		if(Replay->elapsedUs != 0){
+
+			Replay->framesPerSecond = (uint32_t)(((uint64_t)Replay->frames * 1000000u) / Replay->elapsedUs);
+		}
+	}
+
+	return Replay->mismatches == mismatches;
+}
+
+
+void BMP390_Replay_LogCallback(void *ctx, uint32_t index, const BMP390_RawFrame_TypeDef *Frame){
+
+	BMP390_Replay_TypeDef *Replay = (BMP390_Replay_TypeDef *)ctx;
+	BMP390_Sample_TypeDef sample;
+
+	BMP390_Replay_Frame(Replay, Frame, (index < Replay->expectedCount) ? &Replay->expected[index] : NULL, &sample);
+}
+
+
+static float BMP390_Replay_Diff(float a, float b, float *maxErr){
+
+	float diff = (a > b) ? (a - b) : (b - a);
+
+	if(diff > *maxErr || diff != diff){
+
+		*maxErr = diff;
+	}
+
+	return diff;
+}
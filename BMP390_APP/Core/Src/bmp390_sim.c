@@ -0,0 +1,187 @@
+/*!
+ *  @file : bmp390_sim.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * NOTE ==> The true value is turned into raw counts by inverting the compensation of the driver, the noise of
+ * 			one conversion is added in counts and the IIR filter of the sensor runs on the counts. So the output
+ * 			goes through BMP390_Process_RawData exactly like a recorded frame, and its noise after the IIR is
+ * 			BMP390_PressNoise_X1 * BMP390_OsrNoiseFactor * BMP390_IirNoiseFactor.
+ */
+
+#include "bmp390_sim.h"
+
+
+#define BMP390_Sim_MaxRaw			16777215.0f
+
+
+static uint32_t BMP390_Sim_Clamp(double raw);
+
+
+void BMP390_Sim_Init(BMP390_Sim_TypeDef *Sim, const BMP390_PrcsdCalibData_TypeDef *Calib, const BMP390_Params_t *Params, uint32_t seed){
+
+	Sim->Calib = *Calib;
+
+	Sim->pressNoise = BMP390_PressNoise_X1 * BMP390_OsrNoiseFactor(Params->press_osrs);
+	Sim->tempNoise = BMP390_TempNoise_X1 * BMP390_OsrNoiseFactor(Params->temp_osrs);
+	Sim->coef = (float)((1u << Params->filtercoef) - 1u);
+
+	Sim->pressFilt = 0.0;
+	Sim->tempFilt = 0.0;
+	Sim->primed = false;
+
+	Sim->sensortime = 0;
+	Sim->sensortimeStep = (uint32_t)(((uint64_t)BMP390_Calc_OdrPeriod(Params->odr) * BMP390_Sim_SensortimeHz) / 1000000u);
+	Sim->rng = (seed != 0) ? seed : 1;
+}
+
+
+void BMP390_Sim_Step(BMP390_Sim_TypeDef *Sim, float press, float temp, BMP390_RawFrame_TypeDef *Frame){
+
+	float tempSlope, pressSlope;
+	double rawTemp = BMP390_Sim_RawTemp(&Sim->Calib, temp, &tempSlope);
+	double rawPress = BMP390_Sim_RawPress(&Sim->Calib, press, temp, &pressSlope);
+
+	rawTemp += (Sim->tempNoise / tempSlope) * BMP390_Sim_Noise(&Sim->rng);
+	rawPress += (Sim->pressNoise / pressSlope) * BMP390_Sim_Noise(&Sim->rng);
+
+	//IIR of the sensor : data_filt = (data_filt_prev * filter_coef + data_in) / (filter_coef + 1)
+	if(!Sim->primed){
+
+		Sim->tempFilt = rawTemp;
+		Sim->pressFilt = rawPress;
+		Sim->primed = true;
+	}
+	else{
+
+		Sim->tempFilt = ((Sim->tempFilt * Sim->coef) + rawTemp) / (Sim->coef + 1.0);
+		Sim->pressFilt = ((Sim->pressFilt * Sim->coef) + rawPress) / (Sim->coef + 1.0);
+	}
+
+	Frame->rawTemp = BMP390_Sim_Clamp(Sim->tempFilt);
+	Frame->rawPress = BMP390_Sim_Clamp(Sim->pressFilt);
+	Frame->sensortime = Sim->sensortime & 0x00FFFFFF;
+
+	Sim->sensortime += Sim->sensortimeStep;
+}
+
+
+void BMP390_Sim_Generate(BMP390_Sim_TypeDef *Sim, const float *press, const float *temp, float tempConst,
+						 uint32_t n, BMP390_RawFrame_TypeDef *Frames){
+
+	for(uint32_t i = 0; i < n; i++){
+
+		BMP390_Sim_Step(Sim, press[i], (temp != NULL) ? temp[i] : tempConst, &Frames[i]);
+	}
+}
+
+
+double BMP390_Sim_RawTemp(const BMP390_PrcsdCalibData_TypeDef *Calib, float temp, float *slope){
+
+	//temp = T2 * x + T3 * x^2 with x = raw - T1, T3 is tiny so Newton from the linear guess converges at once.
+	//Double, the raw values are ~2^23 where a float is already half a count coarse
+	double x = temp / Calib->T2;
+	double d = Calib->T2;
+
+	for(uint8_t i = 0; i < 3; i++){
+
+		d = Calib->T2 + (2.0 * Calib->T3 * x);
+		x -= ((Calib->T2 * x) + (Calib->T3 * x * x) - temp) / d;
+	}
+
+	if(slope != NULL){
+
+		*slope = (float)d;
+	}
+
+	return x + Calib->T1;
+}
+
+
+double BMP390_Sim_RawPress(const BMP390_PrcsdCalibData_TypeDef *Calib, float press, float temp, float *slope){
+
+	//press = off + sens * r + quad * r^2 + P11 * r^3, the same polynomial as BMP390_Comp_Press
+	double t = temp;
+	double off  = Calib->P5 + (Calib->P6 * t) + (Calib->P7 * t * t) + (Calib->P8 * t * t * t);
+	double sens = Calib->P1 + (Calib->P2 * t) + (Calib->P3 * t * t) + (Calib->P4 * t * t * t);
+	double quad = Calib->P9 + (Calib->P10 * t);
+	double r = (press - off) / sens;
+	double d = sens;
+
+	for(uint8_t i = 0; i < 4; i++){
+
+		d = sens + (2.0 * quad * r) + (3.0 * Calib->P11 * r * r);
+		r -= (off + (sens * r) + (quad * r * r) + (Calib->P11 * r * r * r) - press) / d;
+	}
+
+	if(slope != NULL){
+
+		*slope = (float)d;
+	}
+
+	return r;
+}
+
+
+float BMP390_Sim_Noise(uint32_t *state){
+
+	float sum = 0.0f;
+
+	for(uint8_t i = 0; i < 4; i++){
+
+		uint32_t x = *state;
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		*state = x;
+
+		sum += ((float)x * (2.0f / 4294967296.0f)) - 1.0f;
+	}
+
+	return sum * 0.8660254f;	/*! A uniform of [-1, 1] has a variance of 1/3, sqrt(3/4) */
+}
+
+
+static uint32_t BMP390_Sim_Clamp(double raw){
+
+	if(raw <= 0.0){
+
+		return 0;
+	}
+
+	if(raw >= BMP390_Sim_MaxRaw){
+
+		return 0x00FFFFFF;
+	}
+
+	return (uint32_t)(raw + 0.5);
+}
@@ -0,0 +1,187 @@
+/*!
+ *  @file : bmp390_sweep.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * NOTE ==> Every evaluation is independent, a host program splits the grid indexes between its threads
+ * 			(Tests/bmp390_tool_sweep.c steals index ranges between them) and calls BMP390_Sweep_Evaluate. No state is shared,
+ * 			so the sweep scales with the number of cores. The altitude comes from the driver's own BMP390_Comp_VertAlt.
+ */
+
+#include "bmp390_sweep.h"
+#include "bmp390_sim.h"
+
+
+static float BMP390_Sweep_Abs(float value);
+
+
+void BMP390_Sweep_PrepareFlight(BMP390_Sweep_Flight_TypeDef *Flight){
+
+	float alt0 = BMP390_Comp_VertAlt(Flight->press[0], 0.0f);
+
+	Flight->apogeeIndex = 0;
+	Flight->peakAlt = 0.0f;
+
+	for(uint32_t i = 0; i < Flight->n; i++){
+
+		float alt = (Flight->truthAlt != NULL) ? (Flight->truthAlt[i] - Flight->truthAlt[0])
+											   : (BMP390_Comp_VertAlt(Flight->press[i], 0.0f) - alt0);
+
+		if(alt > Flight->peakAlt){
+
+			Flight->peakAlt = alt;
+			Flight->apogeeIndex = i;
+		}
+	}
+}
+
+
+void BMP390_Sweep_GridConfig(uint32_t index, uint16_t spdSteps, BMP390_Sweep_Config_TypeDef *Config){
+
+	Config->spdAlpha = (float)((index % spdSteps) + 1) / (float)spdSteps;
+	index /= spdSteps;
+
+	Config->pressOsrs = index % BMP390_Sweep_OsrSteps;
+	index /= BMP390_Sweep_OsrSteps;
+
+	Config->filterCoef = index % BMP390_Sweep_FilterSteps;
+	Config->seed = 0x9E3779B9;
+}
+
+
+void BMP390_Sweep_Evaluate(const BMP390_Sweep_Flight_TypeDef *Flight, const BMP390_Sweep_Config_TypeDef *Config,
+						   BMP390_Sweep_Result_TypeDef *Result){
+
+	uint32_t rng = (Config->seed != 0) ? Config->seed : 1;
+	float coef = (float)((1u << Config->filterCoef) - 1u);
+	float noise = Flight->noise * BMP390_OsrNoiseFactor(Config->pressOsrs);
+	float alt0 = BMP390_Comp_VertAlt(Flight->press[0], 0.0f);
+	float truth0 = (Flight->truthAlt != NULL) ? Flight->truthAlt[0] : 0.0f;
+
+	float filtered = Flight->press[0];
+	float prevAlt = 0.0f;
+	float spd = 0.0f;
+	float peak = -1.0e9f;
+	uint32_t peakIndex = 0;
+	int32_t detectIndex = -1;
+	double sumSq = 0.0;
+
+	for(uint32_t i = 0; i < Flight->n; i++){
+
+		float press = Flight->press[i];
+		float alt, truth, err;
+
+		if(noise != 0.0f){
+
+			press += noise * BMP390_Sim_Noise(&rng);
+		}
+
+		//IIR of the sensor : data_filt = (data_filt_prev * filter_coef + data_in) / (filter_coef + 1)
+		filtered = ((filtered * coef) + press) / (coef + 1.0f);
+
+		alt = BMP390_Comp_VertAlt(filtered, 0.0f) - alt0;
+		truth = (Flight->truthAlt != NULL) ? (Flight->truthAlt[i] - truth0)
+										   : (BMP390_Comp_VertAlt(Flight->press[i], 0.0f) - alt0);
+
+		if(i != 0){
+
+			spd += Config->spdAlpha * ((BMP390_Comp_Delta(alt, prevAlt) / Flight->period) - spd);
+		}
+
+		prevAlt = alt;
+
+		err = alt - truth;
+		sumSq += (double)err * err;
+
+		if(alt > peak){
+
+			peak = alt;
+			peakIndex = i;
+		}
+
+		//Only the upper half of the flight counts, the noise on the pad must not look like an apogee
+		if(detectIndex < 0 && spd < 0.0f && alt > (0.5f * Flight->peakAlt)){
+
+			detectIndex = (int32_t)i;
+		}
+	}
+
+	Result->altRms = (Flight->n != 0) ? (float)sqrt(sumSq / Flight->n) : 0.0f;
+	Result->lag = ((float)peakIndex - (float)Flight->apogeeIndex) * Flight->period;
+	Result->detected = (detectIndex >= 0);
+	Result->detectDelay = Result->detected ? (((float)detectIndex - (float)Flight->apogeeIndex) * Flight->period) : 0.0f;
+}
+
+
+void BMP390_Sweep_Rank(BMP390_Sweep_Result_TypeDef *Results, uint32_t n, const BMP390_Sweep_Weights_TypeDef *Weights, uint32_t k){
+
+	if(k > n){
+
+		k = n;
+	}
+
+	for(uint32_t i = 0; i < n; i++){
+
+		BMP390_Sweep_Result_TypeDef *r = &Results[i];
+
+		//A flight whose apogee is never detected is ranked after every detected one
+		r->score = r->altRms + (Weights->lag * BMP390_Sweep_Abs(r->lag)) +
+				   (r->detected ? (Weights->detectDelay * BMP390_Sweep_Abs(r->detectDelay)) : 1.0e30f);
+	}
+
+	//Partial selection sort, O(n * k) and in place
+	for(uint32_t i = 0; i < k; i++){
+
+		uint32_t best = i;
+
+		for(uint32_t j = i + 1; j < n; j++){
+
+			if(Results[j].score < Results[best].score){
+
+				best = j;
+			}
+		}
+
+		if(best != i){
+
+			BMP390_Sweep_Result_TypeDef tmp = Results[i];
+			Results[i] = Results[best];
+			Results[best] = tmp;
+		}
+	}
+}
+
+
+static float BMP390_Sweep_Abs(float value){
+
+	return (value < 0.0f) ? -value : value;
+}
@@ -0,0 +1,361 @@
+/*!
+ *  @file : bmp390_telemetry.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * NOTE ==> The CPU only encodes a frame and copies it into the fill buffer. USART1 TX DMA sends the other buffer,
+ * 			when it finishes the buffers are swapped in the DMA interrupt. Nothing waits for the UART.
+ */
+
+#include "bmp390_telemetry.h"
+#include "string.h"
+
+
+static void BMP390_Telemetry_StartTx(BMP390_Telemetry_TypeDef *Tlm);
+static void BMP390_Telemetry_TxCplt(DMA_HandleTypeDef *hdma);
+static void BMP390_Telemetry_TxError(DMA_HandleTypeDef *hdma);
+
+
+_Bool BMP390_Telemetry_Init(BMP390_Telemetry_TypeDef *Tlm){
+
+	GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+	Tlm->fill = 0;
+	Tlm->active = 0;
+	Tlm->busy = 0;
+	Tlm->seq = 0;
+	Tlm->sentFrames = 0;
+	Tlm->droppedFrames = 0;
+	Tlm->txErrors = 0;
+
+	__HAL_RCC_GPIOA_CLK_ENABLE();
+	__HAL_RCC_USART1_CLK_ENABLE();
+	__HAL_RCC_DMA1_CLK_ENABLE();
+
+	/**USART1 GPIO Configuration
+	PA9     ------> USART1_TX
+	*/
+	GPIO_InitStruct.Pin = GPIO_PIN_9;
+	GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+	GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+	HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+
+	//8N1, only the transmitter is used and it is fed by the DMA
+	USART1->CR1 = 0;
+	USART1->CR2 = 0;
+	USART1->BRR = (uint16_t)((HAL_RCC_GetPCLK2Freq() + (BMP390_Tlm_Baudrate / 2)) / BMP390_Tlm_Baudrate);
+	USART1->CR3 = USART_CR3_DMAT;
+	USART1->CR1 = USART_CR1_UE | USART_CR1_TE;
+
+	Tlm->hdma.Instance = DMA1_Channel4;
+	Tlm->hdma.Init.Direction = DMA_MEMORY_TO_PERIPH;
+	Tlm->hdma.Init.PeriphInc = DMA_PINC_DISABLE;
+	Tlm->hdma.Init.MemInc = DMA_MINC_ENABLE;
+	Tlm->hdma.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+	Tlm->hdma.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+	Tlm->hdma.Init.Mode = DMA_NORMAL;
+	Tlm->hdma.Init.Priority = DMA_PRIORITY_LOW;
+
+	if(HAL_DMA_Init(&Tlm->hdma) != HAL_OK){
+
+		return false;
+
+	}
+
+	Tlm->hdma.Parent = Tlm;
+	Tlm->hdma.XferCpltCallback = BMP390_Telemetry_TxCplt;
+	Tlm->hdma.XferErrorCallback = BMP390_Telemetry_TxError;
+
+	HAL_NVIC_SetPriority(DMA1_Channel4_IRQn, 0, 0);
+	HAL_NVIC_EnableIRQ(DMA1_Channel4_IRQn);
+
+	return true;
+}
+
+
+_Bool BMP390_Telemetry_Send(BMP390_Telemetry_TypeDef *Tlm, uint8_t type, const uint8_t *payload, uint8_t len){
+
+	uint8_t frame[BMP390_Tlm_MaxFrame];
+	uint16_t frameLen;
+	uint32_t primask;
+	uint8_t seq;
+
+	if(len > BMP390_Tlm_MaxPayload){
+
+		return false;
+
+	}
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	seq = Tlm->seq++;
+	__set_PRIMASK(primask);
+
+	frameLen = BMP390_Telemetry_Encode(seq, type, payload, len, frame);
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	if((Tlm->fill + frameLen) > BMP390_Tlm_BufSize){
+
+		Tlm->droppedFrames++;
+		__set_PRIMASK(primask);
+		return false;
+
+	}
+
+	memcpy(&Tlm->buf[Tlm->active][Tlm->fill], frame, frameLen);
+	Tlm->fill += frameLen;
+	Tlm->sentFrames++;
+
+	if(!Tlm->busy){
+
+		BMP390_Telemetry_StartTx(Tlm);
+
+	}
+
+	__set_PRIMASK(primask);
+
+	return true;
+}
+
+
+_Bool BMP390_Telemetry_SendSample(BMP390_Telemetry_TypeDef *Tlm, const BMP390_Sample_TypeDef *Sample){
+
+	uint8_t payload[28];
+
+	//Cortex-M3 is little endian, the fields are copied as they are
+	memcpy(&payload[0],  &Sample->timestamp, 4);
+	memcpy(&payload[4],  &Sample->press, 4);
+	memcpy(&payload[8],  &Sample->temp, 4);
+	memcpy(&payload[12], &Sample->vertAlt, 4);
+	memcpy(&payload[16], &Sample->vertSpd, 4);
+	memcpy(&payload[20], &Sample->vertAcc, 4);
+	memcpy(&payload[24], &Sample->gForce, 4);
+
+	return BMP390_Telemetry_Send(Tlm, BMP390_Tlm_Sample, payload, sizeof(payload));
+}
+
+
+void BMP390_Telemetry_IRQHandler(BMP390_Telemetry_TypeDef *Tlm){
+
+	HAL_DMA_IRQHandler(&Tlm->hdma);
+
+}
+
+
+/**
+ * @brief  Called with interrupts disabled or from the DMA interrupt. The fill buffer is handed to the DMA
+ * 		   and the other one becomes the fill buffer.
+ */
+static void BMP390_Telemetry_StartTx(BMP390_Telemetry_TypeDef *Tlm){
+
+	uint8_t tx = Tlm->active;
+	uint16_t len = Tlm->fill;
+
+	if(len == 0){
+
+		return;
+
+	}
+
+	Tlm->active ^= 1;
+	Tlm->fill = 0;
+	Tlm->busy = 1;
+
+	if(HAL_DMA_Start_IT(&Tlm->hdma, (uint32_t)Tlm->buf[tx], (uint32_t)&USART1->DR, len) != HAL_OK){
+
+		Tlm->txErrors++;
+		Tlm->busy = 0;
+
+	}
+}
+
+
+static void BMP390_Telemetry_TxCplt(DMA_HandleTypeDef *hdma){
+
+	BMP390_Telemetry_TypeDef *Tlm = (BMP390_Telemetry_TypeDef *)hdma->Parent;
+
+	Tlm->busy = 0;
+	BMP390_Telemetry_StartTx(Tlm);
+
+}
+
+
+/**
+ * @brief  HAL_DMA_IRQHandler has already disabled the channel, the next buffer can go.
+ */
+static void BMP390_Telemetry_TxError(DMA_HandleTypeDef *hdma){
+
+	BMP390_Telemetry_TypeDef *Tlm = (BMP390_Telemetry_TypeDef *)hdma->Parent;
+
+	Tlm->txErrors++;
+	Tlm->busy = 0;
+	BMP390_Telemetry_StartTx(Tlm);
+
+}
+
+
+uint16_t BMP390_Telemetry_Crc16(const uint8_t *data, uint16_t len){
+
+	//CRC-16/CCITT-FALSE, 4 bit table
+	static const uint16_t table[16] = {
+
+		0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+		0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+
+	};
+
+	uint16_t crc = 0xFFFF;
+
+	while(len--){
+
+		crc = (uint16_t)((crc << 4) ^ table[(crc >> 12) ^ (*data >> 4)]);
+		crc = (uint16_t)((crc << 4) ^ table[(crc >> 12) ^ (*data & 0x0F)]);
+		data++;
+
+	}
+
+	return crc;
+}
+
+
+uint16_t BMP390_Telemetry_Encode(uint8_t seq, uint8_t type, const uint8_t *payload, uint8_t len, uint8_t *frame){
+
+	uint8_t raw[BMP390_Tlm_MaxRawFrame];
+	uint16_t rawLen = 0;
+	uint16_t crc;
+	uint16_t codeIdx = 0;
+	uint16_t out = 1;
+	uint8_t code = 1;
+
+	raw[rawLen++] = type;
+	raw[rawLen++] = seq;
+	memcpy(&raw[rawLen], payload, len);
+	rawLen += len;
+
+	crc = BMP390_Telemetry_Crc16(raw, rawLen);
+	raw[rawLen++] = (uint8_t)(crc & 0xFF);
+	raw[rawLen++] = (uint8_t)(crc >> 8);
+
+	//COBS, every zero is replaced by the distance to the next zero
+	for(uint16_t i = 0; i < rawLen; i++){
+
+		if(raw[i] == 0){
+
+			frame[codeIdx] = code;
+			codeIdx = out++;
+			code = 1;
+
+		}
+		else{
+
+			frame[out++] = raw[i];
+			code++;
+
+			if(code == 0xFF){
+
+				frame[codeIdx] = code;
+				codeIdx = out++;
+				code = 1;
+
+			}
+		}
+	}
+
+	frame[codeIdx] = code;
+	frame[out++] = 0x00;
+
+	return out;
+}
+
+
+int16_t BMP390_Telemetry_Decode(const uint8_t *frame, uint16_t len, uint8_t *type, uint8_t *seq, uint8_t *payload){
+
+	uint8_t raw[BMP390_Tlm_MaxRawFrame];
+	uint16_t rawLen = 0;
+	uint16_t i = 0;
+	uint8_t code;
+
+	while(i < len){
+
+		code = frame[i++];
+
+		if(code == 0){
+
+			return -1;
+
+		}
+
+		for(uint8_t j = 1; j < code; j++){
+
+			if((i >= len) || (rawLen >= sizeof(raw))){
+
+				return -1;
+
+			}
+
+			raw[rawLen++] = frame[i++];
+
+		}
+
+		if((code < 0xFF) && (i < len)){
+
+			if(rawLen >= sizeof(raw)){
+
+				return -1;
+
+			}
+
+			raw[rawLen++] = 0;
+
+		}
+	}
+
+	if(rawLen < 4){
+
+		return -1;
+
+	}
+
+	if(BMP390_Telemetry_Crc16(raw, rawLen - 2) != (uint16_t)(raw[rawLen - 2] | (raw[rawLen - 1] << 8))){
+
+		return -1;
+
+	}
+
+	*type = raw[0];
+	*seq  = raw[1];
+	memcpy(payload, &raw[2], rawLen - 4);
+
+	return (int16_t)(rawLen - 4);
+}
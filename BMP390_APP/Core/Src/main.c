@@ -22,6 +22,15 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "bmp390.h"
+#include "bmp390_telemetry.h"
+#include "bmp390_logger.h"
+#include "bmp390_allan.h"
+#include "bmp390_flight.h"
+#include "bmp390_drift.h"
+#include "bmp390_fifo.h"
+#include "bmp390_governor.h"
+#include "bmp390_lowpower.h"
+#include "bmp390_ground.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -57,6 +66,40 @@ float  BMP390_VertSpd 	= 0.0;
 float  BMP390_gForce 	= 0.0;
 float  TotalMass 		= 0.75; /*! Unit is Kilogram*/
 
+BMP390_SampleSeqlock_TypeDef BMP390_Latest; /*! Consistent copy of the values above for the readers */
+
+BMP390_Telemetry_TypeDef BMP390_Tlm;		/*! Every sample is streamed from USART1 TX (PA9) */
+
+BMP390_Logger_TypeDef BMP390_Log;			/*! Every raw frame is kept in the LOG flash region */
+
+BMP390_Flight_TypeDef BMP390_Flight;		/*! Flight phase, BMP390_Flight.state becomes BMP390_Flight_Apogee at the top */
+
+BMP390_Drift_TypeDef BMP390_Drift;			/*! Sensortime to MCU time (us), BMP390_Drift_Map */
+
+BMP390_Ground_TypeDef BMP390_Ground;		/*! Follows the weather drift of the pad into FixedAltitude */
+
+#ifdef BMP390_FIFO_MODE
+BMP390_Fifo_TypeDef BMP390_Fifo;			/*! Watermark driven acquisition, see bmp390_conf.h */
+#ifdef BMP390_FIFO_SOFT_IIR
+BMP390_Iir_TypeDef BMP390_Iir;				/*! Filters of the unfiltered FIFO stream, BMP390_Iir_Press(&BMP390_Iir, k) */
+#endif
+#endif
+
+#ifdef BMP390_GOVERNOR
+BMP390_Governor_TypeDef BMP390_Gov;			/*! ODR, oversampling and filter profile of the flight phase */
+#ifdef BMP390_FIFO_MODE
+static uint8_t BMP390_GovPending;			/*! A FIFO frame selected a profile, the main loop uploads it */
+#endif
+#endif
+
+#ifdef BMP390_LOW_POWER
+BMP390_LowPower_TypeDef BMP390_Lp;			/*! Forced conversions on the RTC alarm, Stop mode in between */
+#endif
+
+#ifdef BMP390_CHARACTERIZATION
+BMP390_Allan_TypeDef BMP390_Allan;			/*! Noise floor of the board, see bmp390_conf.h */
+#endif
+
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -65,6 +108,12 @@ static void MX_GPIO_Init(void);
 static void MX_I2C1_Init(void);
 static void MX_TIM1_Init(void);
 /* USER CODE BEGIN PFP */
+#ifdef BMP390_FIFO_MODE
+static void BMP390_FifoFrame(void *ctx, const BMP390_RawFrame_TypeDef *Frame);
+#endif
+#ifdef BMP390_LOW_POWER
+static void BMP390_LpFrame(void *ctx, const BMP390_RawFrame_TypeDef *Frame, uint32_t timestamp);
+#endif
 
 /* USER CODE END PFP */
 
@@ -115,7 +164,58 @@ int main(void)
   BMP390.BMP390_I2C_ADDRESS = BMP390_I2C_ADDRESS_L;
   BMP390.i2c = &hi2c1;
   BMP390.Ref_Alt_Sel = 'm';
+
+  /**
+   * HAL timeouts count SysTick, it has to preempt the TIM1 interrupt that reads the sensor.
+   * Otherwise HAL_GetTick stands still inside TIM1_UP_IRQHandler and a stuck bus is never timed out.
+   */
+  HAL_InitTick(0);
+  HAL_NVIC_SetPriority(TIM1_UP_IRQn, 1, 0);
+
+  BMP390_Telemetry_Init(&BMP390_Tlm);
+  BMP390_Logger_Init(&BMP390_Log);
+  BMP390_Drift_Init(&BMP390_Drift);
   BMP390_Init(&BMP390);
+#ifdef BMP390_CHARACTERIZATION
+  {
+	  //A TIM1 faster than the ODR drops the repeated conversions, the samples come at the slower of the two periods
+	  uint32_t tau0 = BMP390_Calc_OdrPeriod(BMP390.Params.odr) / 1000u;
+
+	  BMP390_Allan_Init(&BMP390_Allan, (uint16_t)(((htim1.Init.Period + 1u) > tau0) ? (htim1.Init.Period + 1u) : tau0));
+  }
+#endif
+  BMP390_Flight_Init(&BMP390_Flight, NULL);
+  BMP390_Ground_Init(&BMP390_Ground, NULL);
+
+#ifdef BMP390_GOVERNOR
+  //Starts on the pad profile, TIM1 polls at its ODR. It is already counting the default period, ARR is preloaded
+  //and the update event restarts it on the new one at once
+  BMP390_Governor_Init(&BMP390_Gov, NULL);
+  BMP390_Governor_Apply(&BMP390_Gov, &BMP390);
+  __HAL_TIM_SET_AUTORELOAD(&htim1, (BMP390_Calc_OdrPeriod(BMP390.Params.odr) / 1000u) - 1u);
+  HAL_TIM_GenerateEvent(&htim1, TIM_EVENTSOURCE_UPDATE);
+#endif
+
+#ifdef BMP390_FIFO_MODE
+  //The FIFO takes over from the TIM1 polling, they can't share the bus
+  HAL_TIM_Base_Stop_IT(&htim1);
+#ifdef BMP390_FIFO_SOFT_IIR
+  {
+	  static const BMP390_FilterCoef_TypeDef coefs[] = BMP390_FIFO_IIR_COEFS;
+
+	  BMP390_Iir_Init(&BMP390_Iir, coefs, sizeof(coefs) / sizeof(coefs[0]));
+	  BMP390_Fifo_Init(&BMP390_Fifo, &BMP390, &BMP390_Drift, &BMP390_Iir, BMP390_FIFO_WATERMARK);
+  }
+#else
+  BMP390_Fifo_Init(&BMP390_Fifo, &BMP390, &BMP390_Drift, NULL, BMP390_FIFO_WATERMARK);
+#endif
+#endif
+
+#ifdef BMP390_LOW_POWER
+  //The RTC alarm takes over from the TIM1 polling
+  HAL_TIM_Base_Stop_IT(&htim1);
+  BMP390_LowPower_Init(&BMP390_Lp, &BMP390, BMP390_LP_PERIOD, BMP390_LP_BATCH);
+#endif
 
 #endif
 
@@ -130,6 +230,29 @@ int main(void)
 
     /* USER CODE BEGIN 3 */
 
+	BMP390_Logger_Task(&BMP390_Log);
+
+#ifdef BMP390_FIFO_MODE
+	BMP390_Fifo_Task(&BMP390_Fifo, BMP390_FifoFrame, NULL);
+
+#ifdef BMP390_GOVERNOR
+	if(BMP390_GovPending){
+
+		BMP390_GovPending = false;
+		BMP390_Fifo_Pause(&BMP390_Fifo);
+		BMP390_Governor_Apply(&BMP390_Gov, &BMP390);
+		BMP390_Fifo_Resume(&BMP390_Fifo);
+	}
+#endif
+#endif
+
+#ifdef BMP390_LOW_POWER
+	BMP390_LowPower_Task(&BMP390_Lp, BMP390_LpFrame, NULL);
+
+	//Stop mode would freeze a telemetry transfer, Sleep mode lets the DMA finish it
+	BMP390_LowPower_Sleep(&BMP390_Lp, !BMP390_Tlm.busy);
+#endif
+
   }
   /* USER CODE END 3 */
 }
@@ -228,7 +351,7 @@ static void MX_TIM1_Init(void)
   htim1.Init.Period = 999;
   htim1.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
   htim1.Init.RepetitionCounter = 0;
-  htim1.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+  htim1.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
   if (HAL_TIM_Base_Init(&htim1) != HAL_OK)
   {
     Error_Handler();
@@ -245,6 +368,11 @@ static void MX_TIM1_Init(void)
     Error_Handler();
   }
   /* USER CODE BEGIN TIM1_Init 2 */
+#ifdef BMP390_STATIC_CONFIG
+  //ARR is preloaded, the update event loads it before the timer starts
+  __HAL_TIM_SET_AUTORELOAD(&htim1, BMP390_CONF_TIM_PERIOD);
+  HAL_TIM_GenerateEvent(&htim1, TIM_EVENTSOURCE_UPDATE);
+#endif
 
   /* USER CODE END TIM1_Init 2 */
 
@@ -283,6 +411,94 @@ static void MX_GPIO_Init(void)
 
 /* USER CODE BEGIN 4 */
 
+#ifdef BMP390_FIFO_MODE
+
+/**
+  * @brief  Every sample of a FIFO drain goes through the same chain as the TIM1 samples, from the main loop.
+  * 		The timestamp is the MCU time of the conversion, mapped from its sensortime. The mapped us don't wrap,
+  * 		the ms are truncated to 32 bit and wrap after 49.7 days like HAL_GetTick.
+  * 		With BMP390_FIFO_SOFT_IIR the frame is unfiltered and the altitude comes from the first software filter.
+  */
+static void BMP390_FifoFrame(void *ctx, const BMP390_RawFrame_TypeDef *Frame)
+{
+	BMP390_Sample_TypeDef sample;
+
+	sample.timestamp = (uint32_t)(BMP390_Drift_Map(&BMP390_Drift, Frame->sensortime) / 1000u);
+#ifdef BMP390_FIFO_SOFT_IIR
+	BMP390_Process_RawData(&BMP390, BMP390_Iir_Press(&BMP390_Iir, 0), BMP390_Iir_Temp(&BMP390_Iir, 0), TotalMass, &sample);
+#else
+	BMP390_Process_RawData(&BMP390, Frame->rawPress, Frame->rawTemp, TotalMass, &sample);
+#endif
+
+	BMP390_Press   = sample.press;
+	BMP390_Temp    = sample.temp;
+	BMP390_VertAlt = sample.vertAlt;
+	BMP390_VertSpd = sample.vertSpd;
+	BMP390_VertAcc = sample.vertAcc;
+	BMP390_gForce  = sample.gForce;
+
+	BMP390_Publish_Sample(&BMP390_Latest, &sample);
+	BMP390_Telemetry_SendSample(&BMP390_Tlm, &sample);
+	BMP390_Logger_Push(&BMP390_Log, Frame);
+	BMP390_Flight_Update(&BMP390_Flight, &sample);
+	BMP390_Ground_Update(&BMP390_Ground, &BMP390, &BMP390_Flight, &sample);
+
+#ifdef BMP390_GOVERNOR
+	if(BMP390_Governor_Update(&BMP390_Gov, &BMP390_Flight, sample.timestamp) >= 0){
+
+		BMP390_GovPending = true;
+	}
+#endif
+}
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+	if(hi2c == BMP390.i2c){
+
+		BMP390_Fifo_RxCplt(&BMP390_Fifo);
+	}
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+	if(hi2c == BMP390.i2c){
+
+		BMP390_Fifo_Error(&BMP390_Fifo);
+	}
+}
+
+#endif
+
+#ifdef BMP390_LOW_POWER
+
+/**
+  * @brief  Every sample of a batch goes through the same chain as the TIM1 samples, from the main loop.
+  * 		The timestamp is the RTC time of the conversion.
+  */
+static void BMP390_LpFrame(void *ctx, const BMP390_RawFrame_TypeDef *Frame, uint32_t timestamp)
+{
+	BMP390_Sample_TypeDef sample;
+
+	sample.timestamp = timestamp;
+	BMP390_Process_RawData(&BMP390, Frame->rawPress, Frame->rawTemp, TotalMass, &sample);
+
+	BMP390_Press   = sample.press;
+	BMP390_Temp    = sample.temp;
+	BMP390_VertAlt = sample.vertAlt;
+	BMP390_VertSpd = sample.vertSpd;
+	BMP390_VertAcc = sample.vertAcc;
+	BMP390_gForce  = sample.gForce;
+
+	BMP390_Publish_Sample(&BMP390_Latest, &sample);
+	BMP390_Telemetry_SendSample(&BMP390_Tlm, &sample);
+	BMP390_Logger_Push(&BMP390_Log, Frame);
+	BMP390_Flight_Update(&BMP390_Flight, &sample);
+	BMP390_Ground_Update(&BMP390_Ground, &BMP390, &BMP390_Flight, &sample);
+}
+
+#endif
+
+
 /* USER CODE END 4 */
 
 /**
@@ -23,6 +23,15 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "bmp390.h"
+#include "bmp390_telemetry.h"
+#include "bmp390_logger.h"
+#include "bmp390_allan.h"
+#include "bmp390_flight.h"
+#include "bmp390_drift.h"
+#include "bmp390_fifo.h"
+#include "bmp390_governor.h"
+#include "bmp390_lowpower.h"
+#include "bmp390_ground.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -51,6 +60,24 @@ extern float  BMP390_VertAcc;
 extern float  BMP390_VertSpd;
 extern float  BMP390_gForce;
 extern float  TotalMass;
+extern BMP390_SampleSeqlock_TypeDef BMP390_Latest;
+extern BMP390_Telemetry_TypeDef BMP390_Tlm;
+extern BMP390_Logger_TypeDef BMP390_Log;
+extern BMP390_Flight_TypeDef BMP390_Flight;
+extern BMP390_Drift_TypeDef BMP390_Drift;
+extern BMP390_Ground_TypeDef BMP390_Ground;
+#ifdef BMP390_FIFO_MODE
+extern BMP390_Fifo_TypeDef BMP390_Fifo;
+#endif
+#ifdef BMP390_CHARACTERIZATION
+extern BMP390_Allan_TypeDef BMP390_Allan;
+#endif
+#ifdef BMP390_GOVERNOR
+extern BMP390_Governor_TypeDef BMP390_Gov;
+#endif
+#ifdef BMP390_LOW_POWER
+extern BMP390_LowPower_TypeDef BMP390_Lp;
+#endif
 
 /* USER CODE END PV */
 
@@ -218,10 +245,51 @@ void TIM1_UP_IRQHandler(void)
  * Pressure, temperature, altitude, acceleration, gravitational force,
  * and velocity values will come to this function once per second.
  */
-	BMP390_Get_SensorValues(&BMP390, &BMP390_Press,
-			  		  	  	&BMP390_Temp, &BMP390_VertAlt,
-			  				&BMP390_VertAcc, &BMP390_VertSpd,
-			  				&BMP390_gForce);
+	BMP390_Sample_TypeDef sample;
+	BMP390_RawFrame_TypeDef frame;
+
+	//Data that was already read, a failed transfer or a lost configuration (already recovered) skips this period
+	if(BMP390_Read_RawFrame(&BMP390, &frame, NULL)){
+
+		BMP390_Drift_Update(&BMP390_Drift, frame.sensortime, BMP390_Drift_Micros(&BMP390_Drift));
+
+		sample.timestamp = HAL_GetTick();
+		BMP390_Process_RawData(&BMP390, frame.rawPress, frame.rawTemp, TotalMass, &sample);
+
+		BMP390_Press   = sample.press;
+		BMP390_Temp    = sample.temp;
+		BMP390_VertAlt = sample.vertAlt;
+		BMP390_VertSpd = sample.vertSpd;
+		BMP390_VertAcc = sample.vertAcc;
+		BMP390_gForce  = sample.gForce;
+
+		BMP390_Publish_Sample(&BMP390_Latest, &sample);
+		BMP390_Telemetry_SendSample(&BMP390_Tlm, &sample);
+		BMP390_Logger_Push(&BMP390_Log, &frame);
+		BMP390_Flight_Update(&BMP390_Flight, &sample);
+		BMP390_Ground_Update(&BMP390_Ground, &BMP390, &BMP390_Flight, &sample);
+
+#ifdef BMP390_GOVERNOR
+		//Nothing else uses the bus here, the profile is uploaded at once and TIM1 follows the new ODR.
+		//ARR is preloaded : the new period starts at the next update, a shorter one can't land below CNT
+		//and leave the timer counting up to 65535 (65 s without a sample)
+		if(BMP390_Governor_Update(&BMP390_Gov, &BMP390_Flight, sample.timestamp) >= 0){
+
+			BMP390_Governor_Apply(&BMP390_Gov, &BMP390);
+			__HAL_TIM_SET_AUTORELOAD(&htim1, (BMP390_Calc_OdrPeriod(BMP390.Params.odr) / 1000u) - 1u);
+		}
+#endif
+
+#ifdef BMP390_CHARACTERIZATION
+		BMP390_Allan_Add(&BMP390_Allan, sample.press, sample.vertAlt);
+
+		if((BMP390_Allan.n % BMP390_CHAR_REPORT_EVERY) == 0){
+
+			BMP390_Allan_Report(&BMP390_Allan, &BMP390_Tlm);
+		}
+#endif
+
+	}
 
   /* USER CODE END TIM1_UP_IRQn 0 */
   HAL_TIM_IRQHandler(&htim1);
@@ -232,4 +300,60 @@ void TIM1_UP_IRQHandler(void)
 
 /* USER CODE BEGIN 1 */
 
+/**
+  * @brief This function handles DMA1 channel4 global interrupt (USART1_TX, telemetry).
+  */
+void DMA1_Channel4_IRQHandler(void)
+{
+	BMP390_Telemetry_IRQHandler(&BMP390_Tlm);
+}
+
+#ifdef BMP390_FIFO_MODE
+
+/**
+  * @brief This function handles EXTI line0 interrupt (INT of the sensor, FIFO watermark or full).
+  */
+void EXTI0_IRQHandler(void)
+{
+	BMP390_Fifo_IRQHandler(&BMP390_Fifo);
+}
+
+/**
+  * @brief This function handles DMA1 channel7 global interrupt (I2C1_RX, FIFO drain).
+  */
+void DMA1_Channel7_IRQHandler(void)
+{
+	HAL_DMA_IRQHandler(&BMP390_Fifo.hdma);
+}
+
+/**
+  * @brief This function handles I2C1 error interrupt, it is enabled during the FIFO drain.
+  */
+void I2C1_ER_IRQHandler(void)
+{
+	HAL_I2C_ER_IRQHandler(BMP390.i2c);
+}
+
+#endif
+
+#ifdef BMP390_LOW_POWER
+
+/**
+  * @brief This function handles EXTI line0 interrupt (INT of the sensor, data ready of a forced conversion).
+  */
+void EXTI0_IRQHandler(void)
+{
+	BMP390_LowPower_IntIRQHandler(&BMP390_Lp);
+}
+
+/**
+  * @brief This function handles RTC alarm interrupt through EXTI line17 (start of a forced conversion).
+  */
+void RTC_Alarm_IRQHandler(void)
+{
+	BMP390_LowPower_AlarmIRQHandler(&BMP390_Lp);
+}
+
+#endif
+
 /* USER CODE END 1 */
@@ -6,6 +6,22 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
 ../Core/Src/bmp390.c \
+../Core/Src/bmp390_allan.c \
+../Core/Src/bmp390_bus.c \
+../Core/Src/bmp390_codec.c \
+../Core/Src/bmp390_drift.c \
+../Core/Src/bmp390_fifo.c \
+../Core/Src/bmp390_flight.c \
+../Core/Src/bmp390_governor.c \
+../Core/Src/bmp390_ground.c \
+../Core/Src/bmp390_health.c \
+../Core/Src/bmp390_iir.c \
+../Core/Src/bmp390_logger.c \
+../Core/Src/bmp390_lowpower.c \
+../Core/Src/bmp390_replay.c \
+../Core/Src/bmp390_sim.c \
+../Core/Src/bmp390_sweep.c \
+../Core/Src/bmp390_telemetry.c \
 ../Core/Src/main.c \
 ../Core/Src/stm32f1xx_hal_msp.c \
 ../Core/Src/stm32f1xx_it.c \
@@ -15,6 +31,22 @@ C_SRCS += \
 
 OBJS += \
 ./Core/Src/bmp390.o \
+./Core/Src/bmp390_allan.o \
+./Core/Src/bmp390_bus.o \
+./Core/Src/bmp390_codec.o \
+./Core/Src/bmp390_drift.o \
+./Core/Src/bmp390_fifo.o \
+./Core/Src/bmp390_flight.o \
+./Core/Src/bmp390_governor.o \
+./Core/Src/bmp390_ground.o \
+./Core/Src/bmp390_health.o \
+./Core/Src/bmp390_iir.o \
+./Core/Src/bmp390_logger.o \
+./Core/Src/bmp390_lowpower.o \
+./Core/Src/bmp390_replay.o \
+./Core/Src/bmp390_sim.o \
+./Core/Src/bmp390_sweep.o \
+./Core/Src/bmp390_telemetry.o \
 ./Core/Src/main.o \
 ./Core/Src/stm32f1xx_hal_msp.o \
 ./Core/Src/stm32f1xx_it.o \
@@ -24,6 +56,22 @@ OBJS += \
 
 C_DEPS += \
 ./Core/Src/bmp390.d \
+./Core/Src/bmp390_allan.d \
+./Core/Src/bmp390_bus.d \
+./Core/Src/bmp390_codec.d \
+./Core/Src/bmp390_drift.d \
+./Core/Src/bmp390_fifo.d \
+./Core/Src/bmp390_flight.d \
+./Core/Src/bmp390_governor.d \
+./Core/Src/bmp390_ground.d \
+./Core/Src/bmp390_health.d \
+./Core/Src/bmp390_iir.d \
+./Core/Src/bmp390_logger.d \
+./Core/Src/bmp390_lowpower.d \
+./Core/Src/bmp390_replay.d \
+./Core/Src/bmp390_sim.d \
+./Core/Src/bmp390_sweep.d \
+./Core/Src/bmp390_telemetry.d \
 ./Core/Src/main.d \
 ./Core/Src/stm32f1xx_hal_msp.d \
 ./Core/Src/stm32f1xx_it.d \
@@ -34,12 +82,12 @@ C_DEPS += \
 
 # Each subdirectory must supply rules for building sources it contributes
 Core/Src/%.o Core/Src/%.su Core/Src/%.cyclo: ../Core/Src/%.c Core/Src/subdir.mk
-	arm-none-eabi-gcc "$<" -mcpu=cortex-m3 -std=gnu11 -g3 -DDEBUG -DUSE_HAL_DRIVER -DSTM32F103x6 -c -I../Core/Inc -I../Drivers/STM32F1xx_HAL_Driver/Inc/Legacy -I../Drivers/STM32F1xx_HAL_Driver/Inc -I../Drivers/CMSIS/Device/ST/STM32F1xx/Include -I../Drivers/CMSIS/Include -O0 -ffunction-sections -fdata-sections -Wall -fstack-usage -fcyclomatic-complexity -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" --specs=nano.specs -mfloat-abi=soft -mthumb -o "$@"
+	arm-none-eabi-gcc "$<" -mcpu=cortex-m3 -std=gnu11 -g3 -DDEBUG -DUSE_HAL_DRIVER -DSTM32F103x6 -c -I../Core/Inc -I../Drivers/STM32F1xx_HAL_Driver/Inc/Legacy -I../Drivers/STM32F1xx_HAL_Driver/Inc -I../Drivers/CMSIS/Device/ST/STM32F1xx/Include -I../Drivers/CMSIS/Include -Og -ffunction-sections -fdata-sections -Wall -fstack-usage -fcyclomatic-complexity -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" --specs=nano.specs -mfloat-abi=soft -mthumb -o "$@"
 
 clean: clean-Core-2f-Src
 
 clean-Core-2f-Src:
-	-$(RM) ./Core/Src/bmp390.cyclo ./Core/Src/bmp390.d ./Core/Src/bmp390.o ./Core/Src/bmp390.su ./Core/Src/main.cyclo ./Core/Src/main.d ./Core/Src/main.o ./Core/Src/main.su ./Core/Src/stm32f1xx_hal_msp.cyclo ./Core/Src/stm32f1xx_hal_msp.d ./Core/Src/stm32f1xx_hal_msp.o ./Core/Src/stm32f1xx_hal_msp.su ./Core/Src/stm32f1xx_it.cyclo ./Core/Src/stm32f1xx_it.d ./Core/Src/stm32f1xx_it.o ./Core/Src/stm32f1xx_it.su ./Core/Src/syscalls.cyclo ./Core/Src/syscalls.d ./Core/Src/syscalls.o ./Core/Src/syscalls.su ./Core/Src/sysmem.cyclo ./Core/Src/sysmem.d ./Core/Src/sysmem.o ./Core/Src/sysmem.su ./Core/Src/system_stm32f1xx.cyclo ./Core/Src/system_stm32f1xx.d ./Core/Src/system_stm32f1xx.o ./Core/Src/system_stm32f1xx.su
+	-$(RM) ./Core/Src/bmp390.cyclo ./Core/Src/bmp390.d ./Core/Src/bmp390.o ./Core/Src/bmp390.su ./Core/Src/bmp390_allan.cyclo ./Core/Src/bmp390_allan.d ./Core/Src/bmp390_allan.o ./Core/Src/bmp390_allan.su ./Core/Src/bmp390_bus.cyclo ./Core/Src/bmp390_bus.d ./Core/Src/bmp390_bus.o ./Core/Src/bmp390_bus.su ./Core/Src/bmp390_codec.cyclo ./Core/Src/bmp390_codec.d ./Core/Src/bmp390_codec.o ./Core/Src/bmp390_codec.su ./Core/Src/bmp390_drift.cyclo ./Core/Src/bmp390_drift.d ./Core/Src/bmp390_drift.o ./Core/Src/bmp390_drift.su ./Core/Src/bmp390_fifo.cyclo ./Core/Src/bmp390_fifo.d ./Core/Src/bmp390_fifo.o ./Core/Src/bmp390_fifo.su ./Core/Src/bmp390_flight.cyclo ./Core/Src/bmp390_flight.d ./Core/Src/bmp390_flight.o ./Core/Src/bmp390_flight.su ./Core/Src/bmp390_governor.cyclo ./Core/Src/bmp390_governor.d ./Core/Src/bmp390_governor.o ./Core/Src/bmp390_governor.su ./Core/Src/bmp390_ground.cyclo ./Core/Src/bmp390_ground.d ./Core/Src/bmp390_ground.o ./Core/Src/bmp390_ground.su ./Core/Src/bmp390_health.cyclo ./Core/Src/bmp390_health.d ./Core/Src/bmp390_health.o ./Core/Src/bmp390_health.su ./Core/Src/bmp390_iir.cyclo ./Core/Src/bmp390_iir.d ./Core/Src/bmp390_iir.o ./Core/Src/bmp390_iir.su ./Core/Src/bmp390_logger.cyclo ./Core/Src/bmp390_logger.d ./Core/Src/bmp390_logger.o ./Core/Src/bmp390_logger.su ./Core/Src/bmp390_lowpower.cyclo ./Core/Src/bmp390_lowpower.d ./Core/Src/bmp390_lowpower.o ./Core/Src/bmp390_lowpower.su ./Core/Src/bmp390_replay.cyclo ./Core/Src/bmp390_replay.d ./Core/Src/bmp390_replay.o ./Core/Src/bmp390_replay.su ./Core/Src/bmp390_sim.cyclo ./Core/Src/bmp390_sim.d ./Core/Src/bmp390_sim.o ./Core/Src/bmp390_sim.su ./Core/Src/bmp390_sweep.cyclo ./Core/Src/bmp390_sweep.d ./Core/Src/bmp390_sweep.o ./Core/Src/bmp390_sweep.su ./Core/Src/bmp390_telemetry.cyclo ./Core/Src/bmp390_telemetry.d ./Core/Src/bmp390_telemetry.o ./Core/Src/bmp390_telemetry.su ./Core/Src/main.cyclo ./Core/Src/main.d ./Core/Src/main.o ./Core/Src/main.su ./Core/Src/stm32f1xx_hal_msp.cyclo ./Core/Src/stm32f1xx_hal_msp.d ./Core/Src/stm32f1xx_hal_msp.o ./Core/Src/stm32f1xx_hal_msp.su ./Core/Src/stm32f1xx_it.cyclo ./Core/Src/stm32f1xx_it.d ./Core/Src/stm32f1xx_it.o ./Core/Src/stm32f1xx_it.su ./Core/Src/syscalls.cyclo ./Core/Src/syscalls.d ./Core/Src/syscalls.o ./Core/Src/syscalls.su ./Core/Src/sysmem.cyclo ./Core/Src/sysmem.d ./Core/Src/sysmem.o ./Core/Src/sysmem.su ./Core/Src/system_stm32f1xx.cyclo ./Core/Src/system_stm32f1xx.d ./Core/Src/system_stm32f1xx.o ./Core/Src/system_stm32f1xx.su
 
 .PHONY: clean-Core-2f-Src
 
@@ -0,0 +1,551 @@
+/*!
+ *  @file : bmp390_mock.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * NOTE ==> Behaviour follows the datasheet where the driver depends on it : the mode field is 2 bits and only 11 is
+ * 			normal mode, ERR.cmd_err/conf_err, EVENT and INT_STATUS are cleared by reading them, drdy_press and
+ * 			drdy_temp by reading a data register. Normal mode checks the conversion time against the ODR period of
+ * 			the registers at the moment it is entered (or a register changes), so the order of the writes matters.
+ * 			Raw values are BMP390_Sim_RawPress/RawTemp of the true values, the same inverse the simulator uses.
+ */
+
+#include "bmp390_mock.h"
+#include "bmp390_sim.h"
+#include "host_hal.h"
+#include "string.h"
+
+
+#define BMP390_Mock_NsPerCount		39062.5		/*! SENSORTIME period, 25.6 kHz */
+
+#define BMP390_Mock_Err_Cmd			0x02
+#define BMP390_Mock_Err_Conf		0x04
+
+BMP390_Mock_TypeDef BMP390_Mock;
+
+static void BMP390_Mock_PowerOn(void);
+static void BMP390_Mock_Configure(void);
+static void BMP390_Mock_Convert(uint64_t sensortime);
+static void BMP390_Mock_Push(const uint8_t *frame, uint8_t len);
+static uint8_t BMP390_Mock_Pop(uint8_t *timeBytes);
+static uint64_t BMP390_Mock_TimeAt(uint64_t us);
+static uint64_t BMP390_Mock_UsAt(uint64_t sensortime);
+static uint32_t BMP390_Mock_MeasTime(void);
+static uint32_t BMP390_Mock_Step(void);
+static void BMP390_Mock_Put24(uint8_t *p, uint32_t v);
+
+
+void BMP390_Mock_Init(uint16_t address){
+
+	BMP390_RawCalibData_TypeDef Nvm = {
+
+		.T1 = 27504, .T2 = 26435, .T3 = -3,
+		.P1 = 1234, .P2 = 16000, .P3 = 10, .P4 = 0, .P5 = 19945, .P6 = 4000,
+		.P7 = 0, .P8 = 0, .P9 = 0, .P10 = 0, .P11 = 0
+	};
+	BMP390_HandleTypeDef Calc;
+	uint8_t *n;
+
+	memset(&BMP390_Mock, 0, sizeof(BMP390_Mock));
+
+	BMP390_Mock.address = address;
+	BMP390_Mock.press = 101325.0f;
+	BMP390_Mock.temp = 25.0f;
+	BMP390_Mock.rng = 1;
+
+	//NVM_PAR_T1 .. NVM_PAR_P11, little endian like BMP390_Get_RawCalibCoeff reads them
+	n = &BMP390_Mock.reg[BMP390_StartAdd_CalibCoeff];
+	n[0] = (uint8_t)Nvm.T1;  n[1] = (uint8_t)(Nvm.T1 >> 8);
+	n[2] = (uint8_t)Nvm.T2;  n[3] = (uint8_t)(Nvm.T2 >> 8);
+	n[4] = (uint8_t)Nvm.T3;
+	n[5] = (uint8_t)Nvm.P1;  n[6] = (uint8_t)((uint16_t)Nvm.P1 >> 8);
+	n[7] = (uint8_t)Nvm.P2;  n[8] = (uint8_t)((uint16_t)Nvm.P2 >> 8);
+	n[9] = (uint8_t)Nvm.P3;
+	n[10] = (uint8_t)Nvm.P4;
+	n[11] = (uint8_t)Nvm.P5; n[12] = (uint8_t)(Nvm.P5 >> 8);
+	n[13] = (uint8_t)Nvm.P6; n[14] = (uint8_t)(Nvm.P6 >> 8);
+	n[15] = (uint8_t)Nvm.P7;
+	n[16] = (uint8_t)Nvm.P8;
+	n[17] = (uint8_t)Nvm.P9; n[18] = (uint8_t)((uint16_t)Nvm.P9 >> 8);
+	n[19] = (uint8_t)Nvm.P10;
+	n[20] = (uint8_t)Nvm.P11;
+
+	BMP390_Calc_PrcsdCalibrationCoeff(&Calc, &Nvm);
+	BMP390_Mock.Calib = Calc.Prcsd_NVM;
+
+	BMP390_Mock_PowerOn();
+}
+
+
+void BMP390_Mock_Brownout(void){
+
+	BMP390_Mock_PowerOn();
+}
+
+
+void BMP390_Mock_Sync(void){
+
+	uint64_t now = Host_Micros();
+
+	while(BMP390_Mock.running && (BMP390_Mock_UsAt(BMP390_Mock.nextTime) <= now)){
+
+		BMP390_Mock_Convert(BMP390_Mock.nextTime);
+		BMP390_Mock.nextTime += BMP390_Mock_Step();
+	}
+
+	if(BMP390_Mock.forced && (BMP390_Mock.forcedEnd <= now)){
+
+		BMP390_Mock.forced = false;
+		BMP390_Mock_Convert(BMP390_Mock_TimeAt(BMP390_Mock.forcedEnd));
+
+		//Back to sleep after the conversion
+		BMP390_Mock.reg[BMP390_REG_PWR_CTRL] &= (uint8_t)~0x30;
+	}
+}
+
+
+void BMP390_Mock_Read(uint8_t reg, uint8_t *data, uint16_t len){
+
+	uint8_t *r = BMP390_Mock.reg;
+	uint8_t timeBytes = 0;
+	uint16_t i;
+
+	BMP390_Mock_Sync();
+
+	if(reg == BMP390_REG_FIFO_DATA){
+
+		for(i = 0; i < len; i++){
+
+			data[i] = BMP390_Mock_Pop(&timeBytes);
+		}
+
+		return;
+	}
+
+	r[BMP390_REG_FIFO_LENGTH_0_1] = (uint8_t)(BMP390_Mock.fifoLen & 0xFF);
+	r[BMP390_REG_FIFO_LENGTH_0_1 + 1] = (uint8_t)(BMP390_Mock.fifoLen >> 8);
+
+	for(i = 0; i < len; i++){
+
+		data[i] = r[(reg + i) & (BMP390_Mock_RegCount - 1)];
+	}
+
+	if((reg <= BMP390_REG_DATA_0_5) && ((reg + len) > BMP390_REG_DATA_0_5) &&
+	   (r[BMP390_REG_STATUS] & (BMP390_drdy_Press | BMP390_drdy_Temp))){
+
+		BMP390_Mock.freshReads++;
+	}
+
+	//Cleared by the read
+	for(i = 0; i < len; i++){
+
+		switch((uint8_t)(reg + i)){
+
+			case BMP390_REG_ERR:			r[BMP390_REG_ERR] &= (uint8_t)~(BMP390_Mock_Err_Cmd | BMP390_Mock_Err_Conf); break;
+			case BMP390_REG_DATA_0_5:
+			case BMP390_REG_DATA_0_5 + 1:
+			case BMP390_REG_DATA_0_5 + 2:	r[BMP390_REG_STATUS] &= (uint8_t)~BMP390_drdy_Press; break;
+			case BMP390_REG_DATA_0_5 + 3:
+			case BMP390_REG_DATA_0_5 + 4:
+			case BMP390_REG_DATA_0_5 + 5:	r[BMP390_REG_STATUS] &= (uint8_t)~BMP390_drdy_Temp; break;
+			case BMP390_REG_EVENT:			r[BMP390_REG_EVENT] = 0; break;
+			case BMP390_REG_INT_STATUS:		r[BMP390_REG_INT_STATUS] = 0; break;
+			default:						break;
+		}
+	}
+}
+
+
+void BMP390_Mock_Write(uint8_t reg, const uint8_t *data, uint16_t len){
+
+	uint8_t *r = BMP390_Mock.reg;
+	uint8_t chg[2] = {BMP390_Fifo_Hdr_ConfigChg, 0x00};
+	uint8_t a, v, mode;
+
+	BMP390_Mock_Sync();
+
+	for(uint16_t i = 0; i < len; i++){
+
+		a = (uint8_t)(reg + i);
+		v = data[i];
+
+		switch(a){
+
+			case BMP390_REG_CMD:
+
+				if(v == BMP390_CMD_Softreset){
+
+					BMP390_Mock_PowerOn();
+				}
+				else if(v == BMP390_CMD_Fifoflush){
+
+					BMP390_Mock.fifoLen = 0;
+					BMP390_Mock.subsCount = 0;
+				}
+				else{
+
+					r[BMP390_REG_ERR] |= BMP390_Mock_Err_Cmd;
+				}
+				break;
+
+			case BMP390_REG_PWR_CTRL:
+
+				r[a] = v & 0x33;
+				mode = (v >> 4) & 0x03;
+
+				BMP390_Mock.running = false;
+				BMP390_Mock.forced = false;
+
+				if((mode == 1) || (mode == 2)){
+
+					BMP390_Mock.forced = true;
+					BMP390_Mock.forcedEnd = Host_Micros() + BMP390_Mock_MeasTime();
+				}
+				else if(mode == 3){
+
+					BMP390_Mock_Configure();
+				}
+				break;
+
+			case BMP390_REG_OSR:
+			case BMP390_REG_ODR:
+			case BMP390_REG_CONFIG:
+
+				v &= (a == BMP390_REG_OSR) ? 0x3F : (a == BMP390_REG_ODR) ? 0x1F : 0x0E;
+
+				if((r[a] != v) && (r[BMP390_REG_FIFO_CONFIG_1] & 0x01)){
+
+					BMP390_Mock_Push(chg, sizeof(chg));
+				}
+
+				r[a] = v;
+
+				if(((r[BMP390_REG_PWR_CTRL] >> 4) & 0x03) == 3){
+
+					BMP390_Mock_Configure();
+				}
+				break;
+
+			case BMP390_REG_FIFO_WTM_0_1:
+			case BMP390_REG_FIFO_WTM_0_1 + 1:
+			case BMP390_REG_FIFO_CONFIG_1:
+			case BMP390_REG_FIFO_CONFIG_2:
+			case BMP390_REG_INT_CTRL:
+			case BMP390_REG_IF_CONF:
+
+				r[a] = v;
+				break;
+
+			default:
+
+				//Read only
+				break;
+		}
+	}
+}
+
+
+_Bool BMP390_Mock_IntLevel(void){
+
+	uint8_t ctrl = BMP390_Mock.reg[BMP390_REG_INT_CTRL];
+	uint8_t mask = ((ctrl & 0x40) ? BMP390_IntStat_drdy : 0) | ((ctrl & 0x10) ? BMP390_IntStat_Fifo_full : 0) |
+				   ((ctrl & 0x08) ? BMP390_IntStat_Fifo_wm : 0);
+
+	BMP390_Mock_Sync();
+
+	return (BMP390_Mock.reg[BMP390_REG_INT_STATUS] & mask) != 0;
+}
+
+
+uint32_t BMP390_Mock_Sensortime(void){
+
+	return (uint32_t)(BMP390_Mock_TimeAt(Host_Micros()) & BMP390_Sensortime_Mask);
+}
+
+
+/**
+ * @brief  Power-on reset values, everything that ran is stopped.
+ */
+static void BMP390_Mock_PowerOn(void){
+
+	uint8_t *r = BMP390_Mock.reg;
+
+	memset(r, 0, BMP390_StartAdd_CalibCoeff);
+	memset(&r[0x46], 0, BMP390_Mock_RegCount - 0x46);
+
+	r[0x00] = BMP390_Mock_ChipId;
+	r[0x01] = 0x01;
+	r[BMP390_REG_STATUS] = BMP390_drdy_CMD;
+	r[BMP390_REG_EVENT] = BMP390_Event_por_detected;
+	r[BMP390_REG_FIFO_WTM_0_1] = 0x01;
+	r[BMP390_REG_FIFO_CONFIG_1] = 0x02;
+	r[BMP390_REG_FIFO_CONFIG_2] = 0x02;
+	r[BMP390_REG_INT_CTRL] = 0x02;
+	r[BMP390_REG_OSR] = 0x02;
+
+	BMP390_Mock.running = false;
+	BMP390_Mock.forced = false;
+	BMP390_Mock.primed = false;
+	BMP390_Mock.fifoLen = 0;
+	BMP390_Mock.subsCount = 0;
+}
+
+
+/**
+ * @brief  Normal mode starts again with the current registers, or stops with conf_err if they don't fit.
+ */
+static void BMP390_Mock_Configure(void){
+
+	uint32_t period = BMP390_Calc_OdrPeriod((BMP390_ODR_TypeDef)BMP390_Mock.reg[BMP390_REG_ODR]);
+
+	if((BMP390_Mock.reg[BMP390_REG_ODR] > BMP390_ODR_0p0015) || (BMP390_Mock_MeasTime() > period)){
+
+		BMP390_Mock.running = false;
+		BMP390_Mock.reg[BMP390_REG_ERR] |= BMP390_Mock_Err_Conf;
+		return;
+	}
+
+	BMP390_Mock.running = true;
+	BMP390_Mock.nextTime = BMP390_Mock_TimeAt(Host_Micros()) + BMP390_Mock_Step();
+}
+
+
+/**
+ * @brief  End of one conversion : data registers, sensortime, drdy, INT_STATUS and the FIFO.
+ */
+static void BMP390_Mock_Convert(uint64_t sensortime){
+
+	uint8_t *r = BMP390_Mock.reg;
+	uint8_t pwr = r[BMP390_REG_PWR_CTRL];
+	uint8_t cfg1 = r[BMP390_REG_FIFO_CONFIG_1];
+	float coef = (float)((1u << ((r[BMP390_REG_CONFIG] >> 1) & 0x07)) - 1u);
+	float press = BMP390_Mock.press, temp = BMP390_Mock.temp;
+	float pressSlope, tempSlope;
+	double rawPress, rawTemp;
+	uint32_t outPress, outTemp, fifoPress, fifoTemp;
+	uint8_t frame[BMP390_Fifo_PressTempLen];
+	uint8_t len = 1;
+
+	if(BMP390_Mock.Truth != NULL){
+
+		BMP390_Mock.Truth(BMP390_Mock_UsAt(sensortime), &press, &temp);
+	}
+
+	rawTemp = BMP390_Sim_RawTemp(&BMP390_Mock.Calib, temp, &tempSlope);
+	rawPress = BMP390_Sim_RawPress(&BMP390_Mock.Calib, press, temp, &pressSlope);
+
+	if(BMP390_Mock.noise > 0.0f){
+
+		rawTemp += BMP390_Mock.noise * (BMP390_TempNoise_X1 * BMP390_OsrNoiseFactor((r[BMP390_REG_OSR] >> 3) & 0x07) / tempSlope) *
+				   BMP390_Sim_Noise(&BMP390_Mock.rng);
+		rawPress += BMP390_Mock.noise * (BMP390_PressNoise_X1 * BMP390_OsrNoiseFactor(r[BMP390_REG_OSR] & 0x07) / pressSlope) *
+					BMP390_Sim_Noise(&BMP390_Mock.rng);
+	}
+
+	if(!BMP390_Mock.primed){
+
+		BMP390_Mock.pressFilt = rawPress;
+		BMP390_Mock.tempFilt = rawTemp;
+		BMP390_Mock.primed = true;
+	}
+	else{
+
+		BMP390_Mock.pressFilt = ((BMP390_Mock.pressFilt * coef) + rawPress) / (coef + 1.0);
+		BMP390_Mock.tempFilt = ((BMP390_Mock.tempFilt * coef) + rawTemp) / (coef + 1.0);
+	}
+
+	outPress = (uint32_t)(BMP390_Mock.pressFilt + 0.5);
+	outTemp = (uint32_t)(BMP390_Mock.tempFilt + 0.5);
+
+	BMP390_Mock.conversions++;
+
+	if(pwr & 0x01){
+
+		BMP390_Mock_Put24(&r[BMP390_REG_DATA_0_5], outPress);
+		r[BMP390_REG_STATUS] |= BMP390_drdy_Press;
+	}
+
+	if(pwr & 0x02){
+
+		BMP390_Mock_Put24(&r[BMP390_REG_DATA_0_5 + 3], outTemp);
+		r[BMP390_REG_STATUS] |= BMP390_drdy_Temp;
+	}
+
+	BMP390_Mock_Put24(&r[BMP390_REG_SENSORTIME_0_3], (uint32_t)(sensortime & BMP390_Sensortime_Mask));
+	r[BMP390_REG_INT_STATUS] |= BMP390_IntStat_drdy;
+
+	if(!(cfg1 & 0x01) || !(cfg1 & 0x18)){
+
+		return;
+	}
+
+	//fifo_subsampling : one conversion out of 2^subs goes into the FIFO
+	if((BMP390_Mock.subsCount++ & ((1u << (r[BMP390_REG_FIFO_CONFIG_2] & 0x07)) - 1u)) != 0){
+
+		return;
+	}
+
+	//data_select : filtered or unfiltered values
+	fifoPress = (r[BMP390_REG_FIFO_CONFIG_2] & 0x18) ? outPress : (uint32_t)(rawPress + 0.5f);
+	fifoTemp = (r[BMP390_REG_FIFO_CONFIG_2] & 0x18) ? outTemp : (uint32_t)(rawTemp + 0.5f);
+
+	frame[0] = 0x80 | ((cfg1 & 0x10) ? 0x10 : 0) | ((cfg1 & 0x08) ? 0x04 : 0);
+
+	if(cfg1 & 0x10){
+
+		BMP390_Mock_Put24(&frame[len], fifoTemp);
+		len += 3;
+	}
+
+	if(cfg1 & 0x08){
+
+		BMP390_Mock_Put24(&frame[len], fifoPress);
+		len += 3;
+	}
+
+	BMP390_Mock_Push(frame, len);
+}
+
+
+/**
+ * @brief  One frame into the FIFO. When it is full the oldest frames go, or the new one with fifo_stop_on_full.
+ */
+static void BMP390_Mock_Push(const uint8_t *frame, uint8_t len){
+
+	uint8_t *r = BMP390_Mock.reg;
+	uint16_t wtm = r[BMP390_REG_FIFO_WTM_0_1] | ((r[BMP390_REG_FIFO_WTM_0_1 + 1] & 0x01) << 8);
+	uint16_t drop = 0;
+
+	if((BMP390_Mock.fifoLen + len) > BMP390_Fifo_Capacity){
+
+		r[BMP390_REG_INT_STATUS] |= BMP390_IntStat_Fifo_full;
+		BMP390_Mock.fifoDrops++;
+
+		if(r[BMP390_REG_FIFO_CONFIG_1] & 0x02){
+
+			return;
+		}
+
+		while((BMP390_Mock.fifoLen - drop + len) > BMP390_Fifo_Capacity){
+
+			uint8_t h = BMP390_Mock.fifo[drop];
+
+			drop += (h == BMP390_Fifo_Hdr_PressTemp) ? 7 : ((h == BMP390_Fifo_Hdr_Temp) || (h == BMP390_Fifo_Hdr_Press)) ? 4 : 2;
+		}
+
+		memmove(BMP390_Mock.fifo, &BMP390_Mock.fifo[drop], BMP390_Mock.fifoLen - drop);
+		BMP390_Mock.fifoLen -= drop;
+	}
+
+	memcpy(&BMP390_Mock.fifo[BMP390_Mock.fifoLen], frame, len);
+	BMP390_Mock.fifoLen += len;
+
+	if((wtm != 0) && (BMP390_Mock.fifoLen >= wtm)){
+
+		r[BMP390_REG_INT_STATUS] |= BMP390_IntStat_Fifo_wm;
+	}
+}
+
+
+/**
+ * @brief  Next byte of a FIFO_DATA burst. Past the fill level comes the sensortime frame (fifo_time_en) once per
+ * 		   burst, then empty frames.
+ */
+static uint8_t BMP390_Mock_Pop(uint8_t *timeBytes){
+
+	uint8_t *r = BMP390_Mock.reg;
+	uint8_t b;
+
+	if(BMP390_Mock.fifoLen != 0){
+
+		b = BMP390_Mock.fifo[0];
+		memmove(BMP390_Mock.fifo, &BMP390_Mock.fifo[1], --BMP390_Mock.fifoLen);
+		return b;
+	}
+
+	if(!(r[BMP390_REG_FIFO_CONFIG_1] & 0x04) && (*timeBytes < 4)){
+
+		*timeBytes = 4;
+	}
+
+	if(*timeBytes < 4){
+
+		b = (*timeBytes == 0) ? BMP390_Fifo_Hdr_Time : r[BMP390_REG_SENSORTIME_0_3 + *timeBytes - 1];
+		(*timeBytes)++;
+		return b;
+	}
+
+	*timeBytes = (*timeBytes == 4) ? 5 : 4;
+
+	return (*timeBytes == 5) ? BMP390_Fifo_Hdr_Empty : 0x00;
+}
+
+
+static uint64_t BMP390_Mock_TimeAt(uint64_t us){
+
+	return (uint64_t)(((double)us * 1000.0 * (1.0 + (BMP390_Mock.ppm * 1e-6))) / BMP390_Mock_NsPerCount);
+}
+
+
+static uint64_t BMP390_Mock_UsAt(uint64_t sensortime){
+
+	double us = ((double)sensortime * BMP390_Mock_NsPerCount) / (1000.0 * (1.0 + (BMP390_Mock.ppm * 1e-6)));
+
+	return (uint64_t)us + 1u;
+}
+
+
+static uint32_t BMP390_Mock_MeasTime(void){
+
+	BMP390_Params_t Params = {0};
+
+	Params.stat_meas_press = BMP390_Mock.reg[BMP390_REG_PWR_CTRL] & 0x01;
+	Params.stat_meas_temp = (BMP390_Mock.reg[BMP390_REG_PWR_CTRL] >> 1) & 0x01;
+	Params.press_osrs = BMP390_Mock.reg[BMP390_REG_OSR] & 0x07;
+	Params.temp_osrs = (BMP390_Mock.reg[BMP390_REG_OSR] >> 3) & 0x07;
+
+	return BMP390_Calc_MeasTime(&Params);
+}
+
+
+static uint32_t BMP390_Mock_Step(void){
+
+	return (uint32_t)BMP390_Sensortime_OdrStep << BMP390_Mock.reg[BMP390_REG_ODR];
+}
+
+
+static void BMP390_Mock_Put24(uint8_t *p, uint32_t v){
+
+	p[0] = (uint8_t)v;
+	p[1] = (uint8_t)(v >> 8);
+	p[2] = (uint8_t)(v >> 16);
+}
@@ -0,0 +1,133 @@
+/*!
+ * @file : bmp390_mock.h
+
+ * Author: Yunus Emre KAYRA (github.com/YEK-Kayra)
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ **/
+
+#ifndef BMP390_MOCK_H_
+#define BMP390_MOCK_H_
+
+
+/******************************************************************************
+         			#### BMP390 MOCK INCLUDES ####
+******************************************************************************/
+#include "bmp390.h"
+#include "bmp390_fifo.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/******************************************************************************
+         			#### BMP390 MOCK DEFINITIONS ####
+******************************************************************************/
+
+#define BMP390_Mock_ChipId			0x60
+#define BMP390_Mock_RegCount		0x80
+
+
+/******************************************************************************
+         			#### BMP390 MOCK STRUCTURES ####
+******************************************************************************/
+
+/**
+ * @brief  True pressure (Pa) and temperature (°C) at an MCU time (us).
+ */
+typedef void (*BMP390_Mock_Truth_t)(uint64_t us, float *press, float *temp);
+
+
+/**
+ * @brief  Register level model of the sensor behind the I2C stubs of host_hal.c.
+ * 		   Sleep, forced (01 and 10) and normal (11) mode, conversions at the ODR of the sensor's own clock,
+ * 		   drdy and interrupt flags that are cleared on read, conf_err when a conversion doesn't fit into the
+ * 		   ODR period, the 512 byte FIFO with its sensortime, empty and configuration change frames.
+ */
+typedef struct{
+
+	uint16_t address;				/*! As the driver passes it to the HAL */
+	uint8_t reg[BMP390_Mock_RegCount];
+
+	BMP390_PrcsdCalibData_TypeDef Calib;	/*! From the NVM bytes at 0x31 */
+
+	float press;					/*! True values when Truth is NULL */
+	float temp;
+	BMP390_Mock_Truth_t Truth;
+	float noise;					/*! 0 : exact raw values, 1 : datasheet noise at the oversampling */
+	uint32_t rng;
+	float ppm;						/*! The sensor clock runs fast by this much */
+
+	uint8_t running;				/*! Normal mode with a configuration that fits */
+	uint64_t nextTime;				/*! Sensortime counts (not wrapped) of the next normal mode conversion */
+	uint8_t forced;					/*! A forced conversion ends at forcedEnd (us) */
+	uint64_t forcedEnd;
+
+	double pressFilt;				/*! IIR filter of the sensor, raw counts */
+	double tempFilt;
+	uint8_t primed;
+
+	uint8_t fifo[BMP390_Fifo_Capacity];
+	uint16_t fifoLen;
+	uint32_t subsCount;
+
+	uint32_t conversions;
+	uint32_t freshReads;			/*! Reads of the data registers that found drdy set */
+	uint32_t fifoDrops;				/*! Frames lost to a full FIFO */
+
+}BMP390_Mock_TypeDef;
+
+extern BMP390_Mock_TypeDef BMP390_Mock;
+
+
+/******************************************************************************
+         	#### BMP390 MOCK PROTOTYPES OF FUNCTIONS ####
+******************************************************************************/
+
+/**
+  * @brief  Power on : reset values, EVENT.por_detected, a typical NVM, 1013.25 hPa at 25 °C, no noise.
+  * @param  address that answers on the bus.
+  */
+void BMP390_Mock_Init(uint16_t address);
+
+
+/**
+  * @brief  Brown-out : the power-on reset values with por_detected, the NVM and the true values stay.
+  */
+void BMP390_Mock_Brownout(void);
+
+
+/**
+  * @brief  Runs the conversions that have ended by now (Host_Micros). Every register access does it first.
+  */
+void BMP390_Mock_Sync(void);
+
+
+/**
+  * @brief  Burst read and write. A read from FIFO_DATA stays on it, other reads increment the address.
+  */
+void BMP390_Mock_Read(uint8_t reg, uint8_t *data, uint16_t len);
+void BMP390_Mock_Write(uint8_t reg, const uint8_t *data, uint16_t len);
+
+
+/**
+  * @brief  INT pin : an enabled flag of INT_STATUS is set.
+  */
+_Bool BMP390_Mock_IntLevel(void);
+
+
+/**
+  * @brief  Sensortime counter (24 bit) now.
+  */
+uint32_t BMP390_Mock_Sensortime(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP390_MOCK_H_ */
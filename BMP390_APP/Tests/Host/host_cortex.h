@@ -0,0 +1,40 @@
+/*!
+ * @file : host_cortex.h
+
+ * Author: Yunus Emre KAYRA (github.com/YEK-Kayra)
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ **/
+
+/**
+ * NOTE ==> Forced into every translation unit of the host build (-include). The CMSIS intrinsics of cmsis_gcc.h
+ * 			stay as they are, the Cortex-M3 instructions that they emit become assembler macros for the host :
+ * 			the barriers are full fences, the interrupt mask is always clear and the sleep instructions return.
+ * 			Assembler macro names are not case sensitive, DMB and dmb are the same macro.
+ * 			It has to come before any code, the build uses -fno-toplevel-reorder.
+ */
+
+#ifndef HOST_CORTEX_H_
+#define HOST_CORTEX_H_
+
+#if !defined(__arm__)
+
+__asm__(
+	".macro dmb opt\n mfence\n.endm\n"
+	".macro dsb opt\n mfence\n.endm\n"
+	".macro isb opt\n.endm\n"
+	".macro cpsid flags\n.endm\n"
+	".macro cpsie flags\n.endm\n"
+	".macro mrs reg, sysreg\n xorl \\reg, \\reg\n.endm\n"
+	".macro msr sysreg, reg\n.endm\n"
+	".macro wfi\n.endm\n"
+	".macro wfe\n.endm\n"
+	".macro sev\n.endm\n"
+);
+
+#endif
+
+#endif /* HOST_CORTEX_H_ */
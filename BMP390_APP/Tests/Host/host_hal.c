@@ -0,0 +1,760 @@
+/*!
+ *  @file : host_hal.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * NOTE ==> The firmware modules are linked unmodified. Flash, the peripherals, their bit-band alias and the Cortex-M3
+ * 			system area are mapped at their real addresses before main, so DWT->CYCCNT, I2C1->SR2 or RCC->AHBENR are
+ * 			plain memory. Only the HAL functions that the modules call are replaced : I2C goes to the sensor mock,
+ * 			flash writes behave like NOR flash, DMA transfers end when the test says so. Time is virtual.
+ */
+
+#define _GNU_SOURCE
+#include "host_hal.h"
+#include "bmp390_mock.h"
+#include "sys/mman.h"
+#include "pthread.h"
+#include "stdlib.h"
+#include "string.h"
+#include "time.h"
+
+#ifndef MAP_FIXED_NOREPLACE
+#define MAP_FIXED_NOREPLACE			0x100000
+#endif
+
+#define Host_PeriphSize				0x30000		/*! APB1, APB2 and AHB (DMA, RCC, flash interface) */
+#define Host_PeriphBbSize			0x800000	/*! Bit-band alias of the APB1 .. AHB range */
+#define Host_SystemBase				0xE0000000UL
+#define Host_SystemSize				0x100000	/*! ITM, DWT, SCS (NVIC, SCB, SysTick, CoreDebug) */
+#define Host_I2cClock				100000
+#define Host_RtcSyncTime			20			/*! us between two RSF updates of the RTC thread */
+
+
+/**!Globals of main.c that the modules use */
+I2C_HandleTypeDef hi2c1;
+TIM_HandleTypeDef htim1;
+float  BMP390_Press;
+float  BMP390_Temp;
+float  BMP390_VertAlt;
+float  BMP390_VertAcc;
+float  BMP390_VertSpd;
+float  TotalMass = 0.75;
+float  BMP390_gForce;
+
+uint32_t SystemCoreClock = 8000000;
+
+Host_Stats_TypeDef Host_Stats;
+
+static uint64_t Host_Now;
+static Host_Fault_TypeDef Host_Fault;
+static uint32_t Host_FaultCount;
+static uint32_t Host_SdaHeld;
+static _Bool Host_BusyStuck;					/*! BUSY latched without a transfer, errata */
+static GPIO_PinState Host_Scl = GPIO_PIN_SET;
+static GPIO_PinState Host_Sda = GPIO_PIN_SET;
+static DMA_HandleTypeDef *Host_Dma;
+static uint8_t Host_DmaEnd;					/*! 0 : running, 1 : complete, 2 : transfer error */
+static uint32_t Host_DmaSrc;
+static uint16_t Host_DmaLen;
+static uint16_t Host_I2cDma;
+static int Host_Failures;
+static _Bool Host_RtcOn;						/*! The backup domain is enabled */
+static _Bool Host_RtcSync;
+
+static void Host_Map(uintptr_t base, size_t size, uint8_t fill);
+static HAL_StatusTypeDef Host_I2c_Transfer(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint8_t *pData,
+										   uint16_t Size, uint32_t Timeout, _Bool write);
+static void Host_I2c_Wire(const I2C_HandleTypeDef *hi2c, uint32_t bytes);
+static void Host_Rtc_Count(uint32_t ms);
+static void *Host_Rtc_Thread(void *arg);
+
+
+__attribute__((constructor)) static void Host_Init(void){
+
+	Host_Map(FLASH_BASE, Host_FlashSize, 0xFF);
+	Host_Map(PERIPH_BASE, Host_PeriphSize, 0x00);
+	Host_Map(PERIPH_BB_BASE, Host_PeriphBbSize, 0x00);
+	Host_Map(Host_SystemBase, Host_SystemSize, 0x00);
+
+	Host_Reset();
+}
+
+
+void Host_Reset(void){
+
+	Host_Now = 0;
+	Host_Fault = Host_Fault_None;
+	Host_FaultCount = 0;
+	Host_SdaHeld = 0;
+	Host_BusyStuck = false;
+	Host_Scl = GPIO_PIN_SET;
+	Host_Sda = GPIO_PIN_SET;
+	Host_Dma = NULL;
+	Host_DmaEnd = 0;
+	Host_DmaLen = 0;
+	Host_I2cDma = 0;
+	Host_Stats = (Host_Stats_TypeDef){0};
+
+	memset((void *)FLASH_BASE, 0xFF, Host_FlashSize);
+
+	memset(&hi2c1, 0, sizeof(hi2c1));
+	hi2c1.Instance = I2C1;
+	hi2c1.Init.ClockSpeed = Host_I2cClock;
+	hi2c1.State = HAL_I2C_STATE_READY;
+	I2C1->CR1 = 0;
+	I2C1->SR2 = 0;
+	Host_RtcOn = false;
+}
+
+
+uint64_t Host_Micros(void){
+
+	return Host_Now;
+}
+
+
+void Host_Advance(uint32_t us){
+
+	uint32_t ms = (uint32_t)(((Host_Now + us) / 1000u) - (Host_Now / 1000u));
+
+	Host_Now += us;
+
+	if(Host_RtcOn){
+
+		Host_Rtc_Count(ms);
+	}
+}
+
+
+uint64_t Host_Cycles(void){
+
+#if defined(__x86_64__) || defined(__i386__)
+	return __builtin_ia32_rdtsc();
+#else
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((uint64_t)now.tv_sec * 1000000000u) + (uint64_t)now.tv_nsec;
+#endif
+}
+
+
+/**
+ * @brief  BMP390_Cycles of the firmware : DWT->CYCCNT is plain memory here and doesn't count.
+ */
+uint32_t BMP390_Cycles(void){
+
+	return (uint32_t)Host_Cycles();
+}
+
+
+void Host_I2c_Inject(Host_Fault_TypeDef fault, uint32_t count){
+
+	Host_Fault = fault;
+	Host_FaultCount = count;
+}
+
+
+void Host_I2c_HoldSda(uint32_t clocks){
+
+	Host_SdaHeld = clocks;
+
+	if(clocks != 0){
+
+		I2C1->SR2 |= I2C_SR2_BUSY;
+	}
+}
+
+
+void Host_I2c_StickBusy(void){
+
+	Host_BusyStuck = true;
+
+	I2C1->SR2 |= I2C_SR2_BUSY;
+}
+
+
+_Bool Host_Dma_Finish(_Bool error){
+
+	if((Host_Dma == NULL) || (Host_DmaEnd != 0)){
+
+		return false;
+	}
+
+	Host_DmaEnd = error ? 2 : 1;
+
+	return true;
+}
+
+
+uint16_t Host_Dma_Data(uint32_t *src){
+
+	if((Host_Dma == NULL) || (Host_DmaEnd != 0)){
+
+		return 0;
+	}
+
+	*src = Host_DmaSrc;
+
+	return Host_DmaLen;
+}
+
+
+uint16_t Host_I2c_TakeDma(void){
+
+	uint16_t len = Host_I2cDma;
+
+	Host_I2cDma = 0;
+
+	return len;
+}
+
+
+void Host_Check(_Bool ok, const char *what, const char *file, int line){
+
+	if(!ok){
+
+		printf("%s:%d: check failed : %s\n", file, line, what);
+		Host_Failures++;
+	}
+}
+
+
+int Host_Result(const char *name){
+
+	printf("%s : %s (%d failed checks)\n", name, (Host_Failures == 0) ? "PASS" : "FAIL", Host_Failures);
+
+	return (Host_Failures == 0) ? 0 : 1;
+}
+
+
+/******************************************************************************
+         			#### HAL REPLACEMENTS ####
+******************************************************************************/
+
+uint32_t HAL_GetTick(void){
+
+	return (uint32_t)(Host_Now / 1000u);
+}
+
+
+void HAL_Delay(uint32_t Delay){
+
+	Host_Advance(Delay * 1000u);
+}
+
+
+void HAL_SuspendTick(void){
+
+}
+
+
+void HAL_ResumeTick(void){
+
+}
+
+
+uint32_t HAL_RCC_GetPCLK2Freq(void){
+
+	return SystemCoreClock;
+}
+
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority){
+
+}
+
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn){
+
+}
+
+
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn){
+
+}
+
+
+void HAL_NVIC_SetPendingIRQ(IRQn_Type IRQn){
+
+	Host_Stats.pending[(uint32_t)IRQn & 63u]++;
+}
+
+
+/**
+ * @brief  The backup domain, only BMP390_LowPower uses it : the LSI is ready at once, RTC writes are done at once
+ * 		   (RTOFF) and a thread stands in for the APB1 resynchronization that sets RSF again after a clear.
+ */
+void HAL_PWR_EnableBkUpAccess(void){
+
+	pthread_t thread;
+
+	RCC->CSR |= RCC_CSR_LSIRDY;
+	RTC->CRL |= RTC_CRL_RTOFF | RTC_CRL_RSF;
+	Host_RtcOn = true;
+
+	if(!Host_RtcSync && (pthread_create(&thread, NULL, Host_Rtc_Thread, NULL) == 0)){
+
+		pthread_detach(thread);
+		Host_RtcSync = true;
+	}
+}
+
+
+void HAL_PWR_EnterSLEEPMode(uint32_t Regulator, uint8_t SLEEPEntry){
+
+	Host_Stats.sleepModes++;
+}
+
+
+void HAL_PWR_EnterSTOPMode(uint32_t Regulator, uint8_t STOPEntry){
+
+	Host_Stats.stopModes++;
+}
+
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim){
+
+	htim->State = HAL_TIM_STATE_BUSY;
+
+	return HAL_OK;
+}
+
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init){
+
+}
+
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState){
+
+	if(GPIOx != GPIOB){
+
+		return;
+	}
+
+	//The bus clear : every edge is followed by a half clock delay, the slave lets SDA go after its clocks
+	//and the first clock releases a latched BUSY
+	if(GPIO_Pin == GPIO_PIN_6){
+
+		if((PinState == GPIO_PIN_SET) && (Host_Scl == GPIO_PIN_RESET)){
+
+			Host_Stats.sclClocks++;
+			Host_BusyStuck = false;
+
+			if(Host_SdaHeld != 0){
+
+				Host_SdaHeld--;
+			}
+		}
+
+		Host_Scl = PinState;
+		Host_Advance(5);
+	}
+	else if(GPIO_Pin == GPIO_PIN_7){
+
+		if((PinState == GPIO_PIN_SET) && (Host_Sda == GPIO_PIN_RESET) && (Host_Scl == GPIO_PIN_SET)){
+
+			Host_Stats.stops++;
+		}
+
+		Host_Sda = PinState;
+		Host_Advance(5);
+	}
+}
+
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin){
+
+	if((GPIOx == GPIOB) && (GPIO_Pin == GPIO_PIN_7)){
+
+		return (Host_SdaHeld != 0) ? GPIO_PIN_RESET : Host_Sda;
+	}
+
+	//INT of the sensor
+	if((GPIOx == GPIOA) && (GPIO_Pin == GPIO_PIN_0)){
+
+		return BMP390_Mock_IntLevel() ? GPIO_PIN_SET : GPIO_PIN_RESET;
+	}
+
+	return GPIO_PIN_RESET;
+}
+
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *hi2c){
+
+	Host_Stats.inits++;
+
+	hi2c->ErrorCode = HAL_I2C_ERROR_NONE;
+	hi2c->State = HAL_I2C_STATE_READY;
+
+	//The HAL pulses SWRST before it configures the peripheral, that releases a latched BUSY
+	hi2c->Instance->CR1 |= I2C_CR1_SWRST;
+	hi2c->Instance->CR1 &= ~I2C_CR1_SWRST;
+	Host_BusyStuck = false;
+
+	if(Host_SdaHeld != 0){
+
+		hi2c->Instance->SR2 |= I2C_SR2_BUSY;
+	}
+	else{
+
+		hi2c->Instance->SR2 &= ~I2C_SR2_BUSY;
+	}
+
+	return HAL_OK;
+}
+
+
+HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef *hi2c){
+
+	hi2c->State = HAL_I2C_STATE_RESET;
+
+	return HAL_OK;
+}
+
+
+uint32_t HAL_I2C_GetError(I2C_HandleTypeDef *hi2c){
+
+	return hi2c->ErrorCode;
+}
+
+
+HAL_StatusTypeDef HAL_I2C_IsDeviceReady(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint32_t Trials, uint32_t Timeout){
+
+	Host_I2c_Wire(hi2c, 1);
+
+	return (DevAddress == BMP390_Mock.address) ? HAL_OK : HAL_ERROR;
+}
+
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize,
+								   uint8_t *pData, uint16_t Size, uint32_t Timeout){
+
+	return Host_I2c_Transfer(hi2c, DevAddress, MemAddress, pData, Size, Timeout, false);
+}
+
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize,
+									uint8_t *pData, uint16_t Size, uint32_t Timeout){
+
+	return Host_I2c_Transfer(hi2c, DevAddress, MemAddress, pData, Size, Timeout, true);
+}
+
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize,
+									   uint8_t *pData, uint16_t Size){
+
+	//The whole read happens now, the test calls the completion
+	if(Host_I2c_Transfer(hi2c, DevAddress, MemAddress, pData, Size, 0, false) != HAL_OK){
+
+		return HAL_ERROR;
+	}
+
+	Host_Stats.dmaStarts++;
+	Host_I2cDma = Size;
+
+	return HAL_OK;
+}
+
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize,
+									  uint8_t *pData, uint16_t Size){
+
+	//Like the DMA read, the test calls the completion the event interrupt would
+	if(Host_I2c_Transfer(hi2c, DevAddress, MemAddress, pData, Size, 0, false) != HAL_OK){
+
+		return HAL_ERROR;
+	}
+
+	Host_Stats.itStarts++;
+
+	return HAL_OK;
+}
+
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize,
+									   uint8_t *pData, uint16_t Size){
+
+	if(Host_I2c_Transfer(hi2c, DevAddress, MemAddress, pData, Size, 0, true) != HAL_OK){
+
+		return HAL_ERROR;
+	}
+
+	Host_Stats.itStarts++;
+
+	return HAL_OK;
+}
+
+
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *hdma){
+
+	hdma->State = HAL_DMA_STATE_READY;
+	hdma->ErrorCode = HAL_DMA_ERROR_NONE;
+
+	return HAL_OK;
+}
+
+
+HAL_StatusTypeDef HAL_DMA_Start_IT(DMA_HandleTypeDef *hdma, uint32_t SrcAddress, uint32_t DstAddress, uint32_t DataLength){
+
+	if(Host_Dma != NULL){
+
+		return HAL_BUSY;
+	}
+
+	Host_Dma = hdma;
+	Host_DmaEnd = 0;
+	Host_DmaSrc = SrcAddress;
+	Host_DmaLen = (uint16_t)DataLength;
+	hdma->State = HAL_DMA_STATE_BUSY;
+	hdma->ErrorCode = HAL_DMA_ERROR_NONE;
+
+	Host_Stats.dmaStarts++;
+	Host_Stats.dmaBytes += DataLength;
+
+	return HAL_OK;
+}
+
+
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef *hdma){
+
+	uint8_t end = Host_DmaEnd;
+
+	if((hdma != Host_Dma) || (end == 0)){
+
+		return;
+	}
+
+	Host_Dma = NULL;
+	Host_DmaEnd = 0;
+	hdma->State = HAL_DMA_STATE_READY;
+
+	if(end == 2){
+
+		hdma->ErrorCode = HAL_DMA_ERROR_TE;
+
+		if(hdma->XferErrorCallback != NULL){
+
+			hdma->XferErrorCallback(hdma);
+		}
+	}
+	else if(hdma->XferCpltCallback != NULL){
+
+		hdma->XferCpltCallback(hdma);
+	}
+}
+
+
+HAL_StatusTypeDef HAL_FLASH_Unlock(void){
+
+	return HAL_OK;
+}
+
+
+HAL_StatusTypeDef HAL_FLASH_Lock(void){
+
+	return HAL_OK;
+}
+
+
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data){
+
+	uint8_t halfWords = (TypeProgram == FLASH_TYPEPROGRAM_HALFWORD) ? 1 : (TypeProgram == FLASH_TYPEPROGRAM_WORD) ? 2 : 4;
+	volatile uint16_t *cell = (volatile uint16_t *)(uintptr_t)Address;
+
+	for(uint8_t i = 0; i < halfWords; i++){
+
+		uint16_t value = (uint16_t)(Data >> (16 * i));
+
+		Host_Advance(Host_FlashProgramTime);
+
+		//PGERR : only an erased half word can be programmed, or any half word to 0
+		if((cell[i] != 0xFFFF) && (value != 0)){
+
+			return HAL_ERROR;
+		}
+
+		cell[i] = value;
+		Host_Stats.flashWrites++;
+	}
+
+	return HAL_OK;
+}
+
+
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *PageError){
+
+	for(uint32_t i = 0; i < pEraseInit->NbPages; i++){
+
+		memset((void *)(uintptr_t)(pEraseInit->PageAddress + (i * Host_FlashPageSize)), 0xFF, Host_FlashPageSize);
+
+		Host_Advance(Host_FlashEraseTime);
+		Host_Stats.flashErases++;
+	}
+
+	*PageError = 0xFFFFFFFFu;
+
+	return HAL_OK;
+}
+
+
+/**
+ * @brief  Memory at a fixed address, the test stops if anything else is already there.
+ */
+static void Host_Map(uintptr_t base, size_t size, uint8_t fill){
+
+	void *p = mmap((void *)base, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+
+	if(p != (void *)base){
+
+		fprintf(stderr, "host : can't map 0x%08lx\n", (unsigned long)base);
+		exit(2);
+	}
+
+	memset(p, fill, size);
+}
+
+
+/**
+ * @brief  Register transfer with the sensor mock, an injected fault or a held SDA fails it like the HAL would.
+ */
+static HAL_StatusTypeDef Host_I2c_Transfer(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint8_t *pData,
+										   uint16_t Size, uint32_t Timeout, _Bool write){
+
+	Host_Fault_TypeDef fault = Host_Fault_None;
+
+	Host_Stats.transfers++;
+	hi2c->ErrorCode = HAL_I2C_ERROR_NONE;
+
+	if(Host_SdaHeld != 0){
+
+		fault = Host_Fault_Timeout;
+	}
+	else if(Host_FaultCount != 0){
+
+		Host_FaultCount--;
+		fault = Host_Fault;
+	}
+	else if(DevAddress != BMP390_Mock.address){
+
+		fault = Host_Fault_Nack;
+	}
+
+	switch(fault){
+
+		case Host_Fault_None:
+
+			if(write){
+
+				BMP390_Mock_Write((uint8_t)MemAddress, pData, Size);
+			}
+			else{
+
+				BMP390_Mock_Read((uint8_t)MemAddress, pData, Size);
+			}
+
+			Host_I2c_Wire(hi2c, Size + 3u);
+			return HAL_OK;
+
+		case Host_Fault_Nack:
+
+			Host_Stats.faults++;
+			hi2c->ErrorCode = HAL_I2C_ERROR_AF;
+			Host_I2c_Wire(hi2c, 1);
+			return HAL_ERROR;
+
+		case Host_Fault_BusError:
+		case Host_Fault_ArbLost:
+
+			Host_Stats.faults++;
+			hi2c->ErrorCode = (fault == Host_Fault_BusError) ? HAL_I2C_ERROR_BERR : HAL_I2C_ERROR_ARLO;
+			Host_I2c_Wire(hi2c, 2);
+			return HAL_ERROR;
+
+		default:
+
+			Host_Stats.faults++;
+			hi2c->ErrorCode = HAL_I2C_ERROR_TIMEOUT;
+			Host_Advance(Timeout * 1000u);
+			return HAL_TIMEOUT;
+	}
+}
+
+
+/**
+ * @brief  Wire time of bytes on the bus, 9 clocks each.
+ */
+static void Host_I2c_Wire(const I2C_HandleTypeDef *hi2c, uint32_t bytes){
+
+	uint32_t clock = (hi2c->Init.ClockSpeed != 0) ? hi2c->Init.ClockSpeed : Host_I2cClock;
+
+	Host_Advance((bytes * 9u * 1000000u) / clock);
+}
+
+
+/**
+ * @brief  RTC counter of the virtual time, one count per ms whatever the prescaler is (BMP390_Lp_LsiHz exact).
+ * 		   ALRF is set when the counter reaches the alarm, the test calls the alarm interrupt.
+ */
+static void Host_Rtc_Count(uint32_t ms){
+
+	uint32_t cnt = ((uint32_t)RTC->CNTH << 16) | RTC->CNTL;
+	uint32_t alr = ((uint32_t)RTC->ALRH << 16) | RTC->ALRL;
+
+	if((alr - cnt - 1u) < ms){
+
+		RTC->CRL |= RTC_CRL_ALRF;
+	}
+
+	cnt += ms;
+	RTC->CNTH = (uint16_t)(cnt >> 16);
+	RTC->CNTL = (uint16_t)cnt;
+}
+
+
+static void *Host_Rtc_Thread(void *arg){
+
+	struct timespec wait = {0, Host_RtcSyncTime * 1000};
+
+	for(;;){
+
+		if((RTC->CRL & RTC_CRL_RSF) == 0){
+
+			__atomic_fetch_or(&RTC->CRL, RTC_CRL_RSF, __ATOMIC_SEQ_CST);
+		}
+
+		nanosleep(&wait, NULL);
+	}
+
+	return NULL;
+}
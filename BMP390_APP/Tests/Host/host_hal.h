@@ -0,0 +1,164 @@
+/*!
+ * @file : host_hal.h
+
+ * Author: Yunus Emre KAYRA (github.com/YEK-Kayra)
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ **/
+
+#ifndef HOST_HAL_H_
+#define HOST_HAL_H_
+
+
+/******************************************************************************
+         			#### HOST HAL INCLUDES ####
+******************************************************************************/
+#include "main.h"
+#include "stdbool.h"
+#include "stdio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/******************************************************************************
+         			#### HOST HAL DEFINITIONS ####
+******************************************************************************/
+
+#define Host_FlashSize				0x10000		/*! Mapped at FLASH_BASE, erased (0xFF) */
+#define Host_FlashPageSize			1024
+#define Host_FlashEraseTime			20000		/*! us, the core stalls this long on a page erase (single bank) */
+#define Host_FlashProgramTime		60			/*! us per half word */
+
+/**!Checks of the tests, a failure is printed and counted, the test goes on */
+#define HOST_CHECK(cond)			Host_Check((cond), #cond, __FILE__, __LINE__)
+#define HOST_CLOSE(a, b, tol)		Host_Check(((a) - (b) <= (tol)) && ((b) - (a) <= (tol)), #a " ~ " #b, __FILE__, __LINE__)
+
+
+/******************************************************************************
+         			#### HOST HAL ENUMS ####
+******************************************************************************/
+
+typedef enum{
+
+	Host_Fault_None     = 0,
+	Host_Fault_Nack     = 1,		/* HAL_ERROR, AF */
+	Host_Fault_BusError = 2,		/* HAL_ERROR, BERR */
+	Host_Fault_ArbLost  = 3,		/* HAL_ERROR, ARLO */
+	Host_Fault_Timeout  = 4			/* HAL_TIMEOUT after the whole timeout */
+
+}Host_Fault_TypeDef;
+
+
+/******************************************************************************
+         			#### HOST HAL STRUCTURES ####
+******************************************************************************/
+
+typedef struct{
+
+	uint32_t transfers;				/*! I2C register transfers that reached the HAL */
+	uint32_t faults;				/*! Injected failures */
+	uint32_t inits;					/*! HAL_I2C_Init */
+	uint32_t sclClocks;				/*! Rising SCL edges of the bus clear */
+	uint32_t stops;					/*! SDA rising while SCL is high */
+	uint32_t itStarts;				/*! HAL_I2C_Mem_Read_IT / Mem_Write_IT */
+	uint32_t dmaStarts;
+	uint32_t dmaBytes;
+	uint32_t flashErases;			/*! Pages */
+	uint32_t flashWrites;			/*! Half words */
+	uint32_t sleepModes;			/*! HAL_PWR_EnterSLEEPMode */
+	uint32_t stopModes;				/*! HAL_PWR_EnterSTOPMode */
+	uint32_t pending[64];			/*! HAL_NVIC_SetPendingIRQ per IRQn */
+
+}Host_Stats_TypeDef;
+
+extern Host_Stats_TypeDef Host_Stats;
+
+extern I2C_HandleTypeDef hi2c1;
+
+
+/******************************************************************************
+         	#### HOST HAL PROTOTYPES OF FUNCTIONS ####
+******************************************************************************/
+
+/**
+  * @brief  Clock back to 0, no faults, flash erased, hi2c1 on I2C1 at 100 kHz, stats cleared. The sensor mock
+  * 		is not touched.
+  */
+void Host_Reset(void);
+
+
+/**
+  * @brief  Virtual time. HAL_GetTick is Host_Micros() / 1000, every I2C transfer takes its wire time,
+  * 		HAL_Delay and a timed out transfer take their whole time. Nothing else moves it. The RTC counts its
+  * 		ms once BMP390_LowPower has enabled it.
+  */
+uint64_t Host_Micros(void);
+void Host_Advance(uint32_t us);
+
+
+/**
+  * @brief  Real time of the host for the benchmarks : the time stamp counter on x86, nanoseconds elsewhere.
+  */
+uint64_t Host_Cycles(void);
+
+
+/**
+  * @brief  The next count I2C transfers fail with fault, the sensor doesn't see them.
+  */
+void Host_I2c_Inject(Host_Fault_TypeDef fault, uint32_t count);
+
+
+/**
+  * @brief  A slave holds SDA low for clocks SCL pulses : BUSY is set, transfers time out and HAL_I2C_Init
+  * 		sets BUSY again until the bus clear has clocked it free.
+  */
+void Host_I2c_HoldSda(uint32_t clocks);
+
+
+/**
+  * @brief  BUSY latches without a transfer (STM32F1 analog filter errata), SDA is high. It stays set until
+  * 		the SWRST of HAL_I2C_Init or a clock of the bus clear.
+  */
+void Host_I2c_StickBusy(void);
+
+
+/**
+  * @brief  The DMA transfer started by HAL_DMA_Start_IT ends, the next HAL_DMA_IRQHandler of its handle calls
+  * 		XferCpltCallback, or XferErrorCallback with HAL_DMA_ERROR_TE after a transfer error.
+  * @retval false if no transfer was running.
+  */
+_Bool Host_Dma_Finish(_Bool error);
+
+
+/**
+  * @brief  Source address of the DMA transfer that is running, for a stand-in of the peripheral. It is the
+  * 		SrcAddress of HAL_DMA_Start_IT, on a 64 bit host only the low half of the pointer.
+  * @retval Its length, 0 if no transfer is running.
+  */
+uint16_t Host_Dma_Data(uint32_t *src);
+
+
+/**
+  * @brief  Length of the last I2C DMA read (HAL_I2C_Mem_Read_DMA), 0 after it is taken. The data is already
+  * 		in the buffer, the test calls the completion like the DMA interrupt would.
+  */
+uint16_t Host_I2c_TakeDma(void);
+
+
+/**
+  * @brief  Counts a failed check (HOST_CHECK), Host_Result prints the total and is the exit code.
+  */
+void Host_Check(_Bool ok, const char *what, const char *file, int line);
+int Host_Result(const char *name);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_HAL_H_ */
@@ -0,0 +1,229 @@
+/*!
+ *  @file : bmp390_bench_async.cpp
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+/**
+ * NOTE ==> The coroutine front end (bmp390_async.hpp) on one thread.
+ * 			HalI2cAsyncBus over the host HAL : a transfer that doesn't fit into the queue fails at once, the queued
+ * 			ones complete in order through irqComplete() and poll().
+ * 			16 AsyncBmp390 sensors on one MockReactor : every round starts a read on each of them, all 16 transfers
+ * 			are in flight together and one pass of the reactor completes them. The cost per read is compared with
+ * 			16 blocking Bmp390 reads of the same register files, the results have to be the same.
+ */
+
+#include "host_hal.h"
+#include "bmp390_async.hpp"
+#include "bmp390_mock.h"
+#include <deque>
+#include <optional>
+
+
+#define Bench_Address				0x76		/*! SDO low, as main.c */
+#define Bench_Sensors				16
+#define Bench_Rounds				20000u
+#define Bench_Repeats				5			/*! The fastest run counts, the others had interruptions */
+
+using Reactor   = bmp390::MockReactor<64>;
+using AsyncBus  = bmp390::MockAsyncBus<Reactor>;
+using Async     = bmp390::AsyncBmp390<AsyncBus, bmp390::FloatMath>;
+using Blocking  = bmp390::Bmp390<bmp390::MockBus, bmp390::FloatMath>;
+using HalBus    = bmp390::HalI2cAsyncBus<2>;
+
+/**
+ * @brief  One simulated sensor : its register file behind the reactor and the driver on top of it.
+ */
+struct Bench_Node {
+
+	AsyncBus bus;
+	Async sensor;
+
+	explicit Bench_Node(Reactor &reactor) : bus{reactor}, sensor{bus} {}
+};
+
+
+/**
+ * @brief  A single 6 byte read through an asynchronous bus.
+ */
+template<class Bus>
+static bmp390::Task<bool> Bench_Read(Bus &bus, uint8_t *data){
+
+	co_return co_await bmp390::TransferAwaitable<Bus>{ bus, bmp390::Transfer{ BMP390_StartAdd_MSB_LSB_XLSB_PT, data, 6, false, false, {} } };
+}
+
+
+static void Bench_HalQueue(void){
+
+	uint8_t data[3][6] = {};
+	HalBus bus{&hi2c1, Bench_Address};
+
+	auto first  = Bench_Read(bus, data[0]);
+	auto second = Bench_Read(bus, data[1]);
+	auto third  = Bench_Read(bus, data[2]);
+
+	//Two fit, the first one is on the bus
+	first.start();
+	second.start();
+	HOST_CHECK(!first.done() && !second.done());
+	HOST_CHECK(Host_Stats.itStarts == 1);
+
+	//The queue is full : the third one fails without touching the bus
+	third.start();
+	HOST_CHECK(third.done() && !third.result());
+	HOST_CHECK(Host_Stats.itStarts == 1);
+
+	//Completions in order, the next transfer starts from poll()
+	bus.poll();
+	HOST_CHECK(!first.done());
+	bus.irqComplete(true);
+	bus.poll();
+	HOST_CHECK(first.done() && first.result());
+	HOST_CHECK(!second.done());
+	HOST_CHECK(Host_Stats.itStarts == 2);
+
+	bus.irqComplete(true);
+	bus.poll();
+	HOST_CHECK(second.done() && second.result());
+	HOST_CHECK(data[1][5] == BMP390_Mock.reg[BMP390_StartAdd_MSB_LSB_XLSB_PT + 5]);
+
+	//A free slot again
+	auto fourth = Bench_Read(bus, data[2]);
+	fourth.start();
+	bus.irqComplete(false);
+	bus.poll();
+	HOST_CHECK(fourth.done() && !fourth.result());
+}
+
+
+int main(void){
+
+	Reactor reactor;
+	std::deque<Bench_Node> nodes;
+	std::deque<Blocking> blocking;
+	std::optional<bmp390::Task<Async::Result>> jobs[Bench_Sensors];
+	Blocking::Measurement m[Bench_Sensors];
+	uint64_t start, asyncBest = UINT64_MAX, blockingBest = UINT64_MAX;
+	uint32_t passes = 0, mismatch = 0;
+
+	//The NVM and one conversion of the sensor model
+	Host_Reset();
+	BMP390_Mock_Init(Bench_Address);
+	BMP390_Mock.reg[BMP390_REG_PWR_CTRL] = 0x13;
+	BMP390_Mock.forced = true;
+	BMP390_Mock.forcedEnd = 0;
+	BMP390_Mock_Sync();
+
+	Bench_HalQueue();
+
+	for(int i = 0 ; i < Bench_Sensors ; i++){
+
+		auto &node = nodes.emplace_back(reactor);
+
+		std::memcpy(node.bus.regs.regs, BMP390_Mock.reg, sizeof(node.bus.regs.regs));
+		node.bus.regs.regs[BMP390_StartAdd_MSB_LSB_XLSB_PT] = static_cast<uint8_t>(i * 16);	//A different pressure each
+		blocking.emplace_back(node.bus.regs);
+
+		auto init = node.sensor.init();
+		init.start();
+
+		while(!reactor.idle()){
+
+			reactor.run();
+
+		}
+
+		HOST_CHECK(init.done() && init.result());
+		HOST_CHECK(blocking.back().init());
+
+	}
+
+	for(int rep = 0 ; rep < Bench_Repeats ; rep++){
+
+		start = Host_Cycles();
+
+		for(uint32_t round = 0 ; round < Bench_Rounds ; round++){
+
+			for(int i = 0 ; i < Bench_Sensors ; i++){
+
+				jobs[i].emplace(nodes[i].sensor.read());
+				jobs[i]->start();
+
+			}
+
+			//Every read is waiting on its transfer now
+			while(!reactor.idle()){
+
+				reactor.run();
+				passes++;
+
+			}
+
+		}
+
+		asyncBest = std::min(asyncBest, Host_Cycles() - start);
+		start = Host_Cycles();
+
+		for(uint32_t round = 0 ; round < Bench_Rounds ; round++){
+
+			for(int i = 0 ; i < Bench_Sensors ; i++){
+
+				blocking[i].read(m[i]);
+
+			}
+
+		}
+
+		blockingBest = std::min(blockingBest, Host_Cycles() - start);
+
+	}
+
+	for(int i = 0 ; i < Bench_Sensors ; i++){
+
+		if(!jobs[i]->done() || !jobs[i]->result().ok || (jobs[i]->result().m.pressure != m[i].pressure) ||
+		   (jobs[i]->result().m.temperature != m[i].temperature)){
+
+			mismatch++;
+
+		}
+
+	}
+
+	printf("%d sensors, %.2f reactor passes per round\n", Bench_Sensors, (double)passes / (Bench_Rounds * Bench_Repeats));
+	printf("co_await read    %8.1f cycles per read\n", (double)asyncBest / (Bench_Rounds * Bench_Sensors));
+	printf("blocking read    %8.1f cycles per read\n", (double)blockingBest / (Bench_Rounds * Bench_Sensors));
+
+	HOST_CHECK(mismatch == 0);
+	HOST_CHECK(passes == (Bench_Rounds * Bench_Repeats));
+	HOST_CHECK(nodes[1].bus.regs.reads > Bench_Rounds);
+
+	return Host_Result("bench_async");
+}
@@ -0,0 +1,165 @@
+/*!
+ *  @file : bmp390_bench_cpp.cpp
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+/**
+ * NOTE ==> Per sample cost of the C++ front end (bmp390.hpp) at -Os against a hand specialized C read : the same
+ * 			6 byte burst from the same register file, then BMP390_Comp_Temp and BMP390_Comp_Press of bmp390.c.
+ * 			FloatMath has to give the values of the C driver, FixedMath the same within its 0.01 resolution.
+ * 			The code size of the three read functions is printed by nm :
+ * 			nm -C -S --size-sort bmp390_bench_cpp | grep Bench_
+ */
+
+#include "host_hal.h"
+#include "bmp390.hpp"
+#include "bmp390_mock.h"
+
+
+#define Bench_Address				0x76		/*! SDO low, as main.c */
+#define Bench_Samples				200000u
+#define Bench_Repeats				5			/*! The fastest run counts, the others had interruptions */
+
+using FloatSensor = bmp390::Bmp390<bmp390::MockBus, bmp390::FloatMath>;
+using FixedSensor = bmp390::Bmp390<bmp390::MockBus, bmp390::FixedMath>;
+
+static BMP390_HandleTypeDef Bench_Handle;		/*! Calibration of the C driver */
+
+
+/**
+ * @brief  What a hand written build of the C driver does per sample.
+ */
+__attribute__((noinline)) static bool Bench_ReadC(bmp390::MockBus &bus, FloatSensor::Measurement &m){
+
+	uint8_t d[6];
+
+	if(!bus.read(BMP390_StartAdd_MSB_LSB_XLSB_PT, d, sizeof(d))){
+
+		return false;
+
+	}
+
+	uint32_t rawPress = d[0] | (d[1] << 8) | (d[2] << 16);
+	uint32_t rawTemp  = d[3] | (d[4] << 8) | (d[5] << 16);
+
+	m.temperature = BMP390_Comp_Temp(&Bench_Handle.Prcsd_NVM, rawTemp);
+	m.pressure    = BMP390_Comp_Press(&Bench_Handle.Prcsd_NVM, rawPress, m.temperature);
+
+	return true;
+}
+
+
+__attribute__((noinline)) static bool Bench_ReadFloat(FloatSensor &sensor, FloatSensor::Measurement &m){
+
+	return sensor.read(m);
+}
+
+
+__attribute__((noinline)) static bool Bench_ReadFixed(FixedSensor &sensor, FixedSensor::Measurement &m){
+
+	return sensor.read(m);
+}
+
+
+/**
+ * @brief  Fastest of Bench_Repeats runs, cycles per call. The raw pressure moves a little with every sample.
+ */
+template<class Read>
+static double Bench_Run(uint8_t *regs, Read read){
+
+	uint64_t best = UINT64_MAX, start;
+
+	for(int rep = 0 ; rep < Bench_Repeats ; rep++){
+
+		start = Host_Cycles();
+
+		for(uint32_t k = 0 ; k < Bench_Samples ; k++){
+
+			regs[BMP390_StartAdd_MSB_LSB_XLSB_PT] = static_cast<uint8_t>(k);
+			read();
+
+		}
+
+		best = std::min(best, Host_Cycles() - start);
+
+	}
+
+	return static_cast<double>(best) / Bench_Samples;
+}
+
+
+int main(void){
+
+	FloatSensor::Measurement c{}, f{};
+	FixedSensor::Measurement x{};
+	bmp390::MockBus bus;
+	BMP390_RawCalibData_TypeDef raw;
+
+	//The NVM and one conversion of the sensor model, at 1013.25 hPa and 25 °C
+	Host_Reset();
+	BMP390_Mock_Init(Bench_Address);
+	BMP390_Mock.reg[BMP390_REG_PWR_CTRL] = 0x13;
+	BMP390_Mock.forced = true;
+	BMP390_Mock.forcedEnd = 0;
+	BMP390_Mock_Sync();
+	std::memcpy(bus.regs, BMP390_Mock.reg, sizeof(bus.regs));
+
+	FloatSensor floatSensor{bus};
+	FixedSensor fixedSensor{bus};
+	HOST_CHECK(floatSensor.init());
+	HOST_CHECK(fixedSensor.init());
+
+	raw = bmp390::ParseCalib(&bus.regs[BMP390_StartAdd_CalibCoeff]);
+	BMP390_Calc_PrcsdCalibrationCoeff(&Bench_Handle, &raw);
+
+	HOST_CHECK(Bench_ReadC(floatSensor.bus(), c));
+	HOST_CHECK(Bench_ReadFloat(floatSensor, f));
+	HOST_CHECK(Bench_ReadFixed(fixedSensor, x));
+
+	printf("C %.2f Pa %.3f C, FloatMath %.2f Pa %.3f C, FixedMath %d/100 Pa %d/100 C\n",
+		   c.pressure, c.temperature, f.pressure, f.temperature, x.pressure, x.temperature);
+
+	HOST_CLOSE(c.pressure, 101325.0f, 1.0f);
+	HOST_CLOSE(f.pressure, c.pressure, 0.01f);
+	HOST_CLOSE(f.temperature, c.temperature, 0.0001f);
+	HOST_CLOSE(x.pressure / 100.0f, c.pressure, 0.02f);
+	HOST_CLOSE(x.temperature / 100.0f, c.temperature, 0.011f);
+
+	printf("hand written C   %8.1f cycles per sample\n",
+		   Bench_Run(floatSensor.bus().regs, [&]{ Bench_ReadC(floatSensor.bus(), c); }));
+	printf("FloatMath        %8.1f cycles per sample\n",
+		   Bench_Run(floatSensor.bus().regs, [&]{ Bench_ReadFloat(floatSensor, f); }));
+	printf("FixedMath        %8.1f cycles per sample\n",
+		   Bench_Run(fixedSensor.bus().regs, [&]{ Bench_ReadFixed(fixedSensor, x); }));
+
+	return Host_Result("bench_cpp");
+}
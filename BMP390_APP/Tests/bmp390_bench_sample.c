@@ -0,0 +1,174 @@
+/*!
+ *  @file : bmp390_bench_sample.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+/**
+ * NOTE ==> Per sample cost of the pointer API (BMP390_Calc_* on the main.c globals, the chain of the old
+ * 			BMP390_Get_SensorValues) against BMP390_Process_RawData filling one restrict qualified sample,
+ * 			and the cost of an upload. Both results have to be the same to the bit.
+ * 			It is built against the runtime configuration (bmp390_bench_sample) and BMP390_STATIC_CONFIG
+ * 			(bmp390_bench_sample_static), the code sizes of both are listed by the bmp390_size target.
+ * 			These are host numbers, the Cortex-M3 with its software floating point has to be measured on the board.
+ */
+
+#include "host_hal.h"
+#include "bmp390.h"
+#include "bmp390_mock.h"
+
+
+#define Bench_Address				0x76		/*! SDO low, as main.c */
+#define Bench_Samples				200000u
+#define Bench_Uploads				2000u
+#define Bench_Repeats				5			/*! The fastest run counts, the others had interruptions */
+
+#define Bench_Min(a, b)				(((a) < (b)) ? (a) : (b))
+
+static BMP390_HandleTypeDef Bench_Sensor;
+
+static void Bench_PointerApi(uint32_t rawPress, uint32_t rawTemp);
+static void Bench_SampleApi(uint32_t rawPress, uint32_t rawTemp, BMP390_Sample_TypeDef *Sample);
+static uint32_t Bench_RawPress(uint32_t k);
+
+
+int main(void){
+
+	BMP390_Sample_TypeDef sample = {0};
+	uint64_t start, pointerApi = UINT64_MAX, sampleApi = UINT64_MAX, upload = UINT64_MAX;
+	uint32_t mismatch = 0;
+
+	Host_Reset();
+	BMP390_Mock_Init(Bench_Address);
+
+	Bench_Sensor.i2c = &hi2c1;
+	Bench_Sensor.BMP390_I2C_ADDRESS = Bench_Address;
+	Bench_Sensor.Ref_Alt_Sel = 'M';
+	HOST_CHECK(BMP390_Init(&Bench_Sensor));
+
+	//Same results, the previous altitude and speed start from the same values
+	for(uint32_t k = 0 ; k < 1000 ; k++){
+
+		BMP390_ResetRef_DeltaVal(&Bench_Sensor);
+		Bench_PointerApi(Bench_RawPress(k), 8388608u);
+		Bench_PointerApi(Bench_RawPress(k + 1), 8388608u);
+
+		BMP390_ResetRef_DeltaVal(&Bench_Sensor);
+		sample.timestamp = 0;
+		Bench_SampleApi(Bench_RawPress(k), 8388608u, &sample);
+		Bench_SampleApi(Bench_RawPress(k + 1), 8388608u, &sample);
+
+		if((sample.press != BMP390_Press) || (sample.temp != BMP390_Temp) || (sample.vertAlt != BMP390_VertAlt) ||
+		   (sample.vertSpd != BMP390_VertSpd) || (sample.vertAcc != BMP390_VertAcc) || (sample.gForce != BMP390_gForce)){
+
+			mismatch++;
+
+		}
+
+	}
+
+	HOST_CHECK(mismatch == 0);
+
+	for(int rep = 0 ; rep < Bench_Repeats ; rep++){
+
+		start = Host_Cycles();
+
+		for(uint32_t k = 0 ; k < Bench_Samples ; k++){
+
+			Bench_PointerApi(Bench_RawPress(k), 8388608u);
+
+		}
+
+		pointerApi = Bench_Min(pointerApi, Host_Cycles() - start);
+		start = Host_Cycles();
+
+		for(uint32_t k = 0 ; k < Bench_Samples ; k++){
+
+			Bench_SampleApi(Bench_RawPress(k), 8388608u, &sample);
+
+		}
+
+		sampleApi = Bench_Min(sampleApi, Host_Cycles() - start);
+		start = Host_Cycles();
+
+		for(uint32_t k = 0 ; k < Bench_Uploads ; k++){
+
+			HOST_CHECK(BMP390_Upload_ConfigParams(&Bench_Sensor));
+
+		}
+
+		upload = Bench_Min(upload, Host_Cycles() - start);
+
+	}
+
+#ifdef BMP390_STATIC_CONFIG
+	printf("static configuration\n");
+#else
+	printf("runtime configuration\n");
+#endif
+	printf("pointer API      %8.1f cycles per sample\n", (double)pointerApi / Bench_Samples);
+	printf("sample API       %8.1f cycles per sample\n", (double)sampleApi / Bench_Samples);
+	printf("upload           %8.1f cycles (sensor model included)\n", (double)upload / Bench_Uploads);
+
+	return Host_Result("bench_sample");
+}
+
+
+/**
+ * @brief  The chain of the old BMP390_Get_SensorValues after the burst read.
+ */
+__attribute__((noinline)) static void Bench_PointerApi(uint32_t rawPress, uint32_t rawTemp){
+
+	BMP390_Temp    = BMP390_Calc_PrcsdTemp(&Bench_Sensor, rawTemp);
+	BMP390_Press   = BMP390_Calc_PrcsdPress(&Bench_Sensor, rawPress, &BMP390_Temp);
+	BMP390_VertAlt = BMP390_Calc_VertAlt(&Bench_Sensor, &BMP390_Press);
+
+	BMP390_Calc_VertSpd(&Bench_Sensor, &BMP390_VertAlt, &BMP390_VertSpd);
+	BMP390_Calc_VertAcc(&Bench_Sensor, &BMP390_VertSpd, &BMP390_VertAcc);
+	BMP390_Calc_gForce(&Bench_Sensor, &BMP390_gForce, &TotalMass, &BMP390_VertAcc);
+}
+
+
+__attribute__((noinline)) static void Bench_SampleApi(uint32_t rawPress, uint32_t rawTemp, BMP390_Sample_TypeDef *Sample){
+
+	//One second per sample like the TIM1 default, the pointer API's differences are per second too
+	Sample->timestamp += 1000u;
+	BMP390_Process_RawData(&Bench_Sensor, rawPress, rawTemp, TotalMass, Sample);
+}
+
+
+/**
+ * @brief  Raw pressure that moves a little with every sample, around sea level with the mock NVM.
+ */
+static uint32_t Bench_RawPress(uint32_t k){
+
+	return 6500000u + (k & 0x3FF);
+}
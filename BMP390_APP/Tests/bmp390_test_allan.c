@@ -0,0 +1,223 @@
+/*!
+ *  @file : bmp390_test_allan.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+/**
+ * NOTE ==> BMP390_Allan_Deviation against the overlapping Allan deviation straight from its definition, in double
+ * 			over the stored samples, for every octave :
+ *
+ * 				AVAR(m) = sum over i of (mean(y[i+m .. i+2m-1]) - mean(y[i .. i+m-1]))^2 / (2 (N - 2m + 1))
+ *
+ * 			The samples are frames of bmp390_sim.c at X1 through the compensation, once for a steady pressure
+ * 			(white noise) and once for a pressure that walks at random (random walk). The comparison is made
+ * 			before the first octaves have their terms, around the ring wrap (BMP390_Allan_RingLen) and long after
+ * 			it, the running sum of the pressure wraps its 32 bits every ~40 samples.
+ * 			The sums are rounded to 1 / BMP390_Allan_Scale, each mean is off by half of it at most, so each
+ * 			difference by one and the deviation by 1 / (sqrt(2) * BMP390_Allan_Scale) at most (Minkowski).
+ * 			Over all the samples the rounding errors average out, truncated sums would stay off (the altitude
+ * 			crosses 0 all the time).
+ */
+
+#include "host_hal.h"
+#include "bmp390_mock.h"
+#include "bmp390_sim.h"
+#include "bmp390_allan.h"
+#include "math.h"
+
+
+#define Test_Samples				5000
+#define Test_Walk					0.3f		/*! Pa RMS per sample of the random walk */
+#define Test_Float					1e-5		/*! Relative, sqrtf and the float division */
+#define Test_Unbiased				0.05		/*! Of the bound after all samples : rounding errors average out, a bias doesn't */
+
+static float Test_Press[Test_Samples];
+static float Test_Alt[Test_Samples];
+
+static const uint32_t Test_Checks[] = {1, 2, 3, 4, 63, 64, 65, 127, 128, 129, 130, 255, 256, 257, 1000, Test_Samples};
+
+static void Test_Series(float walk, uint32_t seed);
+static void Test_Compare(const char *name, float walk, uint32_t seed);
+static double Test_Direct(const float *y, uint32_t n, uint32_t m);
+
+
+int main(void){
+
+	BMP390_Mock_Init(0x76);
+
+	Test_Compare("white", 0.0f, 1);
+	Test_Compare("random walk", Test_Walk, 2);
+
+	return Host_Result("allan");
+}
+
+
+/**
+ * @brief  Test_Samples processed samples of the simulated sensor, the pressure walks by walk Pa RMS per sample.
+ */
+static void Test_Series(float walk, uint32_t seed){
+
+	BMP390_Sim_TypeDef sim;
+	BMP390_Params_t params = {0};
+	BMP390_RawFrame_TypeDef frame;
+	uint32_t rng = seed;
+	float press = (float)SeaLevelPress, fixedAltitude = BMP390_Comp_VertAlt(press, 0.0f), temp;
+
+	params.press_osrs = BMP390_Oversampling_X1;
+	params.temp_osrs = BMP390_Oversampling_X1;
+	params.odr = BMP390_ODR_25;
+	params.filtercoef = BMP390_Filter_Coef_0;
+
+	BMP390_Sim_Init(&sim, &BMP390_Mock.Calib, &params, seed);
+
+	for(uint32_t i = 0; i < Test_Samples; i++){
+
+		press += walk * BMP390_Sim_Noise(&rng);
+
+		BMP390_Sim_Step(&sim, press, 25.0f, &frame);
+
+		temp = BMP390_Comp_Temp(&BMP390_Mock.Calib, frame.rawTemp);
+		Test_Press[i] = BMP390_Comp_Press(&BMP390_Mock.Calib, frame.rawPress, temp);
+		Test_Alt[i] = BMP390_Comp_VertAlt(Test_Press[i], fixedAltitude);
+	}
+}
+
+
+/**
+ * @brief  Feeds one series and compares every octave of both channels at each of Test_Checks.
+ */
+static void Test_Compare(const char *name, float walk, uint32_t seed){
+
+	BMP390_Allan_TypeDef allan;
+	uint32_t n = 0, worstOctave = 0;
+	double worst = 0.0, direct, error, bound;
+	float adev;
+
+	Test_Series(walk, seed);
+	BMP390_Allan_Init(&allan, 40);
+
+	for(uint8_t c = 0; c < (sizeof(Test_Checks) / sizeof(Test_Checks[0])); c++){
+
+		while(n < Test_Checks[c]){
+
+			BMP390_Allan_Add(&allan, Test_Press[n], Test_Alt[n]);
+			n++;
+		}
+
+		HOST_CHECK(allan.n == n);
+
+		for(uint8_t k = 0; k < BMP390_Allan_Octaves; k++){
+
+			for(uint8_t channel = BMP390_Allan_Press; channel <= BMP390_Allan_Alt; channel++){
+
+				adev = BMP390_Allan_Deviation(&allan, channel, k);
+
+				//0 until 2^(k + 1) samples
+				if(n < (2u << k)){
+
+					HOST_CHECK(adev == 0.0f);
+					continue;
+				}
+
+				direct = Test_Direct((channel == BMP390_Allan_Press) ? Test_Press : Test_Alt, n, 1u << k);
+				bound = (1.0 / (sqrt(2.0) * BMP390_Allan_Scale)) + (direct * Test_Float);
+				error = fabs((double)adev - direct) / bound;
+
+				HOST_CHECK(direct > 0.0);
+				HOST_CHECK(error <= 1.0);
+				HOST_CHECK((n < Test_Samples) || (error <= Test_Unbiased));
+
+				if(error > worst){
+
+					worst = error;
+					worstOctave = k;
+				}
+			}
+		}
+	}
+
+	HOST_CHECK(BMP390_Allan_Deviation(&allan, BMP390_Allan_Press, BMP390_Allan_Octaves) == 0.0f);
+
+	printf("%s :", name);
+
+	for(uint8_t k = 0; k < BMP390_Allan_Octaves; k++){
+
+		printf(" %.4f", BMP390_Allan_Deviation(&allan, BMP390_Allan_Press, k));
+	}
+
+	printf(" Pa, worst error %.0f %% of the bound at octave %u\n", worst * 100.0, worstOctave);
+
+	//White noise falls by sqrt(2) per octave, the random walk grows by sqrt(2) once it dominates
+	for(uint8_t k = 0; k < 4; k++){
+
+		float ratio = BMP390_Allan_Deviation(&allan, BMP390_Allan_Press, k + 1) /
+					  BMP390_Allan_Deviation(&allan, BMP390_Allan_Press, k);
+
+		if(walk == 0.0f){
+
+			HOST_CLOSE(ratio, 0.7071f, 0.1f);
+		}
+	}
+
+	if(walk != 0.0f){
+
+		float ratio = BMP390_Allan_Deviation(&allan, BMP390_Allan_Press, BMP390_Allan_Octaves - 1) /
+					  BMP390_Allan_Deviation(&allan, BMP390_Allan_Press, BMP390_Allan_Octaves - 2);
+
+		HOST_CLOSE(ratio, 1.4142f, 0.3f);
+	}
+}
+
+
+/**
+ * @brief  Overlapping Allan deviation of the first n samples of y at tau = m samples, from the definition.
+ */
+static double Test_Direct(const float *y, uint32_t n, uint32_t m){
+
+	double sum = 0.0, a, b;
+
+	for(uint32_t i = 0; (i + (2 * m)) <= n; i++){
+
+		a = 0.0;
+		b = 0.0;
+
+		for(uint32_t j = 0; j < m; j++){
+
+			a += y[i + j];
+			b += y[i + m + j];
+		}
+
+		sum += ((b - a) / m) * ((b - a) / m);
+	}
+
+	return sqrt(sum / (2.0 * (double)(n - (2 * m) + 1)));
+}
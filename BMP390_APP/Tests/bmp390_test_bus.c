@@ -0,0 +1,163 @@
+/*!
+ *  @file : bmp390_test_bus.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * NOTE ==> Bus faults injected into the sampling loop : a NACK, a bus error, a lost arbitration, a stuck transfer,
+ * 			a slave holding SDA low for a few clocks or for more than the 9 clocks of one bus clear, and the BUSY
+ * 			flag of the STM32F1 errata. The read that meets the fault fails, it may not take longer than
+ * 			Test_MaxStall, and a fresh sample has to be read again within Test_MaxLost periods.
+ */
+
+#include "host_hal.h"
+#include "bmp390_mock.h"
+#include "bmp390_bus.h"
+
+
+#define Test_Address				0x76		/*! SDO low, as main.c */
+#define Test_MaxStall				10000		/*! us, one read with its recovery */
+#define Test_MaxLost				3			/*! periods without a fresh sample after the fault */
+
+typedef enum{
+
+	Test_Nack = 0,
+	Test_BusError,
+	Test_ArbLost,
+	Test_Timeout,
+	Test_SdaLow,
+	Test_SdaLowLong,
+	Test_Busy,
+	Test_Scenarios
+
+}Test_Scenario_TypeDef;
+
+static const char *const Test_Names[Test_Scenarios] = {
+
+	"NACK", "BERR", "ARLO", "timeout", "SDA low 5 clocks", "SDA low 20 clocks", "BUSY latched"
+};
+
+static BMP390_HandleTypeDef Test_Sensor;
+
+static void Test_Inject(Test_Scenario_TypeDef scenario);
+
+
+int main(void){
+
+	BMP390_RawFrame_TypeDef frame;
+	uint32_t period, stall, worst, maxStall = 0;
+
+	Host_Reset();
+	BMP390_Mock_Init(Test_Address);
+
+	Test_Sensor.i2c = &hi2c1;
+	Test_Sensor.BMP390_I2C_ADDRESS = Test_Address;
+	Test_Sensor.Ref_Alt_Sel = 'm';
+
+	HOST_CHECK(BMP390_Init(&Test_Sensor));
+
+	period = BMP390_Calc_OdrPeriod(Test_Sensor.Params.odr);
+
+	printf("fault                  stall(us)  lost  recoveries\n");
+
+	for(Test_Scenario_TypeDef s = 0; s < Test_Scenarios; s++){
+
+		uint32_t recoveries = BMP390_Bus_Stats.recoveries;
+		uint64_t start;
+		uint8_t lost = 0;
+
+		//A fresh conversion is waiting, only the fault can make the read fail
+		Host_Advance(period);
+		HOST_CHECK(BMP390_Read_RawFrame(&Test_Sensor, &frame, NULL));
+		Host_Advance(period);
+
+		Test_Inject(s);
+
+		start = Host_Micros();
+		HOST_CHECK(!BMP390_Read_RawFrame(&Test_Sensor, &frame, NULL));
+		worst = (uint32_t)(Host_Micros() - start);
+
+		while(lost < Test_MaxLost){
+
+			Host_Advance(period);
+
+			start = Host_Micros();
+
+			if(BMP390_Read_RawFrame(&Test_Sensor, &frame, NULL)){
+
+				break;
+			}
+
+			stall = (uint32_t)(Host_Micros() - start);
+			worst = (stall > worst) ? stall : worst;
+			lost++;
+		}
+
+		maxStall = (worst > maxStall) ? worst : maxStall;
+
+		printf("%-21s  %9u  %4u  %10u\n", Test_Names[s], worst, lost, BMP390_Bus_Stats.recoveries - recoveries);
+
+		HOST_CHECK(lost < Test_MaxLost);
+		HOST_CHECK(Test_Sensor.ERR == 0);
+
+		//Only a NACK leaves the bus alone
+		HOST_CHECK((s == Test_Nack) == (BMP390_Bus_Stats.recoveries == recoveries));
+	}
+
+	printf("longest read %u us, longest recovery %u ms, %u failed recoveries\n", maxStall,
+		   BMP390_Bus_Stats.maxRecoveryTime, BMP390_Bus_Stats.failedRecoveries);
+
+	HOST_CHECK(maxStall <= Test_MaxStall);
+	HOST_CHECK(BMP390_Bus_Stats.errors[BMP390_Bus_Nack] >= 1);
+	HOST_CHECK(BMP390_Bus_Stats.errors[BMP390_Bus_BusError] >= 1);
+	HOST_CHECK(BMP390_Bus_Stats.errors[BMP390_Bus_ArbLost] >= 1);
+	HOST_CHECK(BMP390_Bus_Stats.errors[BMP390_Bus_Timeout] >= 1);
+	HOST_CHECK(BMP390_Bus_Stats.errors[BMP390_Bus_Busy] >= 1);
+	HOST_CHECK(Host_Stats.sclClocks >= 25);
+
+	return Host_Result("bus");
+}
+
+
+static void Test_Inject(Test_Scenario_TypeDef scenario){
+
+	switch(scenario){
+
+		case Test_Nack:			Host_I2c_Inject(Host_Fault_Nack, 1); break;
+		case Test_BusError:		Host_I2c_Inject(Host_Fault_BusError, 1); break;
+		case Test_ArbLost:		Host_I2c_Inject(Host_Fault_ArbLost, 1); break;
+		case Test_Timeout:		Host_I2c_Inject(Host_Fault_Timeout, 1); break;
+		case Test_SdaLow:		Host_I2c_HoldSda(5); break;
+		case Test_SdaLowLong:	Host_I2c_HoldSda(20); break;
+		case Test_Busy:			Host_I2c_StickBusy(); break;
+		default:				break;
+	}
+}
@@ -0,0 +1,284 @@
+/*!
+ *  @file : bmp390_test_codec.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+/**
+ * NOTE ==> Round trip of the raw frame codec. The stream is a simulated flight at 25 Hz that starts just before the
+ * 			24 bit sensortime wraps, an ODR change, a sensor reset (sensortime back to 0), a jump forward, full range
+ * 			random frames (the longest varints) and at last the frames that the flash log gives back. Every frame
+ * 			has to come back bit-exact from one decoder over the whole stream and from decoders started at
+ * 			keyframes, a stream cut inside a frame has to be refused. The ratio and the cycles are printed.
+ */
+
+#include "host_hal.h"
+#include "bmp390_mock.h"
+#include "bmp390_codec.h"
+#include "bmp390_logger.h"
+#include "bmp390_sim.h"
+
+
+#define Test_Flight					250000u		/*! Frames of the flight, 2.8 hours at 25 Hz */
+#define Test_Random					20000u
+#define Test_MaxLogged				(BMP390_Log_Pages * 2 * BMP390_Log_PairsPerPage)
+#define Test_Frames					(Test_Flight + Test_Random + Test_MaxLogged)
+#define Test_MinRatio				2.5f		/*! Of the simulated flight */
+
+typedef struct{
+
+	BMP390_RawFrame_TypeDef *Frames;
+	uint32_t n;
+
+}Test_Parsed_TypeDef;
+
+static BMP390_RawFrame_TypeDef Test_In[Test_Frames];
+static uint8_t Test_Stream[Test_Frames * BMP390_Codec_MaxSize];
+static uint32_t Test_KeyOffset[(Test_Frames / BMP390_Codec_KeyInterval) + 1];
+static BMP390_Logger_TypeDef Test_Log;
+
+static uint32_t Test_Simulate(BMP390_RawFrame_TypeDef *Frames);
+static uint32_t Test_Logged(const BMP390_RawFrame_TypeDef *Frames, uint32_t n, BMP390_RawFrame_TypeDef *Out);
+static void Test_Record(void *ctx, uint32_t index, const BMP390_RawFrame_TypeDef *Frame);
+static _Bool Test_Same(const BMP390_RawFrame_TypeDef *a, const BMP390_RawFrame_TypeDef *b);
+static uint32_t Test_Rand(uint32_t *state);
+
+
+int main(void){
+
+	BMP390_Codec_TypeDef enc, dec;
+	BMP390_Codec_Stats_TypeDef flight, all;
+	BMP390_RawFrame_TypeDef frame;
+	uint32_t n, size = 0, pos = 0, keys = 0, mismatches = 0, resyncs = 0;
+	uint32_t rng = 7;
+	int16_t used;
+
+	Host_Reset();
+	BMP390_Mock_Init(0x76);
+
+	n = Test_Simulate(Test_In);
+
+	for(uint32_t i = 0; i < Test_Random; i++, n++){
+
+		Test_In[n].rawPress = Test_Rand(&rng) & BMP390_Sensortime_Mask;
+		Test_In[n].rawTemp = Test_Rand(&rng) & BMP390_Sensortime_Mask;
+		Test_In[n].sensortime = Test_Rand(&rng) & BMP390_Sensortime_Mask;
+	}
+
+	n += Test_Logged(Test_In, Test_Flight, &Test_In[n]);
+
+	//One encoder over the whole stream
+	BMP390_Codec_Init(&enc);
+
+	for(uint32_t i = 0; i < n; i++){
+
+		if((i % BMP390_Codec_KeyInterval) == 0){
+
+			Test_KeyOffset[keys++] = size;
+		}
+
+		size += BMP390_Codec_Encode(&enc, &Test_In[i], &Test_Stream[size]);
+	}
+
+	HOST_CHECK(enc.bytes == size);
+
+	//One decoder over the whole stream
+	BMP390_Codec_Init(&dec);
+
+	for(uint32_t i = 0; i < n; i++){
+
+		used = BMP390_Codec_Decode(&dec, &Test_Stream[pos], (uint16_t)((size - pos) > 0xFFFF ? 0xFFFF : (size - pos)), &frame);
+
+		if(used <= 0){
+
+			mismatches++;
+			break;
+		}
+
+		pos += (uint32_t)used;
+		mismatches += !Test_Same(&frame, &Test_In[i]);
+	}
+
+	HOST_CHECK(mismatches == 0);
+	HOST_CHECK(pos == size);
+
+	//A decoder started at any keyframe follows from there
+	for(uint32_t k = 0; k < keys; k += 7){
+
+		BMP390_Codec_Init(&dec);
+		pos = Test_KeyOffset[k];
+
+		for(uint32_t i = k * BMP390_Codec_KeyInterval; (i < n) && (i < ((k + 2) * BMP390_Codec_KeyInterval)); i++){
+
+			used = BMP390_Codec_Decode(&dec, &Test_Stream[pos], BMP390_Codec_MaxSize, &frame);
+			pos += (used > 0) ? (uint32_t)used : 0u;
+			resyncs += (used <= 0) || !Test_Same(&frame, &Test_In[i]);
+		}
+	}
+
+	HOST_CHECK(resyncs == 0);
+
+	//The stream ends inside a keyframe, then inside the varints of a delta frame
+	BMP390_Codec_Init(&dec);
+	HOST_CHECK(BMP390_Codec_Decode(&dec, Test_Stream, BMP390_Codec_KeySize - 1, &frame) == -1);
+	BMP390_Codec_Init(&dec);
+	used = BMP390_Codec_Decode(&dec, Test_Stream, BMP390_Codec_KeySize, &frame);
+	HOST_CHECK(used == BMP390_Codec_KeySize);
+	HOST_CHECK(BMP390_Codec_Decode(&dec, &Test_Stream[used], 1, &frame) == -1);
+
+	BMP390_Codec_Benchmark(Test_In, Test_Flight, &flight);
+	BMP390_Codec_Benchmark(Test_In, n, &all);
+
+	printf("%u frames, %u bytes encoded, %u keyframes\n", n, size, keys);
+	printf("flight       : ratio %.2f, %u cycles per frame\n", flight.ratio, flight.cyclesPerFrame);
+	printf("whole stream : ratio %.2f, %u cycles per frame (random frames included)\n", all.ratio, all.cyclesPerFrame);
+
+	HOST_CHECK(flight.encodedBytes < all.encodedBytes);
+	HOST_CHECK(flight.ratio >= Test_MinRatio);
+	HOST_CHECK(flight.cyclesPerFrame != 0);
+
+	return Host_Result("codec");
+}
+
+
+/**
+ * @brief  Pad, boost, coast and descent at 25 Hz with the noise of X8 and coef 3, the sensortime starting 100 s
+ * 		   before its wrap. An ODR change to 200 Hz, a reset of the sensor and a jump forward on the way.
+ */
+static uint32_t Test_Simulate(BMP390_RawFrame_TypeDef *Frames){
+
+	BMP390_Sim_TypeDef sim;
+	BMP390_Params_t params = {0};
+	float alt = 0.0f, spd = 0.0f, t;
+
+	params.press_osrs = BMP390_Oversampling_X8;
+	params.temp_osrs = BMP390_Oversampling_X2;
+	params.odr = BMP390_ODR_25;
+	params.filtercoef = BMP390_Filter_Coef_3;
+
+	BMP390_Sim_Init(&sim, &BMP390_Mock.Calib, &params, 1);
+	sim.sensortime = BMP390_Sensortime_Mask + 1u - (100u * BMP390_Sim_SensortimeHz);
+
+	for(uint32_t i = 0; i < Test_Flight; i++){
+
+		t = (float)i * 0.04f;
+
+		if((t > 60.0f) && (t < 63.0f)){
+
+			spd += 60.0f * 0.04f;
+		}
+		else if(alt > 0.0f){
+
+			spd = (spd > -6.0f) ? (spd - (9.81f * 0.04f)) : -6.0f;
+		}
+
+		alt = (alt + (spd * 0.04f) > 0.0f) ? (alt + (spd * 0.04f)) : 0.0f;
+
+		if(i == (Test_Flight / 4)){
+
+			sim.sensortimeStep = 128;						//200 Hz
+		}
+		else if(i == (Test_Flight / 2)){
+
+			sim.sensortime = 0;								//Reset of the sensor
+		}
+		else if(i == ((3 * Test_Flight) / 4)){
+
+			sim.sensortime += 3000000u;						//Frames lost
+		}
+
+		BMP390_Sim_Step(&sim, 101325.0f * powf(1.0f - (alt * 2.2558e-5f), 5.2559f), 25.0f - (alt * 0.0065f), &Frames[i]);
+	}
+
+	return Test_Flight;
+}
+
+
+/**
+ * @brief  The frames through the flash log, Out gets the ones that it still holds (the newest ones).
+ */
+static uint32_t Test_Logged(const BMP390_RawFrame_TypeDef *Frames, uint32_t n, BMP390_RawFrame_TypeDef *Out){
+
+	Test_Parsed_TypeDef parsed = {Out, 0};
+
+	HOST_CHECK(BMP390_Logger_Init(&Test_Log));
+
+	for(uint32_t i = n - Test_MaxLogged; i < n; i++){
+
+		HOST_CHECK(BMP390_Logger_Push(&Test_Log, &Frames[i]));
+		HOST_CHECK(BMP390_Logger_Task(&Test_Log));
+	}
+
+	HOST_CHECK(BMP390_Logger_Flush(&Test_Log));
+
+	BMP390_Logger_Parse((const uint8_t *)BMP390_Log_Start, BMP390_Log_Pages * BMP390_Log_PageSize, Test_Record, &parsed);
+
+	HOST_CHECK(parsed.n > 0);
+	HOST_CHECK(Test_Same(&Out[parsed.n - 1], &Frames[n - 1]));
+
+	return parsed.n;
+}
+
+
+/**
+ * @brief  Logger callback, the records come oldest first.
+ */
+static void Test_Record(void *ctx, uint32_t index, const BMP390_RawFrame_TypeDef *Frame){
+
+	Test_Parsed_TypeDef *parsed = ctx;
+
+	if(parsed->n < Test_MaxLogged){
+
+		parsed->Frames[parsed->n++] = *Frame;
+	}
+}
+
+
+/**
+ * @brief  Bit-exact comparison of two frames.
+ */
+static _Bool Test_Same(const BMP390_RawFrame_TypeDef *a, const BMP390_RawFrame_TypeDef *b){
+
+	return (a->rawPress == b->rawPress) && (a->rawTemp == b->rawTemp) && (a->sensortime == b->sensortime);
+}
+
+
+/**
+ * @brief  xorshift32, the same stream on every run.
+ */
+static uint32_t Test_Rand(uint32_t *state){
+
+	*state ^= *state << 13;
+	*state ^= *state >> 17;
+	*state ^= *state << 5;
+
+	return *state;
+}
@@ -0,0 +1,179 @@
+/*!
+ *  @file : bmp390_test_config.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+/**
+ * NOTE ==> Every oversampling and output data rate in normal mode, with pressure and temperature on or off.
+ * 			The measurement time is computed here from the datasheet (3.9.2) independently of the driver :
+ * 			a set that fits is uploaded unchanged, one that doesn't is rejected without AutoAdjust and gets the
+ * 			fastest odr that fits with it. Every accepted set runs on the sensor model without conf_err, every
+ * 			rejected one written to it anyway gives conf_err.
+ */
+
+#include "host_hal.h"
+#include "bmp390.h"
+#include "bmp390_mock.h"
+
+
+#define Test_Address				0x76		/*! SDO low, as main.c */
+
+static BMP390_HandleTypeDef Test_Sensor;
+
+static uint32_t Test_MeasTime(uint8_t pressEn, uint8_t tempEn, uint8_t osrP, uint8_t osrT);
+static uint32_t Test_Period(uint8_t odr);
+static _Bool Test_RunsOnMock(uint8_t odr);
+
+
+int main(void){
+
+	BMP390_Config_Status_TypeDef status;
+	uint32_t meas, sets = 0, adjusted = 0, rejected = 0;
+	uint8_t fastest;
+
+	Host_Reset();
+	BMP390_Mock_Init(Test_Address);
+
+	Test_Sensor.i2c = &hi2c1;
+	Test_Sensor.BMP390_I2C_ADDRESS = Test_Address;
+	BMP390_Set_DefaultParams(&Test_Sensor);
+
+	for(uint8_t en = 1 ; en < 4 ; en++){
+	for(uint8_t osrP = BMP390_Oversampling_X1 ; osrP <= BMP390_Oversampling_X32 ; osrP++){
+	for(uint8_t osrT = BMP390_Oversampling_X1 ; osrT <= BMP390_Oversampling_X32 ; osrT++){
+
+		meas = Test_MeasTime(en & 1, en >> 1, osrP, osrT);
+
+		for(fastest = BMP390_ODR_200 ; meas > Test_Period(fastest) ; fastest++);
+
+		for(uint8_t odr = BMP390_ODR_200 ; odr <= BMP390_ODR_0p0015 ; odr++){
+
+			Test_Sensor.Params.mode = BMP390_Mode_Normal;
+			Test_Sensor.Params.stat_meas_press = (en & 1) ? Enable : Disable;
+			Test_Sensor.Params.stat_meas_temp = (en & 2) ? Enable : Disable;
+			Test_Sensor.Params.press_osrs = osrP;
+			Test_Sensor.Params.temp_osrs = osrT;
+			Test_Sensor.Params.odr = odr;
+			sets++;
+
+			HOST_CHECK(BMP390_Calc_MeasTime(&Test_Sensor.Params) == meas);
+
+			//Without AutoAdjust nothing changes
+			status = BMP390_Check_ConfigParams(&Test_Sensor, false);
+			HOST_CHECK(Test_Sensor.Params.odr == odr);
+
+			if(meas <= Test_Period(odr)){
+
+				HOST_CHECK(status == BMP390_Config_OK);
+				HOST_CHECK(BMP390_Check_ConfigParams(&Test_Sensor, true) == BMP390_Config_OK);
+				HOST_CHECK(Test_Sensor.Params.odr == odr);
+				HOST_CHECK(BMP390_Upload_ConfigParams(&Test_Sensor));
+				HOST_CHECK(Test_RunsOnMock(odr));
+				continue;
+
+			}
+
+			HOST_CHECK(status == BMP390_Config_Invalid);
+			rejected++;
+
+			//The sensor rejects it too
+			HOST_CHECK(!Test_RunsOnMock(odr));
+
+			//The longest measurement (130 ms) fits at 6.25 Hz, AutoAdjust always finds the fastest odr that fits
+			HOST_CHECK(BMP390_Check_ConfigParams(&Test_Sensor, true) == BMP390_Config_Adjusted);
+			HOST_CHECK(Test_Sensor.Params.odr == fastest);
+			adjusted++;
+
+			Test_Sensor.Params.odr = odr;
+			HOST_CHECK(BMP390_Upload_ConfigParams(&Test_Sensor));
+			HOST_CHECK(Test_Sensor.Params.odr == fastest);
+			HOST_CHECK(Test_RunsOnMock(fastest));
+
+		}
+
+	}
+	}
+	}
+
+	printf("%u parameter sets, %u rejected without AutoAdjust, %u adjusted\n", sets, rejected, adjusted);
+
+	HOST_CHECK(sets == (3 * 6 * 6 * 18));
+	HOST_CHECK(adjusted == rejected);
+	HOST_CHECK(adjusted > 0);
+
+	//Out of range values are rejected either way
+	Test_Sensor.Params.odr = BMP390_ODR_0p0015 + 1;
+	HOST_CHECK(BMP390_Check_ConfigParams(&Test_Sensor, true) == BMP390_Config_Invalid);
+	Test_Sensor.Params.odr = BMP390_ODR_50;
+	Test_Sensor.Params.press_osrs = BMP390_Oversampling_X32 + 1;
+	HOST_CHECK(BMP390_Check_ConfigParams(&Test_Sensor, true) == BMP390_Config_Invalid);
+
+	return Host_Result("config");
+}
+
+
+/**
+ * @brief  Datasheet 3.9.2 : 234 us + (392 us + 2^osr_p * 2020 us) + (163 us + 2^osr_t * 2020 us)
+ */
+static uint32_t Test_MeasTime(uint8_t pressEn, uint8_t tempEn, uint8_t osrP, uint8_t osrT){
+
+	return 234 + (pressEn ? (392 + (2020u << osrP)) : 0) + (tempEn ? (163 + (2020u << osrT)) : 0);
+}
+
+
+/**
+ * @brief  5 ms at 200 Hz, doubled by every odr_sel step.
+ */
+static uint32_t Test_Period(uint8_t odr){
+
+	return 5000u << odr;
+}
+
+
+/**
+ * @brief  Writes the registers the way the driver does without checking them and tells whether the sensor runs.
+ */
+static _Bool Test_RunsOnMock(uint8_t odr){
+
+	uint8_t sleep = 0, err;
+	uint8_t pwrCtrl = (BMP390_Mode_Normal << 4) | (Test_Sensor.Params.stat_meas_temp << 1) | Test_Sensor.Params.stat_meas_press;
+	uint8_t osr = Test_Sensor.Params.press_osrs | (Test_Sensor.Params.temp_osrs << 3);
+
+	BMP390_Mock_Read(BMP390_REG_ERR, &err, 1);
+	BMP390_Mock_Write(BMP390_REG_PWR_CTRL, &sleep, 1);
+	BMP390_Mock_Write(BMP390_REG_ODR, &odr, 1);
+	BMP390_Mock_Write(BMP390_REG_OSR, &osr, 1);
+	BMP390_Mock_Write(BMP390_REG_PWR_CTRL, &pwrCtrl, 1);
+	BMP390_Mock_Read(BMP390_REG_ERR, &err, 1);
+
+	return BMP390_Mock.running && ((err & BMP390_Error_Configuration) == 0);
+}
@@ -0,0 +1,214 @@
+/*!
+ *  @file : bmp390_test_cpp.cpp
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+/**
+ * NOTE ==> Register writes of the C++ front end (bmp390.hpp). Bmp390::init() has to upload the configuration like
+ * 			BMP390_Init : PWR_CTRL in sleep mode, CONFIG, ODR, OSR, then PWR_CTRL with the mode.
+ * 			The writes go through a MockBus that logs them into the register file of bmp390_mock, which raises
+ * 			conf_err when a register changes in normal mode and the measurement doesn't fit into the ODR period.
+ * 			The sensor is left at x32/x32 and 1.5 Hz, the new configuration is x1/x1 at 50 Hz : writing the ODR
+ * 			while still in normal mode with x32 gives conf_err.
+ * 			AsyncBmp390::init() has the same order, through a bus that completes every transfer inline.
+ * 			A transfer that doesn't fit into the queue of HalI2cAsyncBus or MockAsyncBus completes inline too :
+ * 			Test_Reads awaits a million of them in a row, a resume from the bus would nest one stack frame each.
+ */
+
+#include "host_hal.h"
+#include "bmp390_async.hpp"
+#include "bmp390_mock.h"
+
+
+#define Test_Address				0x76		/*! SDO low, as main.c */
+#define Test_LogSize				8
+#define Test_ConfErr				0x04		/*! conf_err of REG_ERR */
+#define Test_Flood					1000000u	/*! Transfers into a full queue */
+
+using Fast = bmp390::Config<BMP390_Mode_Normal, BMP390_ODR_50, BMP390_Oversampling_X1,
+							BMP390_Oversampling_X1, BMP390_Filter_Coef_0>;
+
+/**
+ * @brief  MockBus in front of the register mock, every write is logged in order.
+ */
+struct Test_LogBus : bmp390::MockBus {
+
+	uint8_t reg[Test_LogSize]   = {};
+	uint8_t value[Test_LogSize] = {};
+
+	bool read(uint8_t r, uint8_t *data, uint16_t len) {
+		BMP390_Mock_Read(r, data, len);
+		reads++;
+		return true;
+	}
+
+	bool write(uint8_t r, uint8_t v) {
+		if(writes < Test_LogSize){
+			reg[writes]   = r;
+			value[writes] = v;
+		}
+		BMP390_Mock_Write(r, &v, 1);
+		writes++;
+		return true;
+	}
+};
+
+
+/**
+ * @brief  Asynchronous bus that finishes every transfer inside start(), logged by a Test_LogBus.
+ */
+struct Test_InlineBus {
+
+	Test_LogBus log{};
+
+	bool start(bmp390::Transfer &t) {
+		t.ok = t.write ? log.write(t.reg, t.data[0]) : log.read(t.reg, t.data, t.len);
+		return false;
+	}
+};
+
+
+/**
+ * @brief  Awaits n reads in a row, returns how many of them failed.
+ */
+template<class Bus>
+static bmp390::Task<uint32_t> Test_Reads(Bus &bus, uint32_t n){
+
+	uint8_t data[6];
+	uint32_t failed = 0;
+
+	for(uint32_t i = 0; i < n; i++){
+
+		bmp390::Transfer t{ BMP390_StartAdd_MSB_LSB_XLSB_PT, data, sizeof(data), false, false, {} };
+		if(!co_await bmp390::TransferAwaitable<Bus>{ bus, t }) failed++;
+	}
+
+	co_return failed;
+}
+
+
+/**
+ * @brief  Puts the mock into normal mode with a slow, heavily oversampled configuration.
+ */
+static void Test_SlowSensor(void){
+
+	uint8_t sleep = 0x03, osr = (BMP390_Oversampling_X32 << 3) | BMP390_Oversampling_X32;
+	uint8_t odr = BMP390_ODR_1p5, normal = 0x33;
+
+	BMP390_Mock_Init(Test_Address);
+	BMP390_Mock_Write(BMP390_REG_PWR_CTRL, &sleep, 1);
+	BMP390_Mock_Write(BMP390_REG_ODR, &odr, 1);
+	BMP390_Mock_Write(BMP390_REG_OSR, &osr, 1);
+	BMP390_Mock_Write(BMP390_REG_PWR_CTRL, &normal, 1);
+}
+
+
+/**
+ * @brief  The five configuration writes of a Test_LogBus, in order.
+ */
+static void Test_Order(const Test_LogBus &bus){
+
+	const uint8_t order[][2] = {
+
+		{BMP390_REG_PWR_CTRL, Fast::SLEEP},
+		{BMP390_REG_CONFIG,   Fast::CONFIG},
+		{BMP390_REG_ODR,      Fast::ODR},
+		{BMP390_REG_OSR,      Fast::OSR},
+		{BMP390_REG_PWR_CTRL, Fast::PWR_CTRL}
+	};
+
+	HOST_CHECK(bus.writes == (sizeof(order) / sizeof(order[0])));
+	for(uint32_t i = 0; i < (sizeof(order) / sizeof(order[0])); i++){
+
+		HOST_CHECK(bus.reg[i] == order[i][0]);
+		HOST_CHECK(bus.value[i] == order[i][1]);
+	}
+
+	//No register changed in normal mode, the sensor runs the new configuration
+	HOST_CHECK((BMP390_Mock.reg[BMP390_REG_ERR] & Test_ConfErr) == 0);
+	HOST_CHECK(BMP390_Mock.reg[BMP390_REG_PWR_CTRL] == Fast::PWR_CTRL);
+	HOST_CHECK(BMP390_Mock.running);
+}
+
+
+int main(void){
+
+	Host_Reset();
+	HOST_CHECK(Fast::SLEEP == 0x03);
+
+	//Blocking front end
+	Test_SlowSensor();
+	HOST_CHECK((BMP390_Mock.reg[BMP390_REG_ERR] & Test_ConfErr) == 0);
+
+	bmp390::Bmp390<Test_LogBus, bmp390::FloatMath, Fast> sensor{Test_LogBus{}};
+	HOST_CHECK(sensor.init());
+	Test_Order(sensor.bus());
+
+	//Coroutine front end, every transfer completes inline
+	Test_SlowSensor();
+
+	Test_InlineBus inlineBus;
+	bmp390::AsyncBmp390<Test_InlineBus, bmp390::FloatMath, Fast> asyncSensor{inlineBus};
+	auto init = asyncSensor.init();
+	init.start();
+	HOST_CHECK(init.done() && init.result());
+	Test_Order(inlineBus.log);
+
+	//HAL bus with one slot : the first read holds it, the flood fails inline
+	bmp390::HalI2cAsyncBus<1> halBus{&hi2c1, Test_Address};
+	auto held = Test_Reads(halBus, 1);
+	auto halFlood = Test_Reads(halBus, Test_Flood);
+
+	held.start();
+	HOST_CHECK(!held.done());
+	halFlood.start();
+	HOST_CHECK(halFlood.done() && (halFlood.result() == Test_Flood));
+	HOST_CHECK(Host_Stats.itStarts == 1);
+
+	halBus.irqComplete(true);
+	halBus.poll();
+	HOST_CHECK(held.done() && (held.result() == 0));
+
+	//Mock bus on a full reactor
+	bmp390::MockReactor<1> reactor;
+	bmp390::MockAsyncBus<bmp390::MockReactor<1>> mockBus{reactor};
+	auto posted = Test_Reads(mockBus, 1);
+	auto mockFlood = Test_Reads(mockBus, Test_Flood);
+
+	posted.start();
+	mockFlood.start();
+	HOST_CHECK(mockFlood.done() && (mockFlood.result() == Test_Flood));
+	HOST_CHECK(reactor.run() == 1);
+	HOST_CHECK(posted.done() && (posted.result() == 0));
+
+	return Host_Result("cpp");
+}
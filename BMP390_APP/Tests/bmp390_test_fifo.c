@@ -0,0 +1,287 @@
+/*!
+ *  @file : bmp390_test_fifo.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+/**
+ * NOTE ==> Watermark driven FIFO acquisition against the mock for longer than half the sensortime range
+ * 			(2^23 counts, 5.5 minutes). Every drain has to end in the sensortime frame, so the drift estimator
+ * 			gets a pair per drain, and the MCU time of every frame has to go forward and stay behind the
+ * 			time of the drain by no more than the watermark. The sensor clock runs fast by Test_Ppm.
+ * 			Two more runs start shortly before the MCU time passes 2^32 us (71.6 minutes) and 2^32 ms
+ * 			(49.7 days) : the ms timestamp of main.c has to stay with HAL_GetTick through both.
+ * 			The interrupts and bus bits of every run have to match BMP390_Fifo_CalcLoad, which then prints the
+ * 			wake-up and bus utilization table of the watermarks. BMP390_Fifo_Benchmark compares the iterator with
+ * 			the copying parser on a full FIFO.
+ */
+
+#include "host_hal.h"
+#include "bmp390_mock.h"
+#include "bmp390_fifo.h"
+#include "bmp390_drift.h"
+#include "math.h"
+
+
+#define Test_Address				0x76		/*! SDO low, as main.c */
+#define Test_Watermark				112			/*! 16 frames, as main.c */
+#define Test_Minutes				8
+#define Test_Ppm					200.0f
+#define Test_Tick					250			/*! us between two passes of the main loop */
+#define Test_WrapMinutes			4			/*! The wrap runs start 2 minutes before the wrap */
+#define Test_LoadTol				0.02f		/*! Relative, measured against BMP390_Fifo_CalcLoad */
+
+static const BMP390_ODR_TypeDef Test_Odrs[] = {BMP390_ODR_200, BMP390_ODR_50, BMP390_ODR_25, BMP390_ODR_1p5};
+static const uint16_t Test_Watermarks[] = {7, 28, 112, 252, 504};	/*! bytes */
+
+static const uint64_t Test_Starts[] = {0, 0x100000000ull - 120000000u, (0x100000000ull - 120000u) * 1000u};	/*! us */
+
+static BMP390_HandleTypeDef Test_Sensor;
+static BMP390_Drift_TypeDef Test_Drift;
+static BMP390_Fifo_TypeDef Test_Fifo;
+
+static uint32_t Test_Frames;
+static uint64_t Test_Prev;			/*! MCU time of the previous frame (us) */
+static uint32_t Test_Backwards;
+static uint32_t Test_MaxSpacing;
+static uint32_t Test_MaxLate;
+static uint32_t Test_MaxTickLate;	/*! HAL_GetTick - timestamp of a frame (ms) */
+
+static void Test_Run(uint64_t start, uint32_t minutes);
+static void Test_LoadTable(void);
+static void Test_Bench(void);
+static void Test_Frame(void *ctx, const BMP390_RawFrame_TypeDef *Frame);
+
+
+int main(void){
+
+	Test_Run(Test_Starts[0], Test_Minutes);
+	Test_Run(Test_Starts[1], Test_WrapMinutes);
+	Test_Run(Test_Starts[2], Test_WrapMinutes);
+	Test_LoadTable();
+	Test_Bench();
+
+	return Host_Result("fifo");
+}
+
+
+/**
+ * @brief  Acquisition from the MCU time start (us) on, for the given minutes.
+ */
+static void Test_Run(uint64_t start, uint32_t minutes){
+
+	uint32_t period, drains = 0, timed = 0, short_ = 0;
+	uint16_t len;
+	float wakeups, busLoad, seconds = (float)minutes * 60.0f;
+
+	Host_Reset();
+	Host_Advance((uint32_t)(start % 1000000000u));
+	for(uint64_t k = start / 1000000000u; k > 0; k--){
+
+		Host_Advance(1000000000u);
+	}
+
+	BMP390_Mock_Init(Test_Address);
+	BMP390_Mock.ppm = Test_Ppm;
+
+	Test_Sensor = (BMP390_HandleTypeDef){0};
+	Test_Sensor.i2c = &hi2c1;
+	Test_Sensor.BMP390_I2C_ADDRESS = Test_Address;
+	Test_Sensor.Ref_Alt_Sel = 'm';
+
+	HOST_CHECK(BMP390_Init(&Test_Sensor));
+
+	BMP390_Drift_Init(&Test_Drift);
+	HOST_CHECK(BMP390_Fifo_Init(&Test_Fifo, &Test_Sensor, &Test_Drift, NULL, Test_Watermark));
+
+	period = BMP390_Calc_OdrPeriod(Test_Sensor.Params.odr);
+	Test_Frames = 0;
+	Test_Backwards = 0;
+	Test_MaxSpacing = 0;
+	Test_MaxLate = 0;
+	Test_MaxTickLate = 0;
+
+	while(Host_Micros() < (start + (minutes * 60000000ull))){
+
+		Host_Advance(Test_Tick);
+
+		if(BMP390_Mock_IntLevel()){
+
+			BMP390_Fifo_IRQHandler(&Test_Fifo);
+		}
+
+		len = Host_I2c_TakeDma();
+
+		if(len != 0){
+
+			//The fill level was read with the status, the four bytes behind it are the sensortime frame
+			drains++;
+			timed += (Test_Fifo.buf[Test_Fifo.dmaBuf][len - BMP390_Fifo_TimeLen] == BMP390_Fifo_Hdr_Time);
+			short_ += (len < (Test_Watermark + BMP390_Fifo_TimeLen));
+
+			BMP390_Fifo_RxCplt(&Test_Fifo);
+		}
+
+		BMP390_Fifo_Task(&Test_Fifo, Test_Frame, NULL);
+	}
+
+	printf("from %llu us : %u drains, %u frames, drift %u pairs %.1f ppm, spacing up to %u us, "
+		   "latest frame %u us before its drain, %u ms before HAL_GetTick\n", (unsigned long long)start,
+		   drains, Test_Frames, Test_Drift.n, BMP390_Drift_Ppm(&Test_Drift), Test_MaxSpacing, Test_MaxLate,
+		   Test_MaxTickLate);
+
+	HOST_CHECK(drains > ((minutes * 500u) / Test_Minutes));
+	HOST_CHECK(timed == drains);
+	HOST_CHECK(short_ == 0);
+	HOST_CHECK(Test_Fifo.Stats.errors == 0);
+	HOST_CHECK(Test_Fifo.Stats.overruns == 0);
+
+	//Every drain is a pair, none restarted the regression
+	HOST_CHECK(Test_Drift.n == drains);
+	HOST_CLOSE(BMP390_Drift_Ppm(&Test_Drift), -Test_Ppm, 20.0f);
+
+	HOST_CHECK(Test_Frames >= (drains * (Test_Watermark / BMP390_Fifo_PressTempLen)));
+	HOST_CHECK(Test_Backwards == 0);
+	HOST_CHECK(Test_MaxSpacing <= (period + 2000u));
+	HOST_CHECK(Test_MaxLate <= ((Test_Watermark / BMP390_Fifo_PressTempLen) * period + 2000u));
+	HOST_CHECK(Test_MaxTickLate <= (((Test_Watermark / BMP390_Fifo_PressTempLen) * period + 2000u) / 1000u));
+
+	//The INT edge and the DMA completion of every drain, the status read and the drain on the bus
+	BMP390_Fifo_CalcLoad(Test_Watermark, BMP390_Fifo_PressTempLen, period, hi2c1.Init.ClockSpeed, &wakeups, &busLoad);
+	HOST_CLOSE((float)(Test_Fifo.Stats.wakeups + Test_Fifo.Stats.drains) / seconds, wakeups, wakeups * Test_LoadTol);
+	HOST_CLOSE((float)Test_Fifo.Stats.busBits / ((float)hi2c1.Init.ClockSpeed * seconds), busLoad, busLoad * Test_LoadTol);
+}
+
+
+/**
+ * @brief  Wake-ups per second and bus utilization of every watermark, fewer of both as the watermark grows.
+ */
+static void Test_LoadTable(void){
+
+	float wakeups, busLoad, prevWakeups, prevLoad;
+	uint32_t period;
+
+	printf("\nperiod (ms)  watermark  wake-ups/s  bus load (%u Hz)\n", (unsigned)hi2c1.Init.ClockSpeed);
+
+	for(uint32_t o = 0; o < (sizeof(Test_Odrs) / sizeof(Test_Odrs[0])); o++){
+
+		period = BMP390_Calc_OdrPeriod(Test_Odrs[o]);
+		prevWakeups = 1e9f;
+		prevLoad = 1.0f;
+
+		for(uint32_t w = 0; w < (sizeof(Test_Watermarks) / sizeof(Test_Watermarks[0])); w++){
+
+			BMP390_Fifo_CalcLoad(Test_Watermarks[w], BMP390_Fifo_PressTempLen, period, hi2c1.Init.ClockSpeed,
+								 &wakeups, &busLoad);
+
+			printf("%11u  %9u  %10.3f  %8.2f %%\n", period / 1000u, Test_Watermarks[w], wakeups, busLoad * 100.0f);
+
+			HOST_CHECK(wakeups < prevWakeups);
+			HOST_CHECK(busLoad < prevLoad);
+			prevWakeups = wakeups;
+			prevLoad = busLoad;
+		}
+	}
+}
+
+
+/**
+ * @brief  Iterator against the copying parser on a full FIFO of pressure and temperature frames.
+ */
+static void Test_Bench(void){
+
+	static uint8_t data[BMP390_Fifo_BufSize + BMP390_Fifo_TimeLen];
+	static BMP390_RawFrame_TypeDef scratch[BMP390_Fifo_BufSize / BMP390_Fifo_PressTempLen];
+	BMP390_Fifo_Bench_TypeDef Bench;
+	uint16_t frames = BMP390_Fifo_BufSize / BMP390_Fifo_PressTempLen;
+	uint16_t len = 0;
+
+	for(uint16_t k = 0; k < frames; k++){
+
+		data[len++] = BMP390_Fifo_Hdr_PressTemp;
+		for(uint8_t b = 0; b < 6; b++){
+
+			data[len++] = (uint8_t)(k + b);
+		}
+	}
+
+	data[len++] = BMP390_Fifo_Hdr_Time;
+	data[len++] = 0x00;
+	data[len++] = 0x10;
+	data[len++] = 0x00;
+
+	BMP390_Fifo_Benchmark(data, len, BMP390_Sensortime_OdrStep, scratch, &Bench);
+
+	printf("\n%u frames : iterator %u cycles %u bytes, copying parser %u cycles %u bytes per drain\n",
+		   Bench.frames, Bench.iterCycles, Bench.iterRam, Bench.copyCycles, Bench.copyRam);
+
+	HOST_CHECK(Bench.frames == frames);
+	HOST_CHECK(Bench.iterRam < Bench.copyRam);
+	HOST_CHECK(Bench.copyRam == (frames * sizeof(BMP390_RawFrame_TypeDef)));
+}
+
+
+/**
+ * @brief  main.c takes the timestamp of a FIFO frame the same way.
+ */
+static void Test_Frame(void *ctx, const BMP390_RawFrame_TypeDef *Frame){
+
+	uint64_t t = BMP390_Drift_Map(&Test_Drift, Frame->sensortime);
+	uint32_t timestamp = (uint32_t)(t / 1000u);
+	uint32_t late = (uint32_t)(Host_Micros() - t);
+	uint32_t tickLate = HAL_GetTick() - timestamp;
+
+	if(Test_Frames != 0){
+
+		if(t <= Test_Prev){
+
+			Test_Backwards++;
+		}
+		else if((t - Test_Prev) > Test_MaxSpacing){
+
+			Test_MaxSpacing = (uint32_t)(t - Test_Prev);
+		}
+	}
+
+	if((int32_t)late > (int32_t)Test_MaxLate){
+
+		Test_MaxLate = late;
+	}
+
+	//Both wrap at 2^32 ms, the difference is right across the wrap
+	if((int32_t)tickLate > (int32_t)Test_MaxTickLate){
+
+		Test_MaxTickLate = tickLate;
+	}
+
+	Test_Prev = t;
+	Test_Frames++;
+}
@@ -0,0 +1,173 @@
+/*!
+ *  @file : bmp390_test_flight.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * NOTE ==> Latency of the flight events on a simulated flight sampled at 1 Hz (the TIM1 default) and at 25 to
+ * 			200 Hz : a boost of 3 s at 80 m/s², a ballistic coast and a descent at 6 m/s, with 5 cm of altitude
+ * 			noise (X8 oversampling). Every event has to come in order at every rate. The debounces are in ms and
+ * 			the tracker gains are rescaled to the period : a faster rate must not detect the apogee later, each
+ * 			rate has its own bound, and the tracked speed on the pad must not get noisier.
+ */
+
+#include "host_hal.h"
+#include "bmp390_flight.h"
+#include "bmp390_sim.h"
+#include "math.h"
+
+
+#define Test_BoostAcc				80.0f		/*! m/s² */
+#define Test_BoostTime				3.0f		/*! s */
+#define Test_DescentSpd				6.0f		/*! m/s */
+#define Test_Noise					0.05f		/*! m RMS */
+#define Test_PadTime				5.0f		/*! s before the launch */
+#define Test_LandedAlt				0.0f
+
+#define Test_PadNoise				1.2f		/*! Speed RMS on the pad against the one at 25 Hz */
+
+static const uint16_t Test_Rates[] = { 1, 25, 50, 100, 200 };
+static const float Test_MaxLatency[] = { 2000.0f, 500.0f, 400.0f, 330.0f, 300.0f };	/*! Apogee, ms */
+
+static float Test_Altitude(float t, float *apogeeTime, float *landingTime);
+
+
+int main(void){
+
+	float apogeeTime, landingTime, latency[sizeof(Test_Rates) / sizeof(Test_Rates[0])];
+	float padNoise[sizeof(Test_Rates) / sizeof(Test_Rates[0])];
+
+	Test_Altitude(0.0f, &apogeeTime, &landingTime);
+
+	printf("rate(Hz)  boost(ms)  coast(ms)  apogee(ms)  landed(ms)   (after the real event)  pad speed RMS (m/s)\n");
+
+	for(uint8_t r = 0; r < sizeof(Test_Rates) / sizeof(Test_Rates[0]); r++){
+
+		BMP390_Flight_TypeDef flight;
+		BMP390_Sample_TypeDef sample = {0};
+		uint32_t rng = 0x12345678u;
+		uint32_t samples = (uint32_t)((Test_PadTime + landingTime + 10.0f) * Test_Rates[r]);
+		uint8_t order = BMP390_Flight_Pad;
+		_Bool inOrder = true;
+		int8_t state;
+		double padSum = 0.0;
+		uint32_t padSamples = 0;
+
+		BMP390_Flight_Init(&flight, NULL);
+
+		for(uint32_t i = 0; i <= samples; i++){
+
+			float t = (float)i / (float)Test_Rates[r];
+
+			sample.timestamp = (uint32_t)((i * 1000u) / Test_Rates[r]);
+			sample.vertAlt = Test_Altitude(t, NULL, NULL) + (Test_Noise * BMP390_Sim_Noise(&rng));
+
+			if((state = BMP390_Flight_Update(&flight, &sample)) >= 0){
+
+				inOrder &= (state == (order + 1));
+				order = (uint8_t)state;
+			}
+
+			//Settled on the pad, one second after the start up to the launch
+			if((t >= 1.0f) && (t < Test_PadTime)){
+
+				padSum += (double)flight.spd * (double)flight.spd;
+				padSamples++;
+			}
+		}
+
+		latency[r] = (float)flight.eventTime[BMP390_Flight_Apogee] - ((Test_PadTime + apogeeTime) * 1000.0f);
+		padNoise[r] = (float)sqrt(padSum / (double)padSamples);
+
+		printf("%8u  %9.0f  %9s  %10.0f  %10.0f  %43.3f\n", Test_Rates[r],
+			   (float)flight.eventTime[BMP390_Flight_Boost] - (Test_PadTime * 1000.0f),
+			   (flight.eventTime[BMP390_Flight_Coast] != 0) ? "yes" : "no", latency[r],
+			   (float)flight.eventTime[BMP390_Flight_Landed] - ((Test_PadTime + landingTime) * 1000.0f), padNoise[r]);
+
+		HOST_CHECK(inOrder);
+		HOST_CHECK(flight.state == BMP390_Flight_Landed);
+		HOST_CHECK(latency[r] > 0.0f);
+		HOST_CHECK(latency[r] <= Test_MaxLatency[r]);
+
+		if(r != 0){
+
+			HOST_CHECK(latency[r] <= latency[r - 1]);
+		}
+
+		if(Test_Rates[r] > 25){
+
+			HOST_CHECK(padNoise[r] <= (padNoise[1] * Test_PadNoise));
+		}
+	}
+
+	return Host_Result("flight");
+}
+
+
+/**
+ * @brief  Altitude above the pad (m) at t (s) of the simulation, the pad time comes first.
+ */
+static float Test_Altitude(float t, float *apogeeTime, float *landingTime){
+
+	float burnoutSpd = Test_BoostAcc * Test_BoostTime;
+	float burnoutAlt = 0.5f * Test_BoostAcc * Test_BoostTime * Test_BoostTime;
+	float coastTime = burnoutSpd / (float)GravityAccel;
+	float apogeeAlt = burnoutAlt + (0.5f * burnoutSpd * coastTime);
+
+	if(apogeeTime != NULL){
+
+		*apogeeTime = Test_BoostTime + coastTime;
+		*landingTime = *apogeeTime + ((apogeeAlt - Test_LandedAlt) / Test_DescentSpd);
+	}
+
+	t -= Test_PadTime;
+
+	if(t <= 0.0f){
+
+		return 0.0f;
+	}
+
+	if(t < Test_BoostTime){
+
+		return 0.5f * Test_BoostAcc * t * t;
+	}
+
+	t -= Test_BoostTime;
+
+	if(t < coastTime){
+
+		return burnoutAlt + (burnoutSpd * t) - (0.5f * (float)GravityAccel * t * t);
+	}
+
+	t -= coastTime;
+
+	return (apogeeAlt - (Test_DescentSpd * t) > Test_LandedAlt) ? (apogeeAlt - (Test_DescentSpd * t)) : Test_LandedAlt;
+}
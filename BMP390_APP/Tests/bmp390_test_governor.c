@@ -0,0 +1,299 @@
+/*!
+ *  @file : bmp390_test_governor.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+/**
+ * NOTE ==> 600 s of a simulated flight through the whole TIM1 chain with the governor, against the mock with the
+ * 			datasheet noise : 120 s on the pad while the weather drifts, a boost of 2 s at 50 m/s², a ballistic
+ * 			coast, the descent at 6 m/s and the rest of the time on the ground. TIM1 follows the ODR of every
+ * 			profile like stm32f1xx_it.c does.
+ * 			The governor may not switch on the pad or after the landing, the sensor may never see a register set
+ * 			that doesn't fit (conf_err) while it runs, in any direction between any two profiles, the launch and
+ * 			the apogee have to be detected within their bounds and the mean current of the sensor has to stay
+ * 			below Test_MaxCurrent of the fixed configuration of BMP390_Init.
+ */
+
+#include "host_hal.h"
+#include "bmp390_mock.h"
+#include "bmp390_flight.h"
+#include "bmp390_governor.h"
+#include "math.h"
+
+
+#define Test_Address				0x76		/*! SDO low, as main.c */
+#define Test_Seconds				600u
+#define Test_PadTime				120.0f		/*! s before the launch */
+#define Test_BoostAcc				50.0f		/*! m/s² */
+#define Test_BoostTime				2.0f		/*! s */
+#define Test_DescentSpd				6.0f		/*! m/s */
+#define Test_Weather				-0.05f		/*! Pa/s, a fast falling barometer */
+#define Test_Phase					300			/*! us, TIM1 runs behind the conversions */
+#define Test_ConfErr				0x04		/*! conf_err of REG_ERR */
+#define Test_MaxLaunch				1000.0f		/*! ms from the launch to the boost event, at 12.5 Hz on the pad */
+#define Test_MaxFast				500.0f		/*! ms from the launch to the fastest profile */
+#define Test_MaxApogee				400.0f		/*! ms from the apogee to its event */
+#define Test_MaxCurrent				0.35f		/*! Of the fixed configuration */
+#define Test_MaxSwitches			6			/*! 0 -> 1 -> 2 at the launch, 2 -> 1 descending, 1 -> 2 -> 1 -> 0 at the touchdown */
+
+static BMP390_HandleTypeDef Test_Sensor;
+static BMP390_Flight_TypeDef Test_Flight;
+static BMP390_Governor_TypeDef Test_Gov;
+static uint32_t Test_Glitches;
+
+static void Test_Truth(uint64_t us, float *press, float *temp);
+static float Test_Altitude(float t, float *apogeeTime, float *landingTime);
+static void Test_Apply(void);
+static void Test_Directions(void);
+
+
+int main(void){
+
+	BMP390_Gov_Profile_TypeDef fixed;
+	BMP390_RawFrame_TypeDef frame;
+	BMP390_Sample_TypeDef sample;
+	float apogeeTime, landingTime, current = 0.0f, launch, fast = -1.0f, apogee, fixedCurrent;
+	uint32_t period, next, samples = 0, padSwitches = 0, landedSwitches = 0, base;
+	uint32_t total = 0;
+	int8_t state;
+
+	Test_Altitude(0.0f, &apogeeTime, &landingTime);
+
+	Host_Reset();
+	BMP390_Mock_Init(Test_Address);
+	BMP390_Mock.noise = 1.0f;
+	BMP390_Mock.Truth = Test_Truth;
+
+	Test_Sensor.i2c = &hi2c1;
+	Test_Sensor.BMP390_I2C_ADDRESS = Test_Address;
+	Test_Sensor.Ref_Alt_Sel = 'm';
+
+	HOST_CHECK(BMP390_Init(&Test_Sensor));
+
+	fixed = (BMP390_Gov_Profile_TypeDef){Test_Sensor.Params.odr, Test_Sensor.Params.press_osrs,
+										 Test_Sensor.Params.temp_osrs, Test_Sensor.Params.filtercoef};
+	fixedCurrent = BMP390_Governor_Current(&fixed);
+
+	//As main.c : the pad profile, TIM1 at its ODR
+	BMP390_Flight_Init(&Test_Flight, NULL);
+	BMP390_Governor_Init(&Test_Gov, NULL);
+	Test_Apply();
+	base = Test_Gov.Stats.switches;
+
+	period = BMP390_Calc_OdrPeriod(Test_Sensor.Params.odr);
+	next = (uint32_t)Host_Micros() + Test_Phase;
+
+	while(next < (Test_Seconds * 1000000u)){
+
+		Host_Advance(next - (uint32_t)Host_Micros());
+		next += period;
+
+		if(!BMP390_Read_RawFrame(&Test_Sensor, &frame, NULL)){
+
+			continue;
+		}
+
+		sample.timestamp = HAL_GetTick();
+		BMP390_Process_RawData(&Test_Sensor, frame.rawPress, frame.rawTemp, TotalMass, &sample);
+		BMP390_Flight_Update(&Test_Flight, &sample);
+		samples++;
+
+		if(BMP390_Governor_Update(&Test_Gov, &Test_Flight, sample.timestamp) >= 0){
+
+			Test_Apply();
+
+			//ARR is preloaded, the new period starts after the one that is running
+			period = BMP390_Calc_OdrPeriod(Test_Sensor.Params.odr);
+
+			if(sample.timestamp < (uint32_t)(Test_PadTime * 1000.0f)){
+
+				padSwitches++;
+			}
+
+			if(sample.timestamp > (uint32_t)((Test_PadTime + landingTime + 10.0f) * 1000.0f)){
+
+				landedSwitches++;
+			}
+		}
+
+		if((fast < 0.0f) && (Test_Gov.level == (BMP390_Gov_Profiles - 1))){
+
+			fast = (float)sample.timestamp - (Test_PadTime * 1000.0f);
+		}
+	}
+
+	state = (int8_t)Test_Flight.state;
+	launch = (float)Test_Flight.eventTime[BMP390_Flight_Boost] - (Test_PadTime * 1000.0f);
+	apogee = (float)Test_Flight.eventTime[BMP390_Flight_Apogee] - ((Test_PadTime + apogeeTime) * 1000.0f);
+
+	printf("profile  odr  osr  current(uA)  time(s)\n");
+
+	for(uint8_t k = 0; k < BMP390_Gov_Profiles; k++){
+
+		const BMP390_Gov_Profile_TypeDef *Profile = &Test_Gov.Config.Profile[k];
+
+		current += BMP390_Governor_Current(Profile) * (float)Test_Gov.Stats.time[k];
+		total += Test_Gov.Stats.time[k];
+
+		printf("%7u  %3u  x%-2u  %11.1f  %7.1f\n", k, Profile->odr, 1u << Profile->pressOsrs,
+			   BMP390_Governor_Current(Profile), (float)Test_Gov.Stats.time[k] * 0.001f);
+	}
+
+	current /= (float)total;
+
+	printf("%u samples, %u switches, %u register writes : %.1f uA against %.1f uA fixed, launch +%.0f ms "
+		   "(fast profile +%.0f ms), apogee +%.0f ms\n", samples, Test_Gov.Stats.switches - base, Test_Gov.Stats.writes,
+		   current, fixedCurrent, launch, fast, apogee);
+
+	HOST_CHECK(state == BMP390_Flight_Landed);
+	HOST_CHECK(padSwitches == 0);
+	HOST_CHECK(landedSwitches == 0);
+	HOST_CHECK((Test_Gov.Stats.switches - base) <= Test_MaxSwitches);
+	HOST_CHECK(Test_Gov.level == 0);
+	HOST_CHECK(Test_Gov.Stats.failures == 0);
+	HOST_CHECK(Test_Glitches == 0);
+
+	HOST_CHECK((launch > 0.0f) && (launch <= Test_MaxLaunch));
+	HOST_CHECK((fast >= 0.0f) && (fast <= Test_MaxFast));
+	HOST_CHECK((apogee > 0.0f) && (apogee <= Test_MaxApogee));
+	HOST_CHECK(current <= (fixedCurrent * Test_MaxCurrent));
+
+	Test_Directions();
+
+	return Host_Result("governor");
+}
+
+
+/**
+ * @brief  Pressure of the simulated flight (Truth of the mock), the standard atmosphere over a drifting pad.
+ */
+static void Test_Truth(uint64_t us, float *press, float *temp){
+
+	float t = (float)((double)us * 1e-6);
+	float alt = Test_Altitude(t, NULL, NULL);
+	float pad = (float)SeaLevelPress + (Test_Weather * t);
+
+	*press = (float)(pad * pow(1.0 - (alt * GradientTemp / SeaLevelTemp), GravityAccel / (GasCoefficient * GradientTemp)));
+	*temp = 25.0f;
+}
+
+
+/**
+ * @brief  Altitude above the pad (m) at t (s) of the simulation, the pad time comes first.
+ */
+static float Test_Altitude(float t, float *apogeeTime, float *landingTime){
+
+	float burnoutSpd = Test_BoostAcc * Test_BoostTime;
+	float burnoutAlt = 0.5f * Test_BoostAcc * Test_BoostTime * Test_BoostTime;
+	float coastTime = burnoutSpd / (float)GravityAccel;
+	float apogeeAlt = burnoutAlt + (0.5f * burnoutSpd * coastTime);
+
+	if(apogeeTime != NULL){
+
+		*apogeeTime = Test_BoostTime + coastTime;
+		*landingTime = *apogeeTime + (apogeeAlt / Test_DescentSpd);
+	}
+
+	t -= Test_PadTime;
+
+	if(t <= 0.0f){
+
+		return 0.0f;
+	}
+
+	if(t < Test_BoostTime){
+
+		return 0.5f * Test_BoostAcc * t * t;
+	}
+
+	t -= Test_BoostTime;
+
+	if(t < coastTime){
+
+		return burnoutAlt + (burnoutSpd * t) - (0.5f * (float)GravityAccel * t * t);
+	}
+
+	t -= coastTime;
+
+	return ((apogeeAlt - (Test_DescentSpd * t)) > 0.0f) ? (apogeeAlt - (Test_DescentSpd * t)) : 0.0f;
+}
+
+
+/**
+ * @brief  BMP390_Governor_Apply while the sensor runs : no write may leave it with a set that doesn't fit.
+ * 		   Nothing reads ERR in between, so a conf_err of any of the writes is still there.
+ */
+static void Test_Apply(void){
+
+	HOST_CHECK(BMP390_Governor_Apply(&Test_Gov, &Test_Sensor));
+
+	if((BMP390_Mock.reg[BMP390_REG_ERR] & Test_ConfErr) || !BMP390_Mock.running){
+
+		Test_Glitches++;
+	}
+
+	HOST_CHECK(BMP390_Mock.reg[BMP390_REG_ODR] == Test_Gov.Config.Profile[Test_Gov.level].odr);
+}
+
+
+/**
+ * @brief  Every profile to every other one, then the write order that Apply avoids has to give conf_err.
+ */
+static void Test_Directions(void){
+
+	uint8_t odr, osr;
+
+	Test_Glitches = 0;
+
+	for(uint8_t from = 0; from < BMP390_Gov_Profiles; from++){
+
+		for(uint8_t to = 0; to < BMP390_Gov_Profiles; to++){
+
+			Test_Gov.level = from;
+			Test_Apply();
+			Test_Gov.level = to;
+			Test_Apply();
+		}
+	}
+
+	HOST_CHECK(Test_Glitches == 0);
+
+	//Cruise to fast with the faster ODR first : the x4 measurement doesn't fit into 10 ms
+	Test_Gov.level = 1;
+	Test_Apply();
+
+	odr = Test_Gov.Config.Profile[2].odr;
+	osr = (uint8_t)(Test_Gov.Config.Profile[2].pressOsrs | (Test_Gov.Config.Profile[2].tempOsrs << 3));
+	BMP390_Mock_Write(BMP390_REG_ODR, &odr, 1);
+	HOST_CHECK((BMP390_Mock.reg[BMP390_REG_ERR] & Test_ConfErr) != 0);
+	BMP390_Mock_Write(BMP390_REG_OSR, &osr, 1);
+}
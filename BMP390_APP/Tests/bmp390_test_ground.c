@@ -0,0 +1,249 @@
+/*!
+ *  @file : bmp390_test_ground.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+/**
+ * NOTE ==> Four hours on the pad through the TIM1 chain while a front lowers the ground pressure by ~430 Pa, the mock
+ * 			has the datasheet noise. FixedAltitude has to follow the ground at rest and stay where it is :
+ *
+ * 				- while the vehicle is lifted by 5 m for half a minute and set down again (motion),
+ * 				- for hold after that, although the vehicle is at rest again,
+ * 				- for an hour with the flight state out of the pad, while the ground still drifts.
+ */
+
+#include "host_hal.h"
+#include "bmp390_mock.h"
+#include "bmp390_flight.h"
+#include "bmp390_ground.h"
+#include "math.h"
+
+
+#define Test_Address				0x76		/*! SDO low, as main.c */
+#define Test_Weather				-0.03f		/*! Pa/s, ~2.5 mm/s of fake altitude */
+#define Test_Lift					7200.0f		/*! s, start of the motion */
+#define Test_LiftSpd				1.0f		/*! m/s */
+#define Test_LiftHeight				5.0f		/*! m */
+#define Test_LiftTime				20.0f		/*! s up there, less than hold */
+#define Test_OffPad					10800.0f	/*! s, the flight state leaves the pad for an hour */
+#define Test_End					14400.0f
+#define Test_MaxLag					0.5f		/*! m between FixedAltitude and the ground at rest */
+#define Test_MaxDetect				2500		/*! ms from the start of the motion to the freeze */
+#define Test_MaxSettle				60000		/*! ms after the motion until the trend is below maxRate again, hold follows */
+#define Test_MaxCreep				0.02f		/*! m that the reference moves before the freeze */
+
+static BMP390_HandleTypeDef Test_Sensor;
+static BMP390_Flight_TypeDef Test_Flight;
+static BMP390_Ground_TypeDef Test_Ground;
+
+static void Test_Truth(uint64_t us, float *press, float *temp);
+static float Test_Height(float t);
+static float Test_GroundAlt(float t);
+
+
+int main(void){
+
+	BMP390_RawFrame_TypeDef frame;
+	BMP390_Sample_TypeDef sample;
+	uint32_t period, detect = 0, resume = 0, quiet = 0, followed = 0, restMisses = 0, offPadMoves = 0;
+	uint64_t next;
+	float t, liftRef = 0.0f, offPadRef = 0.0f, maxLag = 0.0f, liftAlt = 0.0f, maxCreep = 0.0f;
+	float motionEnd = Test_Lift + ((2.0f * Test_LiftHeight) / Test_LiftSpd) + Test_LiftTime;
+	_Bool follows;
+
+	Host_Reset();
+	BMP390_Mock_Init(Test_Address);
+	BMP390_Mock.noise = 1.0f;
+	BMP390_Mock.Truth = Test_Truth;
+
+	Test_Sensor.i2c = &hi2c1;
+	Test_Sensor.BMP390_I2C_ADDRESS = Test_Address;
+	Test_Sensor.Ref_Alt_Sel = 'm';
+
+	HOST_CHECK(BMP390_Init(&Test_Sensor));
+	HOST_CLOSE(Test_Sensor.FixedAltitude, Test_GroundAlt(0.0f), Test_MaxLag);
+
+	BMP390_Flight_Init(&Test_Flight, NULL);
+	BMP390_Ground_Init(&Test_Ground, NULL);
+
+	period = BMP390_Calc_OdrPeriod(Test_Sensor.Params.odr);
+	next = Host_Micros() + period;
+
+	while(next < (uint64_t)(Test_End * 1e6f)){
+
+		Host_Advance((uint32_t)(next - Host_Micros()));
+		next += period;
+
+		if(!BMP390_Read_RawFrame(&Test_Sensor, &frame, NULL)){
+
+			continue;
+		}
+
+		t = (float)((double)Host_Micros() * 1e-6);
+
+		//The flight state is out of the pad for an hour, as after a landing
+		Test_Flight.state = ((t >= Test_OffPad) && (t < Test_End)) ? BMP390_Flight_Landed : BMP390_Flight_Pad;
+
+		sample.timestamp = HAL_GetTick();
+		BMP390_Process_RawData(&Test_Sensor, frame.rawPress, frame.rawTemp, TotalMass, &sample);
+		follows = BMP390_Ground_Update(&Test_Ground, &Test_Sensor, &Test_Flight, &sample);
+		followed += follows;
+
+		//At rest on the pad, after the first refTau
+		if(((t > 600.0f) && (t < Test_Lift)) || ((t > (motionEnd + 600.0f)) && (t < Test_OffPad))){
+
+			restMisses += !follows;
+
+			if(fabsf(Test_Sensor.FixedAltitude - Test_GroundAlt(t)) > maxLag){
+
+				maxLag = fabsf(Test_Sensor.FixedAltitude - Test_GroundAlt(t));
+			}
+		}
+
+		//Motion : frozen within Test_MaxDetect, then until hold after the vehicle is down again
+		if(t < Test_Lift){
+
+			liftRef = Test_Sensor.FixedAltitude;
+		}
+		else if(t < Test_OffPad){
+
+			if((detect == 0) && !follows){
+
+				detect = sample.timestamp - (uint32_t)(Test_Lift * 1000.0f);
+			}
+
+			if((resume == 0) && (detect != 0) && follows){
+
+				resume = sample.timestamp - (uint32_t)(motionEnd * 1000.0f);
+				quiet = sample.timestamp - Test_Ground.quietSince;
+			}
+
+			if(resume == 0){
+
+				if(fabsf(Test_Sensor.FixedAltitude - liftRef) > maxCreep){
+
+					maxCreep = fabsf(Test_Sensor.FixedAltitude - liftRef);
+				}
+
+				//Up there, half way
+				if(fabsf(t - (Test_Lift + (Test_LiftHeight / Test_LiftSpd) + (Test_LiftTime * 0.5f))) < 0.02f){
+
+					liftAlt = sample.vertAlt;
+				}
+			}
+
+			offPadRef = Test_Sensor.FixedAltitude;
+		}
+		else{
+
+			offPadMoves += follows || (Test_Sensor.FixedAltitude != offPadRef);
+		}
+	}
+
+	printf("drift %.1f m, %u of %u s followed, lag up to %.3f m, motion frozen after %u ms (creep %.4f m), "
+		   "followed again %u ms after it (%u ms quiet), %.2f m lifted\n", BMP390_Ground_Drift(&Test_Ground),
+		   followed / (1000u / (period / 1000u)), (uint32_t)Test_End, maxLag, detect, maxCreep, resume, quiet, liftAlt);
+	printf("off the pad for %.0f s : the ground moved by %.2f m, the altitude reads %.2f m\n", Test_End - Test_OffPad,
+		   Test_GroundAlt(Test_End) - Test_GroundAlt(Test_OffPad), sample.vertAlt);
+
+	//The front alone would be tens of metres
+	HOST_CHECK(fabsf(Test_GroundAlt(Test_OffPad) - Test_GroundAlt(0.0f)) > 20.0f);
+	HOST_CLOSE(BMP390_Ground_Drift(&Test_Ground), Test_GroundAlt(Test_OffPad) - Test_GroundAlt(0.0f), Test_MaxLag);
+	HOST_CHECK(restMisses == 0);
+	HOST_CHECK(maxLag <= Test_MaxLag);
+
+	HOST_CHECK((detect != 0) && (detect <= Test_MaxDetect));
+	HOST_CHECK(maxCreep <= Test_MaxCreep);
+	HOST_CHECK(resume >= Test_Ground.Config.hold);
+	HOST_CHECK(quiet >= Test_Ground.Config.hold);
+	HOST_CHECK(quiet < resume);
+	HOST_CHECK(resume <= (Test_Ground.Config.hold + Test_MaxSettle));
+	HOST_CLOSE(liftAlt, Test_LiftHeight, Test_MaxLag);
+	HOST_CHECK(Test_Ground.Stats.motions >= 1);
+
+	//Frozen off the pad, the drift of that hour shows up in the altitude
+	HOST_CHECK(offPadMoves == 0);
+	HOST_CLOSE(sample.vertAlt, Test_GroundAlt(Test_End) - offPadRef, Test_MaxLag);
+
+	return Host_Result("ground");
+}
+
+
+/**
+ * @brief  Pressure at the sensor (Truth of the mock) : the standard atmosphere over the drifting ground pressure.
+ */
+static void Test_Truth(uint64_t us, float *press, float *temp){
+
+	float t = (float)((double)us * 1e-6);
+	double pad = SeaLevelPress + (Test_Weather * t);
+
+	*press = (float)(pad * pow(1.0 - (Test_Height(t) * GradientTemp / SeaLevelTemp),
+							   GravityAccel / (GasCoefficient * GradientTemp)));
+	*temp = 25.0f;
+}
+
+
+/**
+ * @brief  Height of the sensor over the ground (m) : lifted by Test_LiftHeight at Test_Lift and set down again.
+ */
+static float Test_Height(float t){
+
+	float up = Test_LiftHeight / Test_LiftSpd;
+
+	t -= Test_Lift;
+
+	if((t <= 0.0f) || (t >= ((2.0f * up) + Test_LiftTime))){
+
+		return 0.0f;
+	}
+
+	if(t < up){
+
+		return t * Test_LiftSpd;
+	}
+
+	if(t < (up + Test_LiftTime)){
+
+		return Test_LiftHeight;
+	}
+
+	return Test_LiftHeight - ((t - up - Test_LiftTime) * Test_LiftSpd);
+}
+
+
+/**
+ * @brief  Altitude of the ground over the standard sea level (m) at t (s).
+ */
+static float Test_GroundAlt(float t){
+
+	return BMP390_Comp_VertAlt((float)SeaLevelPress + (Test_Weather * t), 0.0f);
+}
@@ -0,0 +1,212 @@
+/*!
+ *  @file : bmp390_test_health.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+/**
+ * NOTE ==> The faults of BMP390_Health_Check injected into the mock while frames are read at the ODR :
+ *
+ * 				- POR : a brown-out puts the sensor back to its reset values, with por_detected,
+ * 				- fatal_err : it stays set until a soft reset,
+ * 				- cmd_err : an unknown command is written, the data stays valid,
+ * 				- conf_err : an ODR too fast for the oversampling is written in normal mode, the sensor stops.
+ *
+ * 			Every fault has to be counted once in its class and, but for cmd_err, drop its frame and restore
+ * 			Params, with a soft reset for fatal_err only. After that the sensor has to run with Params and give
+ * 			valid frames of the true pressure again.
+ */
+
+#include "host_hal.h"
+#include "bmp390_mock.h"
+#include "bmp390_health.h"
+
+
+#define Test_Address				0x76		/*! SDO low, as main.c */
+#define Test_Fatal					0x01		/*! fatal_err of REG_ERR */
+#define Test_UnknownCmd				0x55
+#define Test_MaxRecovery			3			/*! ODR periods until the first valid frame after a restore */
+#define Test_MaxPressError			5.0f		/*! Pa, no noise */
+
+static BMP390_HandleTypeDef Test_Sensor;
+static BMP390_RawFrame_TypeDef Test_Frame;
+static uint32_t Test_Period;
+
+static void Test_Fault(BMP390_Health_Fault_TypeDef fault);
+static _Bool Test_Read(BMP390_StatusRegs_TypeDef *Regs);
+static void Test_Configured(void);
+
+
+int main(void){
+
+	BMP390_StatusRegs_TypeDef regs;
+
+	Host_Reset();
+	BMP390_Mock_Init(Test_Address);
+
+	Test_Sensor.i2c = &hi2c1;
+	Test_Sensor.BMP390_I2C_ADDRESS = Test_Address;
+	Test_Sensor.Ref_Alt_Sel = 'm';
+
+	HOST_CHECK(BMP390_Init(&Test_Sensor));
+
+	Test_Period = BMP390_Calc_OdrPeriod(Test_Sensor.Params.odr);
+	BMP390_Health_Stats = (BMP390_Health_Stats_TypeDef){0};
+
+	//Healthy frames only count
+	for(uint8_t i = 0; i < 10; i++){
+
+		HOST_CHECK(Test_Read(&regs));
+	}
+
+	HOST_CHECK(BMP390_Health_Stats.frames == 10);
+	HOST_CHECK(BMP390_Health_Stats.droppedFrames == 0);
+	HOST_CHECK(BMP390_Health_Stats.restores == 0);
+
+	Test_Fault(BMP390_Health_Por);
+	Test_Fault(BMP390_Health_Fatal);
+	Test_Fault(BMP390_Health_Cmd);
+	Test_Fault(BMP390_Health_Conf);
+
+	HOST_CHECK(BMP390_Health_Stats.faults[BMP390_Health_Por] == 1);
+	HOST_CHECK(BMP390_Health_Stats.faults[BMP390_Health_Fatal] == 1);
+	HOST_CHECK(BMP390_Health_Stats.faults[BMP390_Health_Cmd] == 1);
+	HOST_CHECK(BMP390_Health_Stats.faults[BMP390_Health_Conf] == 1);
+	HOST_CHECK(BMP390_Health_Stats.droppedFrames == 3);
+	HOST_CHECK(BMP390_Health_Stats.restores == 3);
+	HOST_CHECK(BMP390_Health_Stats.failedRestores == 0);
+
+	return Host_Result("health");
+}
+
+
+/**
+ * @brief  Injects one fault between two frames, checks the frame that sees it and the recovery after it.
+ */
+static void Test_Fault(BMP390_Health_Fault_TypeDef fault){
+
+	BMP390_Health_Stats_TypeDef before = BMP390_Health_Stats;
+	BMP390_StatusRegs_TypeDef regs;
+	BMP390_Sample_TypeDef sample;
+	_Bool lost = (fault != BMP390_Health_Cmd), ok;
+	uint8_t value, recovery = 0;
+
+	switch(fault){
+
+		case BMP390_Health_Por:
+
+			BMP390_Mock_Brownout();
+			break;
+
+		case BMP390_Health_Fatal:
+
+			BMP390_Mock.reg[BMP390_REG_ERR] |= Test_Fatal;
+			break;
+
+		case BMP390_Health_Cmd:
+
+			value = Test_UnknownCmd;
+			BMP390_Mock_Write(BMP390_REG_CMD, &value, 1);
+			break;
+
+		default:
+
+			value = BMP390_ODR_200;
+			BMP390_Mock_Write(BMP390_REG_ODR, &value, 1);
+			HOST_CHECK(!BMP390_Mock.running);
+			break;
+	}
+
+	ok = Test_Read(&regs);
+
+	HOST_CHECK(ok == !lost);
+	HOST_CHECK(BMP390_Health_Stats.frames == (before.frames + 1));
+	HOST_CHECK(BMP390_Health_Stats.faults[fault] == (before.faults[fault] + 1));
+	HOST_CHECK(BMP390_Health_Stats.droppedFrames == (before.droppedFrames + lost));
+	HOST_CHECK(BMP390_Health_Stats.restores == (before.restores + lost));
+
+	for(uint8_t k = 0; k < BMP390_Health_FaultCount; k++){
+
+		HOST_CHECK((k == fault) || (BMP390_Health_Stats.faults[k] == before.faults[k]));
+	}
+
+	//Restored at once : Params in the registers, running, fatal_err gone with the soft reset
+	Test_Configured();
+	HOST_CHECK((BMP390_Mock.reg[BMP390_REG_ERR] & Test_Fatal) == 0);
+
+	before = BMP390_Health_Stats;
+
+	do{
+
+		recovery++;
+		ok = Test_Read(&regs);
+
+	}while(!ok && (recovery < Test_MaxRecovery));
+
+	HOST_CHECK(ok);
+	HOST_CHECK(regs.err == 0);
+
+	sample.timestamp = HAL_GetTick();
+	BMP390_Process_RawData(&Test_Sensor, Test_Frame.rawPress, Test_Frame.rawTemp, TotalMass, &sample);
+	HOST_CLOSE(BMP390_Press, BMP390_Mock.press, Test_MaxPressError);
+
+	//The soft reset of fatal_err shows up as a POR once, nothing else is counted on the way
+	HOST_CHECK(BMP390_Health_Stats.restores == before.restores);
+	HOST_CHECK(BMP390_Health_Stats.droppedFrames == before.droppedFrames);
+
+	printf("fault %u : %s, first valid frame after %u ODR periods\n", fault, lost ? "dropped and restored" : "kept",
+		   recovery);
+}
+
+
+/**
+ * @brief  One frame one ODR period later, as the TIM1 interrupt.
+ */
+static _Bool Test_Read(BMP390_StatusRegs_TypeDef *Regs){
+
+	Host_Advance(Test_Period);
+
+	return BMP390_Read_RawFrame(&Test_Sensor, &Test_Frame, Regs);
+}
+
+
+/**
+ * @brief  The registers of the mock hold Params and the sensor runs in normal mode.
+ */
+static void Test_Configured(void){
+
+	const BMP390_Params_t *Params = &Test_Sensor.Params;
+
+	HOST_CHECK(BMP390_Mock.running);
+	HOST_CHECK(BMP390_Mock.reg[BMP390_REG_ODR] == Params->odr);
+	HOST_CHECK(BMP390_Mock.reg[BMP390_REG_OSR] == (Params->press_osrs | (Params->temp_osrs << 3)));
+	HOST_CHECK(BMP390_Mock.reg[BMP390_REG_CONFIG] == (Params->filtercoef << 1));
+}
@@ -0,0 +1,207 @@
+/*!
+ *  @file : bmp390_test_iir.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+/**
+ * NOTE ==> The software IIR bank against the exact recurrence in double precision, every coefficient of the
+ * 			sensor at once : a noisy pressure and temperature stream that drifts, then a step of one count up
+ * 			and one count down that a truncating filter would never follow at coef 127.
+ * 			Every output has to be within Test_MaxError counts of the exact value.
+ * 			BMP390_Iir_Benchmark prints the cost per sample and filter of a FIFO drain through each bank, its
+ * 			batch has to leave the bank where BMP390_Iir_Update does.
+ */
+
+#include "host_hal.h"
+#include "bmp390_iir.h"
+#include "math.h"
+
+
+#define Test_Samples				100000u
+#define Test_Noise					64			/*! counts, peak to peak */
+#define Test_StepSamples			2000u		/*! 15 time constants at coef 127 */
+#define Test_MaxError				0.51		/*! counts, the rounding of the output and 1/128 of the state */
+#define Test_BenchFrames			73			/*! A full FIFO drain */
+
+static BMP390_Iir_TypeDef Test_Iir[2];
+static double Test_Ref[2][BMP390_Iir_MaxFilters][2];
+static double Test_Error;
+static uint32_t Test_Rng = 1;
+
+static void Test_Bench(const BMP390_FilterCoef_TypeDef *coefs);
+static void Test_Feed(uint8_t bank, uint32_t rawPress, uint32_t rawTemp);
+static uint32_t Test_Rand(void);
+
+
+int main(void){
+
+	static const BMP390_FilterCoef_TypeDef coefs[2][BMP390_Iir_MaxFilters] = {
+
+		{BMP390_Filter_Coef_0, BMP390_Filter_Coef_1, BMP390_Filter_Coef_3, BMP390_Filter_Coef_7},
+		{BMP390_Filter_Coef_15, BMP390_Filter_Coef_31, BMP390_Filter_Coef_63, BMP390_Filter_Coef_127}
+	};
+	uint32_t press = 6500000u, temp = 8400000u;
+
+	for(uint8_t b = 0; b < 2; b++){
+
+		HOST_CHECK(BMP390_Iir_Init(&Test_Iir[b], coefs[b], BMP390_Iir_MaxFilters));
+	}
+
+	//Drifting stream, 24 bit raw values near the top of their range
+	for(uint32_t i = 0; i < Test_Samples; i++){
+
+		uint32_t p = press + (i / 16u) + (Test_Rand() % Test_Noise);
+		uint32_t t = temp - (i / 64u) + (Test_Rand() % Test_Noise);
+
+		Test_Feed(0, p, t);
+		Test_Feed(1, p, t);
+	}
+
+	printf("noisy stream : %.4f counts from the exact recurrence at most\n", Test_Error);
+	HOST_CHECK(Test_Error <= Test_MaxError);
+
+	//Primed on a constant input, then held one count above and one count below it
+	Test_Error = 0.0;
+
+	for(int8_t step = 0; step < 3; step++){
+
+		uint32_t p = press + ((step == 1) ? 1u : 0u) - ((step == 2) ? 1u : 0u);
+
+		BMP390_Iir_Reset(&Test_Iir[1]);
+
+		for(uint32_t i = 0; i < Test_StepSamples; i++){
+
+			Test_Feed(1, (i == 0) ? press : p, temp);
+		}
+
+		if(step != 0){
+
+			HOST_CHECK(BMP390_Iir_Press(&Test_Iir[1], 3) == p);
+		}
+	}
+
+	printf("one count steps : %.4f counts from the exact recurrence at most\n", Test_Error);
+	HOST_CHECK(Test_Error <= Test_MaxError);
+
+	for(uint8_t b = 0; b < 2; b++){
+
+		Test_Bench(coefs[b]);
+	}
+
+	return Host_Result("iir");
+}
+
+
+/**
+ * @brief  BMP390_Iir_Benchmark over one drain, against the same frames one by one through BMP390_Iir_Update.
+ */
+static void Test_Bench(const BMP390_FilterCoef_TypeDef *coefs){
+
+	static BMP390_RawFrame_TypeDef frames[Test_BenchFrames];
+	BMP390_Iir_TypeDef batch, single;
+	uint32_t cycles;
+
+	for(uint16_t i = 0; i < Test_BenchFrames; i++){
+
+		frames[i].rawPress = 6500000u + (Test_Rand() % Test_Noise);
+		frames[i].rawTemp = 8400000u + (Test_Rand() % Test_Noise);
+		frames[i].sensortime = i * BMP390_Sensortime_OdrStep;
+	}
+
+	HOST_CHECK(BMP390_Iir_Init(&batch, coefs, BMP390_Iir_MaxFilters));
+	HOST_CHECK(BMP390_Iir_Init(&single, coefs, BMP390_Iir_MaxFilters));
+	HOST_CHECK(BMP390_Iir_Benchmark(&batch, frames, 0) == 0);
+
+	cycles = BMP390_Iir_Benchmark(&batch, frames, Test_BenchFrames);
+
+	for(uint16_t i = 0; i < Test_BenchFrames; i++){
+
+		BMP390_Iir_Update(&single, &frames[i]);
+	}
+
+	printf("coef %3u .. %3u : %u cycles per sample and filter\n", (1u << coefs[0]) - 1u,
+		   (1u << coefs[BMP390_Iir_MaxFilters - 1]) - 1u, cycles);
+
+	HOST_CHECK(cycles != 0);
+	for(uint8_t k = 0; k < BMP390_Iir_MaxFilters; k++){
+
+		HOST_CHECK(BMP390_Iir_Press(&batch, k) == BMP390_Iir_Press(&single, k));
+		HOST_CHECK(BMP390_Iir_Temp(&batch, k) == BMP390_Iir_Temp(&single, k));
+	}
+}
+
+
+/**
+ * @brief  One sample through a bank and through the exact recurrence of each of its filters.
+ */
+static void Test_Feed(uint8_t bank, uint32_t rawPress, uint32_t rawTemp){
+
+	BMP390_Iir_TypeDef *Iir = &Test_Iir[bank];
+	BMP390_RawFrame_TypeDef frame = {.rawPress = rawPress, .rawTemp = rawTemp};
+	_Bool primed = Iir->primed;
+	double error;
+
+	BMP390_Iir_Update(Iir, &frame);
+
+	for(uint8_t k = 0; k < Iir->n; k++){
+
+		double *ref = Test_Ref[bank][k];
+		double div = (double)(1u << Iir->Filter[k].shift);
+
+		if(!primed){
+
+			ref[0] = rawPress;
+			ref[1] = rawTemp;
+		}
+		else{
+
+			ref[0] += ((double)rawPress - ref[0]) / div;
+			ref[1] += ((double)rawTemp - ref[1]) / div;
+		}
+
+		error = fmax(fabs((double)BMP390_Iir_Press(Iir, k) - ref[0]), fabs((double)BMP390_Iir_Temp(Iir, k) - ref[1]));
+		Test_Error = fmax(Test_Error, error);
+	}
+}
+
+
+/**
+ * @brief  xorshift32, the same stream on every run.
+ */
+static uint32_t Test_Rand(void){
+
+	Test_Rng ^= Test_Rng << 13;
+	Test_Rng ^= Test_Rng >> 17;
+	Test_Rng ^= Test_Rng << 5;
+
+	return Test_Rng;
+}
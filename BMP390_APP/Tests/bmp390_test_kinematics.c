@@ -0,0 +1,135 @@
+/*!
+ *  @file : bmp390_test_kinematics.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+/**
+ * NOTE ==> Vertical speed and acceleration at every sampling period that the firmware can run : the ODRs of the
+ * 			FIFO and the governor and the 1 s TIM1 default. A steady Test_Speed climb goes through
+ * 			BMP390_Process_RawData with MCU timestamps, and through a replay that only has the sensortime of the
+ * 			frames, starting just before the 24 bit counter wraps. Both have to give the same m/s and m/s² at
+ * 			every period. The means telescope, so the rounding of the raw values doesn't hide a wrong scale.
+ */
+
+#include "host_hal.h"
+#include "bmp390_mock.h"
+#include "bmp390_replay.h"
+#include "bmp390_sim.h"
+#include "math.h"
+
+
+#define Test_Speed					10.0f		/*! m/s, climbing */
+#define Test_Seconds				20u
+#define Test_Temp					25.0f
+#define Test_SpeedTol				0.02f		/*! m/s */
+#define Test_AccTol					0.05f		/*! m/s² */
+#define Test_CountsPerMs			25.6f		/*! Nominal sensortime rate */
+
+static const uint32_t Test_Periods[] = {5, 10, 40, 80, 640, 1000};	/*! ms */
+
+static float Test_Press(float alt);
+
+
+int main(void){
+
+	BMP390_HandleTypeDef sensor = {0};
+	BMP390_Replay_TypeDef replay;
+	BMP390_Sample_TypeDef sample, replayed;
+	BMP390_RawFrame_TypeDef frame;
+	double rawTemp;
+
+	Host_Reset();
+	BMP390_Mock_Init(0x76);
+
+	sensor.Prcsd_NVM = BMP390_Mock.Calib;
+	rawTemp = BMP390_Sim_RawTemp(&BMP390_Mock.Calib, Test_Temp, NULL);
+
+	printf("period(ms)  speed(m/s)  acc(m/s2)  replay speed  replay acc\n");
+
+	for(uint32_t r = 0; r < (sizeof(Test_Periods) / sizeof(Test_Periods[0])); r++){
+
+		uint32_t period = Test_Periods[r];
+		uint32_t n = (Test_Seconds * 1000u) / period;
+		uint32_t counts = (uint32_t)((float)period * Test_CountsPerMs);
+		uint32_t start = BMP390_Sensortime_Mask - (n / 2u) * counts;
+		double spd = 0.0, acc = 0.0, replaySpd = 0.0, replayAcc = 0.0;
+
+		BMP390_ResetRef_DeltaVal(&sensor);
+		BMP390_Replay_Init(&replay, &BMP390_Mock.Calib, 0.0f, 1.0f);
+
+		for(uint32_t k = 0; k < n; k++){
+
+			float alt = Test_Speed * (float)(k * period) / 1000.0f;
+
+			frame.rawPress = (uint32_t)lround(BMP390_Sim_RawPress(&BMP390_Mock.Calib, Test_Press(alt), Test_Temp, NULL));
+			frame.rawTemp = (uint32_t)lround(rawTemp);
+			frame.sensortime = (start + (k * counts)) & BMP390_Sensortime_Mask;
+
+			sample.timestamp = 12345u + (k * period);
+			BMP390_Process_RawData(&sensor, frame.rawPress, frame.rawTemp, 1.0f, &sample);
+			BMP390_Replay_Frame(&replay, &frame, NULL, &replayed);
+
+			//The first two samples difference against the reset values
+			if(k >= 2){
+
+				spd += sample.vertSpd;
+				acc += sample.vertAcc;
+				replaySpd += replayed.vertSpd;
+				replayAcc += replayed.vertAcc;
+			}
+		}
+
+		spd /= (n - 2u);
+		acc /= (n - 2u);
+		replaySpd /= (n - 2u);
+		replayAcc /= (n - 2u);
+
+		printf("%10u  %10.4f  %9.4f  %12.4f  %10.4f\n", period, spd, acc, replaySpd, replayAcc);
+
+		HOST_CLOSE(spd, Test_Speed, Test_SpeedTol);
+		HOST_CLOSE(acc, 0.0, Test_AccTol);
+		HOST_CLOSE(replaySpd, Test_Speed, Test_SpeedTol);
+		HOST_CLOSE(replayAcc, 0.0, Test_AccTol);
+		HOST_CHECK(replayed.timestamp == ((n - 1u) * period));
+	}
+
+	return Host_Result("kinematics");
+}
+
+
+/**
+ * @brief  Inverse of BMP390_Comp_VertAlt with the reference at sea level.
+ */
+static float Test_Press(float alt){
+
+	return (float)(SeaLevelPress * pow(1.0 - (alt * GradientTemp / SeaLevelTemp), GravityAccel / (GasCoefficient * GradientTemp)));
+}
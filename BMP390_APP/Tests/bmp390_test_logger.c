@@ -0,0 +1,125 @@
+/*!
+ *  @file : bmp390_test_logger.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * NOTE ==> Capacity of the flash log and the cost of its page erases. Records are pushed at 100 Hz and the log
+ * 			is dumped after every one of them : once the log has gone round, a dump always holds 112 to 224
+ * 			records (the page ahead is kept erased) and ends with the newest programmed record. Every erase
+ * 			takes the core 20 ms on the virtual clock, the time the TIM1 interrupt is held off on the target.
+ */
+
+#include "host_hal.h"
+#include "bmp390_logger.h"
+
+
+#define Test_Records				1000u
+#define Test_Period					10000	/*! us, 100 Hz */
+
+typedef struct{
+
+	uint32_t count;
+	uint32_t last;
+
+}Test_Dump_TypeDef;
+
+static BMP390_Logger_TypeDef Test_Log;
+
+static void Test_Record(void *ctx, uint32_t index, const BMP390_RawFrame_TypeDef *Frame);
+
+
+int main(void){
+
+	BMP390_RawFrame_TypeDef frame = {0};
+	Test_Dump_TypeDef dump;
+	uint32_t minKept = UINT32_MAX, maxKept = 0, erases, taskErases;
+	uint64_t before, stalled = 0;
+
+	Host_Reset();
+
+	HOST_CHECK(BMP390_Logger_Init(&Test_Log));
+	taskErases = Host_Stats.flashErases;
+
+	for(uint32_t k = 1; k <= Test_Records; k++){
+
+		frame.sensortime = k;
+		HOST_CHECK(BMP390_Logger_Push(&Test_Log, &frame));
+
+		erases = Host_Stats.flashErases;
+		before = Host_Micros();
+		HOST_CHECK(BMP390_Logger_Task(&Test_Log));
+
+		if(Host_Stats.flashErases != erases){
+
+			stalled += Host_Micros() - before;
+		}
+
+		Host_Advance(Test_Period);
+
+		dump.count = 0;
+		dump.last = 0;
+		BMP390_Logger_Parse((const uint8_t *)BMP390_Log_Start, BMP390_Log_Pages * BMP390_Log_PageSize, Test_Record, &dump);
+
+		//Pairs are programmed, an odd record waits in the queue
+		HOST_CHECK(dump.last == (k & ~1u));
+
+		if(k > (BMP390_Log_Pages * 2 * BMP390_Log_PairsPerPage)){
+
+			minKept = (dump.count < minKept) ? dump.count : minKept;
+			maxKept = (dump.count > maxKept) ? dump.count : maxKept;
+		}
+	}
+
+	taskErases = Host_Stats.flashErases - taskErases;
+
+	printf("%u to %u records kept, %u erases, %.1f ms stalled each\n", minKept, maxKept, taskErases,
+		   (double)stalled / 1000.0 / (double)taskErases);
+
+	//The first pair of a new page can be programmed before the erase of the oldest page
+	HOST_CHECK(minKept >= ((BMP390_Log_Pages - 2) * 2 * BMP390_Log_PairsPerPage));
+	HOST_CHECK(minKept <= ((BMP390_Log_Pages - 2) * 2 * BMP390_Log_PairsPerPage + 2));
+	HOST_CHECK(maxKept == ((BMP390_Log_Pages - 1) * 2 * BMP390_Log_PairsPerPage));
+	HOST_CHECK(stalled >= ((uint64_t)taskErases * Host_FlashEraseTime));
+	HOST_CHECK(Test_Log.droppedRecords == 0);
+	HOST_CHECK(Test_Log.flashErrors == 0);
+
+	return Host_Result("logger");
+}
+
+
+static void Test_Record(void *ctx, uint32_t index, const BMP390_RawFrame_TypeDef *Frame){
+
+	Test_Dump_TypeDef *dump = (Test_Dump_TypeDef *)ctx;
+
+	dump->count++;
+	dump->last = Frame->sensortime;
+}
@@ -0,0 +1,291 @@
+/*!
+ *  @file : bmp390_test_lowpower.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+/**
+ * NOTE ==> The main loop of main.c with BMP390_LOW_POWER for two hours of the RTC, the interrupts are called by the
+ * 			test when the RTC of host_hal.c sets ALRF and when the INT level of the mock rises. Every alarm has to
+ * 			trigger exactly one forced conversion right away and on the period grid, every conversion has to reach
+ * 			the callback once in a full batch with its data.
+ * 			Some INT edges are dropped : the alarm has to count them as missed and read the latched result, or the
+ * 			pin would stay high and no edge would come again. Twice the main loop is late for an alarm, by less
+ * 			than a period (the grid is kept) and by more than one (the alarms start a new grid from now instead of
+ * 			waiting for an alarm time that has passed). BMP390_LowPower_Report has to scale the counters to an hour.
+ */
+
+#include "host_hal.h"
+#include "bmp390_mock.h"
+#include "bmp390_lowpower.h"
+
+
+#define Test_Address				0x76		/*! SDO low, as main.c */
+#define Test_Period					BMP390_LP_PERIOD
+#define Test_Batch					BMP390_LP_BATCH
+#define Test_Step					500			/*! us between two looks at the INT level and ALRF */
+#define Test_DropEvery				37			/*! Every 37th INT edge is lost */
+#define Test_ShortStall				(Test_Period / 2)
+#define Test_LongStall				((Test_Period * 5) / 2)
+#define Test_MaxLate				2			/*! ms from the alarm to its forced conversion, without a stall */
+#define Test_Runs					4
+
+static BMP390_HandleTypeDef Test_Sensor;
+static BMP390_LowPower_TypeDef Test_Lp;
+
+static uint32_t Test_Alarm;					/*! RTC ms of the last alarm */
+static uint32_t Test_Stall;					/*! The main loop comes this late to the next alarm (ms) */
+static uint32_t Test_Alarms;
+static uint32_t Test_Triggers;
+static uint32_t Test_Late;
+static uint64_t Test_ForcedEnd;
+static uint32_t Test_Edges;
+static uint32_t Test_Dropped;
+static uint8_t Test_Level;
+
+static uint32_t Test_Batches;
+static uint32_t Test_Samples;
+static uint32_t Test_BadFrames;
+static uint32_t Test_LastTime;
+static uint32_t Test_RawPress;
+
+static void Test_Run(uint32_t ms, _Bool deep);
+static void Test_Wait(uint32_t end);
+static void Test_Frame(void *ctx, const BMP390_RawFrame_TypeDef *Frame, uint32_t timestamp);
+static uint32_t Test_Phase(void);
+
+
+int main(void){
+
+	BMP390_Lp_Report_TypeDef Report;
+	uint32_t conversions, phase, elapsed;
+	float hour;
+
+	Host_Reset();
+	BMP390_Mock_Init(Test_Address);
+
+	Test_Sensor.i2c = &hi2c1;
+	Test_Sensor.BMP390_I2C_ADDRESS = Test_Address;
+	Test_Sensor.Ref_Alt_Sel = 'm';
+
+	HOST_CHECK(BMP390_Init(&Test_Sensor));
+
+	HOST_CHECK(!BMP390_LowPower_Init(&Test_Lp, &Test_Sensor, Test_Period, 0));
+	HOST_CHECK(!BMP390_LowPower_Init(&Test_Lp, &Test_Sensor, Test_Period, BMP390_Lp_MaxBatch + 1));
+	HOST_CHECK(!BMP390_LowPower_Init(&Test_Lp, &Test_Sensor, BMP390_Calc_MeasTime(&Test_Sensor.Params) / 1000u,
+									 Test_Batch));
+
+	conversions = BMP390_Mock.conversions;
+
+	HOST_CHECK(BMP390_LowPower_Init(&Test_Lp, &Test_Sensor, Test_Period, Test_Batch));
+
+	//Forced mode with a latched drdy interrupt, the upload started the first conversion
+	HOST_CHECK(BMP390_Mock.forced);
+	HOST_CHECK(!BMP390_Mock.running);
+	HOST_CHECK((BMP390_Mock.reg[BMP390_REG_INT_CTRL] & 0x40) != 0);
+	HOST_CHECK(Test_Lp.nextAlarm == (Test_Lp.startTime + Test_Period));
+
+	Test_ForcedEnd = BMP390_Mock.forcedEnd;
+	Test_Triggers = 1;
+	Test_RawPress = 0;
+
+	//Stop mode, then Sleep mode as if the telemetry DMA ran all the time
+	Test_Run(20u * 60u * 1000u, true);
+	phase = Test_Phase();
+
+	Test_Stall = Test_ShortStall;
+	Test_Run(20u * 60u * 1000u, true);
+	HOST_CHECK(Test_Phase() == phase);
+
+	Test_Stall = Test_LongStall;
+	Test_Run(20u * 60u * 1000u, false);
+	HOST_CHECK(Test_Phase() != phase);
+	HOST_CHECK(Test_Phase() == ((phase + Test_LongStall) % Test_Period));
+
+	Test_Run(60u * 60u * 1000u, false);
+
+	//The last conversions of an unfinished batch are still in Lp->n
+	conversions = BMP390_Mock.conversions - conversions;
+	elapsed = BMP390_LowPower_Millis() - Test_Lp.startTime;
+	hour = 3600000.0f / (float)elapsed;
+
+	BMP390_LowPower_Report(&Test_Lp, &Report);
+
+	printf("%u alarms, %u conversions, %u samples in %u batches, %u dropped edges, %u missed, %u wakes (%u stops, "
+		   "%u sleeps)\n", Test_Alarms, conversions, Test_Samples, Test_Batches, Test_Dropped, Test_Lp.Stats.missed,
+		   Test_Lp.Stats.wakes, Test_Lp.Stats.stops, Test_Lp.Stats.sleeps);
+	printf("per hour : %.1f wakes, %.3f ms on the bus, duty %.2e\n", Report.wakes, Report.busMs, Report.duty);
+
+	HOST_CHECK(Test_Triggers == (Test_Alarms + 1));
+	HOST_CHECK(Test_Triggers == conversions);
+	HOST_CHECK(Test_Late <= Test_MaxLate);
+	HOST_CHECK(Test_Alarms >= ((elapsed / Test_Period) - 3));		//The long stall skips two
+
+	HOST_CHECK(Test_Dropped > 0);
+	HOST_CHECK(Test_Lp.Stats.missed == Test_Dropped);
+	HOST_CHECK(Test_Lp.Stats.samples == conversions);
+	HOST_CHECK(Test_Samples == (Test_Lp.Stats.samples - Test_Lp.n));
+	HOST_CHECK(Test_Samples == (Test_Batches * Test_Batch));
+	HOST_CHECK(Test_Lp.Stats.batches == Test_Batches);
+	HOST_CHECK(Test_BadFrames == 0);
+
+	//One wake-up per alarm and one per INT edge, one more where a run ended asleep, Stop or Sleep mode as asked
+	HOST_CHECK(Test_Lp.Stats.wakes >= (Test_Alarms + Test_Edges - Test_Dropped));
+	HOST_CHECK(Test_Lp.Stats.wakes <= (Test_Alarms + Test_Edges - Test_Dropped + Test_Runs));
+	HOST_CHECK(Test_Lp.Stats.wakes == (Test_Lp.Stats.stops + Test_Lp.Stats.sleeps));
+	HOST_CHECK(Host_Stats.stopModes == Test_Lp.Stats.stops);
+	HOST_CHECK(Host_Stats.sleepModes == Test_Lp.Stats.sleeps);
+	HOST_CHECK((Test_Lp.Stats.stops > 0) && (Test_Lp.Stats.sleeps > 0));
+
+	HOST_CLOSE(Report.wakes, (float)Test_Lp.Stats.wakes * hour, Report.wakes * 1e-5f);
+	HOST_CLOSE(Report.activeCycles, (float)Test_Lp.Stats.activeCycles * hour, Report.activeCycles * 1e-5f);
+	HOST_CLOSE(Report.busMs, ((float)Test_Lp.Stats.busCycles / ((float)SystemCoreClock / 1000.0f)) * hour,
+			   Report.busMs * 1e-5f);
+	HOST_CLOSE(Report.duty, (float)Test_Lp.Stats.activeCycles / ((float)elapsed * ((float)SystemCoreClock / 1000.0f)),
+			   Report.duty * 1e-5f);
+	HOST_CLOSE(Report.wakes, 2.0f * (3600000.0f / (float)Test_Period), 0.02f * Report.wakes);
+
+	return Host_Result("lowpower");
+}
+
+
+/**
+ * @brief  The main loop of main.c for ms of the RTC, the stall of Test_Stall is spent once at the next alarm.
+ */
+static void Test_Run(uint32_t ms, _Bool deep){
+
+	uint32_t end = BMP390_LowPower_Millis() + ms;
+	_Bool stalled;
+
+	while((int32_t)(end - BMP390_LowPower_Millis()) > 0){
+
+		stalled = Test_Lp.alarm && (Test_Stall != 0);
+
+		if(stalled){
+
+			Host_Advance(Test_Stall * 1000u);
+			Test_Stall = 0;
+		}
+
+		BMP390_LowPower_Task(&Test_Lp, Test_Frame, NULL);
+
+		//A new forced conversion
+		if(BMP390_Mock.forced && (BMP390_Mock.forcedEnd != Test_ForcedEnd)){
+
+			Test_ForcedEnd = BMP390_Mock.forcedEnd;
+			Test_Triggers++;
+
+			if(!stalled && ((BMP390_LowPower_Millis() - Test_Alarm) > Test_Late)){
+
+				Test_Late = BMP390_LowPower_Millis() - Test_Alarm;
+			}
+		}
+
+		BMP390_LowPower_Sleep(&Test_Lp, deep);
+		Test_Wait(end);
+	}
+}
+
+
+/**
+ * @brief  Stop mode : the time goes on until an interrupt sets a flag of Lp or the run ends.
+ */
+static void Test_Wait(uint32_t end){
+
+	uint8_t level;
+
+	while(!Test_Lp.alarm && !Test_Lp.drdy && ((int32_t)(end - BMP390_LowPower_Millis()) > 0)){
+
+		Host_Advance(Test_Step);
+
+		level = BMP390_Mock_IntLevel();
+
+		if(level && !Test_Level){
+
+			Test_Edges++;
+
+			if((Test_Edges % Test_DropEvery) == 0){
+
+				Test_Dropped++;
+			}
+			else{
+
+				BMP390_LowPower_IntIRQHandler(&Test_Lp);
+			}
+		}
+
+		Test_Level = level;
+
+		if(RTC->CRL & RTC_CRL_ALRF){
+
+			Test_Alarm = BMP390_LowPower_Millis();
+			Test_Alarms++;
+
+			BMP390_LowPower_AlarmIRQHandler(&Test_Lp);
+			HOST_CHECK((RTC->CRL & RTC_CRL_ALRF) == 0);
+		}
+	}
+}
+
+
+/**
+ * @brief  Callback of a full batch : in time order and the same raw pressure every time (no noise).
+ */
+static void Test_Frame(void *ctx, const BMP390_RawFrame_TypeDef *Frame, uint32_t timestamp){
+
+	if(Test_RawPress == 0){
+
+		Test_RawPress = Frame->rawPress;
+	}
+
+	if((Frame->rawPress != Test_RawPress) || (Frame->rawPress == 0) ||
+	   ((Test_Samples != 0) && ((int32_t)(timestamp - Test_LastTime) <= 0))){
+
+		Test_BadFrames++;
+	}
+
+	Test_LastTime = timestamp;
+	Test_Samples++;
+
+	if((Test_Samples % Test_Batch) == 0){
+
+		Test_Batches++;
+	}
+}
+
+
+/**
+ * @brief  Position of the last alarm on the period grid of BMP390_LowPower_Init (ms).
+ */
+static uint32_t Test_Phase(void){
+
+	return (Test_Alarm - Test_Lp.startTime) % Test_Period;
+}
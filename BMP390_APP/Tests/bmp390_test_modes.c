@@ -0,0 +1,133 @@
+/*!
+ *  @file : bmp390_test_modes.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+/**
+ * NOTE ==> Work modes against the sensor model. PWR_CTRL mode 01 and 10 are both forced mode : one conversion, then
+ * 			the sensor sleeps again and drdy never comes back. Only 11 runs conversions at the ODR.
+ * 			After BMP390_Init every read of the ODR cadence has to find a fresh conversion, a second read in the same
+ * 			period is a duplicate, and the reference altitude is averaged from 20 different conversions.
+ */
+
+#include "host_hal.h"
+#include "bmp390.h"
+#include "bmp390_health.h"
+#include "bmp390_mock.h"
+
+
+#define Test_Address				0x76		/*! SDO low, as main.c */
+#define Test_Periods				50
+
+static BMP390_HandleTypeDef Test_Sensor;
+
+
+int main(void){
+
+	BMP390_RawFrame_TypeDef frame;
+	uint8_t pwrCtrl;
+	uint32_t fresh = 0, conversions, period;
+	uint64_t start;
+
+	Host_Reset();
+	BMP390_Mock_Init(Test_Address);
+
+	//10 : a single forced conversion, the mode bits go back to sleep
+	pwrCtrl = (2 << 4) | 0x03;
+	BMP390_Mock_Write(BMP390_REG_PWR_CTRL, &pwrCtrl, 1);
+	Host_Advance(200000);
+	BMP390_Mock_Read(BMP390_REG_PWR_CTRL, &pwrCtrl, 1);
+	HOST_CHECK(BMP390_Mock.conversions == 1);
+	HOST_CHECK((pwrCtrl & 0x30) == 0);
+
+	Host_Reset();
+	BMP390_Mock_Init(Test_Address);
+
+	Test_Sensor.i2c = &hi2c1;
+	Test_Sensor.BMP390_I2C_ADDRESS = Test_Address;
+	Test_Sensor.Ref_Alt_Sel = 'm';
+
+	HOST_CHECK(BMP390_Init(&Test_Sensor));
+
+	BMP390_Mock_Read(BMP390_REG_PWR_CTRL, &pwrCtrl, 1);
+	HOST_CHECK((pwrCtrl & 0x30) == (BMP390_Mode_Normal << 4));
+	HOST_CHECK(Test_Sensor.ERR == 0);
+	HOST_CHECK(BMP390_Mock.running);
+
+	//The reference altitude needs 20 conversions, not 1 conversion read 20 times.
+	//The por_detected of the power on costs the first attempt : the frame is dropped and the settings restored
+	HOST_CHECK(BMP390_Health_Stats.restores == 1);
+	HOST_CHECK(BMP390_Mock.freshReads >= 19);
+	HOST_CLOSE(Test_Sensor.FixedAltitude, 0.0f, 0.5f);
+
+	//Right after a conversion, the reads below keep this phase
+	for(int cnt = 0 ; (cnt < 1000) && !BMP390_Read_RawFrame(&Test_Sensor, &frame, NULL) ; cnt++){
+
+		Host_Advance(100);
+
+	}
+
+	period = BMP390_Calc_OdrPeriod(Test_Sensor.Params.odr);
+	start = Host_Micros();
+	conversions = BMP390_Mock.conversions;
+	Test_Sensor.Track.missed = 0;
+	Test_Sensor.Track.duplicates = 0;
+
+	//One period apart drdy is set again every time, right after a read it is clear
+	for(int cnt = 1 ; cnt <= Test_Periods ; cnt++){
+
+		Host_Advance((uint32_t)(start + (cnt * period) - Host_Micros()));
+
+		if(BMP390_Read_RawFrame(&Test_Sensor, &frame, NULL)){
+
+			fresh++;
+
+		}
+
+		HOST_CHECK(!BMP390_Read_RawFrame(&Test_Sensor, &frame, NULL));
+
+	}
+
+	printf("%u fresh frames, %u duplicates, %u missed, %u conversions\n", fresh, Test_Sensor.Track.duplicates,
+		   Test_Sensor.Track.missed, BMP390_Mock.conversions - conversions);
+
+	HOST_CHECK(fresh == Test_Periods);
+	HOST_CHECK(Test_Sensor.Track.duplicates == Test_Periods);
+	HOST_CHECK(Test_Sensor.Track.missed == 0);
+
+	//Three periods without a read : two conversions were overwritten
+	Host_Advance((uint32_t)(start + ((Test_Periods + 3) * period) - Host_Micros()));
+	HOST_CHECK(BMP390_Read_RawFrame(&Test_Sensor, &frame, NULL));
+	HOST_CHECK(Test_Sensor.Track.missed == 2);
+
+	return Host_Result("modes");
+}
@@ -0,0 +1,117 @@
+/*!
+ *  @file : bmp390_test_replay.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * NOTE ==> A flash log replayed through BMP390_Logger_Parse and BMP390_Replay_LogCallback is compared with the
+ * 			samples the flight code computed from the same raw frames : every record is compared and matches,
+ * 			a changed sample is found at its index, records without a recorded sample are only replayed.
+ */
+
+#include "host_hal.h"
+#include "bmp390_mock.h"
+#include "bmp390_logger.h"
+#include "bmp390_replay.h"
+
+
+#define Test_Address				0x76		/*! SDO low, as main.c */
+#define Test_Records				200u
+#define Test_Mass					1.5f		/*! kg */
+#define Test_Changed				37u
+
+static BMP390_Logger_TypeDef Test_Log;
+static BMP390_Sample_TypeDef Test_Expected[Test_Records];
+
+static uint32_t Test_Replay(uint32_t expectedCount, BMP390_Replay_TypeDef *Replay);
+
+
+int main(void){
+
+	BMP390_HandleTypeDef flight = {0};
+	BMP390_RawFrame_TypeDef frame;
+	BMP390_Replay_TypeDef replay;
+
+	Host_Reset();
+	BMP390_Mock_Init(Test_Address);
+
+	HOST_CHECK(BMP390_Logger_Init(&Test_Log));
+
+	//The flight code : a climb of a few metres, logged and processed
+	flight.Prcsd_NVM = BMP390_Mock.Calib;
+	flight.FixedAltitude = 0.0f;
+
+	for(uint32_t k = 0; k < Test_Records; k++){
+
+		frame.rawPress = 6500000u - (k * k);
+		frame.rawTemp = 8400000u + (k * 3u);
+		frame.sensortime = k * 1000u;
+
+		Test_Expected[k].timestamp = k;
+		BMP390_Process_RawData(&flight, frame.rawPress, frame.rawTemp, Test_Mass, &Test_Expected[k]);
+
+		HOST_CHECK(BMP390_Logger_Push(&Test_Log, &frame));
+		HOST_CHECK(BMP390_Logger_Task(&Test_Log));
+	}
+
+	HOST_CHECK(BMP390_Logger_Flush(&Test_Log));
+
+	HOST_CHECK(Test_Replay(Test_Records, &replay) == Test_Records);
+	HOST_CHECK(replay.compared == Test_Records);
+	HOST_CHECK(replay.mismatches == 0);
+
+	Test_Expected[Test_Changed].vertAlt += 0.01f;
+
+	HOST_CHECK(Test_Replay(Test_Records, &replay) == Test_Records);
+	HOST_CHECK(replay.mismatches == 1);
+	HOST_CHECK(replay.firstMismatch == Test_Changed);
+
+	HOST_CHECK(Test_Replay(Test_Changed, &replay) == Test_Records);
+	HOST_CHECK(replay.compared == Test_Changed);
+	HOST_CHECK(replay.mismatches == 0);
+
+	return Host_Result("replay");
+}
+
+
+/**
+ * @brief  Replays the LOG region in place against the first expectedCount recorded samples.
+ */
+static uint32_t Test_Replay(uint32_t expectedCount, BMP390_Replay_TypeDef *Replay){
+
+	BMP390_Replay_Init(Replay, &BMP390_Mock.Calib, 0.0f, Test_Mass);
+	Replay->expected = Test_Expected;
+	Replay->expectedCount = expectedCount;
+
+	BMP390_Logger_Parse((const uint8_t *)BMP390_Log_Start, BMP390_Log_Pages * BMP390_Log_PageSize, BMP390_Replay_LogCallback, Replay);
+
+	return Replay->frames;
+}
@@ -0,0 +1,156 @@
+/*!
+ *  @file : bmp390_test_seqlock.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * NOTE ==> Stress test of BMP390_Publish_Sample / BMP390_Read_LatestSample. The writer runs in a signal handler
+ * 			fired by an interval timer every few microseconds, so like the TIM1 interrupt on the target it preempts
+ * 			the reader at any instruction, half way through a copy too, and the reader never preempts it.
+ * 			Every field of a published sample is derived from its timestamp : every copy the reader gets has to
+ * 			be one published sample, and the sequence and the timestamps never go back.
+ * 			Publishes that landed inside a read show that the retry path was taken.
+ */
+
+#include "host_hal.h"
+#include "bmp390.h"
+#include "signal.h"
+#include "sys/time.h"
+
+
+#define Test_Samples				100000u
+#define Test_TimerPeriod			5		/*! us, the kernel stretches it to what it can deliver */
+
+static BMP390_SampleSeqlock_TypeDef Test_Latest;
+static volatile uint32_t Test_Published;
+static volatile uint8_t Test_Reading;
+static volatile uint32_t Test_Inside;		/*! Publishes while a read was in progress */
+
+static void Test_Fill(BMP390_Sample_TypeDef *Sample, uint32_t k);
+static void Test_Isr(int sig);
+
+
+int main(void){
+
+	struct sigaction sa = {0};
+	struct itimerval timer = {{0, Test_TimerPeriod}, {0, Test_TimerPeriod}};
+	struct itimerval stop = {{0, 0}, {0, 0}};
+	BMP390_Sample_TypeDef sample, expect;
+	uint32_t seq, prevSeq = 0, prevTime = 0;
+	uint32_t reads = 0, torn = 0, backwards = 0, odd = 0;
+
+	sa.sa_handler = Test_Isr;
+	sigemptyset(&sa.sa_mask);
+	sigaction(SIGALRM, &sa, NULL);
+	setitimer(ITIMER_REAL, &timer, NULL);
+
+	while(Test_Published < Test_Samples){
+
+		Test_Reading = true;
+		seq = BMP390_Read_LatestSample(&Test_Latest, &sample);
+		Test_Reading = false;
+		reads++;
+
+		if(seq & 1){
+
+			odd++;
+		}
+
+		if((seq < prevSeq) || (sample.timestamp < prevTime)){
+
+			backwards++;
+		}
+
+		prevSeq = seq;
+		prevTime = sample.timestamp;
+
+		if(sample.timestamp == 0){
+
+			continue;
+		}
+
+		Test_Fill(&expect, sample.timestamp);
+
+		if((sample.press != expect.press) || (sample.temp != expect.temp) || (sample.vertAlt != expect.vertAlt) ||
+		   (sample.vertSpd != expect.vertSpd) || (sample.vertAcc != expect.vertAcc) || (sample.gForce != expect.gForce)){
+
+			torn++;
+		}
+	}
+
+	setitimer(ITIMER_REAL, &stop, NULL);
+
+	printf("%u samples published, %u reads, %u publishes inside a read\n", Test_Published, reads, Test_Inside);
+
+	HOST_CHECK(torn == 0);
+	HOST_CHECK(backwards == 0);
+	HOST_CHECK(odd == 0);
+	HOST_CHECK(Test_Inside > 1000);
+
+	//Every publish is two increments, the last sample is the one that stays
+	HOST_CHECK(BMP390_Read_LatestSample(&Test_Latest, &sample) == (2u * Test_Published));
+	HOST_CHECK(sample.timestamp == Test_Published);
+
+	return Host_Result("seqlock");
+}
+
+
+/**
+ * @brief  Every field is a different function of k, a copy mixed from two samples doesn't match.
+ */
+static void Test_Fill(BMP390_Sample_TypeDef *Sample, uint32_t k){
+
+	Sample->timestamp = k;
+	Sample->press = (float)(k & 0xFFFF) * 2.0f;
+	Sample->temp = (float)(k & 0xFFFF) * 3.0f;
+	Sample->vertAlt = (float)(k & 0xFFFF) * 5.0f;
+	Sample->vertSpd = (float)(k & 0xFFFF) * 7.0f;
+	Sample->vertAcc = (float)(k & 0xFFFF) * 11.0f;
+	Sample->gForce = (float)(k & 0xFFFF) * 13.0f;
+}
+
+
+/**
+ * @brief  The TIM1 interrupt : the only writer.
+ */
+static void Test_Isr(int sig){
+
+	BMP390_Sample_TypeDef sample;
+
+	if(Test_Reading){
+
+		Test_Inside++;
+	}
+
+	Test_Fill(&sample, Test_Published + 1);
+	BMP390_Publish_Sample(&Test_Latest, &sample);
+	Test_Published++;
+}
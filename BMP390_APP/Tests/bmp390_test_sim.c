@@ -0,0 +1,225 @@
+/*!
+ *  @file : bmp390_test_sim.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+/**
+ * NOTE ==> bmp390_sim.c is the ground truth of the replay, sweep, codec and Allan tests, so it is checked itself :
+ *
+ * 				- the inverse calibration over -40 .. 85 °C and 300 .. 1250 hPa : the raw value it gives has to
+ * 				  compensate back to the true value within half a count (the raw values are integers) plus the
+ * 				  float rounding of BMP390_Comp_Temp/Press itself, a few ulps of the result,
+ * 				- the noise after the compensation for every oversampling and IIR coefficient :
+ * 				  BMP390_PressNoise_X1 * BMP390_OsrNoiseFactor * BMP390_IirNoiseFactor, with the rounding to
+ * 				  counts (count / sqrt(12)) on top, the same for the temperature,
+ * 				- the samples per second of BMP390_Sim_Step, a 600 s flight at 200 Hz has to take less than a second.
+ */
+
+#include "host_hal.h"
+#include "bmp390_mock.h"
+#include "bmp390_sim.h"
+#include "math.h"
+#include "float.h"
+#include "time.h"
+
+
+#define Test_Press					100000.0f	/*! Pa, the noise runs */
+#define Test_Temp					25.0f
+#define Test_Frames					2000u		/*! Per (coefficient + 1) of the IIR, the same independent samples */
+#define Test_Settle					10u			/*! Time constants of the IIR before the noise is measured */
+#define Test_NoiseTolerance			0.1f		/*! Relative, ~4 sigma of the estimate */
+#define Test_Ulps					4.0f		/*! Float rounding of the compensation, ulps of the result */
+#define Test_RateFrames				1000000u
+#define Test_MinRate				120000.0	/*! samples/s */
+
+static void Test_Inversion(void);
+static void Test_Noise(void);
+static void Test_Rate(void);
+
+
+int main(void){
+
+	BMP390_Mock_Init(0x76);
+
+	Test_Inversion();
+	Test_Noise();
+	Test_Rate();
+
+	return Host_Result("sim");
+}
+
+
+/**
+ * @brief  Raw values of BMP390_Sim_RawTemp/RawPress, rounded like the sensor does, compensated by the driver.
+ */
+static void Test_Inversion(void){
+
+	const BMP390_PrcsdCalibData_TypeDef *Calib = &BMP390_Mock.Calib;
+	float tempSlope, pressSlope, temp, press, worstTemp = 0.0f, worstPress = 0.0f, error;
+	double raw;
+
+	for(float t = -40.0f; t <= 85.0f; t += 5.0f){
+
+		raw = BMP390_Sim_RawTemp(Calib, t, &tempSlope);
+		temp = BMP390_Comp_Temp(Calib, (uint32_t)(raw + 0.5f));
+		error = fabsf(temp - t) / ((0.5f * fabsf(tempSlope)) + (Test_Ulps * FLT_EPSILON * fabsf(t)));
+
+		HOST_CHECK(error <= 1.0f);
+		worstTemp = (error > worstTemp) ? error : worstTemp;
+
+		//The pressure against the compensated temperature, the one BMP390_Comp_Press gets
+		for(float p = 30000.0f; p <= 125000.0f; p += 2500.0f){
+
+			raw = BMP390_Sim_RawPress(Calib, p, temp, &pressSlope);
+			press = BMP390_Comp_Press(Calib, (uint32_t)(raw + 0.5f), temp);
+			error = fabsf(press - p) / ((0.5f * fabsf(pressSlope)) + (Test_Ulps * FLT_EPSILON * p));
+
+			HOST_CHECK(error <= 1.0f);
+			worstPress = (error > worstPress) ? error : worstPress;
+		}
+	}
+
+	printf("inversion : temperature within %.2f, pressure within %.2f of half a count (%.4f °C, %.4f Pa)\n",
+		   worstTemp, worstPress, 0.5f * fabsf(tempSlope), 0.5f * fabsf(pressSlope));
+}
+
+
+/**
+ * @brief  RMS of the compensated values against the noise model for every oversampling and IIR coefficient.
+ */
+static void Test_Noise(void){
+
+	const BMP390_PrcsdCalibData_TypeDef *Calib = &BMP390_Mock.Calib;
+	BMP390_Sim_TypeDef sim;
+	BMP390_Params_t params = {0};
+	BMP390_RawFrame_TypeDef frame;
+	float tempSlope, pressSlope, temp, press, expected[2], rms[2];
+	double sum[2], sq[2];
+	uint32_t frames, settle, n;
+
+	BMP390_Sim_RawTemp(Calib, Test_Temp, &tempSlope);
+	BMP390_Sim_RawPress(Calib, Test_Press, Test_Temp, &pressSlope);
+
+	printf("osr  coef  press (Pa) : model  sim      temp (°C) : model  sim\n");
+
+	params.odr = BMP390_ODR_25;
+
+	for(uint8_t osr = BMP390_Oversampling_X1; osr <= BMP390_Oversampling_X32; osr++){
+
+		for(uint8_t coef = BMP390_Filter_Coef_0; coef <= BMP390_Filter_Coef_127; coef++){
+
+			params.press_osrs = osr;
+			params.temp_osrs = osr;
+			params.filtercoef = coef;
+
+			BMP390_Sim_Init(&sim, Calib, &params, 1u + (osr * 8u) + coef);
+
+			frames = Test_Frames << coef;
+			settle = Test_Settle << coef;
+			sum[0] = sum[1] = sq[0] = sq[1] = 0.0;
+			n = 0;
+
+			for(uint32_t i = 0; i < (settle + frames); i++){
+
+				BMP390_Sim_Step(&sim, Test_Press, Test_Temp, &frame);
+
+				if(i < settle){
+
+					continue;
+				}
+
+				temp = BMP390_Comp_Temp(Calib, frame.rawTemp);
+				press = BMP390_Comp_Press(Calib, frame.rawPress, temp);
+
+				sum[0] += press - Test_Press;
+				sq[0] += (double)(press - Test_Press) * (press - Test_Press);
+				sum[1] += temp - Test_Temp;
+				sq[1] += (double)(temp - Test_Temp) * (temp - Test_Temp);
+				n++;
+			}
+
+			for(uint8_t q = 0; q < 2; q++){
+
+				rms[q] = (float)sqrt((sq[q] / n) - ((sum[q] / n) * (sum[q] / n)));
+			}
+
+			expected[0] = sqrtf(powf(BMP390_PressNoise_X1 * BMP390_OsrNoiseFactor(osr) * BMP390_IirNoiseFactor(coef), 2.0f) +
+								((pressSlope * pressSlope) / 12.0f));
+			expected[1] = sqrtf(powf(BMP390_TempNoise_X1 * BMP390_OsrNoiseFactor(osr) * BMP390_IirNoiseFactor(coef), 2.0f) +
+								((tempSlope * tempSlope) / 12.0f));
+
+			HOST_CLOSE(rms[0], expected[0], expected[0] * Test_NoiseTolerance);
+			HOST_CLOSE(rms[1], expected[1], expected[1] * Test_NoiseTolerance);
+
+			printf("x%-2u  %4u  %18.4f  %.4f  %17.5f  %.5f\n", 1u << osr, (1u << coef) - 1u, expected[0], rms[0],
+				   expected[1], rms[1]);
+		}
+	}
+}
+
+
+/**
+ * @brief  Samples per second of BMP390_Sim_Step on the host.
+ */
+static void Test_Rate(void){
+
+	BMP390_Sim_TypeDef sim;
+	BMP390_Params_t params = {0};
+	BMP390_RawFrame_TypeDef frame;
+	struct timespec start, end;
+	uint32_t check = 0;
+	double seconds, rate;
+
+	params.press_osrs = BMP390_Oversampling_X8;
+	params.temp_osrs = BMP390_Oversampling_X2;
+	params.odr = BMP390_ODR_200;
+	params.filtercoef = BMP390_Filter_Coef_3;
+
+	BMP390_Sim_Init(&sim, &BMP390_Mock.Calib, &params, 1);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for(uint32_t i = 0; i < Test_RateFrames; i++){
+
+		BMP390_Sim_Step(&sim, Test_Press + (float)(i & 1023u), Test_Temp, &frame);
+		check += frame.rawPress;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	seconds = (double)(end.tv_sec - start.tv_sec) + ((double)(end.tv_nsec - start.tv_nsec) * 1e-9);
+	rate = Test_RateFrames / seconds;
+
+	printf("BMP390_Sim_Step : %.0f samples/s (%.1f ns each, check %08x)\n", rate, 1e9 / rate, check);
+
+	HOST_CHECK(rate >= Test_MinRate);
+}
@@ -0,0 +1,66 @@
+/*!
+ *  @file : bmp390_test_sweep.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * NOTE ==> Ranking of BMP390_Sweep_Rank with early detections : an apogee detected 0.5 s early is as good as one
+ * 			detected 0.5 s late, better than 2 s late, and any detection ranks before a flight where it never came.
+ * 			Before the detected flag a delay of -1 s meant "never" and every other early detection ranked first.
+ */
+
+#include "host_hal.h"
+#include "bmp390_sweep.h"
+
+
+int main(void){
+
+	BMP390_Sweep_Weights_TypeDef weights = {1.0f, 1.0f};
+	BMP390_Sweep_Result_TypeDef results[] = {
+
+		{ .index = 0, .altRms = 0.1f, .detectDelay =  0.0f, .detected = false },
+		{ .index = 1, .altRms = 0.1f, .detectDelay = -1.0f, .detected = true  },
+		{ .index = 2, .altRms = 0.1f, .detectDelay =  2.0f, .detected = true  },
+		{ .index = 3, .altRms = 0.1f, .detectDelay = -0.5f, .detected = true  },
+		{ .index = 4, .altRms = 0.1f, .detectDelay = -3.0f, .detected = true  },
+	};
+
+	BMP390_Sweep_Rank(results, 5, &weights, 5);
+
+	HOST_CHECK(results[0].index == 3);
+	HOST_CHECK(results[1].index == 1);
+	HOST_CHECK(results[2].index == 2);
+	HOST_CHECK(results[3].index == 4);
+	HOST_CHECK(results[4].index == 0);
+	HOST_CLOSE(results[0].score, 0.6f, 1.0e-6f);
+
+	return Host_Result("sweep");
+}
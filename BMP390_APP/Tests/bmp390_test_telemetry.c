@@ -0,0 +1,420 @@
+/*!
+ *  @file : bmp390_test_telemetry.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+/**
+ * NOTE ==> The double buffered USART1 TX DMA queue when a transfer fails : the error is counted, the queue
+ * 			isn't left busy and the next buffer goes out. Before XferErrorCallback was set a transfer error
+ * 			left busy at 1 and nothing was sent anymore.
+ * 			Then USART1 is replaced by a loopback at BMP390_Tlm_Baudrate (10 bit times per byte) and a receiver
+ * 			that reads it in chunks of random size, so frames are split between reads, splits them at 0x00 and
+ * 			decodes them. Every sample packet has to come back bit for bit. A corrupted CRC and a frame cut short
+ * 			by a lost tail have to be rejected without losing the frame behind them. Below the capacity of the
+ * 			link nothing is dropped, above it the link stays busy and the queue drops whole frames.
+ */
+
+#include "host_hal.h"
+#include "bmp390_telemetry.h"
+#include "string.h"
+
+
+#define Test_Tick					100			/*! us between two passes of the main loop */
+#define Test_MaxSamples				8192
+#define Test_MaxChunk				64			/*! bytes per read of the receiver */
+#define Test_MinBusy				0.95f		/*! Utilization of the link above its capacity */
+
+/**
+ * @brief  Receiver side of the loopback.
+ */
+typedef struct{
+
+	uint8_t frame[BMP390_Tlm_MaxFrame];
+	uint16_t len;
+	uint8_t overflow;				/*! The frame was longer than any valid one, it is dropped at its 0x00 */
+
+	uint32_t good;
+	uint32_t bad;					/*! Frames that failed to decode */
+	uint32_t mismatches;			/*! Decoded, but not the sample that was sent */
+	uint32_t index;					/*! Send count of the last good frame, from the sequence numbers */
+	uint8_t seq;
+
+}Test_Rx_TypeDef;
+
+static BMP390_Telemetry_TypeDef Test_Tlm;
+static BMP390_Sample_TypeDef Test_Sent[Test_MaxSamples];
+static uint8_t Test_Wire[1u << 18];
+static uint32_t Test_WireLen;
+static uint32_t Test_TxEnd;			/*! Time (us) the byte stream of the running DMA transfer is out */
+static uint16_t Test_TxLen;
+static uint32_t Test_Rng = 1;
+static Test_Rx_TypeDef Test_Rx;
+
+static void Test_Errors(void);
+static void Test_Corrupted(void);
+static void Test_Stream(uint32_t rate, uint32_t seconds);
+static void Test_Uart(void);
+static void Test_Receive(const uint8_t *data, uint32_t len);
+static void Test_Frame(void);
+static void Test_Payload(const BMP390_Sample_TypeDef *Sample, uint8_t *payload);
+static uint32_t Test_Rand(void);
+
+
+int main(void){
+
+	Test_Errors();
+	Test_Corrupted();
+
+	//Below and above the capacity of the link (about 330 sample packets per second)
+	Test_Stream(100, 10);
+	Test_Stream(250, 10);
+	Test_Stream(500, 10);
+
+	return Host_Result("telemetry");
+}
+
+
+/**
+ * @brief  Transfer errors of the DMA queue.
+ */
+static void Test_Errors(void){
+
+	BMP390_Sample_TypeDef sample = {0};
+
+	Host_Reset();
+
+	HOST_CHECK(BMP390_Telemetry_Init(&Test_Tlm));
+
+	//The first frame goes out at once, the second one waits in the fill buffer
+	HOST_CHECK(BMP390_Telemetry_SendSample(&Test_Tlm, &sample));
+	HOST_CHECK(Test_Tlm.busy && (Host_Stats.dmaStarts == 1));
+	HOST_CHECK(BMP390_Telemetry_SendSample(&Test_Tlm, &sample));
+	HOST_CHECK(Host_Stats.dmaStarts == 1);
+
+	//A transfer error : the waiting buffer is sent next
+	HOST_CHECK(Host_Dma_Finish(true));
+	BMP390_Telemetry_IRQHandler(&Test_Tlm);
+	HOST_CHECK(Test_Tlm.txErrors == 1);
+	HOST_CHECK(Test_Tlm.busy && (Host_Stats.dmaStarts == 2));
+	HOST_CHECK(Test_Tlm.fill == 0);
+
+	HOST_CHECK(Host_Dma_Finish(false));
+	BMP390_Telemetry_IRQHandler(&Test_Tlm);
+	HOST_CHECK(!Test_Tlm.busy);
+
+	//A transfer error with nothing waiting : the queue is free for the next frame
+	HOST_CHECK(BMP390_Telemetry_SendSample(&Test_Tlm, &sample));
+	HOST_CHECK(Host_Dma_Finish(true));
+	BMP390_Telemetry_IRQHandler(&Test_Tlm);
+	HOST_CHECK(Test_Tlm.txErrors == 2);
+	HOST_CHECK(!Test_Tlm.busy);
+
+	HOST_CHECK(BMP390_Telemetry_SendSample(&Test_Tlm, &sample));
+	HOST_CHECK(Test_Tlm.busy && (Host_Stats.dmaStarts == 4));
+	HOST_CHECK(Host_Dma_Finish(false));
+	BMP390_Telemetry_IRQHandler(&Test_Tlm);
+	HOST_CHECK(!Test_Tlm.busy);
+
+	HOST_CHECK(Test_Tlm.sentFrames == 4);
+	HOST_CHECK(Test_Tlm.droppedFrames == 0);
+}
+
+
+/**
+ * @brief  Frames that are damaged on the wire, each one is followed by a good one.
+ */
+static void Test_Corrupted(void){
+
+	uint8_t frames[4][BMP390_Tlm_MaxFrame], payload[28], out[BMP390_Tlm_MaxPayload], type, seq;
+	uint16_t len[4], pos;
+	int16_t n;
+
+	memset(&Test_Rx, 0, sizeof(Test_Rx));
+	memset(Test_Sent, 0, sizeof(Test_Sent));
+
+	for(uint8_t k = 0; k < 4; k++){
+
+		Test_Sent[k].timestamp = Test_Rand();
+		Test_Sent[k].press = 101325.0f - (float)k;
+		Test_Payload(&Test_Sent[k], payload);
+		len[k] = BMP390_Telemetry_Encode(k, BMP390_Tlm_Sample, payload, sizeof(payload), frames[k]);
+	}
+
+	//A good frame by itself
+	n = BMP390_Telemetry_Decode(frames[0], len[0] - 1u, &type, &seq, out);
+	HOST_CHECK((n == sizeof(payload)) && (type == BMP390_Tlm_Sample) && (seq == 0));
+
+	//One flipped bit in the payload, the byte stays non zero so the COBS structure is intact
+	pos = len[1] / 2u;
+	frames[1][pos] ^= (frames[1][pos] == 0x01) ? 0x02 : 0x01;
+	HOST_CHECK(BMP390_Telemetry_Decode(frames[1], len[1] - 1u, &type, &seq, out) == -1);
+
+	//The tail of frame 2 is lost, its head runs into frame 3 up to the next 0x00
+	Test_Receive(frames[0], len[0]);
+	Test_Receive(frames[1], len[1]);
+	Test_Receive(frames[2], len[2] / 2u);
+	Test_Receive(frames[3], len[3]);
+	Test_Receive(frames[0], len[0]);
+
+	HOST_CHECK(Test_Rx.good == 2);
+	HOST_CHECK(Test_Rx.bad == 2);
+	HOST_CHECK(Test_Rx.mismatches == 0);
+
+	//A frame too long to be valid and a lone delimiter
+	memset(&Test_Rx, 0, sizeof(Test_Rx));
+	Test_Receive(frames[3], len[3] - 1u);
+	Test_Receive(frames[3], len[3] - 1u);
+	Test_Receive(frames[3], len[3]);
+	Test_Receive(frames[3] + len[3] - 1u, 1);
+	Test_Receive(frames[3], len[3]);
+
+	HOST_CHECK(Test_Rx.good == 1);
+	HOST_CHECK(Test_Rx.bad == 1);
+}
+
+
+/**
+ * @brief  Sample packets at rate (Hz) through the queue, the loopback and the receiver.
+ */
+static void Test_Stream(uint32_t rate, uint32_t seconds){
+
+	uint32_t period = 1000000u / rate, end = seconds * 1000000u, next = 0, sent = 0, delivered, pos = 0, chunk;
+	float capacity = (float)BMP390_Tlm_Baudrate / 10.0f, busy;
+
+	Host_Reset();
+	memset(&Test_Tlm, 0, sizeof(Test_Tlm));
+	memset(&Test_Rx, 0, sizeof(Test_Rx));
+	Test_WireLen = 0;
+	Test_TxLen = 0;
+	Test_TxEnd = 0;
+
+	HOST_CHECK(BMP390_Telemetry_Init(&Test_Tlm));
+
+	while((uint32_t)Host_Micros() < end){
+
+		if((uint32_t)Host_Micros() >= next){
+
+			BMP390_Sample_TypeDef *s = &Test_Sent[sent % Test_MaxSamples];
+			uint32_t bits = Test_Rand();
+
+			//Arbitrary bit patterns, zero bytes included
+			s->timestamp = HAL_GetTick();
+			memcpy(&s->press, &bits, 4);
+			s->temp = 25.0f + (float)(bits & 0xFF) * 0.01f;
+			s->vertAlt = (float)sent * 0.25f;
+			s->vertSpd = 0.0f;
+			s->vertAcc = -9.81f;
+			bits = Test_Rand() & 0x00FF00FFu;
+			memcpy(&s->gForce, &bits, 4);
+
+			BMP390_Telemetry_SendSample(&Test_Tlm, s);
+			sent++;
+			next += period;
+		}
+
+		Host_Advance(Test_Tick);
+		Test_Uart();
+	}
+
+	//The queue empties, the receiver reads the wire in chunks
+	while(Test_Tlm.busy){
+
+		Host_Advance(Test_Tick);
+		Test_Uart();
+	}
+
+	while(pos < Test_WireLen){
+
+		chunk = 1u + (Test_Rand() % Test_MaxChunk);
+		chunk = (chunk > (Test_WireLen - pos)) ? (Test_WireLen - pos) : chunk;
+		Test_Receive(&Test_Wire[pos], chunk);
+		pos += chunk;
+	}
+
+	delivered = Test_Rx.good;
+	busy = (float)Test_WireLen / (capacity * (float)seconds);
+
+	printf("%4u Hz : %5u sent, %5u delivered, %5u dropped, %5.1f %% of the link, %.0f B/s\n",
+		   rate, sent, delivered, Test_Tlm.droppedFrames, busy * 100.0f, (float)Test_WireLen / (float)seconds);
+
+	HOST_CHECK(Test_Rx.bad == 0);
+	HOST_CHECK(Test_Rx.mismatches == 0);
+	HOST_CHECK(Test_Tlm.txErrors == 0);
+	HOST_CHECK(Test_Tlm.sentFrames == delivered);
+	HOST_CHECK((delivered + Test_Tlm.droppedFrames) == sent);
+
+	if(((float)(BMP390_Tlm_MaxFrame * rate)) < capacity){
+
+		HOST_CHECK(Test_Tlm.droppedFrames == 0);
+	}
+	else{
+
+		HOST_CHECK(Test_Tlm.droppedFrames != 0);
+		HOST_CHECK(busy >= Test_MinBusy);
+	}
+}
+
+
+/**
+ * @brief  Stand-in for USART1 : the running DMA transfer leaves at 10 bit times per byte, then completes.
+ */
+static void Test_Uart(void){
+
+	uint32_t now = (uint32_t)Host_Micros(), src;
+	uint8_t b;
+
+	if(Test_TxLen == 0){
+
+		Test_TxLen = Host_Dma_Data(&src);
+
+		if(Test_TxLen == 0){
+
+			return;
+		}
+
+		//The DMA reads the buffer that isn't being filled
+		b = Test_Tlm.active ^ 1u;
+		HOST_CHECK(src == (uint32_t)(uintptr_t)Test_Tlm.buf[b]);
+
+		Test_TxEnd = ((Test_TxEnd > now) ? Test_TxEnd : now) + ((Test_TxLen * 10u * 1000000u) / BMP390_Tlm_Baudrate);
+		memcpy(&Test_Wire[Test_WireLen], Test_Tlm.buf[b], Test_TxLen);
+	}
+
+	if(now >= Test_TxEnd){
+
+		Test_WireLen += Test_TxLen;
+		Test_TxLen = 0;
+
+		HOST_CHECK(Host_Dma_Finish(false));
+		BMP390_Telemetry_IRQHandler(&Test_Tlm);
+	}
+}
+
+
+/**
+ * @brief  Bytes of the wire into the receiver, a 0x00 ends a frame.
+ */
+static void Test_Receive(const uint8_t *data, uint32_t len){
+
+	for(uint32_t i = 0; i < len; i++){
+
+		if(data[i] != 0x00){
+
+			if(Test_Rx.len < sizeof(Test_Rx.frame)){
+
+				Test_Rx.frame[Test_Rx.len++] = data[i];
+			}
+			else{
+
+				Test_Rx.overflow = 1;
+			}
+		}
+		else if(Test_Rx.overflow){
+
+			Test_Rx.bad++;
+			Test_Rx.overflow = 0;
+			Test_Rx.len = 0;
+		}
+		else if(Test_Rx.len != 0){
+
+			Test_Frame();
+			Test_Rx.len = 0;
+		}
+	}
+}
+
+
+/**
+ * @brief  One frame of the receiver against the sample that was sent with its sequence number.
+ */
+static void Test_Frame(void){
+
+	uint8_t payload[BMP390_Tlm_MaxPayload], expected[28], type, seq;
+	int16_t n = BMP390_Telemetry_Decode(Test_Rx.frame, Test_Rx.len, &type, &seq, payload);
+
+	if(n < 0){
+
+		Test_Rx.bad++;
+		return;
+	}
+
+	//Dropped frames used up their sequence numbers too
+	Test_Rx.index = (Test_Rx.good == 0) ? seq : (Test_Rx.index + (uint8_t)(seq - Test_Rx.seq));
+	Test_Rx.seq = seq;
+	Test_Rx.good++;
+
+	Test_Payload(&Test_Sent[Test_Rx.index % Test_MaxSamples], expected);
+
+	if((type != BMP390_Tlm_Sample) || (n != sizeof(expected)) || (memcmp(payload, expected, sizeof(expected)) != 0)){
+
+		Test_Rx.mismatches++;
+	}
+}
+
+
+/**
+ * @brief  The payload layout of BMP390_Tlm_Sample, written out field by field.
+ */
+static void Test_Payload(const BMP390_Sample_TypeDef *Sample, uint8_t *payload){
+
+	const float *fields[6] = {&Sample->press, &Sample->temp, &Sample->vertAlt, &Sample->vertSpd, &Sample->vertAcc,
+							  &Sample->gForce};
+	uint32_t bits;
+
+	for(uint8_t b = 0; b < 4; b++){
+
+		payload[b] = (uint8_t)(Sample->timestamp >> (8u * b));
+	}
+
+	for(uint8_t f = 0; f < 6; f++){
+
+		memcpy(&bits, fields[f], 4);
+
+		for(uint8_t b = 0; b < 4; b++){
+
+			payload[4u + (4u * f) + b] = (uint8_t)(bits >> (8u * b));
+		}
+	}
+}
+
+
+/**
+ * @brief  xorshift32.
+ */
+static uint32_t Test_Rand(void){
+
+	Test_Rng ^= Test_Rng << 13;
+	Test_Rng ^= Test_Rng >> 17;
+	Test_Rng ^= Test_Rng << 5;
+
+	return Test_Rng;
+}
@@ -0,0 +1,259 @@
+/*!
+ *  @file : bmp390_tool_replay.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * NOTE ==> Host replay of a recorded flight :
+ *
+ * 			bmp390_tool_replay [-e expected.bin] [-w out.bin] [-a fixedAltitude] [-m totalMass] nvm.bin log.bin
+ *
+ * 			nvm.bin  : the 21 calibration bytes from 0x31, decoded by BMP390_Get_RawCalibCoeff through the mock
+ * 			log.bin  : a dump of the LOG region (st-flash read, see BMP390_Logger_Parse) or an array of
+ * 					   BMP390_RawFrame_TypeDef
+ * 			expected : an array of BMP390_Sample_TypeDef, record i is compared with sample i
+ * 			out      : every output goes there in the same format, the expected file of the next run
+ *
+ * 			Both files are mapped, not read : a dump is parsed in place and a frame array goes to
+ * 			BMP390_Replay_Run as it is. The exit code is 1 if a sample doesn't match.
+ */
+
+#include "host_hal.h"
+#include "bmp390_mock.h"
+#include "bmp390_logger.h"
+#include "bmp390_replay.h"
+#include "stdlib.h"
+#include "string.h"
+#include "fcntl.h"
+#include "sys/mman.h"
+#include "sys/stat.h"
+#include "time.h"
+#include "unistd.h"
+
+
+#define Tool_Address				0x76		/*! The mock only holds the NVM bytes */
+#define Tool_NvmSize				21
+
+static const void *Tool_Map(const char *path, size_t *size);
+static _Bool Tool_Calib(const char *path, BMP390_PrcsdCalibData_TypeDef *Calib);
+static uint32_t Tool_Clock(void);
+static void Tool_Write(void *ctx, BMP390_Sample_TypeDef *Sample);
+
+
+int main(int argc, char **argv){
+
+	const char *expectedPath = NULL, *outPath = NULL;
+	float fixedAltitude = 0.0f, totalMass = 0.0f;
+	BMP390_PrcsdCalibData_TypeDef calib;
+	BMP390_Replay_TypeDef replay;
+	const uint8_t *log;
+	size_t logSize, expectedSize = 0;
+	uint32_t start, frames, compared;
+	int opt;
+
+	while((opt = getopt(argc, argv, "e:w:a:m:")) != -1){
+
+		switch(opt){
+
+			case 'e': expectedPath = optarg; break;
+			case 'w': outPath = optarg; break;
+			case 'a': fixedAltitude = strtof(optarg, NULL); break;
+			case 'm': totalMass = strtof(optarg, NULL); break;
+			default : optind = argc; break;
+		}
+	}
+
+	if((argc - optind) != 2){
+
+		fprintf(stderr, "usage : %s [-e expected.bin] [-w out.bin] [-a fixedAltitude] [-m totalMass] nvm.bin log.bin\n", argv[0]);
+		return 2;
+	}
+
+	if(!Tool_Calib(argv[optind], &calib) || (log = Tool_Map(argv[optind + 1], &logSize)) == NULL){
+
+		return 2;
+	}
+
+	BMP390_Replay_Init(&replay, &calib, fixedAltitude, totalMass);
+	replay.clock = Tool_Clock;
+
+	if(expectedPath != NULL){
+
+		if((replay.expected = Tool_Map(expectedPath, &expectedSize)) == NULL){
+
+			return 2;
+		}
+
+		replay.expectedCount = (uint32_t)(expectedSize / sizeof(BMP390_Sample_TypeDef));
+	}
+
+	if(outPath != NULL){
+
+		if((replay.stageCtx = fopen(outPath, "wb")) == NULL){
+
+			perror(outPath);
+			return 2;
+		}
+
+		replay.stage = Tool_Write;
+	}
+
+	if((logSize >= BMP390_Log_PageSize) && ((logSize % BMP390_Log_PageSize) == 0) &&
+	   ((log[0] | (log[1] << 8)) == BMP390_Log_Magic)){
+
+		start = Tool_Clock();
+		BMP390_Logger_Parse(log, (uint32_t)logSize, BMP390_Replay_LogCallback, &replay);
+		replay.elapsedUs = Tool_Clock() - start;
+
+		if(replay.elapsedUs != 0){
+
+			replay.framesPerSecond = (uint32_t)(((uint64_t)replay.frames * 1000000u) / replay.elapsedUs);
+		}
+	}
+	else if((logSize % sizeof(BMP390_RawFrame_TypeDef)) == 0){
+
+		//The frames with a recorded sample are compared, the rest are only replayed
+		frames = (uint32_t)(logSize / sizeof(BMP390_RawFrame_TypeDef));
+		compared = (frames < replay.expectedCount) ? frames : replay.expectedCount;
+
+		BMP390_Replay_Run(&replay, (const BMP390_RawFrame_TypeDef *)log, replay.expected, NULL, compared);
+		BMP390_Replay_Run(&replay, (const BMP390_RawFrame_TypeDef *)log + compared, NULL, NULL, frames - compared);
+	}
+	else{
+
+		fprintf(stderr, "%s : neither a LOG dump nor a frame array\n", argv[optind + 1]);
+		return 2;
+	}
+
+	if(replay.stageCtx != NULL){
+
+		fclose(replay.stageCtx);
+	}
+
+	printf("%u frames, %u samples/s\n", replay.frames, replay.framesPerSecond);
+
+	if(replay.expectedCount != 0){
+
+		printf("%u compared, %u mismatches", replay.compared, replay.mismatches);
+
+		if(replay.mismatches != 0){
+
+			printf(", the first one at %u", replay.firstMismatch);
+		}
+
+		printf("\nmax error : press %g Pa, temp %g C, vertAlt %g m, vertSpd %g, vertAcc %g\n",
+			   replay.maxErr.press, replay.maxErr.temp, replay.maxErr.vertAlt, replay.maxErr.vertSpd, replay.maxErr.vertAcc);
+	}
+
+	return (replay.mismatches == 0) ? 0 : 1;
+}
+
+
+/**
+ * @brief  Read only private mapping of a whole file, NULL after printing the error.
+ */
+static const void *Tool_Map(const char *path, size_t *size){
+
+	struct stat st;
+	void *map;
+	int fd;
+
+	if((fd = open(path, O_RDONLY)) < 0 || fstat(fd, &st) != 0 || st.st_size == 0){
+
+		perror(path);
+		return NULL;
+	}
+
+	map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+
+	if(map == MAP_FAILED){
+
+		perror(path);
+		return NULL;
+	}
+
+	*size = (size_t)st.st_size;
+	return map;
+}
+
+
+/**
+ * @brief  The NVM bytes go into the mock's registers, the driver reads and processes them like on the target.
+ */
+static _Bool Tool_Calib(const char *path, BMP390_PrcsdCalibData_TypeDef *Calib){
+
+	BMP390_HandleTypeDef sensor = {0};
+	BMP390_RawCalibData_TypeDef raw;
+	const uint8_t *nvm;
+	size_t size;
+
+	if((nvm = Tool_Map(path, &size)) == NULL){
+
+		return false;
+	}
+
+	if(size != Tool_NvmSize){
+
+		fprintf(stderr, "%s : %u bytes, the NVM is %u\n", path, (unsigned)size, Tool_NvmSize);
+		return false;
+	}
+
+	Host_Reset();
+	BMP390_Mock_Init(Tool_Address);
+	memcpy(&BMP390_Mock.reg[BMP390_StartAdd_CalibCoeff], nvm, Tool_NvmSize);
+
+	sensor.i2c = &hi2c1;
+	sensor.BMP390_I2C_ADDRESS = Tool_Address;
+
+	if(!BMP390_Get_RawCalibCoeff(&sensor, &raw) || !BMP390_Calc_PrcsdCalibrationCoeff(&sensor, &raw)){
+
+		return false;
+	}
+
+	*Calib = sensor.Prcsd_NVM;
+	return true;
+}
+
+
+static uint32_t Tool_Clock(void){
+
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)(((uint64_t)ts.tv_sec * 1000000u) + ((uint64_t)ts.tv_nsec / 1000u));
+}
+
+
+static void Tool_Write(void *ctx, BMP390_Sample_TypeDef *Sample){
+
+	fwrite(Sample, sizeof(*Sample), 1, (FILE *)ctx);
+}
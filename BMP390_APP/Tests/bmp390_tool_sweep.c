@@ -0,0 +1,450 @@
+/*!
+ *  @file : bmp390_tool_sweep.c
+ *  @date : 19-10-2026
+ *
+ *
+ *      Author: Yunus Emre KAYRA (https://github.com/YEK-Kayra)
+ ******************************************************************************
+ * 	@attention
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 TAISAT Turkish Artificial Intelligence Supported Autonomous Technologies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * NOTE ==> Parameter sweep over a set of flights :
+ *
+ * 			bmp390_tool_sweep [-t threads] [-s spdSteps] [-f flights] [-p period] [flight.f32 ...]
+ *
+ * 			Without files, flights simulated flights (boost, coast, descent under a parachute) are used with the
+ * 			datasheet noise. A file is a recorded flight : float pressures (Pa) every period seconds.
+ * 			The grid is BMP390_Sweep_GridSize(spdSteps) configurations, spdSteps 209 is about 10k of them.
+ *
+ * 			Every worker owns a range of grid indexes and takes small chunks from its front. A worker whose range is
+ * 			empty steals the upper half of another worker's range. A range is a single 64 bit word (end, next),
+ * 			so taking a chunk and stealing are one compare and swap each and nothing is locked. The evaluations
+ * 			don't share anything but the flights (read only), so the sweep scales with the cores.
+ */
+
+#include "bmp390_sweep.h"
+#include "pthread.h"
+#include "stdatomic.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "time.h"
+#include "unistd.h"
+
+
+#define Tool_MaxThreads				64
+#define Tool_MaxFlights				64
+#define Tool_Chunk					8			/*! Grid indexes taken at a time */
+#define Tool_Best					10
+
+typedef struct{
+
+	_Atomic uint64_t range;			/*! end << 32 | next */
+	pthread_t thread;
+	uint32_t evaluated;
+	uint32_t steals;
+
+}Tool_Worker_TypeDef;
+
+static Tool_Worker_TypeDef Tool_Workers[Tool_MaxThreads];
+static uint32_t Tool_Threads;
+
+static BMP390_Sweep_Flight_TypeDef Tool_Flights[Tool_MaxFlights];
+static uint32_t Tool_FlightCount;
+
+static BMP390_Sweep_Result_TypeDef *Tool_Results;
+static uint16_t Tool_SpdSteps;
+
+static void *Tool_Worker(void *arg);
+static _Bool Tool_Take(Tool_Worker_TypeDef *Worker, uint32_t *first, uint32_t *count);
+static _Bool Tool_Steal(uint32_t self);
+static void Tool_EvaluateConfig(uint32_t index);
+static _Bool Tool_Simulate(BMP390_Sweep_Flight_TypeDef *Flight, uint32_t k, float period);
+static _Bool Tool_Load(BMP390_Sweep_Flight_TypeDef *Flight, const char *path, float period);
+static double Tool_Seconds(void);
+
+
+int main(int argc, char **argv){
+
+	BMP390_Sweep_Weights_TypeDef weights = {1.0f, 1.0f};
+	uint32_t flights = 8, n, share, evaluated = 0, steals = 0, missing = 0;
+	float period = 0.02f;
+	double start, elapsed;
+	int opt;
+
+	Tool_Threads = (uint32_t)sysconf(_SC_NPROCESSORS_ONLN);
+	Tool_SpdSteps = 209;
+
+	while((opt = getopt(argc, argv, "t:s:f:p:")) != -1){
+
+		switch(opt){
+
+			case 't': Tool_Threads = (uint32_t)atoi(optarg); break;
+			case 's': Tool_SpdSteps = (uint16_t)atoi(optarg); break;
+			case 'f': flights = (uint32_t)atoi(optarg); break;
+			case 'p': period = strtof(optarg, NULL); break;
+			default :
+				fprintf(stderr, "usage : %s [-t threads] [-s spdSteps] [-f flights] [-p period] [flight.f32 ...]\n", argv[0]);
+				return 2;
+		}
+	}
+
+	if(Tool_Threads < 1 || Tool_Threads > Tool_MaxThreads || Tool_SpdSteps < 1 || period <= 0.0f){
+
+		fprintf(stderr, "1 to %u threads, spdSteps and period above 0\n", Tool_MaxThreads);
+		return 2;
+	}
+
+	if(optind < argc){
+
+		for(int i = optind; i < argc && Tool_FlightCount < Tool_MaxFlights; i++){
+
+			if(!Tool_Load(&Tool_Flights[Tool_FlightCount++], argv[i], period)){
+
+				return 2;
+			}
+		}
+	}
+	else{
+
+		for(uint32_t k = 0; k < flights && Tool_FlightCount < Tool_MaxFlights; k++){
+
+			if(!Tool_Simulate(&Tool_Flights[Tool_FlightCount++], k, period)){
+
+				return 2;
+			}
+		}
+	}
+
+	for(uint32_t f = 0; f < Tool_FlightCount; f++){
+
+		BMP390_Sweep_PrepareFlight(&Tool_Flights[f]);
+	}
+
+	n = BMP390_Sweep_GridSize(Tool_SpdSteps);
+	Tool_Results = calloc(n, sizeof(*Tool_Results));
+
+	for(uint32_t i = 0; i < n; i++){
+
+		Tool_Results[i].index = UINT32_MAX;
+	}
+
+	//Equal ranges to begin with, stealing evens out what is left
+	share = (n + Tool_Threads - 1) / Tool_Threads;
+
+	for(uint32_t w = 0; w < Tool_Threads; w++){
+
+		uint64_t first = ((uint64_t)w * share < n) ? ((uint64_t)w * share) : n;
+		uint64_t end = ((first + share) < n) ? (first + share) : n;
+
+		atomic_init(&Tool_Workers[w].range, (end << 32) | first);
+	}
+
+	start = Tool_Seconds();
+
+	for(uint32_t w = 0; w < Tool_Threads; w++){
+
+		pthread_create(&Tool_Workers[w].thread, NULL, Tool_Worker, (void *)(uintptr_t)w);
+	}
+
+	for(uint32_t w = 0; w < Tool_Threads; w++){
+
+		pthread_join(Tool_Workers[w].thread, NULL);
+		evaluated += Tool_Workers[w].evaluated;
+		steals += Tool_Workers[w].steals;
+	}
+
+	elapsed = Tool_Seconds() - start;
+
+	//Every configuration exactly once
+	for(uint32_t i = 0; i < n; i++){
+
+		missing += (Tool_Results[i].index != i);
+	}
+
+	printf("%u configurations x %u flights, %u threads : %.2f s, %.0f configurations/s, %u steals\n",
+		   n, Tool_FlightCount, Tool_Threads, elapsed, (double)n / elapsed, steals);
+
+	for(uint32_t w = 0; w < Tool_Threads; w++){
+
+		printf("  thread %u : %u configurations, %u steals\n", w, Tool_Workers[w].evaluated, Tool_Workers[w].steals);
+	}
+
+	BMP390_Sweep_Rank(Tool_Results, n, &weights, Tool_Best);
+
+	printf("rank  coef  osrs  spdAlpha  altRms(m)  lag(s)  detect(s)  score\n");
+
+	for(uint32_t i = 0; i < Tool_Best && i < n; i++){
+
+		BMP390_Sweep_Config_TypeDef config;
+		BMP390_Sweep_Result_TypeDef *r = &Tool_Results[i];
+		char detect[16] = "never";
+
+		BMP390_Sweep_GridConfig(r->index, Tool_SpdSteps, &config);
+
+		if(r->detected){
+
+			snprintf(detect, sizeof(detect), "%.2f", r->detectDelay);
+		}
+
+		printf("%4u  %4u  %4u  %8.3f  %9.3f  %6.2f  %9s  %g\n", i + 1, (1u << config.filterCoef) - 1u,
+			   1u << config.pressOsrs, config.spdAlpha, r->altRms, r->lag, detect, r->score);
+	}
+
+	if(evaluated != n || missing != 0){
+
+		printf("%u evaluated, %u configurations missing\n", evaluated, missing);
+		return 1;
+	}
+
+	return 0;
+}
+
+
+static void *Tool_Worker(void *arg){
+
+	uint32_t self = (uint32_t)(uintptr_t)arg;
+	Tool_Worker_TypeDef *Worker = &Tool_Workers[self];
+	uint32_t first, count;
+
+	do{
+
+		while(Tool_Take(Worker, &first, &count)){
+
+			for(uint32_t i = first; i < (first + count); i++){
+
+				Tool_EvaluateConfig(i);
+			}
+
+			Worker->evaluated += count;
+		}
+
+	}while(Tool_Steal(self));
+
+	return NULL;
+}
+
+
+/**
+ * @brief  Takes up to Tool_Chunk indexes from the front of the worker's own range.
+ */
+static _Bool Tool_Take(Tool_Worker_TypeDef *Worker, uint32_t *first, uint32_t *count){
+
+	uint64_t range = atomic_load(&Worker->range);
+
+	for(;;){
+
+		uint32_t next = (uint32_t)range, end = (uint32_t)(range >> 32);
+
+		if(next >= end){
+
+			return false;
+		}
+
+		*first = next;
+		*count = ((end - next) < Tool_Chunk) ? (end - next) : Tool_Chunk;
+
+		//A failed exchange reloads range, a thief took the upper half meanwhile
+		if(atomic_compare_exchange_weak(&Worker->range, &range, ((uint64_t)end << 32) | (next + *count))){
+
+			return true;
+		}
+	}
+}
+
+
+/**
+ * @brief  Moves the upper half of another worker's range into the empty range of self.
+ * @retval false if no worker has more than a chunk left, the sweep is ending and the owners finish their ranges.
+ */
+static _Bool Tool_Steal(uint32_t self){
+
+	for(uint32_t k = 1; k < Tool_Threads; k++){
+
+		Tool_Worker_TypeDef *Victim = &Tool_Workers[(self + k) % Tool_Threads];
+		uint64_t range = atomic_load(&Victim->range);
+		uint32_t next = (uint32_t)range, end = (uint32_t)(range >> 32);
+
+		while((end > next) && ((end - next) > Tool_Chunk)){
+
+			uint32_t mid = next + ((end - next) / 2);
+
+			if(atomic_compare_exchange_weak(&Victim->range, &range, ((uint64_t)mid << 32) | next)){
+
+				//Nobody writes an empty range but its owner
+				atomic_store(&Tool_Workers[self].range, ((uint64_t)end << 32) | mid);
+				Tool_Workers[self].steals++;
+				return true;
+			}
+
+			next = (uint32_t)range;
+			end = (uint32_t)(range >> 32);
+		}
+	}
+
+	return false;
+}
+
+
+/**
+ * @brief  One configuration over every flight : RMS of the altitude errors, the worst lag and detection delay.
+ */
+static void Tool_EvaluateConfig(uint32_t index){
+
+	BMP390_Sweep_Config_TypeDef config;
+	BMP390_Sweep_Result_TypeDef one, *Result = &Tool_Results[index];
+	double sumSq = 0.0;
+
+	BMP390_Sweep_GridConfig(index, Tool_SpdSteps, &config);
+
+	Result->lag = 0.0f;
+	Result->detectDelay = 0.0f;
+	Result->detected = true;
+
+	for(uint32_t f = 0; f < Tool_FlightCount; f++){
+
+		BMP390_Sweep_Evaluate(&Tool_Flights[f], &config, &one);
+
+		sumSq += (double)one.altRms * one.altRms;
+
+		if(fabsf(one.lag) > fabsf(Result->lag)){
+
+			Result->lag = one.lag;
+		}
+
+		if(!one.detected){
+
+			Result->detected = false;
+		}
+		else if(fabsf(one.detectDelay) > fabsf(Result->detectDelay)){
+
+			Result->detectDelay = one.detectDelay;
+		}
+	}
+
+	Result->altRms = (float)sqrt(sumSq / Tool_FlightCount);
+	Result->index = index;
+}
+
+
+/**
+ * @brief  Flight k : a boost of 2 to 4 s at 50 to 120 m/s², a ballistic coast to the apogee and 30 s under a
+ * 		   6 m/s parachute, the pressure of the altitude through the standard atmosphere.
+ */
+static _Bool Tool_Simulate(BMP390_Sweep_Flight_TypeDef *Flight, uint32_t k, float period){
+
+	float boostAcc = 50.0f + (float)((k * 37u) % 71u);
+	float boostTime = 2.0f + (float)(k % 5u) * 0.5f;
+	float burnout = boostAcc * boostTime;
+	float burnoutAlt = 0.5f * boostAcc * boostTime * boostTime;
+	float apogeeTime = boostTime + (burnout / (float)GravityAccel);
+	float apogeeAlt = burnoutAlt + ((burnout * burnout) / (2.0f * (float)GravityAccel));
+	uint32_t n = (uint32_t)((apogeeTime + 30.0f) / period);
+	float *press = malloc(n * sizeof(float));
+	float *alt = malloc(n * sizeof(float));
+
+	if(press == NULL || alt == NULL){
+
+		return false;
+	}
+
+	for(uint32_t i = 0; i < n; i++){
+
+		float t = (float)i * period, h;
+
+		if(t < boostTime){
+
+			h = 0.5f * boostAcc * t * t;
+		}
+		else if(t < apogeeTime){
+
+			h = burnoutAlt + (burnout * (t - boostTime)) - (0.5f * (float)GravityAccel * (t - boostTime) * (t - boostTime));
+		}
+		else{
+
+			h = apogeeAlt - (6.0f * (t - apogeeTime));
+		}
+
+		alt[i] = h;
+		press[i] = (float)(SeaLevelPress * pow(1.0 - ((GradientTemp * h) / SeaLevelTemp),
+											   GravityAccel / (GasCoefficient * GradientTemp)));
+	}
+
+	Flight->press = press;
+	Flight->truthAlt = alt;
+	Flight->n = n;
+	Flight->period = period;
+	Flight->noise = BMP390_PressNoise_X1;
+
+	return true;
+}
+
+
+/**
+ * @brief  A recorded flight, the altitude of its pressures is the reference and no noise is added.
+ */
+static _Bool Tool_Load(BMP390_Sweep_Flight_TypeDef *Flight, const char *path, float period){
+
+	FILE *file = fopen(path, "rb");
+	float *press;
+	long size;
+
+	if(file == NULL || fseek(file, 0, SEEK_END) != 0 || (size = ftell(file)) < (long)sizeof(float)){
+
+		perror(path);
+		return false;
+	}
+
+	rewind(file);
+	press = malloc((size_t)size);
+
+	if(press == NULL || fread(press, 1, (size_t)size, file) != (size_t)size){
+
+		perror(path);
+		fclose(file);
+		return false;
+	}
+
+	fclose(file);
+
+	Flight->press = press;
+	Flight->truthAlt = NULL;
+	Flight->n = (uint32_t)((size_t)size / sizeof(float));
+	Flight->period = period;
+	Flight->noise = 0.0f;
+
+	return true;
+}
+
+
+static double Tool_Seconds(void){
+
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + ((double)ts.tv_nsec * 1.0e-9);
+}